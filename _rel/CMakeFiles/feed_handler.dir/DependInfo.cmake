@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/client/feed_handler.cpp" "CMakeFiles/feed_handler.dir/src/client/feed_handler.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/client/feed_handler.cpp.o.d"
+  "/root/repo/src/client/line_arbiter.cpp" "CMakeFiles/feed_handler.dir/src/client/line_arbiter.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/client/line_arbiter.cpp.o.d"
+  "/root/repo/src/client/main.cpp" "CMakeFiles/feed_handler.dir/src/client/main.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/client/main.cpp.o.d"
+  "/root/repo/src/client/parser.cpp" "CMakeFiles/feed_handler.dir/src/client/parser.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/client/parser.cpp.o.d"
+  "/root/repo/src/client/socket.cpp" "CMakeFiles/feed_handler.dir/src/client/socket.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/client/socket.cpp.o.d"
+  "/root/repo/src/client/visualizer.cpp" "CMakeFiles/feed_handler.dir/src/client/visualizer.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/client/visualizer.cpp.o.d"
+  "/root/repo/src/common/analytics.cpp" "CMakeFiles/feed_handler.dir/src/common/analytics.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/analytics.cpp.o.d"
+  "/root/repo/src/common/batch_encoder.cpp" "CMakeFiles/feed_handler.dir/src/common/batch_encoder.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/batch_encoder.cpp.o.d"
+  "/root/repo/src/common/cache.cpp" "CMakeFiles/feed_handler.dir/src/common/cache.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/cache.cpp.o.d"
+  "/root/repo/src/common/huge_pages.cpp" "CMakeFiles/feed_handler.dir/src/common/huge_pages.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/huge_pages.cpp.o.d"
+  "/root/repo/src/common/latency_tracker.cpp" "CMakeFiles/feed_handler.dir/src/common/latency_tracker.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/latency_tracker.cpp.o.d"
+  "/root/repo/src/common/memory_pool.cpp" "CMakeFiles/feed_handler.dir/src/common/memory_pool.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/memory_pool.cpp.o.d"
+  "/root/repo/src/common/order_book.cpp" "CMakeFiles/feed_handler.dir/src/common/order_book.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/order_book.cpp.o.d"
+  "/root/repo/src/common/slab_allocator.cpp" "CMakeFiles/feed_handler.dir/src/common/slab_allocator.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/slab_allocator.cpp.o.d"
+  "/root/repo/src/common/symbol_master.cpp" "CMakeFiles/feed_handler.dir/src/common/symbol_master.cpp.o" "gcc" "CMakeFiles/feed_handler.dir/src/common/symbol_master.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
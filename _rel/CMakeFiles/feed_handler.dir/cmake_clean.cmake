@@ -0,0 +1,39 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/feed_handler.dir/src/client/feed_handler.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/client/feed_handler.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/client/line_arbiter.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/client/line_arbiter.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/client/main.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/client/main.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/client/parser.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/client/parser.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/client/socket.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/client/socket.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/client/visualizer.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/client/visualizer.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/cache.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/feed_handler.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/feed_handler.dir/src/common/symbol_master.cpp.o.d"
+  "feed_handler"
+  "feed_handler.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/feed_handler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
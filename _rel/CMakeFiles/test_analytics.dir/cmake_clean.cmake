@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_analytics.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_analytics.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_analytics.dir/tests/test_analytics.cpp.o"
+  "CMakeFiles/test_analytics.dir/tests/test_analytics.cpp.o.d"
+  "test_analytics"
+  "test_analytics.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_analytics.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_exchange_simulator.dir/src/client/parser.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/client/parser.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/alloc_counter.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/alloc_counter.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/client_manager.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/client_manager.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/exchange_simulator.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/exchange_simulator.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/impairment.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/impairment.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/tick_generator.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/tick_generator.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/udp_publisher.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/src/server/udp_publisher.cpp.o.d"
+  "CMakeFiles/test_exchange_simulator.dir/tests/test_exchange_simulator.cpp.o"
+  "CMakeFiles/test_exchange_simulator.dir/tests/test_exchange_simulator.cpp.o.d"
+  "test_exchange_simulator"
+  "test_exchange_simulator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_exchange_simulator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_impairment.dir/src/client/parser.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/client/parser.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/server/client_manager.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/server/client_manager.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/server/impairment.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/server/impairment.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/src/server/tick_generator.cpp.o"
+  "CMakeFiles/test_impairment.dir/src/server/tick_generator.cpp.o.d"
+  "CMakeFiles/test_impairment.dir/tests/test_impairment.cpp.o"
+  "CMakeFiles/test_impairment.dir/tests/test_impairment.cpp.o.d"
+  "test_impairment"
+  "test_impairment.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_impairment.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/common/analytics.cpp" "CMakeFiles/test_memory_pool.dir/src/common/analytics.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/analytics.cpp.o.d"
+  "/root/repo/src/common/batch_encoder.cpp" "CMakeFiles/test_memory_pool.dir/src/common/batch_encoder.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/batch_encoder.cpp.o.d"
+  "/root/repo/src/common/cache.cpp" "CMakeFiles/test_memory_pool.dir/src/common/cache.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/cache.cpp.o.d"
+  "/root/repo/src/common/huge_pages.cpp" "CMakeFiles/test_memory_pool.dir/src/common/huge_pages.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/huge_pages.cpp.o.d"
+  "/root/repo/src/common/latency_tracker.cpp" "CMakeFiles/test_memory_pool.dir/src/common/latency_tracker.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/latency_tracker.cpp.o.d"
+  "/root/repo/src/common/memory_pool.cpp" "CMakeFiles/test_memory_pool.dir/src/common/memory_pool.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/memory_pool.cpp.o.d"
+  "/root/repo/src/common/order_book.cpp" "CMakeFiles/test_memory_pool.dir/src/common/order_book.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/order_book.cpp.o.d"
+  "/root/repo/src/common/slab_allocator.cpp" "CMakeFiles/test_memory_pool.dir/src/common/slab_allocator.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/slab_allocator.cpp.o.d"
+  "/root/repo/src/common/symbol_master.cpp" "CMakeFiles/test_memory_pool.dir/src/common/symbol_master.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/src/common/symbol_master.cpp.o.d"
+  "/root/repo/tests/test_memory_pool.cpp" "CMakeFiles/test_memory_pool.dir/tests/test_memory_pool.cpp.o" "gcc" "CMakeFiles/test_memory_pool.dir/tests/test_memory_pool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
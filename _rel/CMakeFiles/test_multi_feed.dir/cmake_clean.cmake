@@ -0,0 +1,39 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_multi_feed.dir/src/client/feed_handler.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/client/feed_handler.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/client/line_arbiter.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/client/line_arbiter.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/client/parser.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/client/parser.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/client/socket.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/client/socket.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/client/visualizer.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/client/visualizer.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_multi_feed.dir/tests/test_multi_feed.cpp.o"
+  "CMakeFiles/test_multi_feed.dir/tests/test_multi_feed.cpp.o.d"
+  "test_multi_feed"
+  "test_multi_feed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_multi_feed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
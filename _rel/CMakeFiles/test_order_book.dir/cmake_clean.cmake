@@ -0,0 +1,31 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_order_book.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/src/server/tick_generator.cpp.o"
+  "CMakeFiles/test_order_book.dir/src/server/tick_generator.cpp.o.d"
+  "CMakeFiles/test_order_book.dir/tests/test_order_book.cpp.o"
+  "CMakeFiles/test_order_book.dir/tests/test_order_book.cpp.o.d"
+  "test_order_book"
+  "test_order_book.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_order_book.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
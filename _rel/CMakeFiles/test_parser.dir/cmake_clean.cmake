@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_parser.dir/src/client/parser.cpp.o"
+  "CMakeFiles/test_parser.dir/src/client/parser.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_parser.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_parser.dir/src/server/tick_generator.cpp.o"
+  "CMakeFiles/test_parser.dir/src/server/tick_generator.cpp.o.d"
+  "CMakeFiles/test_parser.dir/tests/test_parser.cpp.o"
+  "CMakeFiles/test_parser.dir/tests/test_parser.cpp.o.d"
+  "test_parser"
+  "test_parser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
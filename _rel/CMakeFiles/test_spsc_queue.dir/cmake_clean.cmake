@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_spsc_queue.dir/tests/test_spsc_queue.cpp.o"
+  "CMakeFiles/test_spsc_queue.dir/tests/test_spsc_queue.cpp.o.d"
+  "test_spsc_queue"
+  "test_spsc_queue.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_spsc_queue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
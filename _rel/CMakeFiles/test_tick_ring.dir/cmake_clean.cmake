@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_tick_ring.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_tick_ring.dir/tests/test_tick_ring.cpp.o"
+  "CMakeFiles/test_tick_ring.dir/tests/test_tick_ring.cpp.o.d"
+  "test_tick_ring"
+  "test_tick_ring.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_tick_ring.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
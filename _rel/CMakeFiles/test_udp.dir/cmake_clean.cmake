@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_udp.dir/src/client/parser.cpp.o"
+  "CMakeFiles/test_udp.dir/src/client/parser.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/client/socket.cpp.o"
+  "CMakeFiles/test_udp.dir/src/client/socket.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/analytics.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/analytics.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/batch_encoder.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/batch_encoder.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/cache.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/cache.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/huge_pages.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/huge_pages.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/latency_tracker.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/latency_tracker.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/memory_pool.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/memory_pool.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/order_book.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/order_book.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/slab_allocator.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/slab_allocator.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/common/symbol_master.cpp.o"
+  "CMakeFiles/test_udp.dir/src/common/symbol_master.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/server/tick_generator.cpp.o"
+  "CMakeFiles/test_udp.dir/src/server/tick_generator.cpp.o.d"
+  "CMakeFiles/test_udp.dir/src/server/udp_publisher.cpp.o"
+  "CMakeFiles/test_udp.dir/src/server/udp_publisher.cpp.o.d"
+  "CMakeFiles/test_udp.dir/tests/test_udp.cpp.o"
+  "CMakeFiles/test_udp.dir/tests/test_udp.cpp.o.d"
+  "test_udp"
+  "test_udp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_udp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,42 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_rel
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ProtocolTests "/root/repo/_rel/test_protocol")
+set_tests_properties(ProtocolTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;73;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(CacheTests "/root/repo/_rel/test_cache")
+set_tests_properties(CacheTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;77;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(LatencyTests "/root/repo/_rel/test_latency")
+set_tests_properties(LatencyTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;81;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(OrderBookTests "/root/repo/_rel/test_order_book")
+set_tests_properties(OrderBookTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;86;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ParserTests "/root/repo/_rel/test_parser")
+set_tests_properties(ParserTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;91;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ClientManagerTests "/root/repo/_rel/test_client_manager")
+set_tests_properties(ClientManagerTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;97;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(UdpTests "/root/repo/_rel/test_udp")
+set_tests_properties(UdpTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;103;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(SymbolMasterTests "/root/repo/_rel/test_symbol_master")
+set_tests_properties(SymbolMasterTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;107;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(AnalyticsTests "/root/repo/_rel/test_analytics")
+set_tests_properties(AnalyticsTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;111;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(SpscQueueTests "/root/repo/_rel/test_spsc_queue")
+set_tests_properties(SpscQueueTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;115;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(TickRingTests "/root/repo/_rel/test_tick_ring")
+set_tests_properties(TickRingTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;119;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(MultiFeedTests "/root/repo/_rel/test_multi_feed")
+set_tests_properties(MultiFeedTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;126;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(LineArbiterTests "/root/repo/_rel/test_line_arbiter")
+set_tests_properties(LineArbiterTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;131;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ImpairmentTests "/root/repo/_rel/test_impairment")
+set_tests_properties(ImpairmentTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;137;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(MemoryPoolTests "/root/repo/_rel/test_memory_pool")
+set_tests_properties(MemoryPoolTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;141;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(MessagePathTests "/root/repo/_rel/test_message_path")
+set_tests_properties(MessagePathTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;148;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(SlabAllocatorTests "/root/repo/_rel/test_slab_allocator")
+set_tests_properties(SlabAllocatorTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;153;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(ExchangeSimulatorTests "/root/repo/_rel/test_exchange_simulator")
+set_tests_properties(ExchangeSimulatorTests PROPERTIES  TIMEOUT "120" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;162;add_test;/root/repo/CMakeLists.txt;0;")
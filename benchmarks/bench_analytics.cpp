@@ -0,0 +1,85 @@
+// Analytics engine benchmark
+// Per-update cost of the feed path with and without AnalyticsEngine
+// (trades and quotes mixed like the feed, ~30/70), and reader cost
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../include/analytics.h"
+#include "../include/cache.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t OPS = 4000000;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// One millisecond of feed time per 100 messages, so bars roll over
+// every second and minute as they would live
+static double run(size_t symbols, bool with_analytics, const std::vector<uint16_t>& order) {
+    auto cache = std::make_unique<SymbolCache>(symbols);
+    auto analytics = std::make_unique<AnalyticsEngine>(symbols);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < OPS; ++i) {
+        uint16_t s = order[i & (order.size() - 1)];
+        double px = 100.0 + (i & 63) * 0.05;
+        uint64_t ts = i * 10000;
+        if (i % 10 < 3) {
+            cache->update_trade(s, px, 10, ts);
+            if (with_analytics) analytics->on_trade(s, px, 10, ts);
+        } else {
+            cache->update_quote(s, px, 100, px + 0.05, 200, ts);
+            if (with_analytics) analytics->on_quote(s, px, px + 0.05);
+        }
+    }
+    return elapsed_ns(start) / OPS;
+}
+
+int main() {
+    std::cout << "=== Analytics Engine Benchmark ===\n";
+    std::cout << OPS << " messages, 30% trades\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "symbols   cache only   cache+analytics   overhead ns/msg\n";
+    for (size_t symbols : {500, 5000}) {
+        std::vector<uint16_t> order(1 << 16);
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<size_t> pick(0, symbols - 1);
+        for (auto& s : order) s = static_cast<uint16_t>(pick(rng));
+
+        double base = run(symbols, false, order);
+        double with = run(symbols, true, order);
+        std::cout << std::setw(7) << symbols << std::setw(13) << base
+                  << std::setw(18) << with << std::setw(18) << with - base << "\n";
+    }
+
+    // Reader side on a populated engine
+    constexpr size_t SYMBOLS = 500;
+    auto engine = std::make_unique<AnalyticsEngine>(SYMBOLS);
+    for (size_t i = 0; i < 200000; ++i) {
+        engine->on_trade(static_cast<uint16_t>(i % SYMBOLS), 100.0 + (i & 7), 10, i * 1000000);
+    }
+
+    volatile double sink = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < OPS; ++i) {
+        sink = sink + engine->get(static_cast<uint16_t>(i % SYMBOLS)).vwap;
+    }
+    std::cout << "\nget(): " << elapsed_ns(start) / OPS << " ns\n";
+
+    Bar bars[AnalyticsEngine::DEFAULT_BAR_HISTORY];
+    start = Clock::now();
+    for (size_t i = 0; i < OPS / 4; ++i) {
+        sink = sink + engine->get_bars(static_cast<uint16_t>(i % SYMBOLS), BarInterval::Second,
+                                       bars, AnalyticsEngine::DEFAULT_BAR_HISTORY);
+    }
+    std::cout << "get_bars(" << AnalyticsEngine::DEFAULT_BAR_HISTORY
+              << " x 1s): " << elapsed_ns(start) / (OPS / 4) << " ns\n";
+    return 0;
+}
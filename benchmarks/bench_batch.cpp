@@ -0,0 +1,105 @@
+// Batched packet benchmark: per-message framing vs delta-encoded batches
+// Reports bytes/message and client parse CPU/message for v1 and v2 payloads
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include "../include/batch_encoder.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static double parse_ns_per_msg(const std::vector<uint8_t>& stream, size_t messages) {
+    MessageParser parser;
+    volatile double sink = 0;
+    parser.set_trade_callback([&](const MessageHeader&, const TradePayload& p) {
+        sink = sink + p.price;
+    });
+    parser.set_quote_callback([&](const MessageHeader&, const QuotePayload& q) {
+        sink = sink + q.bid_price;
+    });
+
+    constexpr size_t CHUNK = 64 * 1024;
+    auto start = Clock::now();
+    size_t parsed = 0;
+    for (size_t off = 0; off < stream.size(); off += CHUNK) {
+        size_t len = std::min(CHUNK, stream.size() - off);
+        parser.append_data(stream.data() + off, len);
+        parsed += parser.parse_messages();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (parsed != messages) {
+        std::cerr << "parsed " << parsed << " of " << messages << "\n";
+    }
+    return ns / messages;
+}
+
+int main() {
+    constexpr size_t NUM_MESSAGES = 2000000;
+    constexpr size_t BURST = 50;   // Ticks per flush (100 max per loop in simulator)
+
+    std::cout << "=== Batched Packet Benchmark ===\n";
+
+    TickGenerator gen(MAX_SYMBOLS);
+    std::vector<uint8_t> v1, v2, v1_batched, v2_batched;
+    BatchEncoder batch_v1, batch_v2;
+    uint8_t buffer[MAX_MSG_SIZE];
+    uint8_t encoded[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    size_t packets = 0;
+
+    auto flush = [&](BatchEncoder& batch, std::vector<uint8_t>& out) {
+        size_t packet = batch.finish();
+        if (packet == 0) return;
+        out.insert(out.end(), batch.data(), batch.data() + packet);
+        batch.clear();
+        packets++;
+    };
+    auto append = [&](BatchEncoder& batch, std::vector<uint8_t>& out,
+                      const uint8_t* msg, size_t len) {
+        if (!batch.append(msg, len)) {
+            flush(batch, out);
+            batch.append(msg, len);
+        }
+    };
+
+    double encode_ns = 0;
+    for (size_t i = 0; i < NUM_MESSAGES; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        size_t v2_size = encode_v2(buffer, encoded);
+        v1.insert(v1.end(), buffer, buffer + size);
+        v2.insert(v2.end(), encoded, encoded + v2_size);
+
+        auto t0 = Clock::now();
+        append(batch_v1, v1_batched, buffer, size);
+        encode_ns += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        append(batch_v2, v2_batched, encoded, v2_size);
+
+        if ((i + 1) % BURST == 0) {
+            flush(batch_v1, v1_batched);
+            flush(batch_v2, v2_batched);
+        }
+    }
+    flush(batch_v1, v1_batched);
+    flush(batch_v2, v2_batched);
+
+    struct Row { const char* name; const std::vector<uint8_t>* stream; };
+    Row rows[] = {{"v1 per-message", &v1}, {"v1 batched", &v1_batched},
+                  {"v2 per-message", &v2}, {"v2 batched", &v2_batched}};
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(18) << "format" << std::right
+              << std::setw(12) << "bytes/msg" << std::setw(14) << "parse ns/msg" << "\n";
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(18) << row.name << std::right
+                  << std::setw(12) << static_cast<double>(row.stream->size()) / NUM_MESSAGES
+                  << std::setw(14) << parse_ns_per_msg(*row.stream, NUM_MESSAGES) << "\n";
+    }
+    std::cout << "packets:          " << packets / 2 << " per format ("
+              << static_cast<double>(NUM_MESSAGES) / (packets / 2) << " msgs/packet)\n";
+    std::cout << "encoder append:   " << encode_ns / NUM_MESSAGES << " ns/msg\n";
+    return 0;
+}
@@ -0,0 +1,213 @@
+// SymbolCache layout benchmark
+// Update and read cost for the wide (128B, two lines) and compact (one
+// 64B line) entry layouts, with L1D and last-level cache misses from
+// perf_event_open where the kernel exposes hardware counters
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include "../include/cache.h"
+
+#ifndef USE_KQUEUE
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t OPS = 4000000;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Counts one hardware cache event for this thread; -1 when unavailable
+class CacheCounter {
+public:
+    explicit CacheCounter(uint64_t cache_id) {
+#ifndef USE_KQUEUE
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = cache_id | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)cache_id;
+#endif
+    }
+
+    ~CacheCounter() {
+#ifndef USE_KQUEUE
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    void start() {
+#ifndef USE_KQUEUE
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    int64_t stop() {
+#ifndef USE_KQUEUE
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        int64_t count = 0;
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) return -1;
+        return count;
+#else
+        return -1;
+#endif
+    }
+
+    bool available() const { return fd_ >= 0; }
+
+private:
+    int fd_ = -1;
+};
+
+struct Result {
+    double ns;
+    double l1_misses;   // Per op, < 0 if unavailable
+    double ll_misses;
+};
+
+#ifndef USE_KQUEUE
+static constexpr uint64_t L1D = PERF_COUNT_HW_CACHE_L1D;
+static constexpr uint64_t LL = PERF_COUNT_HW_CACHE_LL;
+#else
+static constexpr uint64_t L1D = 0;
+static constexpr uint64_t LL = 0;
+#endif
+
+template <typename Fn>
+static Result measure(size_t ops, Fn&& fn) {
+    CacheCounter l1(L1D);
+    CacheCounter ll(LL);
+    l1.start();
+    ll.start();
+    auto start = Clock::now();
+    fn();
+    double ns = elapsed_ns(start);
+    int64_t l1_count = l1.stop();
+    int64_t ll_count = ll.stop();
+    return {ns / ops,
+            l1_count < 0 ? -1.0 : static_cast<double>(l1_count) / ops,
+            ll_count < 0 ? -1.0 : static_cast<double>(ll_count) / ops};
+}
+
+static std::string misses(double per_op) {
+    if (per_op < 0) return "n/a";
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << per_op;
+    return out.str();
+}
+
+static void report(const char* layout, const char* op, const Result& r) {
+    std::cout << std::left << std::setw(8) << layout << std::setw(24) << op << std::right
+              << std::setw(8) << r.ns << std::setw(12) << misses(r.l1_misses)
+              << std::setw(12) << misses(r.ll_misses) << "\n";
+}
+
+static void run_layout(const char* name, CacheLayout layout, const std::vector<uint16_t>& order) {
+    auto cache = std::make_unique<SymbolCache>(MAX_SYMBOLS, layout);
+    for (uint16_t s = 0; s < MAX_SYMBOLS; ++s) {
+        cache->update_quote(s, 100.0 + s, 100, 100.05 + s, 200, s);
+    }
+
+    // Quotes and trades mixed like the feed (~70/30), random symbols
+    report(name, "update (random symbol)", measure(OPS, [&]() {
+        for (size_t i = 0; i < OPS; ++i) {
+            uint16_t s = order[i % order.size()];
+            double px = 100.0 + (i & 63) * 0.05;
+            if (i % 10 < 7) {
+                cache->update_quote(s, px, 100, px + 0.05, 200, i);
+            } else {
+                cache->update_trade(s, px, 10, i);
+            }
+        }
+    }));
+
+    // Same updates after other work has evicted the cache (as when large
+    // receive buffers stream through between bursts); only updates are timed
+    constexpr size_t BURST = 64;
+    constexpr size_t BURSTS = 2000;
+    std::vector<uint8_t> evict(32 * 1024 * 1024);
+    double cold_ns = 0;
+    CacheCounter l1(L1D);
+    CacheCounter ll(LL);
+    int64_t l1_total = 0, ll_total = 0;
+    for (size_t b = 0; b < BURSTS; ++b) {
+        for (size_t i = 0; i < evict.size(); i += 64) evict[i]++;
+        l1.start();
+        ll.start();
+        auto start = Clock::now();
+        for (size_t i = 0; i < BURST; ++i) {
+            uint16_t s = order[(b * BURST + i) % order.size()];
+            cache->update_quote(s, 100.0, 100, 100.05, 200, i);
+        }
+        cold_ns += elapsed_ns(start);
+        l1_total += l1.stop();
+        ll_total += ll.stop();
+    }
+    double cold_ops = static_cast<double>(BURSTS * BURST);
+    report(name, "update (cold cache)", {cold_ns / cold_ops,
+           l1.available() ? l1_total / cold_ops : -1.0,
+           ll.available() ? ll_total / cold_ops : -1.0});
+
+    volatile double sink = 0;
+    report(name, "get_snapshot (random)", measure(OPS, [&]() {
+        for (size_t i = 0; i < OPS; ++i) {
+            sink = sink + cache->get_snapshot(order[i % order.size()]).best_bid;
+        }
+    }));
+
+    constexpr size_t PUBLISHES = 20000;
+    report(name, "publish_snapshot", measure(PUBLISHES, [&]() {
+        for (size_t i = 0; i < PUBLISHES; ++i) {
+            cache->publish_snapshot();
+        }
+    }));
+}
+
+int main() {
+    std::cout << "=== SymbolCache Layout Benchmark (" << MAX_SYMBOLS << " symbols) ===\n";
+    std::cout << "sizeof(SymbolEntry)=" << sizeof(SymbolEntry)
+              << " sizeof(CompactEntry<double>)=" << sizeof(CompactEntry<double>)
+              << " sizeof(CompactEntry<int32_t>)=" << sizeof(CompactEntry<int32_t>) << "\n";
+    std::cout << "Working set: wide " << sizeof(SymbolEntry) * MAX_SYMBOLS / 1024
+              << " KB, compact " << (sizeof(CompactEntry<double>) + sizeof(double)) * MAX_SYMBOLS / 1024
+              << " KB\n";
+
+    CacheCounter probe(L1D);
+    if (!probe.available()) {
+        std::cout << "Hardware cache counters unavailable (misses shown as n/a)\n";
+    }
+
+    std::vector<uint16_t> order(1 << 16);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, MAX_SYMBOLS - 1);
+    for (auto& s : order) s = static_cast<uint16_t>(pick(rng));
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\nlayout  operation                     ns   L1D miss/op  LL miss/op\n";
+    run_layout("wide", CacheLayout::Wide, order);
+    run_layout("compact", CacheLayout::Compact, order);
+    run_layout("fixed", CacheLayout::CompactFixed, order);
+    return 0;
+}
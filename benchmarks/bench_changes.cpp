@@ -0,0 +1,184 @@
+// Change-notification benchmark
+// Reader cost of finding what changed when a fraction of symbols update per
+// interval: scanning every symbol vs polling the dirty bitmap. Also the
+// writer's cost per registered reader and eventfd wakeup latency
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <ctime>
+#include "../include/cache.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+struct ReaderCost {
+    double scan_ns;
+    double top_ns;
+    double poll_ns;
+};
+
+// Writer changes `changed` random symbols, then each reader style finds
+// and copies them; only the reader side is timed
+static ReaderCost run_interval(size_t changed) {
+    constexpr size_t INTERVALS = 5000;
+
+    auto cache = std::make_unique<SymbolCache>();
+    int reader = cache->register_change_reader();
+    std::vector<MarketState> local(MAX_SYMBOLS);
+    std::vector<uint16_t> ids(MAX_SYMBOLS);
+    std::vector<uint16_t> all(MAX_SYMBOLS);
+    for (uint16_t s = 0; s < MAX_SYMBOLS; ++s) all[s] = s;
+    uint16_t top_ids[20];
+    MarketState top_states[20];
+
+    std::mt19937 rng(42);
+    double scan = 0, top = 0, poll = 0;
+    volatile size_t sink = 0;
+    for (size_t it = 0; it < INTERVALS; ++it) {
+        std::shuffle(all.begin(), all.end(), rng);
+        for (size_t i = 0; i < changed; ++i) {
+            cache->update_quote(all[i], 100.0, 100, 100.05, 200, it);
+        }
+
+        // Poll every symbol, compare with the local copy
+        auto start = Clock::now();
+        size_t found = 0;
+        for (uint16_t s = 0; s < MAX_SYMBOLS; ++s) {
+            MarketState state = cache->get_snapshot(s);
+            if (state.update_count != local[s].update_count) {
+                local[s] = state;
+                found++;
+            }
+        }
+        scan += elapsed_ns(start);
+        sink = sink + found;
+
+        // What the visualizer did each render
+        start = Clock::now();
+        cache->get_top_symbols(top_ids, top_states, 20);
+        top += elapsed_ns(start);
+
+        // Dirty bitmap
+        start = Clock::now();
+        size_t n = cache->poll_changes(reader, ids.data(), ids.size());
+        for (size_t i = 0; i < n; ++i) {
+            local[ids[i]] = cache->get_snapshot(ids[i]);
+        }
+        poll += elapsed_ns(start);
+        sink = sink + n;
+    }
+
+    return {scan / INTERVALS, top / INTERVALS, poll / INTERVALS};
+}
+
+static double writer_ns(size_t readers) {
+    constexpr size_t UPDATES = 2000000;
+
+    auto cache = std::make_unique<SymbolCache>();
+    std::vector<int> ids;
+    for (size_t r = 0; r < readers; ++r) {
+        ids.push_back(cache->register_change_reader());
+    }
+    std::vector<uint16_t> out(MAX_SYMBOLS);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < UPDATES; ++i) {
+        cache->update_quote(static_cast<uint16_t>(i % MAX_SYMBOLS), 100.0, 100, 100.05, 200, i);
+        // Readers drain every 1000 updates so bits keep getting re-set
+        if (i % 1000 == 999) {
+            for (int r : ids) cache->poll_changes(r, out.data(), out.size());
+        }
+    }
+    return elapsed_ns(start) / UPDATES;
+}
+
+// Writer changes 25 symbols every 1ms; a blocking reader waits on the eventfd
+static void bench_wakeup() {
+    constexpr auto DURATION = std::chrono::seconds(2);
+
+    auto cache = std::make_unique<SymbolCache>();
+    int reader = cache->register_change_reader(true);
+    std::atomic<bool> done{false};
+    std::atomic<int64_t> written_at{0};
+
+    std::vector<double> latencies;
+    double reader_cpu = 0;
+    std::thread consumer([&]() {
+        std::vector<uint16_t> ids(MAX_SYMBOLS);
+        double t0 = thread_cpu_ns();
+        while (!done.load()) {
+            if (!cache->wait_for_changes(reader, 100)) continue;
+            int64_t now = Clock::now().time_since_epoch().count();
+            latencies.push_back(static_cast<double>(now - written_at.load()));
+            size_t n = cache->poll_changes(reader, ids.data(), ids.size());
+            for (size_t i = 0; i < n; ++i) {
+                cache->get_snapshot(ids[i]);
+            }
+        }
+        reader_cpu = thread_cpu_ns() - t0;
+    });
+
+    auto start = Clock::now();
+    auto next = start;
+    uint64_t seq = 0;
+    while (Clock::now() - start < DURATION) {
+        written_at.store(Clock::now().time_since_epoch().count());
+        for (uint16_t i = 0; i < 25; ++i) {
+            cache->update_trade(static_cast<uint16_t>((seq * 25 + i) % MAX_SYMBOLS), 100.0, 10, seq);
+        }
+        seq++;
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+    }
+    done.store(true);
+    consumer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) {
+        return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    double elapsed = elapsed_ns(start);
+    std::cout << "\nBlocking reader (eventfd), 25 changes every 1ms:\n";
+    std::cout << "  wakeups: " << latencies.size() << "\n";
+    std::cout << "  wake latency p50: " << pct(0.5) / 1000 << " us  p99: "
+              << pct(0.99) / 1000 << " us\n";
+    std::cout << "  reader CPU: " << 100.0 * reader_cpu / elapsed << "%\n";
+}
+
+int main() {
+    std::cout << "=== Change Notification Benchmark (" << MAX_SYMBOLS << " symbols) ===\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "\nReader ns per interval to find and copy changed symbols:\n";
+    std::cout << "changed    full scan   get_top_symbols   poll_changes\n";
+    for (size_t pct : {1, 5, 25, 100}) {
+        size_t changed = MAX_SYMBOLS * pct / 100;
+        ReaderCost c = run_interval(changed);
+        std::cout << std::setw(6) << pct << "%" << std::setw(12) << c.scan_ns
+                  << std::setw(18) << c.top_ns << std::setw(15) << c.poll_ns << "\n";
+    }
+
+    std::cout << "\nWriter ns per update by registered readers:\n";
+    for (size_t readers : {0, 1, 4, 8}) {
+        std::cout << std::setw(7) << readers << " readers: " << writer_ns(readers) << " ns\n";
+    }
+
+    bench_wakeup();
+    return 0;
+}
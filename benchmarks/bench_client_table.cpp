@@ -0,0 +1,197 @@
+// Client table benchmark: the per-client cost of a broadcast scan
+// ClientManager keeps clients in dense slots with the fields a broadcast
+// reads in parallel arrays. The reference here is the layout it replaced:
+// an unordered_map from fd to the whole connection, with a hash set of
+// subscribed symbols. Two scans that make no syscalls, so only the table
+// is measured: every client subscribed to symbols the tick isn't for, and
+// every client slow (the tick is dropped for each). Then the lookup by fd
+// the write path made per send. Reported as CPU ns per client per
+// broadcast (or per lookup).
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/client_manager.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+
+static constexpr size_t SCAN_WORK = 20000000;   // Client visits per measurement
+static constexpr size_t SYMBOLS_PER_CLIENT = 20;
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// The connection as the map held it, cold fields included
+struct MapClient {
+    int fd;
+    std::string address;
+    uint16_t port;
+    std::unordered_set<uint16_t> subscribed_symbols;
+    bool subscribe_all = true;
+    uint8_t protocol_version = PROTOCOL_V1;
+    uint8_t line = 0;
+    size_t pending_bytes = 0;
+    size_t slow_consumer_count = 0;
+    bool is_slow = false;
+    std::unique_ptr<SendQueue> queue;
+    std::unique_ptr<BatchEncoder> batch;
+    std::unique_ptr<ConflationState> conflation;
+    std::unique_ptr<Impairer> impairer;
+    bool reset = false;
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    std::chrono::steady_clock::time_point connect_time;
+    std::chrono::steady_clock::time_point last_activity;
+};
+
+// The old broadcast loop up to the send, which none of these reach
+static size_t map_broadcast(std::unordered_map<int, MapClient>& clients, uint16_t symbol_id,
+                            uint64_t& dropped) {
+    size_t count = 0;
+    for (auto& [fd, client] : clients) {
+        if (!client.subscribe_all &&
+            client.subscribed_symbols.find(symbol_id) == client.subscribed_symbols.end()) {
+            continue;
+        }
+        if (client.is_slow) {
+            dropped++;
+            continue;
+        }
+        count += client.reset ? 0 : 1;
+    }
+    return count;
+}
+
+// Symbols the client subscribes to, all at or above MAX_SYMBOLS / 2
+static std::vector<uint16_t> subscription(size_t client) {
+    std::vector<uint16_t> symbols(SYMBOLS_PER_CLIENT);
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        symbols[i] = static_cast<uint16_t>(MAX_SYMBOLS / 2 + (client * 7 + i * 11) % (MAX_SYMBOLS / 2));
+    }
+    return symbols;
+}
+
+struct Row {
+    double map_filtered, slots_filtered;
+    double map_slow, slots_slow;
+    double map_lookup, slots_lookup;
+};
+
+static Row run(size_t clients) {
+    // Every client is a dup of one socket, so there are enough fds
+    int pair[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, pair);
+    ClientManager mgr;
+    std::unordered_map<int, MapClient> map;
+    std::vector<int> fds;
+    for (size_t c = 0; c < clients; ++c) {
+        int fd = dup(pair[0]);
+        fds.push_back(fd);
+        mgr.add_client(fd, "bench", 0);
+        std::vector<uint16_t> symbols = subscription(c);
+        mgr.handle_subscription(fd, symbols.data(), symbols.size());
+
+        MapClient& client = map[fd];
+        client.fd = fd;
+        client.address = "bench";
+        client.subscribe_all = false;
+        client.subscribed_symbols.insert(symbols.begin(), symbols.end());
+        client.queue = std::make_unique<SendQueue>(ClientManager::SEND_QUEUE_DEPTH);
+    }
+
+    TickGenerator gen(MAX_SYMBOLS);
+    uint8_t tick[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    gen.generate_tick(tick, size, symbol_id);
+
+    size_t broadcasts = SCAN_WORK / clients;
+    double per_visit = static_cast<double>(broadcasts * clients);
+    uint64_t dropped = 0;
+    volatile size_t sink = 0;
+    Row row{};
+
+    // Ticks for symbols below MAX_SYMBOLS / 2: nobody is subscribed
+    double t0 = thread_cpu_ns();
+    for (size_t i = 0; i < broadcasts; ++i) {
+        sink = sink + map_broadcast(map, static_cast<uint16_t>(i % (MAX_SYMBOLS / 2)), dropped);
+    }
+    row.map_filtered = (thread_cpu_ns() - t0) / per_visit;
+    t0 = thread_cpu_ns();
+    for (size_t i = 0; i < broadcasts; ++i) {
+        sink = sink + mgr.broadcast(tick, size, static_cast<uint16_t>(i % (MAX_SYMBOLS / 2)));
+    }
+    row.slots_filtered = (thread_cpu_ns() - t0) / per_visit;
+
+    // Everyone on everything, everyone slow
+    for (auto& [fd, client] : map) {
+        client.subscribe_all = true;
+        client.is_slow = true;
+    }
+    for (int fd : fds) {
+        mgr.handle_subscription(fd, nullptr, 0);
+        mgr.mark_slow_consumer(fd);
+    }
+    t0 = thread_cpu_ns();
+    for (size_t i = 0; i < broadcasts; ++i) {
+        sink = sink + map_broadcast(map, static_cast<uint16_t>(i % MAX_SYMBOLS), dropped);
+    }
+    row.map_slow = (thread_cpu_ns() - t0) / per_visit;
+    t0 = thread_cpu_ns();
+    for (size_t i = 0; i < broadcasts; ++i) {
+        sink = sink + mgr.broadcast(tick, size, static_cast<uint16_t>(i % MAX_SYMBOLS));
+    }
+    row.slots_slow = (thread_cpu_ns() - t0) / per_visit;
+
+    // Lookup by fd, in connection order
+    t0 = thread_cpu_ns();
+    for (size_t i = 0; i < broadcasts; ++i) {
+        for (int fd : fds) {
+            auto it = map.find(fd);
+            sink = sink + (it != map.end() && it->second.is_slow);
+        }
+    }
+    row.map_lookup = (thread_cpu_ns() - t0) / per_visit;
+    t0 = thread_cpu_ns();
+    for (size_t i = 0; i < broadcasts; ++i) {
+        for (int fd : fds) {
+            sink = sink + mgr.is_slow(fd);
+        }
+    }
+    row.slots_lookup = (thread_cpu_ns() - t0) / per_visit;
+
+    for (int fd : fds) {
+        mgr.remove_client(fd);
+    }
+    close(pair[0]);
+    close(pair[1]);
+    return row;
+}
+
+int main() {
+    std::cout << "=== Client Table Benchmark (CPU ns per client) ===\n";
+    std::cout << SYMBOLS_PER_CLIENT << " symbols per client, " << SCAN_WORK
+              << " client visits per cell\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "           unsubscribed tick     all clients slow      lookup by fd\n";
+    std::cout << "clients       map    slots         map    slots         map    slots\n";
+    for (size_t clients : {1, 16, 64, 256, 1024, 4096}) {
+        Row r = run(clients);
+        std::cout << std::setw(7) << clients
+                  << std::setw(10) << r.map_filtered << std::setw(9) << r.slots_filtered
+                  << std::setw(12) << r.map_slow << std::setw(9) << r.slots_slow
+                  << std::setw(12) << r.map_lookup << std::setw(9) << r.slots_lookup << "\n";
+    }
+    return 0;
+}
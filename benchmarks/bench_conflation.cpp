@@ -0,0 +1,184 @@
+// Slow consumer benchmark: drop vs per-symbol conflation
+// One fast and one slow reader on loopback TCP; reports server memory per
+// client, how stale the prices each client sees are, and how many symbols
+// each client has the latest value for once the feed goes quiet
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "../include/client_manager.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static uint64_t now_ns() {
+    // Same clock as TickGenerator timestamps
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+struct ReaderResult {
+    std::vector<uint64_t> staleness_ns;
+    uint64_t messages = 0;
+    uint64_t gaps = 0;
+    std::vector<uint32_t> last_seq = std::vector<uint32_t>(MAX_SYMBOLS, 0);
+};
+
+// Read until EOF, recording (receive time - exchange timestamp)
+// A slow reader sleeps between small reads to force backpressure
+static void run_reader(int fd, bool slow, ReaderResult& result) {
+    MessageParser parser;
+    auto record = [&](const MessageHeader& h) {
+        result.staleness_ns.push_back(now_ns() - h.timestamp_ns);
+        result.last_seq[h.symbol_id] = std::max(result.last_seq[h.symbol_id], h.sequence_number);
+    };
+    parser.set_trade_callback([&](const MessageHeader& h, const TradePayload&) { record(h); });
+    parser.set_quote_callback([&](const MessageHeader& h, const QuotePayload&) { record(h); });
+
+    uint8_t buffer[64 * 1024];
+    size_t chunk = slow ? 4096 : sizeof(buffer);
+    while (true) {
+        ssize_t n = recv(fd, buffer, chunk, 0);
+        if (n <= 0) break;
+        parser.append_data(buffer, n);
+        result.messages += parser.parse_messages();
+        if (slow) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    result.gaps = parser.sequence_gaps();
+    close(fd);
+}
+
+static int connect_pair(int listen_fd, uint16_t port, int& server_side) {
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    server_side = accept(listen_fd, nullptr, nullptr);
+
+    int rcvbuf = 64 * 1024;
+    setsockopt(client, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    return client;
+}
+
+static void print_row(const char* name, ReaderResult& r,
+                      const std::vector<uint32_t>& server_seq, size_t num_symbols) {
+    auto& s = r.staleness_ns;
+    std::sort(s.begin(), s.end());
+    auto pct = [&](double p) {
+        return s.empty() ? 0.0 : s[static_cast<size_t>(p * (s.size() - 1))] / 1e6;
+    };
+    size_t current = 0;
+    for (size_t i = 0; i < num_symbols; ++i) {
+        current += r.last_seq[i] == server_seq[i];
+    }
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::setw(10) << r.messages << std::setw(8) << r.gaps
+              << std::setw(10) << pct(0.50) << std::setw(10) << pct(0.99)
+              << std::setw(10) << pct(1.0) << std::setw(10) << current << "/"
+              << num_symbols << "\n";
+}
+
+static void run_scenario(bool conflation) {
+    constexpr double DURATION_SECS = 3.0;
+    constexpr size_t TICKS_PER_BURST = 100;
+    constexpr auto BURST_INTERVAL = std::chrono::microseconds(500);  // ~200K msg/s
+    constexpr size_t NUM_SYMBOLS = 100;
+
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    listen(listen_fd, 4);
+    socklen_t addr_len = sizeof(addr);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len);
+    uint16_t port = ntohs(addr.sin_port);
+
+    ClientManager mgr(NUM_SYMBOLS);
+    mgr.set_conflation(conflation);
+    mgr.set_slow_threshold(256 * 1024);
+
+    int fast_srv, slow_srv;
+    int fast_cli = connect_pair(listen_fd, port, fast_srv);
+    int slow_cli = connect_pair(listen_fd, port, slow_srv);
+    mgr.add_client(fast_srv, "fast", 0);
+    mgr.add_client(slow_srv, "slow", 0);
+
+    ReaderResult fast, slow;
+    std::thread fast_thread(run_reader, fast_cli, false, std::ref(fast));
+    std::thread slow_thread(run_reader, slow_cli, true, std::ref(slow));
+
+    TickGenerator gen(NUM_SYMBOLS);
+    std::vector<uint32_t> server_seq(MAX_SYMBOLS, 0);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+
+    auto start = Clock::now();
+    auto next = start;
+    while (std::chrono::duration<double>(Clock::now() - start).count() < DURATION_SECS) {
+        for (size_t i = 0; i < TICKS_PER_BURST; ++i) {
+            gen.generate_tick(buffer, size, symbol_id);
+            mgr.broadcast(buffer, size, symbol_id);
+            MessageHeader header;
+            std::memcpy(&header, buffer, sizeof(header));
+            server_seq[symbol_id] = header.sequence_number;
+        }
+        mgr.drain_slow_clients();
+        next += BURST_INTERVAL;
+        std::this_thread::sleep_until(next);
+    }
+
+    // Feed goes quiet - give the slow client time to catch up
+    auto quiet_end = Clock::now() + std::chrono::seconds(1);
+    while (Clock::now() < quiet_end) {
+        mgr.drain_slow_clients();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    size_t state_bytes = 0;
+    if (const auto* c = mgr.get_client(slow_srv); c && c->conflation) {
+        state_bytes = c->conflation->bytes();
+    }
+
+    // Closing the server side lets readers finish what's buffered
+    mgr.remove_client(fast_srv);
+    mgr.remove_client(slow_srv);
+    close(listen_fd);
+    fast_thread.join();
+    slow_thread.join();
+
+    std::cout << "\n--- " << (conflation ? "Conflation" : "Drop (default)") << " ---\n";
+    std::cout << "client      received    gaps   p50(ms)   p99(ms)   max(ms)   current\n";
+    std::cout << std::fixed << std::setprecision(2);
+    print_row("fast", fast, server_seq, NUM_SYMBOLS);
+    print_row("slow", slow, server_seq, NUM_SYMBOLS);
+    std::cout << "server conflated: " << mgr.conflated_messages()
+              << ", dropped: " << mgr.dropped_messages() << "\n";
+    std::cout << "slow client state: " << sizeof(ClientConnection) + state_bytes
+              << " bytes\n";
+}
+
+int main() {
+    std::cout << "=== Slow Consumer Conflation Benchmark ===\n";
+    std::cout << "sizeof(ClientConnection): " << sizeof(ClientConnection) << " bytes\n";
+    std::cout << "ConflationState (100 symbols): " << ConflationState(100).bytes()
+              << " bytes (allocated on first slow event)\n";
+
+    run_scenario(false);
+    run_scenario(true);
+    return 0;
+}
@@ -0,0 +1,223 @@
+// Connection storm: 1000 clients connect to the simulator at once, on the
+// single tick loop and on 1, 2 and 4 SO_REUSEPORT workers. Reports the
+// time from connect() to each client's first tick (accept, then the next
+// tick for one of its symbols: each subscribes to a few as soon as it is
+// connected, so some 10ms of this is waiting for a tick), how long until
+// the server had accepted them all, and then the steady fan-out: messages
+// delivered per second and server CPU ns per message (process CPU less
+// this reader thread's). The simulator's per-connection logging
+// is muted.
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/exchange_simulator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t CLIENTS = 1000;
+static constexpr size_t SYMBOLS = 100;
+static constexpr uint16_t SYMBOLS_PER_CLIENT = 5;
+static constexpr uint32_t TICK_RATE = 1000;
+static constexpr auto STORM_TIMEOUT = std::chrono::seconds(15);
+static constexpr auto WARMUP = std::chrono::seconds(1);
+static constexpr auto MEASURE = std::chrono::seconds(2);
+
+static double cpu_ns(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct Result {
+    double p50_ms, p99_ms, max_ms;   // connect() to first tick
+    double all_accepted_ms;
+    size_t connected;
+    double msgs_per_sec;
+    double cpu_ns_per_msg;
+    uint64_t overruns;
+};
+
+// Reads whatever is waiting; a client the server closed stops polling
+static size_t drain(int epoll_fd, int fd) {
+    static uint8_t block[64 * 1024];
+    size_t total = 0;
+    ssize_t n;
+    while ((n = recv(fd, block, sizeof(block), 0)) > 0) {
+        total += static_cast<size_t>(n);
+    }
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    return total;
+}
+
+// Sent as soon as the connection is up, so no client takes the whole feed
+// (a thousand of those would swamp the server before the storm is over)
+static void subscribe(int fd, size_t client) {
+    uint8_t request[3 + 2 * SYMBOLS_PER_CLIENT] = {SUBSCRIBE_CMD, SYMBOLS_PER_CLIENT, 0};
+    for (uint16_t s = 0; s < SYMBOLS_PER_CLIENT; ++s) {
+        uint16_t symbol = static_cast<uint16_t>((client * 7 + s * 13) % SYMBOLS);
+        std::memcpy(request + 3 + 2 * s, &symbol, sizeof(symbol));
+    }
+    send(fd, request, sizeof(request), MSG_NOSIGNAL);
+}
+
+static Result run(size_t workers) {
+    ExchangeSimulator sim(0, SYMBOLS);
+    sim.set_workers(workers);
+    sim.set_tick_rate(TICK_RATE);
+    sim.start();
+    std::thread runner([&sim]() { sim.run(); });
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(sim.port());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    int epoll_fd = epoll_create1(0);
+    std::vector<int> fds(CLIENTS);
+    std::vector<Clock::time_point> started(CLIENTS);
+    std::vector<double> first_tick_ms(CLIENTS, -1);
+
+    // Every connect() goes out before the first reply is read
+    auto storm = Clock::now();
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        fds[i] = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        started[i] = Clock::now();
+        connect(fds[i], reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT;   // Writable once connected
+        ev.data.u64 = i;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fds[i], &ev);
+    }
+
+    size_t connected = 0;
+    double all_accepted_ms = -1;
+    epoll_event events[256];
+    while ((connected < CLIENTS || all_accepted_ms < 0) && Clock::now() - storm < STORM_TIMEOUT) {
+        int n = epoll_wait(epoll_fd, events, 256, 10);
+        auto now = Clock::now();
+        for (int e = 0; e < n; ++e) {
+            size_t i = events[e].data.u64;
+            if (events[e].events & EPOLLOUT) {
+                subscribe(fds[i], i);
+                epoll_event ev{};
+                ev.events = EPOLLIN;
+                ev.data.u64 = i;
+                epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fds[i], &ev);
+            }
+            if (drain(epoll_fd, fds[i]) > 0 && first_tick_ms[i] < 0) {
+                first_tick_ms[i] =
+                    std::chrono::duration<double, std::milli>(now - started[i]).count();
+                connected++;
+            }
+        }
+        if (all_accepted_ms < 0 && sim.client_count() == CLIENTS) {
+            all_accepted_ms = std::chrono::duration<double, std::milli>(now - storm).count();
+        }
+    }
+
+    auto pump = [&](Clock::duration duration) {
+        auto end = Clock::now() + duration;
+        while (Clock::now() < end) {
+            int n = epoll_wait(epoll_fd, events, 256, 10);
+            for (int e = 0; e < n; ++e) {
+                drain(epoll_fd, fds[events[e].data.u64]);
+            }
+        }
+    };
+    pump(WARMUP);
+
+    uint64_t sent_before = sim.messages_sent();
+    double process_before = cpu_ns(CLOCK_PROCESS_CPUTIME_ID);
+    double reader_before = cpu_ns(CLOCK_THREAD_CPUTIME_ID);
+    auto start = Clock::now();
+    pump(MEASURE);
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    double server_cpu = (cpu_ns(CLOCK_PROCESS_CPUTIME_ID) - process_before) -
+                        (cpu_ns(CLOCK_THREAD_CPUTIME_ID) - reader_before);
+    double messages = static_cast<double>(sim.messages_sent() - sent_before);
+
+    sim.stop();
+    runner.join();
+    for (int fd : fds) close(fd);
+    close(epoll_fd);
+
+    std::vector<double> latencies;
+    for (double ms : first_tick_ms) {
+        if (ms >= 0) latencies.push_back(ms);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) {
+        return latencies.empty() ? -1.0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+
+    Result result;
+    result.p50_ms = pct(0.50);
+    result.p99_ms = pct(0.99);
+    result.max_ms = latencies.empty() ? -1.0 : latencies.back();
+    result.all_accepted_ms = all_accepted_ms;
+    result.connected = connected;
+    result.msgs_per_sec = messages / secs;
+    result.cpu_ns_per_msg = messages > 0 ? server_cpu / messages : 0;
+    result.overruns = sim.ring_overruns();
+    return result;
+}
+
+int main() {
+    // Two fds per client, plus the simulator's
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = std::max<rlim_t>(limit.rlim_cur, std::min<rlim_t>(limit.rlim_max, 4 * CLIENTS));
+    setrlimit(RLIMIT_NOFILE, &limit);
+
+    std::cout << "=== Connection Storm Benchmark ===\n";
+    std::cout << CLIENTS << " clients connecting at once; then " << SYMBOLS_PER_CLIENT << " of "
+              << SYMBOLS << " symbols each at " << TICK_RATE << " ticks/s for "
+              << std::chrono::duration<double>(MEASURE).count() << "s\n\n";
+    std::cout << "                first tick after connect (ms)   all accepted"
+                 "    steady fan-out\n";
+    std::cout << "mode          connected    p50     p99     max           (ms)"
+                 "     msgs/s  cpu ns/msg  overruns\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::streambuf* out = std::cout.rdbuf();
+    NullBuffer null_buffer;
+    for (size_t workers : {0, 1, 2, 4}) {
+        std::cout.rdbuf(&null_buffer);
+        Result r = run(workers);
+        std::cout.rdbuf(out);
+        std::cout.clear();
+
+        std::string mode = workers == 0 ? "tick loop" : std::to_string(workers) + " workers";
+        std::cout << std::left << std::setw(12) << mode << std::right
+                  << std::setw(11) << r.connected
+                  << std::setw(7) << r.p50_ms << std::setw(8) << r.p99_ms
+                  << std::setw(8) << r.max_ms << std::setw(15) << r.all_accepted_ms
+                  << std::setw(11) << std::setprecision(0) << r.msgs_per_sec
+                  << std::setw(12) << r.cpu_ns_per_msg << std::setw(10) << r.overruns
+                  << std::setprecision(1) << "\n";
+    }
+    return 0;
+}
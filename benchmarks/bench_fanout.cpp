@@ -0,0 +1,160 @@
+// Fan-out benchmark: server CPU per client for TCP vs UDP distribution
+// Measures the sending thread's CPU time (CLOCK_THREAD_CPUTIME_ID) while
+// it delivers the same tick stream to N loopback receivers
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <ctime>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "../include/client_manager.h"
+#include "../include/socket.h"
+#include "../include/tick_generator.h"
+#include "../include/udp_publisher.h"
+
+using namespace mdf;
+
+static constexpr size_t NUM_MESSAGES = 50000;
+static constexpr size_t BURST = 50;   // Messages per flush, like one tick burst
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Pre-generate the stream so generation cost isn't measured
+static std::vector<std::vector<uint8_t>> make_ticks() {
+    TickGenerator gen(100);
+    std::vector<std::vector<uint8_t>> ticks(NUM_MESSAGES);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (auto& t : ticks) {
+        gen.generate_tick(buffer, size, symbol_id);
+        t.assign(buffer, buffer + size);
+    }
+    return ticks;
+}
+
+// Sender yields between bursts so receivers keep up (even on one core)
+template <typename SendBurst>
+static double run_sender(const std::vector<std::vector<uint8_t>>& ticks, SendBurst send_burst) {
+    double cpu = 0;
+    for (size_t i = 0; i < ticks.size(); i += BURST) {
+        double t0 = thread_cpu_ns();
+        send_burst(i, std::min(i + BURST, ticks.size()));
+        cpu += thread_cpu_ns() - t0;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return cpu;
+}
+
+static double bench_tcp(const std::vector<std::vector<uint8_t>>& ticks, size_t clients,
+                        bool batching) {
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    listen(listen_fd, 128);
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+
+    ClientManager mgr;
+    mgr.set_batching(batching);
+    std::vector<std::thread> readers;
+    for (size_t c = 0; c < clients; ++c) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        mgr.add_client(accept(listen_fd, nullptr, nullptr), "bench", 0);
+        readers.emplace_back([fd]() {
+            uint8_t buffer[64 * 1024];
+            while (recv(fd, buffer, sizeof(buffer), 0) > 0) {}
+            close(fd);
+        });
+    }
+
+    double cpu = run_sender(ticks, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            mgr.broadcast(ticks[i].data(), ticks[i].size(), 0);
+        }
+        mgr.flush_batches();
+    });
+
+    for (int fd : mgr.get_all_client_fds()) {
+        mgr.remove_client(fd);
+    }
+    for (auto& t : readers) t.join();
+    close(listen_fd);
+    return cpu;
+}
+
+static double bench_udp(const std::vector<std::vector<uint8_t>>& ticks, size_t clients,
+                        bool multicast) {
+    const std::string group = "239.255.77.2";
+    std::vector<std::unique_ptr<MarketDataSocket>> socks;
+    UdpPublisher pub;
+    for (size_t c = 0; c < clients; ++c) {
+        auto sock = std::make_unique<MarketDataSocket>();
+        uint16_t port = multicast && c > 0 ? socks[0]->udp_port() : 0;
+        if (!sock->open_udp(multicast ? group : "127.0.0.1", port)) {
+            std::cerr << sock->last_error() << "\n";
+            return -1;
+        }
+        if (!multicast || c == 0) {
+            pub.add_destination(multicast ? group : "127.0.0.1", sock->udp_port());
+        }
+        socks.push_back(std::move(sock));
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (auto& sock : socks) {
+        readers.emplace_back([&done, s = sock.get()]() {
+            while (!done.load()) {
+                if (s->receive_datagrams() <= 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+        });
+    }
+
+    double cpu = run_sender(ticks, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            pub.publish(ticks[i].data(), ticks[i].size());
+        }
+        pub.flush();
+    });
+
+    done.store(true);
+    for (auto& t : readers) t.join();
+    return cpu;
+}
+
+int main() {
+    std::cout << "=== Fan-out Benchmark (server CPU ns per message per client) ===\n";
+    std::cout << NUM_MESSAGES << " messages, flushed every " << BURST << "\n\n";
+
+    auto ticks = make_ticks();
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "clients        TCP    TCP batched    UDP unicast  UDP multicast\n";
+    for (size_t clients : {1, 4, 16, 64}) {
+        double msgs = static_cast<double>(NUM_MESSAGES) * clients;
+        double tcp = bench_tcp(ticks, clients, false) / msgs;
+        double tcp_batched = bench_tcp(ticks, clients, true) / msgs;
+        double unicast = bench_udp(ticks, clients, false) / msgs;
+        double multicast = bench_udp(ticks, clients, true) / msgs;
+        std::cout << std::setw(7) << clients << std::setw(11) << tcp
+                  << std::setw(15) << tcp_batched << std::setw(15) << unicast
+                  << std::setw(15) << multicast << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Line noise benchmark: one exchange simulator impairing its TCP stream
+// (bit flips, truncation, duplicates, reordering, stalls, partial writes,
+// resets) and a FeedHandler reading it. Reports what the handler applied,
+// the gaps and checksum failures it saw, reconnects, and end-to-end
+// latency of applied messages (mean and max: the latency histogram stops
+// at 1ms, so p99 says little once stalls are in play).
+//
+// Usage: bench_impairment [ticks_per_sec] [base_port]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "../include/exchange_simulator.h"
+#include "../include/feed_handler.h"
+
+using namespace mdf;
+
+static constexpr auto RUN_TIME = std::chrono::seconds(2);
+
+struct Profile {
+    const char* name;
+    const char* spec;
+};
+
+struct Result {
+    ImpairmentStats noise;
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    ConnectionStats conn;
+    LatencyStats latency;
+};
+
+static Result run(const Profile& profile, uint32_t rate, uint16_t port) {
+    // Simulator and handler chatter stays out of the table
+    std::ostringstream quiet;
+    auto* saved_out = std::cout.rdbuf(quiet.rdbuf());
+    auto* saved_err = std::cerr.rdbuf(quiet.rdbuf());
+
+    ImpairmentConfig config;
+    parse_impairments(profile.spec, config);
+
+    ExchangeSimulator sim(port, MAX_SYMBOLS);
+    sim.set_tick_rate(rate);
+    sim.set_impairments(config);
+    sim.start();
+    std::thread sim_thread([&]() { sim.run(); });
+
+    FeedHandlerConfig fh;
+    fh.enable_visualization = false;
+    fh.port = port;
+
+    auto handler = std::make_unique<FeedHandler>();
+    handler->configure(fh);
+    if (!handler->start()) {
+        std::cout.rdbuf(saved_out);
+        std::cerr.rdbuf(saved_err);
+        std::cerr << "FeedHandler failed to start\n";
+        std::exit(1);
+    }
+    std::thread runner([&]() { handler->run(); });
+
+    std::this_thread::sleep_for(RUN_TIME);
+    handler->stop();
+    runner.join();
+
+    Result result;
+    result.received = handler->messages_received();
+    result.conn = handler->get_connection_stats()[0];
+    result.latency = handler->get_latency_stats();
+
+    sim.stop();
+    sim_thread.join();
+    result.noise = sim.impairment_stats();
+    result.sent = sim.messages_sent();
+    std::cout.rdbuf(saved_out);
+    std::cerr.rdbuf(saved_err);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t rate = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    uint16_t port = argc > 2 ? static_cast<uint16_t>(std::atoi(argv[2])) : 19930;
+
+    const Profile profiles[] = {
+        {"clean",          ""},
+        {"flips 0.1%",     "flip=0.001"},
+        {"truncate 0.1%",  "truncate=0.001"},
+        {"dup+reorder 1%", "dup=0.01,reorder=0.01,delay_us=1000"},
+        {"stalls 0.1% 2ms", "delay=0.001,delay_us=2000"},
+        {"partial 50%",    "partial=0.5"},
+        {"resets",         "reset=0.00001"},
+        {"mixed",          "flip=0.0005,truncate=0.0005,dup=0.002,reorder=0.002,"
+                           "delay=0.0005,delay_us=2000,partial=0.2,reset=0.000005"},
+    };
+
+    std::cout << "=== Line Noise Benchmark ===\n";
+    std::cout << "Simulator at " << rate << " ticks/s for "
+              << std::chrono::duration<double>(RUN_TIME).count()
+              << "s per profile, one TCP client\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "profile             sent  received  impaired  checksum   gaps"
+                 "  reconnects  mean us   max us\n";
+
+    for (const auto& profile : profiles) {
+        Result r = run(profile, rate, port++);
+        const ImpairmentStats& n = r.noise;
+        uint64_t impaired = n.bit_flips + n.truncated + n.duplicated + n.reordered +
+                            n.delays + n.partial_writes + n.resets;
+        std::cout << std::left << std::setw(16) << profile.name << std::right
+                  << std::setw(8) << r.sent
+                  << std::setw(10) << r.received
+                  << std::setw(10) << impaired
+                  << std::setw(10) << r.conn.checksum_errors
+                  << std::setw(7) << r.conn.sequence_gaps
+                  << std::setw(12) << r.conn.reconnects
+                  << std::setw(9) << r.latency.mean / 1000.0
+                  << std::setw(9) << r.latency.max / 1000.0 << "\n";
+    }
+    return 0;
+}
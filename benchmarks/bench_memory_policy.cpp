@@ -0,0 +1,213 @@
+// Memory policy benchmark: the feed handler's large buffers (a 16MB
+// pipeline MemoryPool, the parser buffer, a LatencyTracker ring) under
+// each MemoryPolicy. Reports construction time, first-message latency
+// (a cold 64KB receive through pool and parser until the first callback),
+// page faults in each phase, and steady-state parse cost with dTLB load
+// misses while cycling through every pool block. dTLB misses need
+// hardware perf counters and print n/a where the host has none.
+//
+// Usage: bench_memory_policy [policy ...]   (default: a fixed set)
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../include/latency_tracker.h"
+#include "../include/memory_pool.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t CHUNK = 64 * 1024;
+static constexpr size_t POOL_CHUNKS = 256;
+static constexpr size_t IN_FLIGHT = 192;     // Spreads receives over the pool
+static constexpr size_t STREAM_MESSAGES = 1000000;
+static constexpr size_t STEADY_PASSES = 4;
+
+// One user-space perf counter, or nothing if the host has none
+class PerfCounter {
+public:
+    PerfCounter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~PerfCounter() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    bool valid() const { return fd_ >= 0; }
+    void start() {
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    uint64_t stop() {
+        uint64_t value = 0;
+        if (fd_ < 0) return 0;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd_, &value, sizeof(value)) != sizeof(value)) return 0;
+        return value;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+static long minor_faults() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+struct Result {
+    double construct_us;
+    long construct_faults;
+    double first_message_us;
+    long first_faults;
+    double steady_ns_per_msg;
+    long steady_faults;
+    bool has_tlb;
+    double tlb_misses_per_kmsg;
+    const char* pool_backing;
+};
+
+static Result run(const MemoryPolicy& policy, const std::vector<uint8_t>& stream) {
+    set_memory_policy(policy);
+    Result r{};
+
+    long faults = minor_faults();
+    auto start = Clock::now();
+    auto pool = std::make_unique<MemoryPool>(CHUNK, POOL_CHUNKS);
+    auto parser = std::make_unique<MessageParser>();
+    auto tracker = std::make_unique<LatencyTracker>();
+    r.construct_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    r.construct_faults = minor_faults() - faults;
+    r.pool_backing = backing_name(pool->storage().backing());
+
+    Clock::time_point first;
+    bool seen = false;
+    auto on_message = [&](const MessageHeader&) {
+        if (!seen) {
+            first = Clock::now();
+            seen = true;
+        }
+    };
+    parser->set_trade_callback([&](const MessageHeader& h, const TradePayload&) { on_message(h); });
+    parser->set_quote_callback([&](const MessageHeader& h, const QuotePayload&) { on_message(h); });
+
+    // Cold path: the first receive lands in a never-touched block
+    faults = minor_faults();
+    start = Clock::now();
+    void* block = pool->allocate();
+    std::memcpy(block, stream.data(), CHUNK);
+    parser->append_data(block, CHUNK);
+    pool->deallocate(block);
+    parser->parse_messages();
+    tracker->record(static_cast<uint64_t>((first - start).count()));
+    r.first_message_us = std::chrono::duration<double, std::micro>(first - start).count();
+    r.first_faults = minor_faults() - faults;
+
+    // Steady state: chunks cycle through the pool FIFO, as the pipeline's
+    // receive and parse stages drive it, so every block is touched
+    PerfCounter tlb(PERF_TYPE_HW_CACHE,
+                    PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    std::deque<void*> in_flight;
+    size_t messages = 0;
+    faults = minor_faults();
+    tlb.start();
+    start = Clock::now();
+    for (size_t pass = 0; pass < STEADY_PASSES; ++pass) {
+        parser->reset();
+        for (size_t offset = 0; offset + CHUNK <= stream.size(); offset += CHUNK) {
+            void* b = pool->allocate();
+            std::memcpy(b, stream.data() + offset, CHUNK);
+            in_flight.push_back(b);
+            if (in_flight.size() == IN_FLIGHT) {
+                void* oldest = in_flight.front();
+                in_flight.pop_front();
+                parser->append_data(oldest, CHUNK);
+                pool->deallocate(oldest);
+                messages += parser->parse_messages();
+            }
+        }
+        while (!in_flight.empty()) {
+            parser->append_data(in_flight.front(), CHUNK);
+            pool->deallocate(in_flight.front());
+            in_flight.pop_front();
+            messages += parser->parse_messages();
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    uint64_t misses = tlb.stop();
+    r.steady_faults = minor_faults() - faults;
+    r.steady_ns_per_msg = ns / messages;
+    r.has_tlb = tlb.valid();
+    r.tlb_misses_per_kmsg = 1000.0 * misses / messages;
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> specs;
+    for (int i = 1; i < argc; ++i) specs.push_back(argv[i]);
+    if (specs.empty()) {
+        specs = {"4k", "4k,prefault", "huge", "huge,prefault", "huge,prefault,lock",
+                 "huge,node=local,prefault"};
+    }
+
+    TickGenerator gen(100);
+    std::vector<uint8_t> stream;
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (size_t i = 0; i < STREAM_MESSAGES; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        stream.insert(stream.end(), buffer, buffer + size);
+    }
+
+    std::cout << "=== Memory Policy Benchmark ===\n";
+    std::cout << POOL_CHUNKS << " x " << CHUNK / 1024 << "KB pool, "
+              << stream.size() / (1024 * 1024) << "MB stream x " << STEADY_PASSES
+              << " passes\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "policy                     pool     build us  faults  first us  faults"
+                 "  ns/msg  faults  dTLB/1K msgs\n";
+
+    for (const auto& spec : specs) {
+        MemoryPolicy policy;
+        if (!parse_memory_policy(spec, policy)) {
+            std::cerr << "Invalid policy: " << spec << "\n";
+            return 1;
+        }
+        Result r = run(policy, stream);
+        std::cout << std::left << std::setw(27) << spec << std::setw(8) << r.pool_backing
+                  << std::right << std::setw(10) << r.construct_us
+                  << std::setw(8) << r.construct_faults
+                  << std::setw(10) << r.first_message_us
+                  << std::setw(8) << r.first_faults
+                  << std::setw(8) << r.steady_ns_per_msg
+                  << std::setw(8) << r.steady_faults;
+        if (r.has_tlb) {
+            std::cout << std::setw(14) << r.tlb_misses_per_kmsg << "\n";
+        } else {
+            std::cout << std::setw(14) << "n/a" << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+// MemoryPool alloc/free throughput versus malloc
+// 1-16 threads each allocate a burst of blocks, touch them, and free them
+// (the pattern of a receive loop), for malloc/free, the pool's shared
+// stack alone, and the pool with per-thread magazines. A handoff run then
+// allocates on one thread and frees on another through an SpscQueue, as
+// the feed handler's receive and parse stages do. Also reports CPU ns per
+// alloc+free pair, which stays meaningful when threads share cores.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <ctime>
+#include "../include/memory_pool.h"
+#include "../include/spsc_queue.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t BLOCK_SIZE = MemoryPool::DEFAULT_BLOCK_SIZE;
+static constexpr size_t POOL_BLOCKS = 4096;
+static constexpr size_t PAIRS_PER_THREAD = 2000000;
+static constexpr size_t BURST = 8;
+
+enum class Allocator { Malloc, SharedStack, Magazines };
+
+static const char* name(Allocator a) {
+    switch (a) {
+        case Allocator::Malloc: return "malloc";
+        case Allocator::SharedStack: return "pool, shared stack";
+        case Allocator::Magazines: return "pool, magazines";
+    }
+    return "";
+}
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+struct Result {
+    double mpairs_per_sec;
+    double cpu_ns_per_pair;
+};
+
+static std::unique_ptr<MemoryPool> make_pool(Allocator a) {
+    if (a == Allocator::Malloc) return nullptr;
+    return std::make_unique<MemoryPool>(
+        BLOCK_SIZE, POOL_BLOCKS, a == Allocator::Magazines ? MemoryPool::MAX_THREAD_CACHE : 0);
+}
+
+static void* take(MemoryPool* pool) {
+    return pool ? pool->allocate() : std::malloc(BLOCK_SIZE);
+}
+
+static void give(MemoryPool* pool, void* block) {
+    if (pool) {
+        pool->deallocate(block);
+    } else {
+        std::free(block);
+    }
+}
+
+static Result run_bursts(Allocator a, size_t num_threads) {
+    auto pool = make_pool(a);
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<uint64_t> cpu_total{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            void* blocks[BURST];
+            ready.fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+            double t0 = thread_cpu_ns();
+            for (size_t i = 0; i < PAIRS_PER_THREAD; i += BURST) {
+                for (size_t b = 0; b < BURST; ++b) {
+                    blocks[b] = take(pool.get());
+                    static_cast<volatile uint8_t*>(blocks[b])[0] = 1;
+                }
+                for (size_t b = 0; b < BURST; ++b) {
+                    give(pool.get(), blocks[b]);
+                }
+            }
+            cpu_total.fetch_add(static_cast<uint64_t>(thread_cpu_ns() - t0));
+        });
+    }
+    while (ready.load() < num_threads) std::this_thread::yield();
+
+    auto start = Clock::now();
+    go.store(true);
+    for (auto& thread : threads) thread.join();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double pairs = static_cast<double>(PAIRS_PER_THREAD * num_threads);
+    return {pairs / secs / 1e6, cpu_total.load() / pairs};
+}
+
+// One producer allocates, one consumer frees: every block crosses threads
+static Result run_handoff(Allocator a) {
+    auto pool = make_pool(a);
+    SpscQueue<void*> queue(256);
+
+    std::atomic<uint64_t> cpu_total{0};
+    auto start = Clock::now();
+    std::thread consumer([&]() {
+        double t0 = thread_cpu_ns();
+        void* blocks[16];
+        size_t freed = 0;
+        while (freed < PAIRS_PER_THREAD) {
+            size_t n = queue.pop_batch(blocks, 16);
+            if (n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < n; ++i) give(pool.get(), blocks[i]);
+            freed += n;
+        }
+        cpu_total.fetch_add(static_cast<uint64_t>(thread_cpu_ns() - t0));
+    });
+
+    double t0 = thread_cpu_ns();
+    for (size_t i = 0; i < PAIRS_PER_THREAD; ++i) {
+        void* block;
+        while (!(block = take(pool.get()))) std::this_thread::yield();
+        static_cast<volatile uint8_t*>(block)[0] = 1;
+        while (!queue.try_push(block)) std::this_thread::yield();
+    }
+    cpu_total.fetch_add(static_cast<uint64_t>(thread_cpu_ns() - t0));
+    consumer.join();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double pairs = static_cast<double>(PAIRS_PER_THREAD);
+    return {pairs / secs / 1e6, cpu_total.load() / pairs};
+}
+
+int main() {
+    const Allocator allocators[] = {Allocator::Malloc, Allocator::SharedStack,
+                                    Allocator::Magazines};
+
+    std::cout << "=== MemoryPool Benchmark ===\n";
+    std::cout << BLOCK_SIZE << "-byte blocks, " << PAIRS_PER_THREAD
+              << " alloc+free pairs per thread in bursts of " << BURST << ", "
+              << std::thread::hardware_concurrency() << " hardware threads\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "allocator            threads  Mpairs/s  CPU ns/pair\n";
+    for (Allocator a : allocators) {
+        for (size_t threads : {1, 2, 4, 8, 16}) {
+            Result r = run_bursts(a, threads);
+            std::cout << std::left << std::setw(21) << name(a) << std::right
+                      << std::setw(7) << threads
+                      << std::setw(10) << r.mpairs_per_sec
+                      << std::setw(13) << r.cpu_ns_per_pair << "\n";
+        }
+    }
+
+    std::cout << "\nCross-thread handoff (alloc on one thread, free on another)\n";
+    std::cout << "allocator            Mpairs/s  CPU ns/pair\n";
+    for (Allocator a : allocators) {
+        Result r = run_handoff(a);
+        std::cout << std::left << std::setw(21) << name(a) << std::right
+                  << std::setw(9) << r.mpairs_per_sec
+                  << std::setw(13) << r.cpu_ns_per_pair << "\n";
+    }
+    return 0;
+}
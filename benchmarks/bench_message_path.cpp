@@ -0,0 +1,170 @@
+// Message path benchmark: pooled, reference-counted messages from tick
+// generation through client send queues, and receive blocks parsed in
+// place. Server side: ticks fanned out to N socketpair clients, a quarter
+// of them reading only every 512 ticks so their sockets fill and their
+// queues take over; reports broadcast ns per message, queue high water,
+// and heap allocations per message, for ticks generated into the send
+// pool versus on the stack (copied in once when a queue needs them).
+// Client side: parse cost per message copying each receive into the
+// parser versus parsing it where it was received.
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/alloc_counter.h"
+#include "../include/client_manager.h"
+#include "../include/memory_pool.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t WARMUP_TICKS = 20000;
+static constexpr size_t TICKS = 200000;
+static constexpr size_t BURST = 64;
+static constexpr size_t SLOW_EVERY = 512;
+
+struct FanoutResult {
+    double ns_per_msg;
+    size_t peak_queue;
+    double allocs_per_msg;
+    uint64_t delivered;
+};
+
+static FanoutResult run_fanout(size_t num_clients, bool pooled) {
+    ClientManager mgr;
+    std::vector<std::array<int, 2>> fds(num_clients);
+    std::vector<MessageParser> parsers(num_clients);
+    int small_buffer = 16 * 1024;
+    for (size_t i = 0; i < num_clients; ++i) {
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds[i].data());
+        mgr.add_client(fds[i][0], "local", 0);
+        if (i % 4 == 3) {
+            setsockopt(fds[i][0], SOL_SOCKET, SO_SNDBUF, &small_buffer, sizeof(small_buffer));
+        }
+    }
+
+    TickGenerator gen(100);
+    MemoryPool blocks(64 * 1024, 16);
+    double ns = 0;
+    size_t peak_queue = 0;
+    uint64_t delivered = 0;
+
+    auto drain = [&](size_t t) {
+        for (size_t i = 0; i < num_clients; ++i) {
+            if (i % 4 == 3) {
+                peak_queue = std::max(peak_queue, mgr.get_client(fds[i][0])->queue->size());
+                if (t % SLOW_EVERY != 0) continue;
+            }
+            for (;;) {
+                PoolBuffer block(&blocks, blocks.allocate());
+                ssize_t n = recv(fds[i][1], block.data(), blocks.block_size(), MSG_DONTWAIT);
+                if (n <= 0) break;
+                parsers[i].parse_buffer(block.data(), static_cast<size_t>(n));
+            }
+        }
+        mgr.flush_send_queues();
+    };
+
+    auto run = [&](size_t ticks) {
+        uint8_t buffer[MAX_MSG_SIZE];
+        size_t size;
+        uint16_t symbol_id;
+        for (size_t t = BURST; t <= ticks; t += BURST) {
+            auto start = Clock::now();
+            for (size_t b = 0; b < BURST; ++b) {
+                if (pooled) {
+                    MessageRef msg = mgr.allocate_message();
+                    gen.generate_tick(msg.data(), size, symbol_id);
+                    msg.resize(size);
+                    delivered += mgr.broadcast(msg, symbol_id);
+                } else {
+                    gen.generate_tick(buffer, size, symbol_id);
+                    delivered += mgr.broadcast(buffer, size, symbol_id);
+                }
+            }
+            ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            drain(t);
+        }
+    };
+
+    run(WARMUP_TICKS);
+    ns = 0;
+    peak_queue = 0;
+    delivered = 0;
+    AllocationScope scope;
+    run(TICKS);
+    double allocs = static_cast<double>(scope.allocations()) / TICKS;
+
+    for (auto& pair : fds) {
+        mgr.remove_client(pair[0]);
+        close(pair[1]);
+    }
+    return {ns / TICKS, peak_queue, allocs, delivered};
+}
+
+static double run_parse(const std::vector<uint8_t>& stream, bool in_place, size_t& messages) {
+    MessageParser parser;
+    MemoryPool blocks(64 * 1024, 16);
+    messages = 0;
+    auto start = Clock::now();
+    for (size_t off = 0; off < stream.size(); off += 64 * 1024) {
+        size_t len = std::min<size_t>(64 * 1024, stream.size() - off);
+        PoolBuffer block(&blocks, blocks.allocate());
+        std::memcpy(block.data(), stream.data() + off, len);   // The receive
+        if (in_place) {
+            messages += parser.parse_buffer(block.data(), len);
+        } else {
+            parser.append_data(block.data(), len);
+            messages += parser.parse_messages();
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / messages;
+}
+
+int main() {
+    std::cout << "=== Message Path Benchmark ===\n";
+    std::cout << TICKS << " ticks in bursts of " << BURST << ", every 4th client reading every "
+              << SLOW_EVERY << " ticks\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "clients  tick buffer   broadcast ns/msg  peak queue  allocs/msg  delivered\n";
+    for (size_t clients : {1, 4, 16, 64}) {
+        for (bool pooled : {false, true}) {
+            FanoutResult r = run_fanout(clients, pooled);
+            std::cout << std::setw(7) << clients << "  " << std::left << std::setw(12)
+                      << (pooled ? "pooled" : "stack") << std::right
+                      << std::setw(18) << r.ns_per_msg
+                      << std::setw(12) << r.peak_queue
+                      << std::setw(12) << r.allocs_per_msg
+                      << std::setw(11) << r.delivered << "\n";
+        }
+    }
+
+    TickGenerator gen(100);
+    std::vector<uint8_t> stream;
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (size_t i = 0; i < 2000000; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        stream.insert(stream.end(), buffer, buffer + size);
+    }
+
+    std::cout << "\nReceive path, " << stream.size() / (1024 * 1024) << "MB in 64KB blocks\n";
+    std::cout << "parse            ns/msg\n";
+    for (bool in_place : {false, true}) {
+        size_t messages;
+        double ns = run_parse(stream, in_place, messages);
+        std::cout << std::left << std::setw(15) << (in_place ? "in place" : "copy in")
+                  << std::right << std::setw(8) << ns << "\n";
+    }
+    return 0;
+}
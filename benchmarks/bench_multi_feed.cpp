@@ -0,0 +1,125 @@
+// Multi-feed benchmark: one FeedHandler consuming N exchange simulators
+// Each simulator is an independent feed (own sequence space) running in
+// this process. Reports aggregate receive rate, the handler thread's CPU
+// per message, end-to-end latency, and the per-connection breakdown.
+//
+// Usage: bench_multi_feed [ticks_per_sec_per_feed] [base_port]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../include/exchange_simulator.h"
+#include "../include/feed_handler.h"
+
+using namespace mdf;
+
+static constexpr auto RUN_TIME = std::chrono::seconds(2);
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+struct Result {
+    double msgs_per_sec = 0;
+    double cpu_ns_per_msg = 0;
+    uint64_t gaps = 0;
+    LatencyStats latency;
+    std::vector<ConnectionStats> feeds;
+};
+
+static Result run(size_t num_feeds, uint32_t rate, uint16_t base_port) {
+    // Simulator and handler chatter stays out of the table
+    std::ostringstream quiet;
+    auto* saved = std::cout.rdbuf(quiet.rdbuf());
+
+    std::vector<std::unique_ptr<ExchangeSimulator>> sims;
+    std::vector<std::thread> sim_threads;
+    FeedHandlerConfig config;
+    config.enable_visualization = false;
+    config.auto_reconnect = false;
+    for (size_t i = 0; i < num_feeds; ++i) {
+        uint16_t port = static_cast<uint16_t>(base_port + i);
+        auto sim = std::make_unique<ExchangeSimulator>(port, MAX_SYMBOLS);
+        sim->set_tick_rate(rate);
+        sim->start();
+        sim_threads.emplace_back([s = sim.get()]() { s->run(); });
+        sims.push_back(std::move(sim));
+        config.feeds.push_back(FeedEndpoint{"127.0.0.1", port, {}});
+    }
+
+    auto handler = std::make_unique<FeedHandler>();
+    handler->configure(config);
+    if (!handler->start()) {
+        std::cout.rdbuf(saved);
+        std::cerr << "FeedHandler failed to start\n";
+        std::exit(1);
+    }
+
+    double cpu = 0;
+    std::thread runner([&]() {
+        double t0 = thread_cpu_ns();
+        handler->run();
+        cpu = thread_cpu_ns() - t0;
+    });
+
+    std::this_thread::sleep_for(RUN_TIME);
+    handler->stop();
+    runner.join();
+
+    Result result;
+    double secs = std::chrono::duration<double>(RUN_TIME).count();
+    uint64_t messages = handler->messages_received();
+    result.msgs_per_sec = messages / secs;
+    result.cpu_ns_per_msg = messages ? cpu / messages : 0;
+    result.gaps = handler->sequence_gaps();
+    result.latency = handler->get_latency_stats();
+    result.feeds = handler->get_connection_stats();
+
+    for (auto& sim : sims) sim->stop();
+    for (auto& t : sim_threads) t.join();
+    std::cout.rdbuf(saved);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t rate = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    uint16_t base_port = argc > 2 ? static_cast<uint16_t>(std::atoi(argv[2])) : 19870;
+
+    std::cout << "=== Multi-Feed Handler Benchmark ===\n";
+    std::cout << "Each feed: exchange simulator at " << rate << " ticks/s, "
+              << MAX_SYMBOLS << " symbols, " << std::thread::hardware_concurrency()
+              << " hardware threads\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "feeds    K msg/s   CPU ns/msg   p50 us   p99 us   gaps\n";
+
+    Result four;
+    for (size_t feeds : {1, 2, 4}) {
+        Result r = run(feeds, rate, base_port);
+        std::cout << std::setw(5) << feeds
+                  << std::setw(12) << r.msgs_per_sec / 1000.0
+                  << std::setw(13) << r.cpu_ns_per_msg
+                  << std::setw(9) << r.latency.p50 / 1000.0
+                  << std::setw(9) << r.latency.p99 / 1000.0
+                  << std::setw(7) << r.gaps << "\n";
+        base_port = static_cast<uint16_t>(base_port + feeds);
+        if (feeds == 4) four = r;
+    }
+
+    std::cout << "\nPer connection (4 feeds):\n";
+    std::cout << "endpoint              messages   p50 us   p99 us   gaps\n";
+    for (const auto& feed : four.feeds) {
+        std::cout << std::left << std::setw(20) << feed.endpoint << std::right
+                  << std::setw(11) << feed.messages_received
+                  << std::setw(9) << feed.latency.p50 / 1000.0
+                  << std::setw(9) << feed.latency.p99 / 1000.0
+                  << std::setw(7) << feed.sequence_gaps << "\n";
+    }
+    return 0;
+}
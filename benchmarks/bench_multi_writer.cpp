@@ -0,0 +1,90 @@
+// Multi-writer SymbolCache benchmark
+// Aggregate update throughput with 1-8 writer threads for each WriterMode.
+// Also reports writer CPU ns per update, which stays meaningful when the
+// threads share fewer cores than there are writers
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <ctime>
+#include "../include/cache.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t UPDATES_PER_WRITER = 2000000;
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+struct Result {
+    double mupdates_per_sec;
+    double cpu_ns_per_update;
+};
+
+// contended: every writer cycles through the same symbols; otherwise
+// writer w updates only symbols s % writers == w
+static Result run(WriterMode mode, size_t writers, bool contended) {
+    auto cache = std::make_unique<SymbolCache>();
+    cache->set_writer_mode(mode);
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<uint64_t> cpu_total{0};
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w]() {
+            ready.fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+            double t0 = thread_cpu_ns();
+            for (size_t i = 0; i < UPDATES_PER_WRITER; ++i) {
+                uint16_t s = contended
+                                 ? static_cast<uint16_t>(i % 16)
+                                 : static_cast<uint16_t>((i * writers + w) % MAX_SYMBOLS);
+                double px = 100.0 + (i & 63) * 0.05;
+                cache->update_quote(s, px, 100, px + 0.05, 200, i);
+            }
+            cpu_total.fetch_add(static_cast<uint64_t>(thread_cpu_ns() - t0));
+        });
+    }
+    while (ready.load() < writers) std::this_thread::yield();
+
+    auto start = Clock::now();
+    go.store(true);
+    for (auto& t : threads) t.join();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double updates = static_cast<double>(UPDATES_PER_WRITER * writers);
+    return {updates / secs / 1e6, cpu_total.load() / updates};
+}
+
+int main() {
+    std::cout << "=== Multi-Writer SymbolCache Benchmark ===\n";
+    std::cout << UPDATES_PER_WRITER << " updates per writer, "
+              << std::thread::hardware_concurrency() << " hardware threads\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    Result single = run(WriterMode::Single, 1, false);
+    std::cout << "Single, 1 writer: " << single.mupdates_per_sec << " M/s, "
+              << single.cpu_ns_per_update << " CPU ns/update\n\n";
+
+    std::cout << "writers   Partitioned        Shared (disjoint)   Shared (16 hot symbols)\n";
+    std::cout << "          M/s   CPU ns       M/s   CPU ns        M/s   CPU ns\n";
+    for (size_t writers : {1, 2, 4, 8}) {
+        Result part = run(WriterMode::Partitioned, writers, false);
+        Result shared = run(WriterMode::Shared, writers, false);
+        Result hot = run(WriterMode::Shared, writers, true);
+        std::cout << std::setw(7) << writers
+                  << std::setw(7) << part.mupdates_per_sec << std::setw(9) << part.cpu_ns_per_update
+                  << std::setw(10) << shared.mupdates_per_sec << std::setw(9) << shared.cpu_ns_per_update
+                  << std::setw(11) << hot.mupdates_per_sec << std::setw(9) << hot.cpu_ns_per_update
+                  << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Order book microbenchmark
+// Measures incremental update throughput and top-N level read cost
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include "../include/order_book.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+int main() {
+    constexpr size_t NUM_SYMBOLS = 500;
+    constexpr size_t NUM_UPDATES = 2000000;
+    constexpr size_t NUM_READS = 5000000;
+
+    std::cout << "=== Order Book Benchmark ===\n";
+
+    // Pre-generate a realistic update stream from the simulator
+    TickGenerator gen(NUM_SYMBOLS);
+    gen.set_depth_levels(MAX_BOOK_LEVELS);
+
+    std::vector<uint16_t> symbols(NUM_UPDATES);
+    std::vector<DepthUpdatePayload> updates(NUM_UPDATES);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    for (size_t i = 0; i < NUM_UPDATES; ++i) {
+        symbols[i] = static_cast<uint16_t>((i * 7919) % NUM_SYMBOLS);
+        gen.generate_depth_update(symbols[i], buffer, size);
+        std::memcpy(&updates[i], buffer + HEADER_SIZE, sizeof(DepthUpdatePayload));
+    }
+
+    // Update throughput
+    DepthCache cache(NUM_SYMBOLS);
+    auto start = Clock::now();
+    for (size_t i = 0; i < NUM_UPDATES; ++i) {
+        cache.apply_update(symbols[i], updates[i], i);
+    }
+    double update_ns = elapsed_ns(start) / NUM_UPDATES;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "apply_update:        " << update_ns << " ns/update  ("
+              << std::setprecision(2) << (1000.0 / update_ns) << "M updates/s)\n";
+    std::cout << std::setprecision(1);
+
+    // Top-N read cost
+    PriceLevel levels[MAX_BOOK_LEVELS];
+    for (size_t n : {1, 5, 10, 20}) {
+        volatile double sink = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < NUM_READS; ++i) {
+            size_t got = cache.get_levels(static_cast<uint16_t>(i % NUM_SYMBOLS),
+                                          BookSide::BID, levels, n);
+            if (got > 0) sink = sink + levels[got - 1].price;
+        }
+        double read_ns = elapsed_ns(start) / NUM_READS;
+        std::cout << "get_levels(top " << std::setw(2) << n << "): " << read_ns
+                  << " ns/read\n";
+    }
+
+    // Full book snapshot for comparison
+    {
+        volatile uint8_t sink = 0;
+        start = Clock::now();
+        for (size_t i = 0; i < NUM_READS; ++i) {
+            OrderBook book = cache.get_book(static_cast<uint16_t>(i % NUM_SYMBOLS));
+            sink = sink + book.bid_count;
+        }
+        std::cout << "get_book (full):     " << elapsed_ns(start) / NUM_READS
+                  << " ns/read\n";
+    }
+
+    std::cout << "sizeof(OrderBook):   " << sizeof(OrderBook) << " bytes\n";
+    return 0;
+}
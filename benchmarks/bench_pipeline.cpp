@@ -0,0 +1,204 @@
+// Pipelined vs inline FeedHandler benchmark
+// A sender thread streams pre-generated ticks over loopback TCP into a
+// real FeedHandler. Reports sustained max throughput (sender unpaced) and
+// wire-to-apply latency at a fixed offered rate, for both modes.
+//
+// Usage: bench_pipeline [rate_msgs_per_sec] [recv,parse,apply cores]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/feed_handler.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t STREAM_MESSAGES = 2000000;
+static constexpr size_t SEND_CHUNK = 64 * 1024;
+
+struct Stream {
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> offsets;   // Start of each message
+};
+
+static Stream make_stream() {
+    Stream stream;
+    TickGenerator gen(MAX_SYMBOLS);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (size_t i = 0; i < STREAM_MESSAGES; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        stream.offsets.push_back(static_cast<uint32_t>(stream.bytes.size()));
+        stream.bytes.insert(stream.bytes.end(), buffer, buffer + size);
+    }
+    stream.offsets.push_back(static_cast<uint32_t>(stream.bytes.size()));
+    return stream;
+}
+
+// Rewrite the send timestamp of messages [first, last) and re-checksum
+static void stamp(Stream& stream, size_t first, size_t last) {
+    uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    for (size_t i = first; i < last; ++i) {
+        uint8_t* msg = &stream.bytes[stream.offsets[i]];
+        MessageHeader header;
+        std::memcpy(&header, msg, sizeof(header));
+        header.timestamp_ns = now;
+        std::memcpy(msg, &header, sizeof(header));
+        size_t body = HEADER_SIZE + get_payload_size(static_cast<MessageType>(header.message_type));
+        uint32_t checksum = calculate_checksum(msg, body);
+        std::memcpy(msg + body, &checksum, sizeof(checksum));
+    }
+}
+
+static bool send_all(int fd, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+struct Result {
+    double mmsgs_per_sec = 0;
+    LatencyStats wire;           // Send to apply
+    PipelineStats pipeline;
+};
+
+// rate == 0: unpaced, measures throughput
+static Result run(Stream& stream, bool pipeline, double rate, const int cores[3]) {
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listener, 1) < 0 ||
+        ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) < 0) {
+        std::perror("listen");
+        std::exit(1);
+    }
+
+    FeedHandlerConfig config;
+    config.host = "127.0.0.1";
+    config.port = ntohs(addr.sin_port);
+    config.enable_visualization = false;
+    config.auto_reconnect = false;
+    config.pipeline = pipeline;
+    config.recv_core = cores[0];
+    config.parse_core = cores[1];
+    config.apply_core = cores[2];
+
+    auto handler = std::make_unique<FeedHandler>();
+    handler->configure(config);
+
+    // Keep the handler's connect chatter out of the table
+    std::ostringstream quiet;
+    auto* saved = std::cout.rdbuf(quiet.rdbuf());
+    bool started = handler->start();
+    std::cout.rdbuf(saved);
+    if (!started) {
+        std::cerr << "FeedHandler failed to start\n";
+        std::exit(1);
+    }
+    int fd = ::accept(listener, nullptr, nullptr);
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    std::thread runner([&]() { handler->run(); });
+
+    size_t total = stream.offsets.size() - 1;
+    auto start = Clock::now();
+    if (rate <= 0) {
+        for (size_t off = 0; off < stream.bytes.size(); off += SEND_CHUNK) {
+            size_t len = std::min(SEND_CHUNK, stream.bytes.size() - off);
+            if (!send_all(fd, &stream.bytes[off], len)) break;
+        }
+    } else {
+        // One slice per millisecond, stamped just before it is sent
+        size_t per_slice = static_cast<size_t>(rate / 1000);
+        auto next = start;
+        for (size_t first = 0; first < total; first += per_slice) {
+            size_t last = std::min(total, first + per_slice);
+            stamp(stream, first, last);
+            if (!send_all(fd, &stream.bytes[stream.offsets[first]],
+                          stream.offsets[last] - stream.offsets[first])) break;
+            next += std::chrono::milliseconds(1);
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    // Every message records one wire-latency sample when it is applied
+    auto deadline = Clock::now() + std::chrono::seconds(60);
+    while (handler->get_latency_stats().sample_count < total && Clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Result result;
+    result.mmsgs_per_sec = handler->get_latency_stats().sample_count / secs / 1e6;
+    result.wire = handler->get_latency_stats();
+    result.pipeline = handler->get_pipeline_stats();
+
+    handler->stop();
+    runner.join();
+    ::close(fd);
+    ::close(listener);
+    return result;
+}
+
+static void report(const char* mode, const Result& r, bool show_pipeline) {
+    std::cout << std::left << std::setw(10) << mode << std::right
+              << std::setw(10) << r.mmsgs_per_sec
+              << std::setw(10) << r.wire.p50 / 1000.0
+              << std::setw(10) << r.wire.p99 / 1000.0
+              << std::setw(11) << r.wire.p999 / 1000.0;
+    if (show_pipeline) {
+        std::cout << "   raw max " << r.pipeline.raw_queue_max_depth
+                  << ", events max " << r.pipeline.event_queue_max_depth
+                  << ", apply wait p99 " << r.pipeline.apply_wait.p99 / 1000.0 << " us";
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    double rate = argc > 1 ? std::atof(argv[1]) : 1000000;
+    int cores[3] = {-1, -1, -1};
+    if (argc > 2) {
+        std::sscanf(argv[2], "%d,%d,%d", &cores[0], &cores[1], &cores[2]);
+    }
+
+    std::cout << "=== Pipeline vs Inline Feed Handler Benchmark ===\n";
+    std::cout << STREAM_MESSAGES << " messages over loopback TCP, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+    Stream stream = make_stream();
+    std::cout << std::fixed << std::setprecision(1);
+
+    std::cout << "\nUnpaced sender (max sustained throughput):\n";
+    std::cout << "mode           M/s\n";
+    for (bool pipeline : {false, true}) {
+        Result r = run(stream, pipeline, 0, cores);
+        std::cout << std::left << std::setw(10) << (pipeline ? "pipeline" : "inline")
+                  << std::right << std::setw(10) << r.mmsgs_per_sec << "\n";
+    }
+
+    std::cout << "\nOffered " << rate / 1e6 << "M msg/s (send to apply, us):\n";
+    std::cout << "mode           M/s       p50       p99      p999\n";
+    report("inline", run(stream, false, rate, cores), false);
+    report("pipeline", run(stream, true, rate, cores), true);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Wire protocol benchmark: v1 (double prices) vs v2 (fixed-point)
+// Reports bytes/message, bandwidth at 500K msg/s and parser throughput
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static double parse_rate(const std::vector<uint8_t>& stream) {
+    MessageParser parser;
+    volatile double sink = 0;
+    parser.set_trade_callback([&](const MessageHeader&, const TradePayload& p) {
+        sink = sink + p.price;
+    });
+    parser.set_quote_callback([&](const MessageHeader&, const QuotePayload& q) {
+        sink = sink + q.bid_price;
+    });
+
+    // Feed in 64KB chunks, like recv() would
+    constexpr size_t CHUNK = 64 * 1024;
+    auto start = Clock::now();
+    size_t parsed = 0;
+    for (size_t off = 0; off < stream.size(); off += CHUNK) {
+        size_t len = std::min(CHUNK, stream.size() - off);
+        parser.append_data(stream.data() + off, len);
+        parsed += parser.parse_messages();
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    return parsed / secs;
+}
+
+int main() {
+    constexpr size_t NUM_MESSAGES = 2000000;
+    constexpr double TARGET_RATE = 500000.0;
+
+    std::cout << "=== Protocol v1 vs v2 Benchmark ===\n";
+
+    TickGenerator gen(MAX_SYMBOLS);
+    std::vector<uint8_t> v1, v2;
+    v1.reserve(NUM_MESSAGES * MAX_MSG_SIZE);
+    v2.reserve(NUM_MESSAGES * MAX_MSG_SIZE);
+
+    uint8_t buffer[MAX_MSG_SIZE];
+    uint8_t encoded[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+
+    double encode_secs = 0;
+    for (size_t i = 0; i < NUM_MESSAGES; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        v1.insert(v1.end(), buffer, buffer + size);
+
+        auto t0 = Clock::now();
+        size_t v2_size = encode_v2(buffer, encoded);
+        encode_secs += std::chrono::duration<double>(Clock::now() - t0).count();
+        v2.insert(v2.end(), encoded, encoded + v2_size);
+    }
+
+    double v1_bpm = static_cast<double>(v1.size()) / NUM_MESSAGES;
+    double v2_bpm = static_cast<double>(v2.size()) / NUM_MESSAGES;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "                     v1          v2\n";
+    std::cout << "bytes/message    " << std::setw(8) << v1_bpm << "    "
+              << std::setw(8) << v2_bpm << "\n";
+    std::cout << "MB/s @ 500K msg/s" << std::setw(8) << v1_bpm * TARGET_RATE / 1e6
+              << "    " << std::setw(8) << v2_bpm * TARGET_RATE / 1e6 << "\n";
+    std::cout << "Mbps @ 500K msg/s" << std::setw(8) << v1_bpm * TARGET_RATE * 8 / 1e6
+              << "    " << std::setw(8) << v2_bpm * TARGET_RATE * 8 / 1e6 << "\n";
+
+    double v1_rate = parse_rate(v1);
+    double v2_rate = parse_rate(v2);
+    std::cout << "parse M msg/s    " << std::setw(8) << v1_rate / 1e6 << "    "
+              << std::setw(8) << v2_rate / 1e6 << "\n";
+    std::cout << "CPU @ 500K msg/s " << std::setw(7) << 100.0 * TARGET_RATE / v1_rate
+              << "%    " << std::setw(7) << 100.0 * TARGET_RATE / v2_rate << "%\n";
+    std::cout << "server encode_v2: " << encode_secs * 1e9 / NUM_MESSAGES
+              << " ns/msg\n";
+    std::cout << "bandwidth saving: " << 100.0 * (1.0 - v2_bpm / v1_bpm) << "%\n";
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Parser reorder buffer benchmark
+// Parses a stream of trades, in order and with reordering or loss, with
+// the reorder buffer off and on. Reports parse cost per message, the gaps
+// reported, messages dispatched out of order, and how long held messages
+// waited (wall time inside the parse loop, so a lower bound).
+//
+// Usage: bench_reorder [messages]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../include/parser.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+enum class Impairment { None, Swap, Displace, Drop };
+
+struct Case {
+    const char* name;
+    Impairment impairment;
+    size_t window;
+};
+
+// Sequence order as it arrives: 1% of messages swapped with the next one,
+// moved 16 places later, or lost
+static std::vector<uint32_t> arrival_order(size_t count, Impairment impairment) {
+    std::vector<uint32_t> seqs(count);
+    for (size_t i = 0; i < count; ++i) seqs[i] = static_cast<uint32_t>(i + 1);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<uint32_t> out;
+    out.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (impairment == Impairment::None || percent(rng) != 0) continue;
+        if (impairment == Impairment::Swap && i + 1 < count) {
+            std::swap(seqs[i], seqs[i + 1]);
+            i++;
+        } else if (impairment == Impairment::Displace && i + 16 < count) {
+            uint32_t moved = seqs[i];
+            for (size_t j = i; j < i + 16; ++j) seqs[j] = seqs[j + 1];
+            seqs[i + 16] = moved;
+            i += 16;
+        } else if (impairment == Impairment::Drop) {
+            seqs[i] = 0;
+        }
+    }
+    for (uint32_t seq : seqs) {
+        if (seq != 0) out.push_back(seq);
+    }
+    return out;
+}
+
+static std::vector<uint8_t> encode(const std::vector<uint32_t>& seqs) {
+    std::vector<uint8_t> stream;
+    stream.reserve(seqs.size() * TRADE_MSG_SIZE);
+    for (uint32_t seq : seqs) {
+        TradeMessage msg{};
+        msg.header.message_type = static_cast<uint16_t>(MessageType::TRADE);
+        msg.header.sequence_number = seq;
+        msg.header.symbol_id = static_cast<uint16_t>(seq % 100);
+        msg.payload.price = 100.0 + (seq % 1000) * 0.05;
+        msg.payload.quantity = 100;
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - sizeof(msg.checksum));
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&msg);
+        stream.insert(stream.end(), bytes, bytes + sizeof(msg));
+    }
+    return stream;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000000;
+
+    const Case cases[] = {
+        {"in order",        Impairment::None,     0},
+        {"in order",        Impairment::None,     64},
+        {"1% swapped",      Impairment::Swap,     0},
+        {"1% swapped",      Impairment::Swap,     64},
+        {"1% 16 late",      Impairment::Displace, 0},
+        {"1% 16 late",      Impairment::Displace, 64},
+        {"1% 16 late",      Impairment::Displace, 8},
+        {"1% lost",         Impairment::Drop,     0},
+        {"1% lost",         Impairment::Drop,     64},
+    };
+
+    std::cout << "=== Parser Reorder Buffer Benchmark ===\n";
+    std::cout << count << " trades per case, parsed in 64KB chunks\n\n";
+    std::cout << "case          window   ns/msg     gaps  out of order    late"
+                 "  max depth  mean hold ns\n";
+
+    for (const auto& c : cases) {
+        auto stream = encode(arrival_order(count, c.impairment));
+
+        MessageParser parser;
+        parser.set_reorder_window(c.window);
+        uint32_t last = 0;
+        uint64_t out_of_order = 0;
+        volatile double sink = 0;
+        parser.set_trade_callback([&](const MessageHeader& h, const TradePayload& p) {
+            uint32_t seq = h.sequence_number;
+            out_of_order += seq < last ? 1 : 0;
+            last = seq;
+            sink = sink + p.price;
+        });
+
+        // Feed in 64KB chunks, like recv() would
+        constexpr size_t CHUNK = 64 * 1024;
+        auto start = Clock::now();
+        size_t parsed = 0;
+        for (size_t off = 0; off < stream.size(); off += CHUNK) {
+            size_t len = std::min(CHUNK, stream.size() - off);
+            parser.append_data(stream.data() + off, len);
+            parsed += parser.parse_messages();
+        }
+        parser.flush_reorder();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        ReorderStats stats = parser.reorder_stats();
+        std::cout << std::left << std::setw(14) << c.name << std::right
+                  << std::setw(6) << c.window
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(9) << ns / (parsed ? parsed : 1)
+                  << std::setw(9) << parser.sequence_gaps()
+                  << std::setw(14) << out_of_order
+                  << std::setw(8) << stats.late
+                  << std::setw(11) << stats.max_depth
+                  << std::setw(14) << stats.mean_hold_ns << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// Parser resync benchmark: fuzz-style recovery after corruption
+// Overwrites random stretches of a generated tick stream (noise, or zeros
+// like a torn page) and parses it with the resync scan off (one byte and
+// one checksum attempt per step) and on. Reports the parse time per corrupt
+// stretch beyond what the surviving messages cost in a clean parse, the
+// failed type/checksum checks spent, and messages lost beyond the ones the
+// corruption overlapped.
+//
+// Usage: bench_resync [messages] [max stretches per case]
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t NUM_SYMBOLS = 500;
+static constexpr size_t CHUNK = 64 * 1024;
+
+struct Stream {
+    std::vector<uint8_t> bytes;
+    std::vector<size_t> offsets;  // Start of each message
+};
+
+struct Result {
+    double ns = 0;
+    uint64_t delivered = 0;
+    uint64_t attempts = 0;        // Failed type or checksum checks
+    ResyncStats resync;
+};
+
+static Stream generate(size_t count) {
+    TickGenerator gen(NUM_SYMBOLS);
+    Stream stream;
+    stream.offsets.reserve(count);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (size_t i = 0; i < count; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        stream.offsets.push_back(stream.bytes.size());
+        stream.bytes.insert(stream.bytes.end(), buffer, buffer + size);
+    }
+    return stream;
+}
+
+static Result parse(const std::vector<uint8_t>& bytes, bool scan) {
+    MessageParser parser;
+    parser.set_symbol_limit(NUM_SYMBOLS);
+    parser.set_resync_scan(scan);
+    volatile uint64_t sink = 0;
+    parser.set_quote_callback([&](const MessageHeader&, const QuotePayload& p) {
+        sink = sink + p.bid_quantity;
+    });
+    parser.set_trade_callback([&](const MessageHeader&, const TradePayload& p) {
+        sink = sink + p.quantity;
+    });
+
+    auto start = Clock::now();
+    for (size_t off = 0; off < bytes.size(); off += CHUNK) {
+        parser.append_data(bytes.data() + off, std::min(CHUNK, bytes.size() - off));
+        parser.parse_messages();
+    }
+    Result r;
+    r.ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    r.delivered = parser.messages_parsed();
+    r.attempts = parser.checksum_errors() + parser.malformed_messages();
+    r.resync = parser.resync_stats();
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 400000;
+    size_t max_bursts = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 200;
+
+    Stream stream = generate(count);
+
+    // Best of a few clean parses is the baseline for each run
+    double clean_ns = 1e300;
+    for (int i = 0; i < 5; ++i) {
+        clean_ns = std::min(clean_ns, parse(stream.bytes, true).ns);
+    }
+    double clean_per_msg = clean_ns / count;
+
+    std::cout << "=== Parser Resync Benchmark ===\n";
+    std::cout << count << " ticks (" << stream.bytes.size() / 1024 << " KB), "
+              << "clean parse " << std::fixed << std::setprecision(2)
+              << clean_ns / 1e6 << " ms\n\n";
+    std::cout << "fill      burst  stretches  scan  recovery us  checks/stretch"
+                 "  candidates  extra lost\n";
+
+    const size_t sizes[] = {16, 256, 4096, 65536, 1 << 20};
+    for (bool noise : {true, false}) {
+        for (size_t burst : sizes) {
+            // Random, non-overlapping stretches, at most a quarter of the stream
+            std::mt19937_64 rng(burst);
+            std::vector<uint8_t> bytes = stream.bytes;
+            size_t bursts = std::min(max_bursts, bytes.size() / (4 * burst));
+            if (bursts == 0) {
+                continue;
+            }
+            size_t spacing = bytes.size() / bursts;
+            size_t overlapped = 0;
+            for (size_t b = 0; b < bursts; ++b) {
+                size_t at = b * spacing + rng() % (spacing - burst - 64);
+                for (size_t i = at; i < at + burst; ++i) {
+                    bytes[i] = noise ? static_cast<uint8_t>(rng()) : 0;
+                }
+
+                // Messages the stretch touched
+                auto first = std::upper_bound(stream.offsets.begin(), stream.offsets.end(), at) - 1;
+                auto last = std::upper_bound(stream.offsets.begin(), stream.offsets.end(),
+                                             at + burst - 1) - 1;
+                overlapped += static_cast<size_t>(last - first) + 1;
+            }
+
+            for (bool scan : {false, true}) {
+                Result best;
+                best.ns = 1e300;
+                for (int i = 0; i < 5; ++i) {
+                    Result r = parse(bytes, scan);
+                    if (r.ns < best.ns) best = r;
+                }
+                double survivors_ns = clean_per_msg * static_cast<double>(best.delivered);
+                double recovery_us = std::max(0.0, best.ns - survivors_ns) / bursts / 1000.0;
+                int64_t extra_lost = static_cast<int64_t>(count - overlapped) -
+                                     static_cast<int64_t>(best.delivered);
+                std::cout << std::left << std::setw(6) << (noise ? "noise" : "zeros")
+                          << std::right << std::setw(9) << burst
+                          << std::setw(11) << bursts
+                          << std::setw(6) << (scan ? "on" : "off")
+                          << std::setw(13) << std::setprecision(1) << recovery_us
+                          << std::setw(16) << static_cast<double>(best.attempts) / bursts
+                          << std::setw(12) << best.resync.candidates
+                          << std::setw(12) << extra_lost << "\n";
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,208 @@
+// SlabAllocator versus glibc malloc and the fixed-block MemoryPool
+// Each thread keeps a window of live allocations and replaces a random
+// one per step, with sizes drawn from a mix like the server's (mostly
+// set nodes and request scratch, some packets, a few large buffers).
+// The fixed pool has 4KB blocks, so it must send anything larger to
+// malloc and spends a whole block on every small request; reported as
+// CPU ns per alloc+free pair, bytes held per byte requested, and the
+// share of requests the pool or slab had to pass on to malloc. Then
+// whole std::pmr containers (a client's subscription set and the
+// request vector it is built from) on new/delete, the standard pool
+// resource, and the slab.
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../include/memory_pool.h"
+#include "../include/slab_allocator.h"
+
+using namespace mdf;
+
+static constexpr size_t WINDOW = 256;
+static constexpr size_t STEPS_PER_THREAD = 2000000;
+static constexpr size_t CLASS_BYTES = 2 * 1024 * 1024;
+
+enum class Allocator { Malloc, Pool, Slab };
+
+static const char* name(Allocator a) {
+    switch (a) {
+        case Allocator::Malloc: return "malloc";
+        case Allocator::Pool: return "pool (4KB blocks)";
+        case Allocator::Slab: return "slab";
+    }
+    return "";
+}
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// 70% up to 128B, 25% up to 2KB, 5% up to 64KB
+static size_t draw_size(std::mt19937& rng) {
+    uint32_t r = rng();
+    uint32_t pick = r % 100;
+    if (pick < 70) return 8 + (r >> 8) % 121;
+    if (pick < 95) return 129 + (r >> 8) % 1920;
+    return 2049 + (r >> 8) % (64 * 1024 - 2048);
+}
+
+struct Held {
+    void* ptr = nullptr;
+    size_t size = 0;
+    bool pooled = false;
+};
+
+struct Result {
+    double cpu_ns_per_pair;
+    double held_per_requested;   // Bytes the allocator set aside per byte asked for
+    double upstream_pct;         // Requests the pool or slab sent to malloc
+};
+
+static Result run(Allocator a, size_t num_threads) {
+    MemoryPool pool(MemoryPool::DEFAULT_BLOCK_SIZE, 1024 * num_threads);
+    SlabAllocator slab(CLASS_BYTES * num_threads);
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<uint64_t> cpu_total{0};
+    std::atomic<uint64_t> requested_total{0};
+    std::atomic<uint64_t> held_total{0};
+    std::atomic<uint64_t> pool_misses{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(static_cast<uint32_t>(t + 1));
+            std::vector<Held> window(WINDOW);
+            uint64_t requested = 0;
+            uint64_t held = 0;
+
+            auto take = [&](Held& h, size_t size) {
+                h.size = size;
+                h.pooled = false;
+                if (a == Allocator::Slab) {
+                    h.ptr = slab.allocate(size);
+                } else if (a == Allocator::Pool && size <= pool.block_size() &&
+                           (h.ptr = pool.allocate())) {
+                    h.pooled = true;
+                } else {
+                    h.ptr = std::malloc(size);
+                    if (a == Allocator::Pool) pool_misses.fetch_add(1, std::memory_order_relaxed);
+                }
+                static_cast<volatile uint8_t*>(h.ptr)[0] = 1;
+            };
+            auto give = [&](Held& h) {
+                if (a == Allocator::Slab) {
+                    slab.deallocate(h.ptr, h.size);
+                } else if (h.pooled) {
+                    pool.deallocate(h.ptr);
+                } else {
+                    std::free(h.ptr);
+                }
+            };
+
+            for (Held& h : window) take(h, draw_size(rng));
+            ready.fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+
+            double t0 = thread_cpu_ns();
+            for (size_t i = 0; i < STEPS_PER_THREAD; ++i) {
+                Held& h = window[rng() % WINDOW];
+                give(h);
+                take(h, draw_size(rng));
+            }
+            cpu_total.fetch_add(static_cast<uint64_t>(thread_cpu_ns() - t0));
+
+            for (Held& h : window) {
+                requested += h.size;
+                if (a == Allocator::Slab) {
+                    size_t index = SlabAllocator::class_index(h.size);
+                    held += index < SlabAllocator::NUM_CLASSES ? SlabAllocator::class_size(index)
+                                                               : h.size;
+                } else if (h.pooled) {
+                    held += pool.block_size();
+                } else {
+                    held += h.size;   // Plus malloc's own header and rounding
+                }
+                give(h);
+            }
+            requested_total.fetch_add(requested);
+            held_total.fetch_add(held);
+        });
+    }
+    while (ready.load() < num_threads) std::this_thread::yield();
+    go.store(true);
+    for (auto& thread : threads) thread.join();
+
+    uint64_t upstream = pool_misses.load() + slab.oversize_allocations();
+    for (size_t i = 0; i < SlabAllocator::NUM_CLASSES; ++i) {
+        upstream += slab.class_stats(i).fallbacks;
+    }
+    double pairs = static_cast<double>(STEPS_PER_THREAD * num_threads);
+    double takes = pairs + static_cast<double>(WINDOW * num_threads);
+    return {cpu_total.load() / pairs,
+            static_cast<double>(held_total.load()) / requested_total.load(),
+            a == Allocator::Malloc ? 100.0 : 100.0 * upstream / takes};
+}
+
+// Build and tear down a 200-symbol subscription from its request vector
+static double run_containers(std::pmr::memory_resource* resource) {
+    constexpr size_t ROUNDS = 20000;
+    constexpr uint16_t SYMBOLS = 200;
+    double t0 = thread_cpu_ns();
+    for (size_t r = 0; r < ROUNDS; ++r) {
+        std::pmr::vector<uint16_t> request(SYMBOLS, resource);
+        for (uint16_t i = 0; i < SYMBOLS; ++i) {
+            request[i] = static_cast<uint16_t>((i * 7 + r) % 1000);
+        }
+        std::pmr::unordered_set<uint16_t> subscribed(request.begin(), request.end(), 0, {}, {},
+                                                     resource);
+        if (subscribed.empty()) std::abort();
+    }
+    return (thread_cpu_ns() - t0) / ROUNDS;
+}
+
+int main() {
+    std::cout << "=== Slab Allocator Benchmark ===\n";
+    std::cout << STEPS_PER_THREAD << " replacements per thread in a window of " << WINDOW
+              << " live allocations, sizes 8B-64KB\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "threads  allocator           cpu ns/pair  held/requested  to malloc %\n";
+    for (size_t threads : {1, 2, 4}) {
+        for (Allocator a : {Allocator::Malloc, Allocator::Pool, Allocator::Slab}) {
+            Result r = run(a, threads);
+            std::cout << std::setw(7) << threads << "  " << std::left << std::setw(20) << name(a)
+                      << std::right << std::setw(11) << r.cpu_ns_per_pair
+                      << std::setw(16) << r.held_per_requested
+                      << std::setw(13) << r.upstream_pct << "\n";
+        }
+    }
+
+    std::cout << "\nSubscription set of 200 symbols, built and destroyed\n";
+    std::cout << "resource                   cpu ns/set\n";
+    std::pmr::unsynchronized_pool_resource std_pool;
+    SlabAllocator slab;
+    struct {
+        const char* label;
+        std::pmr::memory_resource* resource;
+    } resources[] = {
+        {"new/delete", std::pmr::new_delete_resource()},
+        {"unsynchronized_pool", &std_pool},
+        {"slab", &slab},
+    };
+    for (auto& r : resources) {
+        run_containers(r.resource);   // Warm up
+        std::cout << std::left << std::setw(25) << r.label << std::right << std::setw(12)
+                  << run_containers(r.resource) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Full-cache snapshot benchmark
+// Compares a published cross-symbol snapshot with stitching per-symbol
+// reads, and measures the writer's cost of publishing at 500K updates/sec
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <ctime>
+#include "../include/cache.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void fill(SymbolCache& cache) {
+    for (uint16_t s = 0; s < MAX_SYMBOLS; ++s) {
+        cache.update_quote(s, 100.0 + s, 100, 100.05 + s, 200, s);
+        cache.update_trade(s, 100.02 + s, 10, s);
+    }
+}
+
+struct WriterResult {
+    double ns_per_update;
+    uint64_t publishes;
+    uint64_t reads;
+    double read_ns;
+};
+
+// Writer applies 500K updates/sec in bursts of 100 every 200us, publishing
+// every publish_interval (0 = never); a reader takes a snapshot every 100us
+static WriterResult run_writer(std::chrono::microseconds publish_interval) {
+    constexpr size_t BURST = 100;
+    constexpr auto BURST_INTERVAL = std::chrono::microseconds(200);
+    constexpr auto DURATION = std::chrono::seconds(2);
+
+    auto cache = std::make_unique<SymbolCache>();
+    fill(*cache);
+    if (publish_interval.count() > 0) {
+        cache->publish_snapshot();
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> read_time{0};
+    std::thread reader([&]() {
+        auto snap = std::make_unique<CacheSnapshot>();
+        while (!done.load()) {
+            auto t0 = Clock::now();
+            if (cache->read_snapshot(*snap)) {
+                read_time.fetch_add(static_cast<uint64_t>(elapsed_ns(t0)));
+                reads.fetch_add(1);
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    double cpu = 0;
+    uint64_t updates = 0;
+    uint64_t publishes = 0;
+    auto start = Clock::now();
+    auto next = start;
+    auto last_publish = start;
+    uint16_t symbol = 0;
+    while (Clock::now() - start < DURATION) {
+        double t0 = thread_cpu_ns();
+        for (size_t i = 0; i < BURST; ++i) {
+            double px = 100.0 + (updates % 100) * 0.05;
+            cache->update_quote(symbol, px, 100, px + 0.05, 200, updates);
+            symbol = static_cast<uint16_t>((symbol + 1) % MAX_SYMBOLS);
+            updates++;
+        }
+        auto now = Clock::now();
+        if (publish_interval.count() > 0 && now - last_publish >= publish_interval) {
+            cache->publish_snapshot();
+            last_publish = now;
+            publishes++;
+        }
+        cpu += thread_cpu_ns() - t0;
+
+        next += BURST_INTERVAL;
+        std::this_thread::sleep_until(next);
+    }
+
+    done.store(true);
+    reader.join();
+
+    uint64_t r = reads.load();
+    return {cpu / updates, publishes, r, r ? static_cast<double>(read_time.load()) / r : 0.0};
+}
+
+int main() {
+    constexpr size_t ITERATIONS = 20000;
+
+    std::cout << "=== Full-Cache Snapshot Benchmark (" << MAX_SYMBOLS << " symbols) ===\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    auto cache = std::make_unique<SymbolCache>();
+    fill(*cache);
+    auto snap = std::make_unique<CacheSnapshot>(MAX_SYMBOLS);
+
+    // Stitching per-symbol SeqLock reads (what callers did before)
+    auto start = Clock::now();
+    for (size_t it = 0; it < ITERATIONS; ++it) {
+        for (uint16_t s = 0; s < MAX_SYMBOLS; ++s) {
+            snap->states[s] = cache->get_snapshot(s);
+        }
+    }
+    std::cout << "stitched get_snapshot x" << MAX_SYMBOLS << ": "
+              << elapsed_ns(start) / ITERATIONS << " ns (not consistent)\n";
+
+    start = Clock::now();
+    for (size_t it = 0; it < ITERATIONS; ++it) {
+        cache->publish_snapshot();
+    }
+    std::cout << "publish_snapshot:          " << elapsed_ns(start) / ITERATIONS
+              << " ns (writer)\n";
+
+    start = Clock::now();
+    for (size_t it = 0; it < ITERATIONS; ++it) {
+        cache->read_snapshot(*snap);
+    }
+    std::cout << "read_snapshot:             " << elapsed_ns(start) / ITERATIONS
+              << " ns (reader)\n";
+
+    volatile uint64_t sink = 0;
+    start = Clock::now();
+    for (size_t it = 0; it < ITERATIONS; ++it) {
+        sink = sink + cache->get_total_updates();
+    }
+    std::cout << "get_total_updates:         " << elapsed_ns(start) / ITERATIONS
+              << " ns\n";
+
+    std::cout << "\nWriter at 500K updates/sec, reader snapshot every 100us:\n";
+    std::cout << "publish every   writer ns/update   publishes   reads   read ns\n";
+    for (auto interval : {std::chrono::microseconds(0), std::chrono::microseconds(1000),
+                          std::chrono::microseconds(100)}) {
+        WriterResult r = run_writer(interval);
+        std::cout << std::setw(13)
+                  << (interval.count() ? std::to_string(interval.count()) + "us" : "never")
+                  << std::setw(19) << r.ns_per_update << std::setw(12) << r.publishes
+                  << std::setw(8) << r.reads << std::setw(10) << r.read_ns << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Exchange simulator steady state: tick generation alone, then the whole
+// simulator run loop serving four loopback TCP clients at 100K ticks/s,
+// with and without a delayed redundant line. Reports generator ns per
+// tick, the simulator thread's CPU ns per tick, and heap allocations per
+// 1000 ticks across the process once warmed up (the reader thread makes
+// none of its own).
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/alloc_counter.h"
+#include "../include/exchange_simulator.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t GENERATOR_TICKS = 5000000;
+static constexpr size_t CLIENTS = 4;
+static constexpr auto WARMUP = std::chrono::milliseconds(1200);
+static constexpr auto MEASURE = std::chrono::milliseconds(3000);
+
+static double cpu_ns(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double run_generator() {
+    TickGenerator gen(100);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    volatile uint8_t sink = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < GENERATOR_TICKS; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        sink = static_cast<uint8_t>(sink + buffer[size - 1]);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / GENERATOR_TICKS;
+}
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+struct LoopResult {
+    double ticks_per_sec;
+    double cpu_ns_per_tick;
+    double allocs_per_1k_ticks;
+};
+
+static LoopResult run_simulator(bool delayed_line) {
+    ExchangeSimulator sim(0, 100);
+    sim.set_tick_rate(100000);
+    if (delayed_line) {
+        LineFaults faults;
+        faults.delay_us = 2000;
+        sim.set_line_faults(0, faults);
+    }
+    sim.start();
+    std::thread runner([&sim]() { sim.run(); });
+    clockid_t sim_clock;
+    pthread_getcpuclockid(runner.native_handle(), &sim_clock);
+
+    std::vector<int> fds;
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        fds.push_back(connect_client(sim.port()));
+    }
+    MessageParser parser;   // Counts ticks on the first client
+    static uint8_t block[64 * 1024];
+    auto pump = [&](std::chrono::milliseconds duration) {
+        auto end = Clock::now() + duration;
+        while (Clock::now() < end) {
+            for (size_t i = 0; i < fds.size(); ++i) {
+                ssize_t n;
+                while ((n = recv(fds[i], block, sizeof(block), 0)) > 0) {
+                    if (i == 0) parser.parse_buffer(block, static_cast<size_t>(n));
+                }
+            }
+            usleep(200);
+        }
+    };
+
+    pump(WARMUP);
+    uint64_t ticks_before = parser.messages_parsed();
+    uint64_t allocs_before = process_allocations().allocations;
+    double cpu_before = cpu_ns(sim_clock);
+    auto start = Clock::now();
+    pump(MEASURE);
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    double cpu = cpu_ns(sim_clock) - cpu_before;
+    uint64_t allocs = process_allocations().allocations - allocs_before;
+    double ticks = static_cast<double>(parser.messages_parsed() - ticks_before);
+
+    sim.stop();
+    runner.join();
+    for (int fd : fds) close(fd);
+    return {ticks / secs, cpu / ticks, 1000.0 * allocs / ticks};
+}
+
+int main() {
+    std::cout << "=== Simulator Steady State Benchmark ===\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "Tick generator: " << run_generator() << " ns/tick over "
+              << GENERATOR_TICKS << " ticks\n\n";
+
+    std::cout << CLIENTS << " TCP clients at 100K ticks/s, "
+              << std::chrono::duration<double>(MEASURE).count() << "s after "
+              << std::chrono::duration<double>(WARMUP).count() << "s warm-up\n";
+    std::cout << "line          ticks/s   sim cpu ns/tick  allocs/1k ticks\n";
+    for (bool delayed : {false, true}) {
+        LoopResult r = run_simulator(delayed);
+        std::cout << std::left << std::setw(10) << (delayed ? "delayed" : "direct") << std::right
+                  << std::setw(11) << r.ticks_per_sec
+                  << std::setw(18) << r.cpu_ns_per_tick
+                  << std::setw(17) << r.allocs_per_1k_ticks << "\n";
+    }
+    return 0;
+}
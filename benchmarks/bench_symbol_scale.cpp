@@ -0,0 +1,80 @@
+// Symbol-universe scaling benchmark
+// SymbolCache update, read and full-snapshot cost at 500, 5000 and 50000
+// symbols, with the page backing the entry table actually received. Random
+// symbol order so larger universes stress the TLB as well as the caches
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <vector>
+#include "../include/cache.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t OPS = 4000000;
+
+static double elapsed_ns(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static void run(size_t symbols, CacheLayout layout, const char* layout_name) {
+    auto cache = std::make_unique<SymbolCache>(symbols, layout);
+    for (size_t s = 0; s < symbols; ++s) {
+        cache->update_quote(static_cast<uint16_t>(s), 100.0, 100, 100.05, 200, s);
+    }
+
+    std::vector<uint16_t> order(1 << 16);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, symbols - 1);
+    for (auto& s : order) s = static_cast<uint16_t>(pick(rng));
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < OPS; ++i) {
+        double px = 100.0 + (i & 63) * 0.05;
+        cache->update_quote(order[i & (order.size() - 1)], px, 100, px + 0.05, 200, i);
+    }
+    double update_ns = elapsed_ns(start) / OPS;
+
+    volatile double sink = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < OPS; ++i) {
+        sink = sink + cache->get_snapshot(order[i & (order.size() - 1)]).best_bid;
+    }
+    double read_ns = elapsed_ns(start) / OPS;
+
+    // Keep the total copied roughly constant across sizes
+    size_t publishes = std::max<size_t>(20, 10000000 / symbols);
+    start = Clock::now();
+    for (size_t i = 0; i < publishes; ++i) {
+        cache->publish_snapshot();
+    }
+    double publish_us = elapsed_ns(start) / publishes / 1000;
+
+    auto snap = std::make_unique<CacheSnapshot>(symbols);
+    start = Clock::now();
+    for (size_t i = 0; i < publishes; ++i) {
+        cache->read_snapshot(*snap);
+    }
+    double read_snap_us = elapsed_ns(start) / publishes / 1000;
+
+    std::cout << std::setw(7) << symbols << "  " << std::left << std::setw(9) << layout_name
+              << std::setw(9) << backing_name(cache->backing()) << std::right
+              << std::setw(9) << update_ns << std::setw(9) << read_ns
+              << std::setw(12) << publish_us << std::setw(12) << read_snap_us << "\n";
+}
+
+int main() {
+    std::cout << "=== Symbol Scale Benchmark ===\n";
+    std::cout << "sizeof(SymbolEntry)=" << sizeof(SymbolEntry)
+              << " sizeof(CompactEntry<double>)=" << sizeof(CompactEntry<double>) << "\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "symbols  layout   backing  update ns  read ns  publish us  read snap us\n";
+    for (size_t symbols : {500, 5000, 50000}) {
+        run(symbols, CacheLayout::Wide, "wide");
+        run(symbols, CacheLayout::Compact, "compact");
+    }
+    return 0;
+}
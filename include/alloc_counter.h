@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mdf {
+
+// Heap allocation counter for tests and benchmarks
+// Linking src/common/alloc_counter.cpp replaces the global operator new
+// and delete with versions that count every allocation made through them,
+// per thread and process-wide, and can call a hook on each one. Replacing
+// them is a whole-program decision, so only test and benchmark targets
+// link it; the binaries keep the default allocator. Direct malloc() calls
+// are not counted.
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+// Allocations made by the calling thread so far
+AllocationCounts thread_allocations();
+
+// Allocations made by all threads so far
+AllocationCounts process_allocations();
+
+// Called with the size of every counted allocation, on the allocating
+// thread, until replaced; nullptr removes it. The hook must not allocate.
+// A hook that aborts stops a steady-state test at the offending call.
+using AllocationHook = void (*)(std::size_t size);
+void set_allocation_hook(AllocationHook hook);
+
+// Allocations made by the calling thread since construction
+class AllocationScope {
+public:
+    AllocationScope() : start_(thread_allocations()) {}
+
+    uint64_t allocations() const {
+        return thread_allocations().allocations - start_.allocations;
+    }
+    uint64_t bytes() const { return thread_allocations().bytes - start_.bytes; }
+
+private:
+    AllocationCounts start_;
+};
+
+} // namespace mdf
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "huge_pages.h"
+#include "protocol.h"
+
+namespace mdf {
+
+// One OHLCV bar; start_ns is the interval start (0 = no bar yet)
+struct Bar {
+    uint64_t start_ns = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    uint64_t volume = 0;
+    uint32_t trades = 0;
+};
+
+enum class BarInterval : uint8_t { Second, Minute };
+
+constexpr uint64_t bar_interval_ns(BarInterval interval) {
+    return interval == BarInterval::Second ? 1000000000ULL : 60000000000ULL;
+}
+
+// Derived per-symbol analytics at one point in time
+struct Analytics {
+    double vwap = 0.0;          // Session VWAP, 0 before the first trade
+    uint64_t volume = 0;        // Session traded quantity
+    uint64_t trades = 0;
+    double volatility = 0.0;    // EWMA std dev of trade-to-trade returns
+    double mid = 0.0;           // From the latest quote, 0 before one
+    double spread = 0.0;
+    Bar second_bar;             // Bars in progress
+    Bar minute_bar;
+};
+
+// Incremental analytics fed from the trade and quote stream
+//
+// Every update is O(1): VWAP and volume are running sums, volatility is an
+// exponentially weighted variance of per-trade returns, and OHLCV bars
+// roll over in a fixed ring per symbol and interval when a trade's
+// timestamp crosses an interval boundary (intervals with no trades leave
+// no bar). All storage is preallocated.
+//
+// Single writer (feed thread); readers use the same per-symbol SeqLock
+// as SymbolCache, so a read never sees half an update.
+class AnalyticsEngine {
+public:
+    static constexpr size_t DEFAULT_BAR_HISTORY = 16;
+    static constexpr double VOLATILITY_DECAY = 0.94;   // RiskMetrics lambda
+
+    explicit AnalyticsEngine(size_t num_symbols = MAX_SYMBOLS,
+                             size_t bar_history = DEFAULT_BAR_HISTORY);
+
+    // Writer side
+    void on_trade(uint16_t symbol_id, double price, uint32_t quantity, uint64_t timestamp_ns);
+    void on_quote(uint16_t symbol_id, double bid_price, double ask_price);
+
+    // Reader side (lock-free)
+    Analytics get(uint16_t symbol_id) const;
+
+    // Most recent bars for one interval, newest (in progress) first
+    size_t get_bars(uint16_t symbol_id, BarInterval interval, Bar* out, size_t max_bars) const;
+
+    void reset();
+
+    size_t num_symbols() const { return num_symbols_; }
+    size_t bar_history() const { return bar_history_; }
+
+private:
+    static constexpr size_t NUM_INTERVALS = 2;
+
+    struct alignas(64) Entry {
+        std::atomic<uint64_t> sequence{0};
+        double pv_sum = 0.0;            // Sum of price * quantity
+        uint64_t volume = 0;
+        uint64_t trades = 0;
+        double last_price = 0.0;
+        double variance = 0.0;
+        double mid = 0.0;
+        double spread = 0.0;
+        uint16_t bar_head[NUM_INTERVALS] = {};     // Ring slot of the bar in progress
+        uint16_t bar_count[NUM_INTERVALS] = {};
+    };
+
+    size_t num_symbols_;
+    size_t bar_history_;
+    HugeArray<Entry> entries_;
+    HugeArray<Bar> bars_;   // [symbol][interval][bar_history]
+
+    Bar* ring(uint16_t symbol_id, size_t interval) {
+        return &bars_[(symbol_id * NUM_INTERVALS + interval) * bar_history_];
+    }
+    const Bar* ring(uint16_t symbol_id, size_t interval) const {
+        return &bars_[(symbol_id * NUM_INTERVALS + interval) * bar_history_];
+    }
+
+    void update_bar(Entry& entry, uint16_t symbol_id, size_t interval,
+                    double price, uint32_t quantity, uint64_t timestamp_ns);
+};
+
+} // namespace mdf
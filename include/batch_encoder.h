@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "protocol.h"
+
+namespace mdf {
+
+// Builds one batched packet from complete (v1 or v2) messages
+// The per-message header is replaced by an 8-byte delta record and the
+// per-message checksum by a single packet checksum.
+class BatchEncoder {
+public:
+    BatchEncoder(size_t max_packet_size = MAX_BATCH_PACKET_SIZE);
+
+    // Append a complete message (header + payload + checksum)
+    // Returns false if the message doesn't fit or can't be delta-encoded
+    // against the current batch - flush and retry in that case
+    bool append(const uint8_t* msg, size_t len);
+
+    // Write packet header and checksum, returns packet size (0 if empty)
+    size_t finish();
+
+    const uint8_t* data() const { return buffer_.data(); }
+    size_t size() const { return write_pos_; }
+    size_t message_count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // Start a new packet
+    void clear();
+
+private:
+    std::array<uint8_t, MAX_BATCH_PACKET_SIZE> buffer_;
+    size_t max_size_;
+    size_t write_pos_ = BATCH_HEADER_SIZE;
+    uint16_t count_ = 0;
+
+    uint32_t base_sequence_ = 0;
+    uint64_t base_timestamp_ = 0;
+    uint32_t last_sequence_ = 0;
+    uint64_t last_timestamp_ = 0;
+};
+
+} // namespace mdf
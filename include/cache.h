@@ -3,6 +3,10 @@
 #include <atomic>
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "huge_pages.h"
 #include "protocol.h"
 
 namespace mdf {
@@ -21,18 +25,70 @@ struct alignas(64) MarketState {
 };
 
 // Single symbol entry with SeqLock for lock-free reads
-// Aligned to cache line to prevent false sharing
+// Aligned to cache line to prevent false sharing; MarketState's own
+// alignment puts the sequence and the state on separate lines
 struct alignas(128) SymbolEntry {
     std::atomic<uint64_t> sequence{0};  // Odd = writing, Even = valid
     MarketState state;
-    char padding[128 - sizeof(std::atomic<uint64_t>) - sizeof(MarketState)];
+};
+static_assert(sizeof(SymbolEntry) == 128, "SymbolEntry should span two cache lines");
+
+// Hot fields of a single symbol in one cache line (sequence included)
+// opening_price is written once, so it lives in a separate cold array
+// Price is double, or int32_t paisa as on the v2 wire
+template <typename Price>
+struct alignas(64) CompactEntry {
+    std::atomic<uint32_t> sequence{0};  // Odd = writing, Even = valid
+    uint32_t bid_quantity = 0;
+    uint32_t ask_quantity = 0;
+    uint32_t last_traded_quantity = 0;
+    uint32_t has_opening = 0;           // Cold opening price has been set
+    Price best_bid = 0;
+    Price best_ask = 0;
+    Price last_traded_price = 0;
+    uint64_t last_update_time = 0;
+    uint64_t update_count = 0;
+};
+static_assert(sizeof(CompactEntry<double>) == 64, "CompactEntry must fit one cache line");
+static_assert(sizeof(CompactEntry<int32_t>) == 64, "CompactEntry must fit one cache line");
+
+// Per-symbol storage used by SymbolCache
+enum class CacheLayout : uint8_t {
+    Wide,           // SymbolEntry: 128 bytes, sequence and state on separate lines
+    Compact,        // CompactEntry<double>: one line per symbol
+    CompactFixed    // CompactEntry<int32_t>: one line, prices rounded to paisa
+};
+
+// Who may write a symbol concurrently
+enum class WriterMode : uint8_t {
+    Single,         // One writer thread for the whole cache
+    Partitioned,    // Several writers, each symbol owned by exactly one of them
+    Shared          // Any writer may update any symbol (CAS on the sequence)
+};
+
+// Point-in-time copy of every symbol, published by the writer
+struct CacheSnapshot {
+    uint64_t epoch = 0;             // Publish counter (0 = never published)
+    uint64_t total_updates = 0;     // Sum of update_count at publish time
+    size_t num_symbols = 0;
+    std::vector<MarketState> states;    // Indexed by symbol id
+    
+    CacheSnapshot() = default;
+    explicit CacheSnapshot(size_t capacity) : states(capacity) {}
 };
 
 // Lock-free symbol cache using SeqLock pattern
-// Single writer (feed handler), multiple readers (visualization)
+// Holds symbol ids [0, num_symbols), num_symbols up to MAX_SYMBOL_CAPACITY;
+// entries are one contiguous hugepage-backed table indexed by id
+// Single writer (feed handler) by default, multiple readers (visualization);
+// see WriterMode for sharded feed threads
 class SymbolCache {
 public:
-    SymbolCache(size_t num_symbols = MAX_SYMBOLS);
+    SymbolCache(size_t num_symbols = MAX_SYMBOLS, CacheLayout layout = CacheLayout::Wide);
+    ~SymbolCache();
+    
+    SymbolCache(const SymbolCache&) = delete;
+    SymbolCache& operator=(const SymbolCache&) = delete;
     
     // Writer methods (single writer thread)
     void update_quote(uint16_t symbol_id, double bid_price, uint32_t bid_qty,
@@ -47,6 +103,10 @@ public:
     void update_ask(uint16_t symbol_id, double price, uint32_t quantity,
                     uint64_t timestamp);
     
+    // Set before writer threads start
+    void set_writer_mode(WriterMode mode) { writer_mode_ = mode; }
+    WriterMode writer_mode() const { return writer_mode_; }
+    
     // Reader methods (lock-free, consistent snapshot)
     MarketState get_snapshot(uint16_t symbol_id) const;
     
@@ -57,18 +117,122 @@ public:
     // Get total update count across all symbols
     uint64_t get_total_updates() const;
     
+    // Writer: copy all symbols into the back snapshot buffer and make it
+    // current. Costs one copy of num_symbols states, so call it at the
+    // rate consumers need rather than per update. With several writers the
+    // copy is consistent per symbol, not across symbols.
+    void publish_snapshot();
+    
+    // Reader: copy the latest published snapshot, consistent across symbols
+    // Returns false if nothing has been published yet
+    bool read_snapshot(CacheSnapshot& out) const;
+    
+    uint64_t snapshot_epoch() const { return published_epoch_.load(std::memory_order_acquire); }
+    
+    // Change notification: each registered reader has its own dirty bitmap
+    // that the writer marks on every update, so a reader can ask which
+    // symbols changed since its last poll without scanning them all.
+    static constexpr size_t MAX_CHANGE_READERS = 8;
+    
+    // Returns reader id, or -1 if all slots are taken
+    // with_wakeup adds an fd (eventfd/pipe) for blocking consumers
+    int register_change_reader(bool with_wakeup = false);
+    void unregister_change_reader(int reader);
+    
+    // Copy ids of symbols changed since the last poll (ascending) and clear
+    // them; symbols that don't fit in max_ids stay pending
+    size_t poll_changes(int reader, uint16_t* out_ids, size_t max_ids);
+    
+    // Block until changes are pending (needs with_wakeup) or timeout
+    // Returns true if changes are pending
+    bool wait_for_changes(int reader, int timeout_ms);
+    
+    // Readable when changes are pending, for use in an external poll loop
+    int change_fd(int reader) const;
+    
     // Reset all state
     void reset();
     
     size_t num_symbols() const { return num_symbols_; }
+    CacheLayout layout() const { return layout_; }
+    
+    // Page backing of the entry table for the active layout
+    HugePageBuffer::Backing backing() const;
     
 private:
     size_t num_symbols_;
-    std::array<SymbolEntry, MAX_SYMBOLS> entries_;
+    CacheLayout layout_;
+    WriterMode writer_mode_ = WriterMode::Single;
+    
+    // Only the array for layout_ is allocated
+    HugeArray<SymbolEntry> entries_;
+    HugeArray<CompactEntry<double>> compact_;
+    HugeArray<CompactEntry<int32_t>> compact_fixed_;
+    HugeArray<double> opening_prices_;   // Cold fields for compact layouts
+    
+    // Double-buffered snapshots: publish writes buffer (epoch & 1) while
+    // readers copy the other, so a reader only retries if it is still
+    // copying when the writer publishes twice
+    struct alignas(64) SnapshotBuffer {
+        std::atomic<uint64_t> sequence{0};  // Odd = publishing
+        CacheSnapshot snapshot;
+    };
+    std::unique_ptr<SnapshotBuffer[]> snapshots_;
+    std::atomic<uint64_t> published_epoch_{0};
+    
+    // Maintained by the writer so the total is O(1) and exact
+    std::atomic<uint64_t> total_updates_{0};
+    
+    // With several writers each thread counts on its own line
+    static constexpr size_t UPDATE_STRIPES = 16;
+    struct alignas(64) UpdateStripe {
+        std::atomic<uint64_t> count{0};
+    };
+    std::array<UpdateStripe, UPDATE_STRIPES> update_stripes_;
+    
+    std::mutex publish_mutex_;   // Serializes publish_snapshot across writers
+    
+    size_t change_words_;    // Bitmap words per reader
+    
+    struct alignas(64) ChangeReader {
+        std::unique_ptr<std::atomic<uint64_t>[]> dirty;
+        std::atomic<bool> pending{false};   // Wakeup sent since last poll
+        std::atomic<bool> wakeup{false};    // Registered with_wakeup; publishes wake fds
+        int wake_fd = -1;                   // eventfd (or pipe read end)
+        int wake_write_fd = -1;             // Same as wake_fd for eventfd
+    };
+    std::array<ChangeReader, MAX_CHANGE_READERS> change_readers_;
+    std::atomic<uint32_t> claimed_readers_{0};
+    std::atomic<uint32_t> active_readers_{0};
+    
+    // Writer side: mark symbol dirty for every active reader
+    void mark_changed(uint16_t symbol_id);
+    void wake(ChangeReader& reader);
+    
+    // Apply fn(state, set_opening) to the symbol under its SeqLock, for
+    // whichever layout is active; set_opening(price) only takes the first
+    template <typename Fn>
+    void write(uint16_t symbol_id, Fn&& fn);
+    
+    template <typename Entry, typename Fn>
+    void write_compact(Entry& entry, uint16_t symbol_id, Fn& fn);
+    
+    template <typename Entry>
+    MarketState read_compact(const Entry& entry, uint16_t symbol_id) const;
+    
+    // Writer-side copy without the SeqLock
+    MarketState load_state(uint16_t symbol_id) const;
     
-    // Begin write - returns sequence to pass to end_write
-    void begin_write(uint16_t symbol_id);
-    void end_write(uint16_t symbol_id);
+    // Single writer - plain load/store, no locked increment
+    void count_update() {
+        if (writer_mode_ == WriterMode::Single) {
+            total_updates_.store(total_updates_.load(std::memory_order_relaxed) + 1,
+                                 std::memory_order_relaxed);
+        } else {
+            count_update_striped();
+        }
+    }
+    void count_update_striped();
 };
 
 } // namespace mdf
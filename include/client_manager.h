@@ -1,35 +1,89 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <cstdint>
 #include <string>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include "batch_encoder.h"
+#include "impairment.h"
+#include "memory_pool.h"
+#include "protocol.h"
+#include "slab_allocator.h"
 
 namespace mdf {
 
+// Latest-value cache for a slow consumer
+// One slot per symbol for quotes and one for trades; a dirty bitmap
+// records which slots changed while the client's socket was backed up
+struct ConflationState {
+    struct Slot {
+        uint8_t data[MAX_MSG_SIZE];
+        uint8_t size = 0;
+    };
+    
+    explicit ConflationState(size_t num_symbols)
+        : slots(num_symbols * 2), dirty((num_symbols * 2 + 63) / 64, 0) {}
+    
+    // Heap footprint for one slow client
+    size_t bytes() const {
+        return sizeof(*this) + slots.size() * sizeof(Slot) + dirty.size() * sizeof(uint64_t);
+    }
+    
+    std::vector<Slot> slots;
+    std::vector<uint64_t> dirty;
+    size_t dirty_count = 0;
+};
+
+// Bytes accepted for a client that its socket has not taken yet
+// A fixed ring of message references: a broadcast message waiting for
+// many clients is queued by reference, never copied per client. An entry
+// leaves the ring, dropping its reference, once fully written.
+struct SendQueue {
+    explicit SendQueue(size_t capacity) : entries(capacity) {}
+    
+    bool empty() const { return head == tail; }
+    bool full() const { return tail - head == entries.size(); }
+    size_t size() const { return tail - head; }
+    MessageRef& at(size_t i) { return entries[i & (entries.size() - 1)]; }
+    
+    std::vector<MessageRef> entries;    // Power-of-two capacity
+    size_t head = 0;                    // Oldest entry (free-running)
+    size_t tail = 0;                    // Next free entry (free-running)
+    size_t offset = 0;                  // Bytes of the oldest entry already written
+    size_t bytes = 0;                   // Queued bytes not yet written
+};
+
 // Client connection state
+// The cold part: touched on connect, on slow-consumer events, and when a
+// socket backs up. What every broadcast reads (fd, flags, line,
+// subscriptions, counters) lives in ClientManager's slot table.
 struct ClientConnection {
     int fd;
     std::string address;
     uint16_t port;
-    
-    // Subscription state
-    std::unordered_set<uint16_t> subscribed_symbols;
-    bool subscribe_all = true;  // By default, subscribe to all
+    uint8_t protocol_version = PROTOCOL_V1;  // Negotiated wire format
     
     // Flow control
     size_t pending_bytes = 0;           // Bytes pending in send buffer
     size_t slow_consumer_count = 0;      // Count of slow consumer events
-    bool is_slow = false;                // Currently slow
     
-    // Statistics
-    uint64_t messages_sent = 0;
-    uint64_t bytes_sent = 0;
+    // Written in order ahead of anything new; created with the connection
+    std::unique_ptr<SendQueue> queue;
+    
+    // Pending batched packet (only allocated when batching is enabled)
+    std::unique_ptr<BatchEncoder> batch;
+    
+    // Latest values held while slow (allocated on first slow event)
+    std::unique_ptr<ConflationState> conflation;
+    
+    // Injected line noise (only allocated for impaired clients)
+    std::unique_ptr<Impairer> impairer;
+    
     std::chrono::steady_clock::time_point connect_time;
-    std::chrono::steady_clock::time_point last_activity;
 };
 
 // Client manager - handles multiple client connections
@@ -38,7 +92,16 @@ public:
     static constexpr size_t MAX_SEND_BUFFER_SIZE = 4 * 1024 * 1024;  // 4MB
     static constexpr size_t SLOW_CONSUMER_THRESHOLD = 1 * 1024 * 1024;  // 1MB pending
     
-    ClientManager();
+    // Send pool: one block per queued message (larger messages span
+    // several blocks), shared by every client queue
+    static constexpr size_t MESSAGE_BLOCK_SIZE = 128;
+    static constexpr size_t MESSAGE_POOL_BLOCKS = 32 * 1024;
+    
+    // Messages queued per client before it counts as a slow consumer
+    static constexpr size_t SEND_QUEUE_DEPTH = 1024;
+    
+    // num_symbols bounds the ids that can be conflated
+    explicit ClientManager(size_t num_symbols = MAX_SYMBOLS);
     ~ClientManager();
     
     // Add new client connection
@@ -50,20 +113,102 @@ public:
     // Check if client exists
     bool has_client(int fd) const;
     
-    // Get client info
+    // Get client info; valid until the next add_client() or remove_client()
     const ClientConnection* get_client(int fd) const;
     
+    // Per-client state from the slot table (false/0 for an unknown fd)
+    bool is_slow(int fd) const;
+    uint64_t client_messages_sent(int fd) const;
+    uint64_t client_bytes_sent(int fd) const;
+    
     // Handle subscription request from client
     bool handle_subscription(int fd, const uint16_t* symbol_ids, size_t count);
     
+    // Set negotiated protocol version for client
+    bool set_protocol_version(int fd, uint8_t version);
+    
+    // Set the redundant line the client belongs to
+    bool set_line(int fd, uint8_t line);
+    
+    // Buffer for a message of up to size bytes from the send pool; fill
+    // it, resize() it to what was written, and broadcast it
+    MessageRef allocate_message(size_t size = MAX_MSG_SIZE) {
+        return MessageRef::allocate(message_pool_, size);
+    }
+    
     // Broadcast message to all subscribed clients
-    // Returns number of clients that received the message
-    size_t broadcast(const void* data, size_t len, uint16_t symbol_id);
+    // If v2 is given, clients on protocol v2 receive it instead of msg
+    // line >= 0 limits it to clients on that line. Clients whose socket is
+    // backed up queue a reference to the message rather than a copy.
+    // Returns number of clients that received (or queued) the message
+    size_t broadcast(const MessageRef& msg, uint16_t symbol_id,
+                     const MessageRef& v2 = MessageRef(), int line = -1);
+    
+    // Same, for a message not in the send pool (copied in once if needed)
+    size_t broadcast(const void* data, size_t len, uint16_t symbol_id,
+                     const void* v2_data = nullptr, size_t v2_len = 0,
+                     int line = -1);
     
     // Send to specific client (non-blocking)
-    // Returns true if all bytes were sent, false if partial/blocked
+    // Returns true if all bytes were sent or queued behind earlier ones,
+    // false if the client is backed up or gone
     bool send_to_client(int fd, const void* data, size_t len);
     
+    // Send to every client (on line, if line >= 0) whatever its
+    // subscription or slow state, as heartbeats go; queued by reference
+    // where a socket is backed up. Returns clients that took it
+    size_t send_to_all(const MessageRef& msg, int line = -1);
+    
+    // Write queued bytes to every client whose socket has room, releasing
+    // messages as they complete; returns bytes written
+    size_t flush_send_queues();
+    size_t queued_clients() const { return queued_clients_; }
+    const MemoryPool& message_pool() const { return message_pool_; }
+    
+    // Small variable-size allocations: subscription request scratch and
+    // queued copies of packets larger than a send block
+    SlabAllocator& slab() { return slab_; }
+    const SlabAllocator& slab() const { return slab_; }
+    
+    // Batch messages per client instead of sending each one immediately
+    // Batches go out on flush_batches() or when a packet fills up
+    void set_batching(bool enable) { batching_ = enable; }
+    bool batching_enabled() const { return batching_; }
+    
+    // Send all pending batches, returns number of packets sent
+    size_t flush_batches();
+    
+    // Conflate quotes/trades for slow clients instead of dropping them
+    // Once the socket drains, the client gets the newest state of every
+    // symbol that changed (depth updates can't be conflated and are dropped)
+    void set_conflation(bool enable) { conflation_ = enable; }
+    bool conflation_enabled() const { return conflation_; }
+    
+    // Clear slow status of clients whose socket drained and send them
+    // any conflated state, returns number of messages sent
+    size_t drain_slow_clients();
+    
+    // Impair the TCP stream of clients added from now on (connection n
+    // gets seed config.seed + n), or of the nth client to connect (counting
+    // from 0), or of one connected client
+    void set_default_impairments(const ImpairmentConfig& config) { default_impairments_ = config; }
+    void set_connection_impairments(size_t connection, const ImpairmentConfig& config);
+    bool set_client_impairments(int fd, const ImpairmentConfig& config);
+    
+    // Send impaired bytes whose stall or hold is over, returns bytes sent
+    size_t release_impairments(std::chrono::steady_clock::time_point now);
+    
+    // Clients whose connection an injected reset broke; the caller removes
+    // them (closing with SO_LINGER 0 sends the RST)
+    bool has_pending_resets() const { return !pending_resets_.empty(); }
+    std::vector<int> take_pending_resets();
+    
+    size_t impaired_client_count() const { return impaired_clients_; }
+    ImpairmentStats impairment_stats() const;
+    
+    uint64_t conflated_messages() const { return conflated_messages_; }
+    uint64_t dropped_messages() const { return dropped_messages_; }
+    
     // Get list of all client FDs
     std::vector<int> get_all_client_fds() const;
     
@@ -77,7 +222,8 @@ public:
     void clear_slow_status(int fd);
     
     // Statistics
-    size_t client_count() const { return clients_.size(); }
+    size_t client_count() const { return slot_fds_.size(); }
+    size_t v2_client_count() const { return v2_client_count_; }
     uint64_t total_messages_sent() const { return total_messages_sent_.load(); }
     uint64_t total_bytes_sent() const { return total_bytes_sent_.load(); }
     
@@ -85,14 +231,103 @@ public:
     void set_slow_threshold(size_t bytes) { slow_threshold_ = bytes; }
     
 private:
-    std::unordered_map<int, ClientConnection> clients_;
+    // Hot flags, one byte per slot
+    static constexpr uint8_t SUBSCRIBE_ALL = 1 << 0;  // Default until a subscription
+    static constexpr uint8_t V2 = 1 << 1;             // Negotiated protocol v2
+    static constexpr uint8_t SLOW = 1 << 2;           // Currently slow
+    static constexpr uint8_t RESET = 1 << 3;          // Reset injected, awaiting removal
+    static constexpr uint8_t IMPAIRED = 1 << 4;       // Has an impairer
+    
+    // Declared ahead of the clients so messages still queued to them go
+    // back before the pool and slab are destroyed
+    MemoryPool message_pool_;
+    SlabAllocator slab_;
+    
+    // Clients in dense slots 0..client_count()-1, found by fd through
+    // slot_of_fd_. The fields a broadcast reads for every client are
+    // split into parallel arrays (structure of arrays) so the scan runs
+    // linearly through a few bytes per client; connections_ holds the
+    // cold rest. Removing a client moves the last slot into its place.
+    std::vector<int32_t> slot_of_fd_;           // -1: no client on that fd
+    std::vector<int> slot_fds_;
+    std::vector<uint8_t> slot_flags_;
+    std::vector<uint8_t> slot_lines_;           // Redundant line it connected on
+    std::vector<uint64_t> slot_subscriptions_;  // subscription_words_ per slot
+    std::vector<uint64_t> slot_messages_;       // Messages sent
+    std::vector<uint64_t> slot_bytes_;          // Bytes sent
+    std::vector<ClientConnection> connections_;
+    
     size_t slow_threshold_ = SLOW_CONSUMER_THRESHOLD;
+    size_t v2_client_count_ = 0;
+    bool batching_ = false;
+    size_t num_symbols_;
+    size_t subscription_words_;         // Bitmap words per client
+    bool conflation_ = false;
+    
+    uint64_t conflated_messages_ = 0;   // Overwritten in a slot before delivery
+    uint64_t dropped_messages_ = 0;     // Not delivered to a slow client at all
+    std::vector<std::pair<uint32_t, uint32_t>> drain_order_;  // (sequence, slot)
+    
+    ImpairmentConfig default_impairments_;
+    std::unordered_map<size_t, ImpairmentConfig> connection_impairments_;
+    size_t connections_accepted_ = 0;
+    size_t impaired_clients_ = 0;
+    std::vector<int> pending_resets_;
+    ImpairmentStats retired_impairments_;  // From clients since removed
     
     std::atomic<uint64_t> total_messages_sent_{0};
     std::atomic<uint64_t> total_bytes_sent_{0};
     
+    size_t queued_clients_ = 0;         // Clients with a non-empty send queue
+    
     // Check socket send buffer status
     size_t get_pending_bytes(int fd) const;
+    
+    // Slot of fd, or -1
+    int32_t slot_of(int fd) const {
+        return fd >= 0 && static_cast<size_t>(fd) < slot_of_fd_.size() ? slot_of_fd_[fd] : -1;
+    }
+    
+    bool subscribed(size_t slot, uint16_t symbol_id) const {
+        if (slot_flags_[slot] & SUBSCRIBE_ALL) return true;
+        if (symbol_id >= num_symbols_) return false;
+        uint64_t word = slot_subscriptions_[slot * subscription_words_ + symbol_id / 64];
+        return (word >> (symbol_id % 64)) & 1;
+    }
+    
+    void mark_slow(size_t slot);
+    
+    // broadcast() for messages with (or without) a pooled copy
+    size_t deliver(const void* data, size_t len, const MessageRef* msg, uint16_t symbol_id,
+                   const void* v2_data, size_t v2_len, const MessageRef* v2, int line);
+    
+    // send_to_client() past the impairments; msg, if given, holds data
+    // and is queued by reference instead of copying what doesn't go out
+    bool write_to_client(size_t slot, const void* data, size_t len,
+                         const MessageRef* msg = nullptr);
+    
+    // Queue data[offset, len) behind the client's earlier bytes
+    bool enqueue(ClientConnection& client, const uint8_t* data, size_t len,
+                 const MessageRef* msg, size_t offset);
+    
+    // Write as much of the client's queue as the socket takes
+    size_t flush_queue(size_t slot);
+    
+    // send_to_client() for a slot: through its impairer, if any
+    bool send_to_slot(size_t slot, const void* data, size_t len);
+    bool send_impaired(size_t slot, const void* data, size_t len);
+    
+    // Add message to client's batch, flushing first if it doesn't fit
+    bool append_to_batch(size_t slot, const void* data, size_t len);
+    
+    // Send client's pending batch, returns bytes sent
+    size_t flush_client_batch(size_t slot);
+    
+    // Store message in slow client's latest-value slot
+    void conflate(ClientConnection& client, const void* data, size_t len);
+    
+    // Send dirty slots in sequence order, returns messages sent
+    size_t send_conflated(size_t slot);
 };
 
 } // namespace mdf
@@ -0,0 +1,41 @@
+#pragma once
+
+#ifndef USE_KQUEUE
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mdf {
+
+// Pin the calling thread to one CPU core; false if unsupported or the
+// core is not in the process's allowed set. A negative core is a no-op.
+inline bool pin_current_thread(int core) {
+    if (core < 0) {
+        return true;
+    }
+#ifndef USE_KQUEUE
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;   // macOS has affinity hints only, not pinning
+#endif
+}
+
+// NUMA node of the CPU the calling thread is running on (pin it first for
+// an answer that stays true); 0 where unknown
+inline int current_numa_node() {
+#if !defined(USE_KQUEUE) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return 0;
+}
+
+} // namespace mdf
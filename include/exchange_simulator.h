@@ -2,13 +2,26 @@
 
 #include <cstdint>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <functional>
+#include <random>
+#include <thread>
+#include <vector>
 #include "tick_generator.h"
+#include "tick_ring.h"
 #include "client_manager.h"
+#include "udp_publisher.h"
 
 namespace mdf {
 
+// Impairments for one redundant line, drawn from the line's own seed
+struct LineFaults {
+    double drop_rate = 0.0;   // Chance each message is not sent on the line
+    uint32_t delay_us = 0;    // Held this long before sending (1ms loop resolution)
+    uint64_t seed = 1;
+};
+
 class ExchangeSimulator {
 public:
     // Initialize with port and symbol count
@@ -28,13 +41,56 @@ public:
     void set_tick_rate(uint32_t ticks_per_second);
     void enable_fault_injection(bool enable);
     void set_market_condition(TickGenerator::MarketCondition condition);
+    void set_depth_levels(size_t levels);
+    void enable_batching(bool enable);
+    void enable_conflation(bool enable);
+    
+    // Send ticks over UDP instead of TCP (TCP still carries heartbeats
+    // and retransmissions). Call once per unicast endpoint, or once with
+    // a multicast group address.
+    bool add_udp_destination(const std::string& address, uint16_t port,
+                             const std::string& interface_addr = "127.0.0.1");
+    
+    // Redundant (A/B) lines: publish the same sequenced TCP stream on
+    // another port. The main port is line 0. Every line drops and delays
+    // independently. Call before start().
+    bool add_line(uint16_t port, const LineFaults& faults = LineFaults{});
+    void set_line_faults(size_t line, const LineFaults& faults);
+    size_t line_count() const { return lines_.empty() ? 1 : lines_.size(); }
+    uint64_t line_dropped(size_t line) const;
+    
+    // Line noise on client TCP streams (see ImpairmentConfig): for every
+    // client, or for the nth client to connect (counting from 0), which
+    // overrides it. Ticks, batches, heartbeats and retransmissions are all
+    // impaired; UDP datagrams are not. Call before clients connect.
+    void set_impairments(const ImpairmentConfig& config);
+    void set_connection_impairments(size_t connection, const ImpairmentConfig& config);
+    ImpairmentStats impairment_stats() const;
+    
+    // Accept and fan out on n worker threads instead of the tick thread
+    // (epoll only). Each worker has its own SO_REUSEPORT listener on the
+    // port, so the kernel spreads connections across them, and its own
+    // epoll instance and client manager. The tick thread generates each
+    // message once into a shared TickRing that every worker reads at its
+    // own pace. Not with UDP mode, redundant lines or impairments. Call
+    // before start(); the disconnect callback then runs on the workers.
+    bool set_workers(size_t n);
+    size_t worker_count() const { return workers_.size(); }
+    
+    // Ring messages workers lost by falling a whole ring behind
+    uint64_t ring_overruns() const;
     
     // Statistics
     uint64_t messages_sent() const { return messages_sent_.load(); }
     uint64_t total_bytes_sent() const { return bytes_sent_.load(); }
     size_t client_count() const;
+    uint64_t retransmitted_messages() const { return retransmitted_.load(); }
     uint32_t current_tick_rate() const { return tick_rate_; }
     
+    // Main port; the one the OS picked if constructed with port 0,
+    // once start() has bound it
+    uint16_t port() const { return port_; }
+    
     // Callbacks for external handling
     using DisconnectCallback = std::function<void(int fd, const std::string& reason)>;
     void set_disconnect_callback(DisconnectCallback cb) { disconnect_cb_ = cb; }
@@ -51,39 +107,151 @@ private:
     std::atomic<bool> running_{false};
     std::atomic<uint64_t> messages_sent_{0};
     std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> retransmitted_{0};
     
     uint32_t tick_rate_ = 100000;  // 100K msgs/sec default
+    static constexpr int MAX_TICK_BURST = 100;  // Catch-up ticks per loop pass
     bool fault_injection_ = false;
     uint32_t fault_skip_counter_ = 0;
     
     std::unique_ptr<TickGenerator> tick_gen_;
     std::unique_ptr<ClientManager> client_mgr_;
+    std::unique_ptr<UdpPublisher> udp_;  // Only set in UDP mode
+    bool impaired_ = false;              // Any impairments configured
     
     DisconnectCallback disconnect_cb_;
     
+    // An acceptor/fan-out thread in worker mode
+    struct Worker {
+        int listen_fd = -1;
+        int event_fd = -1;
+        int wake_fd = -1;                     // eventfd the tick thread writes
+        std::unique_ptr<ClientManager> clients;
+        uint64_t cursor = 0;                  // Next ring position to read
+        std::thread thread;
+        std::atomic<size_t> client_count{0};
+        std::atomic<uint64_t> overruns{0};
+    };
+    
+    // Ring messages a worker fans out between polls for events
+    static constexpr size_t WORKER_BATCH = 256;
+    
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<TickRing> ring_;          // Only set in worker mode
+    
+    // A message waiting out its line's delay (holding a reference to
+    // the pooled buffers, not a copy)
+    struct DelayedMessage {
+        std::chrono::steady_clock::time_point due;
+        uint16_t symbol_id;
+        bool heartbeat;
+        MessageRef msg;
+        MessageRef v2;
+    };
+    
+    // A line's delayed messages, oldest first. A vector consumed from the
+    // front and compacted in place: a steady delay reuses the storage it
+    // grew to, where a deque would allocate and free a chunk every few
+    // messages.
+    class DelayQueue {
+    public:
+        bool empty() const { return head_ == entries_.size(); }
+        DelayedMessage& front() { return entries_[head_]; }
+        DelayedMessage& emplace_back() { return entries_.emplace_back(); }
+        // Room for count messages waiting at once: consumed entries stay
+        // until half the vector (and at least COMPACT_AFTER) is spent
+        void reserve(size_t count) { entries_.reserve(2 * count + COMPACT_AFTER + 1); }
+        
+        void pop_front() {
+            entries_[head_++] = DelayedMessage();   // Drop its references now
+            if (head_ == entries_.size()) {
+                entries_.clear();
+                head_ = 0;
+            } else if (head_ >= COMPACT_AFTER && head_ * 2 >= entries_.size()) {
+                entries_.erase(entries_.begin(), entries_.begin() + head_);
+                head_ = 0;
+            }
+        }
+        
+    private:
+        static constexpr size_t COMPACT_AFTER = 64;
+        std::vector<DelayedMessage> entries_;
+        size_t head_ = 0;
+    };
+    
+    struct Line {
+        uint16_t port = 0;
+        int server_fd = -1;   // Line 0 uses server_fd_
+        LineFaults faults;
+        std::mt19937_64 rng;
+        DelayQueue delayed;
+        uint64_t dropped = 0;
+    };
+    
+    // Empty unless redundant lines are configured
+    std::vector<Line> lines_;
+    
     // Initialize server socket
     bool init_server_socket();
+    int open_listener(uint16_t port, bool reuse_port = false);
+    bool register_listener(int event_fd, int fd);
+    int listener_line(int fd) const;
+    
+    // Worker mode: listeners and epoll instances, the tick loop, and
+    // each worker's loop
+    bool init_workers();
+    void run_tick_loop();
+    void run_worker(Worker& worker);
+    void wake_workers();
+    
+    // Create line 0 (the main port) on first use
+    void ensure_lines();
+    
+    // Send (or drop, or delay) one message on every line
+    size_t publish_to_lines(const MessageRef& msg, uint16_t symbol_id, const MessageRef& v2,
+                            bool heartbeat);
+    size_t send_on_line(size_t line, const MessageRef& msg, uint16_t symbol_id,
+                        const MessageRef& v2, bool heartbeat);
+    
+    // Send delayed messages whose time has come
+    void release_delayed(std::chrono::steady_clock::time_point now);
     
     // Initialize event notification (kqueue/epoll)
     bool init_event_system();
     
-    // Accept new client connections
-    void handle_new_connection();
+    // Accept new client connections into clients, registering them with
+    // event_fd (the tick thread's own, or a worker's)
+    void handle_new_connection(ClientManager& clients, int event_fd, int listen_fd,
+                               uint8_t line);
     
     // Handle client events (data, disconnect)
-    void handle_client_event(int client_fd, bool is_read, bool is_error);
+    void handle_client_event(ClientManager& clients, int event_fd, int client_fd,
+                             bool is_read, bool is_error);
     
     // Generate and broadcast tick
     void generate_and_broadcast_tick();
     
+    // Send pending batched packets to all clients
+    void flush_batches();
+    
+    // Send pending UDP datagram
+    void flush_udp();
+    
+    // Resend retained messages to client over TCP
+    void handle_retransmit(int client_fd, const RetransmitRequest& request);
+    
+    // Recover drained slow consumers
+    void drain_slow_clients();
+    
     // Send heartbeat to all clients
     void send_heartbeat();
     
     // Handle client disconnection
-    void handle_client_disconnect(int client_fd, const std::string& reason = "");
+    void handle_client_disconnect(ClientManager& clients, int event_fd, int client_fd,
+                                  const std::string& reason = "");
     
     // Process subscription request from client
-    bool process_subscription(int client_fd);
+    bool process_subscription(ClientManager& clients, int event_fd, int client_fd);
 };
 
 } // namespace mdf
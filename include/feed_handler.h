@@ -1,11 +1,18 @@
 #pragma once
 
+#include "analytics.h"
 #include "cache.h"
 #include "latency_tracker.h"
+#include "line_arbiter.h"
+#include "memory_pool.h"
+#include "order_book.h"
 #include "parser.h"
 #include "socket.h"
+#include "spsc_queue.h"
+#include "symbol_master.h"
 #include "visualizer.h"
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <fstream>
 #include <memory>
@@ -15,6 +22,13 @@
 
 namespace mdf {
 
+// One feed connection; several partition the symbol universe between them
+struct FeedEndpoint {
+  std::string host = "localhost";
+  uint16_t port = DEFAULT_PORT;
+  std::vector<uint16_t> subscribe_symbols; // Empty = config's list
+};
+
 // Feed handler configuration
 struct FeedHandlerConfig {
   std::string host = "localhost";
@@ -25,6 +39,61 @@ struct FeedHandlerConfig {
   bool enable_visualization = true;
   std::string dump_file; // If set, dump all messages to this file
   std::vector<uint16_t> subscribe_symbols; // Empty = subscribe all
+  uint8_t protocol_version = PROTOCOL_V1;  // Wire format requested from server
+  std::string udp_address;  // If set (with udp_port), ticks arrive over UDP
+  uint16_t udp_port = 0;
+  std::string udp_interface = "127.0.0.1";  // Interface for multicast join
+  CacheLayout cache_layout = CacheLayout::Wide;
+  std::shared_ptr<const SymbolMaster> symbols;  // Null = built-in names
+  bool enable_analytics = true;  // VWAP, volatility and bars per symbol
+
+  // Reorder buffer on the tick stream (UDP in UDP mode, otherwise each
+  // feed's TCP stream): early messages wait for missing ones, up to this
+  // many sequences ahead and reorder_hold_us. 0 = off, gaps are immediate.
+  size_t reorder_window = 0;
+  uint32_t reorder_hold_us = 1000;
+
+  // Multi-feed mode: one connection per endpoint (replacing host/port),
+  // each with its own parser and sequence space, polled together on one
+  // thread and applied to the shared caches. TCP only, inline only.
+  std::vector<FeedEndpoint> feeds;
+
+  // Arbitration: the feeds are redundant lines (A/B) of one stream instead,
+  // and each sequence is applied once, from whichever line has it first
+  bool arbitrate = false;
+  size_t arbitration_window = LineArbiter::DEFAULT_WINDOW;
+  uint32_t arbitration_hold_us = 5000;  // Wait for another line to fill a gap
+
+  // Pipeline mode (TCP only): receive, parse and apply on separate threads,
+  // each pinned to a core when set (-1 = unpinned)
+  bool pipeline = false;
+  int recv_core = -1;
+  int parse_core = -1;
+  int apply_core = -1;
+};
+
+// Pipeline mode queue and per-stage latency metrics
+struct PipelineStats {
+  size_t raw_queue_depth = 0;       // Received buffers waiting to be parsed
+  size_t raw_queue_max_depth = 0;
+  size_t event_queue_depth = 0;     // Decoded messages waiting to be applied
+  size_t event_queue_max_depth = 0;
+  uint64_t recv_stalls = 0;         // Receive waited for a free buffer
+  uint64_t parse_stalls = 0;        // Parse waited on a full event queue
+  LatencyStats parse_wait;          // Receive to parse, per buffer
+  LatencyStats apply_wait;          // Receive to apply, oldest message per batch
+};
+
+// Per-connection counters (one entry per feed)
+struct ConnectionStats {
+  std::string endpoint;  // host:port
+  bool connected = false;
+  uint64_t messages_received = 0;
+  uint64_t bytes_received = 0;
+  uint64_t sequence_gaps = 0;
+  uint64_t checksum_errors = 0;
+  uint32_t reconnects = 0;
+  LatencyStats latency;
 };
 
 // Feed handler - main client class
@@ -48,16 +117,41 @@ public:
   // Get market state for symbol
   MarketState get_market_state(uint16_t symbol_id) const;
 
+  // Get all symbols at one point in time (republished every
+  // SNAPSHOT_INTERVAL while data flows), false before the first publish
+  bool get_cache_snapshot(CacheSnapshot &out) const;
+
+  // Get derived analytics for symbol (zeroed if analytics are disabled)
+  Analytics get_analytics(uint16_t symbol_id) const;
+
+  // Get recent OHLCV bars for symbol, newest (in progress) first
+  size_t get_bars(uint16_t symbol_id, BarInterval interval, Bar *out,
+                  size_t max_bars) const;
+
+  // Get top-N price levels for one side of a symbol's book
+  size_t get_book_levels(uint16_t symbol_id, BookSide side, PriceLevel *out,
+                         size_t max_levels) const;
+
   // Get statistics
   uint64_t messages_received() const;
   uint64_t bytes_received() const;
   uint64_t sequence_gaps() const;
+  uint64_t messages_recovered() const;  // UDP gaps filled over TCP
+  uint64_t retransmit_requests() const { return retransmit_requests_.load(); }
   LatencyStats get_latency_stats() const;
+  PipelineStats get_pipeline_stats() const;  // Zeroed outside pipeline mode
+  ReorderStats get_reorder_stats() const;    // Primary tick stream's parser
+  std::vector<ConnectionStats> get_connection_stats() const;
+  size_t connection_count() const { return connections_.size(); }
+
+  // Line wins, lead times and unfilled gaps (empty outside arbitration);
+  // read once run() has returned
+  ArbitrationStats get_arbitration_stats() const;
 
-  // Check connection status
+  // Check connection status (any feed connected)
   bool is_connected() const;
 
-  // Force reconnection
+  // Force reconnection of every feed
   bool reconnect();
 
   // Non-copyable
@@ -67,33 +161,138 @@ public:
 private:
   FeedHandlerConfig config_;
 
-  std::unique_ptr<MarketDataSocket> socket_;
-  std::unique_ptr<MessageParser> parser_;
+  // One TCP connection and the parser for its stream
+  struct FeedConnection {
+    FeedEndpoint endpoint;
+    std::unique_ptr<MarketDataSocket> socket;
+    std::unique_ptr<MessageParser> parser;
+    std::unique_ptr<LatencyTracker> latency;  // Multi-feed mode only
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> bytes_received{0};
+    bool active = true;   // False once reconnection gives up
+    bool pending = false; // Receive budget ran out before the socket drained
+  };
+
+  // connections_[0] is the primary feed, and the only one in pipeline and
+  // UDP modes; socket_ and parser_ alias it
+  std::vector<std::unique_ptr<FeedConnection>> connections_;
+  MarketDataSocket *socket_ = nullptr;
+  MessageParser *parser_ = nullptr;
+  FeedConnection *current_ = nullptr;  // Multi-feed: connection being parsed
+  std::unique_ptr<MessageParser> udp_parser_;  // Only set in UDP mode
+  std::unique_ptr<LineArbiter> arbiter_;       // Only set in arbitration mode
+  uint64_t recv_ns_ = 0;  // Arbitration: when the buffer being parsed arrived
   std::unique_ptr<SymbolCache> cache_;
+  std::unique_ptr<DepthCache> depth_cache_;
+  std::unique_ptr<AnalyticsEngine> analytics_;  // Null when disabled
   std::unique_ptr<Visualizer> visualizer_;
   std::unique_ptr<LatencyTracker> latency_tracker_;
+  std::shared_ptr<const SymbolMaster> symbols_;
 
   std::atomic<bool> running_{false};
+  std::atomic<bool> connection_changed_{false};  // Visualizer status is stale
 
-  // Receive buffer (4MB aligned)
-  static constexpr size_t RECV_BUFFER_SIZE = 4 * 1024 * 1024;
-  std::unique_ptr<uint8_t[]> recv_buffer_;
+  // Full-cache snapshot cadence for get_cache_snapshot()
+  static constexpr auto SNAPSHOT_INTERVAL = std::chrono::milliseconds(1);
+  std::chrono::steady_clock::time_point last_snapshot_;
 
   // Statistics
   std::atomic<uint64_t> messages_received_{0};
   std::atomic<uint64_t> bytes_received_{0};
+  std::atomic<uint64_t> retransmit_requests_{0};
+
+  // UDP mode: newest sequence applied per symbol (+1, 0 = none), so
+  // retransmitted messages never overwrite newer state
+  std::vector<uint32_t> symbol_sequence_;
 
   // Dump file
   std::unique_ptr<std::ofstream> dump_file_;
 
-  // Process received data
-  void process_data();
+  // Pipeline mode: recv thread -> raw buffers -> parse thread -> decoded
+  // events -> apply thread (the only cache writer)
+  struct RawChunk {
+    void *data;
+    uint32_t size;
+    uint64_t recv_ns;
+  };
+
+  enum class EventKind : uint8_t { Trade, Quote, Depth };
+
+  struct FeedEvent {
+    MessageHeader header;
+    EventKind kind;
+    union {
+      TradePayload trade;
+      QuotePayload quote;
+      DepthUpdatePayload depth;
+    };
+    uint64_t recv_ns;  // When the buffer holding it was received
+  };
+
+  // Receive buffers, inline and pipelined: each receive lands in a pool
+  // block that the parser reads in place
+  static constexpr size_t RECV_CHUNK_SIZE = 64 * 1024;
+  static constexpr size_t RECV_CHUNKS = 256;
+  static constexpr size_t PIPELINE_EVENTS = 64 * 1024;
+  static constexpr size_t PIPELINE_BATCH = 256;
+
+  std::unique_ptr<MemoryPool> chunk_pool_;
+  std::unique_ptr<SpscQueue<RawChunk>> raw_queue_;
+  std::unique_ptr<SpscQueue<FeedEvent>> event_queue_;
+  std::unique_ptr<LatencyTracker> parse_wait_;
+  std::unique_ptr<LatencyTracker> apply_wait_;
+  std::atomic<uint64_t> recv_stalls_{0};
+  std::atomic<uint64_t> parse_stalls_{0};
+  uint64_t parse_chunk_ns_ = 0;  // Parse thread: recv_ns of current buffer
+  std::thread recv_thread_;
+  std::thread parse_thread_;
+  std::thread apply_thread_;
+
+  void run_pipeline();
+  void recv_stage();
+  void parse_stage();
+  void apply_stage();
+  void push_event(const FeedEvent &event);
+
+  // Multi-feed event loop
+  void run_feeds();
+
+  // Create connections for config_.feeds (or host/port)
+  void create_connections();
+  const std::vector<uint16_t> &subscriptions(const FeedConnection &conn) const;
+  bool subscribe(FeedConnection &conn);
+
+  // Reconnect after a receive error; false if the connection is lost
+  bool handle_connection_loss(FeedConnection &conn);
+
+  // Main thread only: push connection status and stats to the visualizer
+  void update_visualizer();
+
+  // Register message callbacks on a parser
+  void set_parser_callbacks(MessageParser &parser);
+
+  // Arbitration: route a line's messages through the arbiter
+  void set_line_callbacks(MessageParser &parser, size_t line);
+  void apply_message(const LineMessage &msg);
+
+  // Process received data; false if max_iterations ran out first
+  bool process_data(FeedConnection &conn, int max_iterations = 1000);
+  void process_datagrams();
+  MessageParser &tick_parser() { return udp_parser_ ? *udp_parser_ : *parser_; }
+
+  void record_latency(const MessageHeader &header);
+
+  // False if a newer message for the symbol was already applied
+  bool accept_sequence(const MessageHeader &header);
 
   // Message callbacks
   void on_trade(const MessageHeader &header, const TradePayload &payload);
   void on_quote(const MessageHeader &header, const QuotePayload &payload);
+  void on_depth(const MessageHeader &header,
+                const DepthUpdatePayload &payload);
   void on_heartbeat(const MessageHeader &header);
   void on_sequence_gap(uint32_t expected, uint32_t received);
+  void on_udp_gap(uint32_t expected, uint32_t received);
 };
 
 } // namespace mdf
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace mdf {
+
+// How large buffers are backed and placed. HugePageBuffer, and everything
+// built on it (HugeArray tables, MemoryPool blocks, parser buffers, the
+// latency ring), follows the process-wide policy unless given its own.
+struct MemoryPolicy {
+    static constexpr int FIRST_TOUCH = -1;  // Pages land where first written
+    static constexpr int LOCAL_NODE = -2;   // Node of the allocating thread's CPU
+
+    bool huge_pages = true;         // 2MB pages for buffers of 256KB and up
+    int numa_node = FIRST_TOUCH;    // Or a node to mbind() the pages to
+    bool lock = false;              // mlock(): faulted in now, never paged out
+    bool prefault = false;          // Touch every page now, not on first use
+};
+
+// Parse "4k|huge,node=<n|local>,lock,prefault"; false if malformed
+bool parse_memory_policy(const std::string& spec, MemoryPolicy& policy);
+
+// Process-wide default; set it before the buffers it should cover exist
+void set_memory_policy(const MemoryPolicy& policy);
+const MemoryPolicy& memory_policy();
+
+// Zero-filled contiguous memory for large tables, backed by 2MB pages
+// where the system allows: explicit hugepages (MAP_HUGETLB) first, then
+// transparent hugepages (madvise), then ordinary 4K pages. The policy's
+// NUMA binding, locking and prefaulting are best effort: a failure leaves
+// the buffer usable, and numa_node()/locked() report what took effect.
+class HugePageBuffer {
+public:
+    enum class Backing : uint8_t { None, HugeTlb, Transparent, Normal };
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    HugePageBuffer() = default;
+    explicit HugePageBuffer(size_t bytes);
+    HugePageBuffer(size_t bytes, const MemoryPolicy& policy);
+    ~HugePageBuffer();
+
+    HugePageBuffer(HugePageBuffer&& other) noexcept { swap(other); }
+    HugePageBuffer& operator=(HugePageBuffer&& other) noexcept {
+        HugePageBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    HugePageBuffer(const HugePageBuffer&) = delete;
+    HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+
+    void* data() const { return data_; }
+    size_t size() const { return size_; }
+    Backing backing() const { return backing_; }
+    int numa_node() const { return numa_node_; }  // -1 if not bound
+    bool locked() const { return locked_; }
+
+    void swap(HugePageBuffer& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(mapped_, other.mapped_);
+        std::swap(backing_, other.backing_);
+        std::swap(numa_node_, other.numa_node_);
+        std::swap(locked_, other.locked_);
+    }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    size_t mapped_ = 0;     // Length passed to mmap (rounded up)
+    Backing backing_ = Backing::None;
+    int numa_node_ = -1;
+    bool locked_ = false;
+
+    void place(const MemoryPolicy& policy);
+};
+
+const char* backing_name(HugePageBuffer::Backing backing);
+
+// Fixed-size array of T constructed in a HugePageBuffer
+// Elements are default-constructed in place, so T may hold atomics
+template <typename T>
+class HugeArray {
+public:
+    HugeArray() = default;
+    explicit HugeArray(size_t count)
+        : buffer_(count * sizeof(T)), count_(count) {
+        data_ = static_cast<T*>(buffer_.data());
+        for (size_t i = 0; i < count_; ++i) {
+            new (&data_[i]) T();
+        }
+    }
+
+    ~HugeArray() { destroy(); }
+
+    HugeArray(HugeArray&& other) noexcept { swap(other); }
+    HugeArray& operator=(HugeArray&& other) noexcept {
+        HugeArray(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return count_; }
+    HugePageBuffer::Backing backing() const { return buffer_.backing(); }
+
+    void swap(HugeArray& other) noexcept {
+        buffer_.swap(other.buffer_);
+        std::swap(data_, other.data_);
+        std::swap(count_, other.count_);
+    }
+
+private:
+    HugePageBuffer buffer_;
+    T* data_ = nullptr;
+    size_t count_ = 0;
+
+    void destroy() {
+        for (size_t i = 0; i < count_; ++i) {
+            data_[i].~T();
+        }
+        count_ = 0;
+    }
+};
+
+} // namespace mdf
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mdf {
+
+// Line noise for one client's TCP stream. Each probability applies per
+// write (one message, or one batched packet), drawn from the seeded
+// generator, so a run can be replayed exactly.
+struct ImpairmentConfig {
+    double bit_flip = 0.0;       // Flip one random bit
+    double truncate = 0.0;       // Send a random prefix only
+    double duplicate = 0.0;      // Send the write twice
+    double reorder = 0.0;        // Hold it back until after the next write
+    double delay = 0.0;          // Stall the stream for delay_us, then flush it in one burst
+    uint32_t delay_us = 1000;
+    double partial_write = 0.0;  // Split the bytes over two send() calls
+    double reset = 0.0;          // Reset the connection instead of sending
+    uint64_t seed = 1;
+
+    bool enabled() const {
+        return bit_flip > 0 || truncate > 0 || duplicate > 0 || reorder > 0 ||
+               delay > 0 || partial_write > 0 || reset > 0;
+    }
+};
+
+struct ImpairmentStats {
+    uint64_t writes = 0;         // Writes offered
+    uint64_t bit_flips = 0;
+    uint64_t truncated = 0;
+    uint64_t duplicated = 0;
+    uint64_t reordered = 0;
+    uint64_t delays = 0;         // Stalls started
+    uint64_t partial_writes = 0;
+    uint64_t resets = 0;
+
+    ImpairmentStats& operator+=(const ImpairmentStats& other);
+};
+
+// Parse "flip=0.001,truncate=0.001,dup=0.01,reorder=0.01,delay=0.001,
+// delay_us=2000,partial=0.1,reset=0.0001,seed=7" (any subset, any order)
+bool parse_impairments(const std::string& spec, ImpairmentConfig& config);
+
+// Applies an ImpairmentConfig to one stream of writes
+// apply() turns each write into the byte runs to send now, each run its
+// own send() call: possibly none (held back), possibly several (a
+// duplicate, the halves of a partial write, or a stalled burst).
+// Single-threaded; the buffers are reused, so nothing allocates once they
+// have grown to the largest burst.
+class Impairer {
+public:
+    enum class Action { Send, Reset };
+
+    explicit Impairer(const ImpairmentConfig& config);
+
+    Action apply(const uint8_t* data, size_t len, std::chrono::steady_clock::time_point now);
+
+    // Flush a stall whose time is up, and a write held for reordering that
+    // has waited delay_us with nothing behind it; true if runs are ready
+    bool release(std::chrono::steady_clock::time_point now);
+
+    // Runs produced by the last apply() or release()
+    size_t run_count() const { return runs_.size(); }
+    const uint8_t* run_data(size_t i) const { return out_.data() + runs_[i].offset; }
+    size_t run_size(size_t i) const { return runs_[i].size; }
+
+    bool holding() const { return stalled_ || !reorder_.empty(); }
+    const ImpairmentConfig& config() const { return config_; }
+    const ImpairmentStats& stats() const { return stats_; }
+
+private:
+    struct Run {
+        size_t offset;
+        size_t size;
+    };
+
+    ImpairmentConfig config_;
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> chance_{0.0, 1.0};
+
+    std::vector<uint8_t> out_;      // Bytes of the runs to send now
+    std::vector<Run> runs_;
+    std::vector<uint8_t> scratch_;  // The write being impaired
+    std::vector<uint8_t> reorder_;  // Write held until the next one
+    std::vector<uint8_t> stalled_bytes_;
+    bool stalled_ = false;
+    std::chrono::steady_clock::time_point stall_until_;
+    std::chrono::steady_clock::time_point reorder_since_;
+    ImpairmentStats stats_;
+
+    bool roll(double p) { return p > 0 && chance_(rng_) < p; }
+    size_t pick(size_t lo, size_t hi) {  // Uniform in [lo, hi]
+        return std::uniform_int_distribution<size_t>(lo, hi)(rng_);
+    }
+
+    // Queue bytes for sending: into the stall if one is running, else as
+    // one run (or two, for a partial write)
+    void emit(const uint8_t* data, size_t len);
+    void add_run(const uint8_t* data, size_t len);
+};
+
+} // namespace mdf
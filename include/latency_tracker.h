@@ -6,6 +6,7 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include "huge_pages.h"
 
 namespace mdf {
 
@@ -43,8 +44,9 @@ public:
     bool export_csv(const std::string& filename) const;
     
 private:
-    // Ring buffer for raw samples (for exact percentile if needed)
-    std::array<std::atomic<uint64_t>, RING_BUFFER_SIZE> ring_buffer_;
+    // Ring buffer for raw samples (for exact percentile if needed). 8MB,
+    // so it lives in its own mapping, not inline in the tracker.
+    HugeArray<std::atomic<uint64_t>> ring_buffer_;
     std::atomic<uint64_t> write_index_{0};
     
     // Histogram buckets for fast percentile calculation
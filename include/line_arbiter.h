@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "protocol.h"
+
+namespace mdf {
+
+enum class MessageKind : uint8_t { Trade, Quote, Depth, Heartbeat };
+
+// One decoded message, as a parser callback delivered it
+struct LineMessage {
+    MessageHeader header;
+    MessageKind kind;
+    union {
+        TradePayload trade;
+        QuotePayload quote;
+        DepthUpdatePayload depth;
+    };
+};
+
+// Per-line arbitration counters
+struct LineStats {
+    uint64_t messages = 0;       // Received on the line, duplicates included
+    uint64_t wins = 0;           // Sequences this line had first
+    uint64_t missed = 0;         // Sequences the line skipped
+    uint64_t lead_samples = 0;   // Wins later matched by another line's copy
+    uint64_t lead_ns_total = 0;  // How far ahead of that copy the win was
+    uint64_t max_lead_ns = 0;
+
+    uint64_t mean_lead_ns() const { return lead_samples ? lead_ns_total / lead_samples : 0; }
+};
+
+struct ArbitrationStats {
+    uint64_t delivered = 0;      // Unique sequences passed on
+    uint64_t duplicates = 0;     // Copies discarded
+    uint64_t gap_events = 0;     // Gaps no line filled
+    uint64_t lost = 0;           // Sequences in those gaps
+    uint64_t held = 0;           // Messages that waited for an earlier sequence
+    size_t max_held = 0;         // Most waiting at once
+    std::vector<LineStats> lines;
+};
+
+// Merges redundant lines (A/B feeds) that carry one sequence space
+// Each sequence is delivered once, from whichever line has it first.
+// A sequence that arrives ahead of the next expected one waits in a ring
+// indexed by sequence while the other lines get a chance to fill the gap;
+// the gap is declared lost when the ring overflows or the wait exceeds
+// max_hold_ns. Single-threaded: call from the thread that parses.
+class LineArbiter {
+public:
+    static constexpr size_t MAX_LINES = 8;
+    static constexpr size_t DEFAULT_WINDOW = 4096;
+    static constexpr uint64_t DEFAULT_MAX_HOLD_NS = 5000000;  // 5ms
+
+    // line is the line whose copy is delivered
+    using DeliverCallback = std::function<void(const LineMessage&, size_t line)>;
+
+    // Called when no line filled [expected, received)
+    using GapCallback = std::function<void(uint32_t expected, uint32_t received)>;
+
+    explicit LineArbiter(size_t num_lines, size_t window = DEFAULT_WINDOW,
+                         uint64_t max_hold_ns = DEFAULT_MAX_HOLD_NS);
+
+    void set_deliver_callback(DeliverCallback cb) { deliver_cb_ = std::move(cb); }
+    void set_gap_callback(GapCallback cb) { gap_cb_ = std::move(cb); }
+
+    // Offer a message received on line at now_ns (steady clock)
+    void on_message(size_t line, const LineMessage& msg, uint64_t now_ns);
+
+    // Declare the current gap lost once it has waited max_hold_ns
+    void poll(uint64_t now_ns);
+
+    size_t num_lines() const { return lines_.size(); }
+    size_t window() const { return window_; }
+    uint32_t next_sequence() const { return next_; }
+    size_t held() const { return held_count_; }
+    uint64_t gap_events() const { return gap_events_; }
+    ArbitrationStats stats() const;
+
+    void reset();
+
+    // Non-copyable
+    LineArbiter(const LineArbiter&) = delete;
+    LineArbiter& operator=(const LineArbiter&) = delete;
+
+private:
+    struct Slot {
+        uint32_t sequence = 0;
+        bool valid = false;    // Describes `sequence` (delivered or held)
+        bool held = false;     // Waiting for earlier sequences
+        uint8_t winner = 0;
+        uint64_t first_ns = 0;
+        LineMessage msg;
+    };
+
+    struct LineState {
+        uint32_t next = 0;     // Sequence the line should send next
+        bool started = false;
+    };
+
+    // Twice the window: held sequences ahead of next_, and history behind
+    // it so late copies can be matched for lead time
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    size_t window_;
+    uint64_t max_hold_ns_;
+    DeliverCallback deliver_cb_;
+    GapCallback gap_cb_;
+
+    uint32_t next_ = 0;
+    bool started_ = false;
+    size_t held_count_ = 0;
+    uint64_t gap_since_ns_ = 0;  // When the gap at next_ started waiting
+
+    std::vector<LineStats> lines_;
+    std::vector<LineState> line_state_;
+    uint64_t delivered_ = 0;
+    uint64_t duplicates_ = 0;
+    uint64_t gap_events_ = 0;
+    uint64_t lost_ = 0;
+    uint64_t held_total_ = 0;
+    size_t max_held_ = 0;
+
+    Slot& slot(uint32_t sequence) { return slots_[sequence & mask_]; }
+    void deliver(const LineMessage& msg, size_t line);
+    void record_duplicate(uint32_t sequence, uint64_t now_ns);
+
+    // Deliver held sequences that are now next in line
+    void release_held(uint64_t now_ns);
+
+    // Give up on every sequence before base that no line delivered
+    void skip_to(uint32_t base, uint64_t now_ns);
+    void declare_gap(uint32_t expected, uint32_t received);
+};
+
+} // namespace mdf
@@ -5,34 +5,71 @@
 #include <cstdint>
 #include <cstddef>
 #include <memory>
+#include "huge_pages.h"
 
 namespace mdf {
 
 // Lock-free memory pool for fixed-size allocations
-// Designed for network buffer management with minimal contention
+// Designed for network buffer management with minimal contention.
+//
+// Free blocks sit on a Treiber stack whose head packs a 32-bit block
+// index with a 32-bit tag into one 64-bit word. Every push and pop bumps
+// the tag, so a thread that read the head, stalled, and saw the same
+// block come back on top still fails its CAS (the ABA problem). The
+// packed word keeps the CAS single-width and lock-free everywhere.
+//
+// In front of the shared stack, each thread keeps a small magazine of
+// blocks for this pool. Allocate and deallocate hit the magazine with no
+// atomic read-modify-writes; an empty magazine refills half a magazine
+// from the stack in one CAS, and a full one returns its older half in one
+// CAS. Blocks cached by a thread return to the stack when it exits.
+//
+// Block storage is a HugePageBuffer under the process memory policy.
 class MemoryPool {
 public:
     static constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
     static constexpr size_t DEFAULT_POOL_SIZE = 1024;
     static constexpr size_t CACHE_LINE_SIZE = 64;
     
+    // Blocks cached per thread; clamped to an eighth of the pool so small
+    // pools cannot strand most of their blocks in idle threads
+    static constexpr size_t MAX_THREAD_CACHE = 32;
+    
+    // Threads that get a magazine; any more share the stack directly
+    static constexpr size_t MAX_CACHED_THREADS = 64;
+    
     MemoryPool(size_t block_size = DEFAULT_BLOCK_SIZE,
-               size_t num_blocks = DEFAULT_POOL_SIZE);
+               size_t num_blocks = DEFAULT_POOL_SIZE,
+               size_t thread_cache = MAX_THREAD_CACHE);
     ~MemoryPool();
     
-    // Allocate a block (returns nullptr if pool exhausted)
+    // Allocate a block (returns nullptr if pool exhausted). Blocks cached
+    // by other threads are not visible, so this can fail with up to
+    // thread_cache_size() blocks free per other thread.
     void* allocate();
     
     // Return a block to the pool
     void deallocate(void* ptr);
     
-    // Get pool statistics
+    // Whether ptr lies in this pool's block storage
+    bool owns(const void* ptr) const {
+        auto* p = static_cast<const uint8_t*>(ptr);
+        return p >= aligned_base_ && p < aligned_base_ + block_size_ * num_blocks_;
+    }
+    
+    // Return this thread's cached blocks to the shared stack
+    void flush_thread_cache();
+    
+    // Get pool statistics (exact once threads are quiescent)
     size_t get_allocated_count() const;
     size_t get_available_count() const;
     size_t block_size() const { return block_size_; }
     size_t capacity() const { return num_blocks_; }
+    size_t thread_cache_size() const { return cache_size_; }
+    const HugePageBuffer& storage() const { return storage_; }
     
-    // Reset pool (all blocks available)
+    // Reset pool (all blocks available). Not safe while other threads
+    // use the pool.
     void reset();
     
     // Non-copyable
@@ -40,20 +77,52 @@ public:
     MemoryPool& operator=(const MemoryPool&) = delete;
     
 private:
-    struct alignas(CACHE_LINE_SIZE) FreeNode {
-        std::atomic<FreeNode*> next;
+    static constexpr uint32_t NIL = UINT32_MAX;
+    
+    // Overlays the first word of a free block
+    struct FreeNode {
+        std::atomic<uint32_t> next;
+    };
+    
+    // One thread's cached blocks; only the owning thread writes it
+    struct alignas(CACHE_LINE_SIZE) Magazine {
+        std::atomic<uint32_t> count{0};  // Atomic only for the stats readers
+        void* blocks[MAX_THREAD_CACHE];
     };
     
     size_t block_size_;
     size_t num_blocks_;
+    size_t cache_size_;
     
-    // Aligned memory storage
-    std::unique_ptr<uint8_t[]> storage_;
+    // Page-aligned block storage
+    HugePageBuffer storage_;
     uint8_t* aligned_base_;
     
-    // Lock-free free list using tagged pointer for ABA prevention
-    std::atomic<FreeNode*> free_list_{nullptr};
-    std::atomic<size_t> allocated_count_{0};
+    // Free stack head: tag in the high 32 bits, block index in the low 32
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> free_head_{NIL};
+    
+    // Blocks off the stack: allocated or cached in a magazine
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> outstanding_{0};
+    
+    // One magazine per thread slot; empty if caching is off
+    std::unique_ptr<Magazine[]> magazines_;
+    
+    FreeNode* node(uint32_t index) const {
+        return reinterpret_cast<FreeNode*>(aligned_base_ + index * block_size_);
+    }
+    uint32_t index_of(const void* ptr) const {
+        return static_cast<uint32_t>(
+            (static_cast<const uint8_t*>(ptr) - aligned_base_) / block_size_);
+    }
+    
+    // The calling thread's magazine, or nullptr to use the stack directly
+    Magazine* local_magazine();
+    
+    // Pop up to max blocks in one CAS; returns how many
+    size_t pop_blocks(void** out, size_t max);
+    
+    // Push count blocks in one CAS
+    void push_blocks(void* const* blocks, size_t count);
 };
 
 // RAII wrapper for pool-allocated buffers
@@ -107,4 +176,106 @@ private:
     void* data_;
 };
 
+// Reference-counted message in a pool block
+// The block holds a small header (reference count, size, owning pool)
+// followed by the message bytes. Copies share the block, so one message
+// can sit in many clients' send queues at once; the last reference to go
+// returns the block to its pool, from whichever thread drops it. If the
+// pool is exhausted or its blocks are too small, the message goes on the
+// heap instead (counted by heap_fallbacks()).
+class MessageRef {
+public:
+    MessageRef() = default;
+
+    // Uninitialised message of size bytes, to be filled through data()
+    static MessageRef allocate(MemoryPool& pool, size_t size);
+
+    // Message holding a copy of data
+    static MessageRef copy_of(MemoryPool& pool, const void* data, size_t size);
+
+    ~MessageRef() { release(); }
+
+    MessageRef(const MessageRef& other) : header_(other.header_) {
+        if (header_) {
+            header_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    MessageRef& operator=(const MessageRef& other) {
+        if (header_ != other.header_) {
+            release();
+            header_ = other.header_;
+            if (header_) {
+                header_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return *this;
+    }
+
+    MessageRef(MessageRef&& other) noexcept : header_(other.header_) {
+        other.header_ = nullptr;
+    }
+
+    MessageRef& operator=(MessageRef&& other) noexcept {
+        if (this != &other) {
+            release();
+            header_ = other.header_;
+            other.header_ = nullptr;
+        }
+        return *this;
+    }
+
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(header_ + 1); }
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(header_ + 1); }
+    size_t size() const { return header_ ? header_->size : 0; }
+
+    // Shrink to the bytes actually written (never grows)
+    void resize(size_t size) {
+        if (header_ && size < header_->size) {
+            header_->size = static_cast<uint32_t>(size);
+        }
+    }
+
+    uint32_t use_count() const {
+        return header_ ? header_->refs.load(std::memory_order_relaxed) : 0;
+    }
+    bool pooled() const { return header_ && header_->pool; }
+    explicit operator bool() const { return header_ != nullptr; }
+
+    void reset() {
+        release();
+        header_ = nullptr;
+    }
+
+    // Bytes of each block taken by the header
+    static constexpr size_t HEADER_SIZE = 16;
+
+    // Largest message a block of this pool holds
+    static size_t capacity(const MemoryPool& pool) {
+        return pool.block_size() - HEADER_SIZE;
+    }
+
+    // Messages that did not fit in their pool, process-wide
+    static uint64_t heap_fallbacks();
+
+private:
+    struct alignas(16) Header {
+        std::atomic<uint32_t> refs;
+        uint32_t size;
+        MemoryPool* pool;   // nullptr: heap allocated
+    };
+    static_assert(sizeof(Header) == HEADER_SIZE, "header size");
+
+    explicit MessageRef(Header* header) : header_(header) {}
+
+    void release() {
+        if (header_ && header_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            free_block(header_);
+        }
+    }
+    static void free_block(Header* header);
+
+    Header* header_ = nullptr;
+};
+
 } // namespace mdf
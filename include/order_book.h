@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "huge_pages.h"
+#include "protocol.h"
+
+namespace mdf {
+
+// Single aggregated price level
+struct PriceLevel {
+    double price = 0.0;
+    uint32_t quantity = 0;
+};
+
+// Fixed-capacity market-by-price book for one symbol
+// Prices and quantities are kept in separate arrays (SoA) so that a
+// top-N read only touches the first few cache lines of each side.
+// Level 0 is always the best price.
+struct alignas(64) OrderBook {
+    double bid_prices[MAX_BOOK_LEVELS];
+    double ask_prices[MAX_BOOK_LEVELS];
+    uint32_t bid_quantities[MAX_BOOK_LEVELS];
+    uint32_t ask_quantities[MAX_BOOK_LEVELS];
+    uint8_t bid_count = 0;
+    uint8_t ask_count = 0;
+
+    OrderBook() { clear(); }
+
+    // Apply an incremental update
+    // Returns false if the update references a level that doesn't exist
+    bool apply(BookSide side, BookAction action, uint8_t level,
+               double price, uint32_t quantity);
+
+    bool apply(const DepthUpdatePayload& update) {
+        return apply(static_cast<BookSide>(update.side),
+                     static_cast<BookAction>(update.action),
+                     update.level, update.price, update.quantity);
+    }
+
+    // Copy up to max_levels from one side, returns number of levels copied
+    size_t top_levels(BookSide side, PriceLevel* out, size_t max_levels) const;
+
+    size_t level_count(BookSide side) const {
+        return side == BookSide::BID ? bid_count : ask_count;
+    }
+
+    void clear();
+};
+
+// Per-symbol depth cache using the same SeqLock scheme as SymbolCache
+// Single writer (feed handler), multiple readers
+class DepthCache {
+public:
+    DepthCache(size_t num_symbols = MAX_SYMBOLS);
+
+    // Writer method (single writer thread)
+    bool apply_update(uint16_t symbol_id, const DepthUpdatePayload& update,
+                      uint64_t timestamp);
+
+    // Reader methods (lock-free, consistent snapshot)
+    // Copies only the requested levels, not the whole book
+    size_t get_levels(uint16_t symbol_id, BookSide side,
+                      PriceLevel* out, size_t max_levels) const;
+
+    OrderBook get_book(uint16_t symbol_id) const;
+
+    uint64_t update_count(uint16_t symbol_id) const;
+    uint64_t rejected_updates() const { return rejected_updates_.load(); }
+
+    void reset();
+
+    size_t num_symbols() const { return num_symbols_; }
+
+    // Non-copyable
+    DepthCache(const DepthCache&) = delete;
+    DepthCache& operator=(const DepthCache&) = delete;
+
+private:
+    struct alignas(64) BookEntry {
+        std::atomic<uint64_t> sequence{0};  // Odd = writing, Even = valid
+        uint64_t update_count = 0;
+        uint64_t last_update_time = 0;
+        OrderBook book;
+    };
+
+    size_t num_symbols_;
+    HugeArray<BookEntry> entries_;
+    std::atomic<uint64_t> rejected_updates_{0};
+};
+
+} // namespace mdf
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <functional>
 #include <atomic>
 #include "protocol.h"
+#include "huge_pages.h"
 
 namespace mdf {
 
 // Parser callback types
 using TradeCallback = std::function<void(const MessageHeader&, const TradePayload&)>;
 using QuoteCallback = std::function<void(const MessageHeader&, const QuotePayload&)>;
+using DepthCallback = std::function<void(const MessageHeader&, const DepthUpdatePayload&)>;
 using HeartbeatCallback = std::function<void(const MessageHeader&)>;
 using GapCallback = std::function<void(uint32_t expected, uint32_t received)>;
 
@@ -23,11 +26,38 @@ enum class ParseResult {
     SEQUENCE_GAP
 };
 
+// Reorder buffer counters (zero while the buffer is disabled)
+struct ReorderStats {
+    size_t window = 0;
+    size_t depth = 0;            // Messages held now
+    size_t max_depth = 0;
+    uint64_t held = 0;           // Messages that arrived early and waited
+    uint64_t late = 0;           // Dropped: behind the next expected sequence
+    uint64_t overflow_gaps = 0;  // Gaps declared to make room in the window
+    uint64_t timeout_gaps = 0;   // Gaps declared after the hold timeout or a flush
+    uint64_t lost = 0;           // Sequences in declared gaps
+    uint64_t mean_hold_ns = 0;   // Held messages, arrival to release
+    uint64_t max_hold_ns = 0;
+};
+
+// Recovery from corrupt bytes (bad type, length or checksum)
+struct ResyncStats {
+    uint64_t events = 0;         // Corrupt stretches recovered from
+    uint64_t bytes_skipped = 0;  // Discarded while searching for a header
+    uint64_t candidates = 0;     // Offsets with a valid type field
+    uint64_t rejected = 0;       // Of those, failed the sequence or symbol check
+};
+
 // Zero-copy binary parser for market data messages
 class MessageParser {
 public:
     static constexpr size_t MAX_BUFFER_SIZE = 16 * 1024 * 1024;  // 16MB max buffer
     static constexpr size_t INITIAL_BUFFER_SIZE = 4 * 1024 * 1024;  // 4MB initial
+    static constexpr size_t MAX_REORDER_WINDOW = 65536;
+    static constexpr uint64_t DEFAULT_REORDER_HOLD_NS = 1000000;  // 1ms
+    static constexpr uint32_t REORDER_RESYNC_DISTANCE = 1u << 20;  // Further back = restarted
+    static constexpr uint32_t RESYNC_SEQUENCE_RANGE = 1u << 20;    // Plausible distance from expected
+    static constexpr size_t RESYNC_STRICT_BYTES = 64 * 1024;       // Then drop the sequence check
     
     MessageParser();
     
@@ -40,6 +70,12 @@ public:
     // Returns number of messages parsed
     size_t parse_messages();
     
+    // append_data() and parse_messages() in one, parsing straight out of
+    // the caller's buffer (a receive block, say). A partial message left
+    // from before takes only the bytes that complete it; the rest is
+    // parsed in place and only a trailing partial message is copied in.
+    size_t parse_buffer(const void* data, size_t len);
+    
     // Parse single message from buffer
     // Returns parse result
     ParseResult parse_one();
@@ -47,16 +83,48 @@ public:
     // Register callbacks
     void set_trade_callback(TradeCallback cb) { trade_cb_ = std::move(cb); }
     void set_quote_callback(QuoteCallback cb) { quote_cb_ = std::move(cb); }
+    void set_depth_callback(DepthCallback cb) { depth_cb_ = std::move(cb); }
     void set_heartbeat_callback(HeartbeatCallback cb) { heartbeat_cb_ = std::move(cb); }
     void set_gap_callback(GapCallback cb) { gap_cb_ = std::move(cb); }
     
+    // Reorder buffer: messages up to window-1 sequences ahead of a missing
+    // one are held (window rounded up to a power of two) and released in
+    // order when it arrives. The gap is declared, through the gap callback,
+    // when a message would not fit or the gap has waited max_hold_ns.
+    // Messages behind the next expected sequence are dropped as late.
+    // 0 disables (the default): out-of-order messages are reported as gaps
+    // and dispatched at once. Allocates here, never while parsing.
+    void set_reorder_window(size_t window, uint64_t max_hold_ns = DEFAULT_REORDER_HOLD_NS);
+    
+    // Declare the gap lost if it has waited too long (parse_messages()
+    // checks after each call; call this when no data is arriving)
+    void expire_reorder(uint64_t now_ns);
+    
+    // Give up on every pending gap and release all held messages
+    void flush_reorder();
+    
+    // Resynchronization after corrupt bytes: the parser scans ahead for
+    // the next offset holding a valid type field (16 bytes per step with
+    // SSE2), a symbol id below the limit and a sequence number within
+    // RESYNC_SEQUENCE_RANGE of the expected one, and only then tries the
+    // checksum. The sequence check is dropped once a stretch has skipped
+    // RESYNC_STRICT_BYTES, in case the stream restarted. Disabling the scan
+    // restores the old behaviour: advance one byte per failed attempt.
+    void set_symbol_limit(size_t num_symbols) { symbol_limit_ = num_symbols; }
+    void set_resync_scan(bool enabled) { resync_scan_ = enabled; }
+    
     // Statistics
     uint64_t messages_parsed() const { return messages_parsed_.load(); }
     uint64_t trades_parsed() const { return trades_parsed_.load(); }
     uint64_t quotes_parsed() const { return quotes_parsed_.load(); }
+    uint64_t depth_updates_parsed() const { return depth_updates_parsed_.load(); }
     uint64_t checksum_errors() const { return checksum_errors_.load(); }
     uint64_t sequence_gaps() const { return sequence_gaps_.load(); }
     uint64_t malformed_messages() const { return malformed_messages_.load(); }
+    uint64_t bytes_copied() const { return bytes_copied_.load(); }  // Into the internal buffer
+    ReorderStats reorder_stats() const;
+    ResyncStats resync_stats() const;
+    size_t reorder_depth() const { return reorder_depth_.load(std::memory_order_relaxed); }
     
     // Reset parser state
     void reset();
@@ -70,16 +138,23 @@ public:
     uint32_t expected_sequence() const { return expected_sequence_; }
     
 private:
-    std::vector<uint8_t> buffer_;
+    HugePageBuffer buffer_;  // Grown by copying; follows the memory policy
     size_t read_pos_ = 0;
     size_t write_pos_ = 0;
     
+    const uint8_t* view_ = nullptr;  // Caller's buffer while parse_buffer() reads it
+    
+    uint8_t* buffer() const {
+        return view_ ? const_cast<uint8_t*>(view_) : static_cast<uint8_t*>(buffer_.data());
+    }
+    
     uint32_t expected_sequence_ = 0;
     bool first_message_ = true;
     
     // Callbacks
     TradeCallback trade_cb_;
     QuoteCallback quote_cb_;
+    DepthCallback depth_cb_;
     HeartbeatCallback heartbeat_cb_;
     GapCallback gap_cb_;
     
@@ -87,18 +162,86 @@ private:
     std::atomic<uint64_t> messages_parsed_{0};
     std::atomic<uint64_t> trades_parsed_{0};
     std::atomic<uint64_t> quotes_parsed_{0};
+    std::atomic<uint64_t> depth_updates_parsed_{0};
     std::atomic<uint64_t> checksum_errors_{0};
     std::atomic<uint64_t> sequence_gaps_{0};
     std::atomic<uint64_t> malformed_messages_{0};
+    std::atomic<uint64_t> bytes_copied_{0};
+    
+    // Resync state
+    size_t symbol_limit_ = MAX_SYMBOL_CAPACITY;
+    bool resync_scan_ = true;
+    bool in_resync_ = false;
+    size_t resync_skipped_ = 0;  // Bytes skipped in the current stretch
+    std::atomic<uint64_t> resync_events_{0};
+    std::atomic<uint64_t> resync_bytes_skipped_{0};
+    std::atomic<uint64_t> resync_candidates_{0};
+    std::atomic<uint64_t> resync_rejected_{0};
+    
+    // Reorder buffer, indexed by sequence & reorder_mask_
+    struct ReorderSlot {
+        MessageHeader header;
+        bool held = false;
+        uint64_t held_ns = 0;
+        uint8_t payload[MAX_MSG_SIZE - HEADER_SIZE - CHECKSUM_SIZE];
+    };
+    std::unique_ptr<ReorderSlot[]> reorder_slots_;
+    size_t reorder_mask_ = 0;
+    uint64_t reorder_hold_ns_ = DEFAULT_REORDER_HOLD_NS;
+    uint64_t gap_since_ns_ = 0;  // When the gap at expected_sequence_ began waiting
+    
+    std::atomic<size_t> reorder_depth_{0};
+    std::atomic<size_t> reorder_max_depth_{0};
+    std::atomic<uint64_t> reorder_held_{0};
+    std::atomic<uint64_t> reorder_late_{0};
+    std::atomic<uint64_t> reorder_overflow_gaps_{0};
+    std::atomic<uint64_t> reorder_timeout_gaps_{0};
+    std::atomic<uint64_t> reorder_lost_{0};
+    std::atomic<uint64_t> reorder_released_{0};
+    std::atomic<uint64_t> reorder_hold_ns_total_{0};
+    std::atomic<uint64_t> reorder_hold_ns_max_{0};
     
     // Compact buffer if needed
     void compact_buffer();
     
+    // Bytes the buffered partial message still lacks before parse_one()
+    // can decide it (just its header's, if that is incomplete too)
+    size_t missing_bytes() const;
+    
     // Validate message checksum
     bool validate_checksum(const void* data, size_t msg_len);
     
     // Check and report sequence gap
     bool check_sequence(uint32_t received_seq);
+    
+    // Sequence check and dispatch, through the reorder buffer when enabled;
+    // false if a gap was declared
+    bool deliver(const MessageHeader& header, const uint8_t* payload);
+    bool reorder(const MessageHeader& header, const uint8_t* payload);
+    
+    // Reorder buffer: dispatch held messages that are now next in line
+    void release_held();
+    
+    // Declare [expected_sequence_, base) lost, releasing held messages in it
+    void skip_to(uint32_t base, std::atomic<uint64_t>& reason);
+    
+    bool is_held(uint32_t sequence) const {
+        const ReorderSlot& slot = reorder_slots_[sequence & reorder_mask_];
+        return slot.held && slot.header.sequence_number == sequence;
+    }
+    
+    // Skip the corrupt message at read_pos_ to the next plausible header
+    void resync();
+    
+    // Cheap checks on a candidate header before its checksum is tried
+    // (true when too few bytes have arrived to tell)
+    bool plausible_header(const uint8_t* data, size_t available);
+    
+    // Decode a batched packet (all records, one checksum)
+    ParseResult parse_batch(const uint8_t* packet, size_t available);
+    
+    // Invoke callback and update stats for one decoded message
+    void dispatch(const MessageHeader& header, const uint8_t* payload);
 };
 
 } // namespace mdf
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 
 namespace mdf {
@@ -9,29 +10,88 @@ namespace mdf {
 enum class MessageType : uint16_t {
     TRADE = 0x01,
     QUOTE = 0x02,
-    HEARTBEAT = 0x03
+    HEARTBEAT = 0x03,
+    DEPTH_UPDATE = 0x04,
+    
+    // Protocol v2: fixed-point prices (int32 paisa)
+    TRADE_V2 = 0x11,
+    QUOTE_V2 = 0x12,
+    DEPTH_UPDATE_V2 = 0x14,
+    
+    // Batched packet of delta-encoded records
+    BATCH = 0x20
+};
+
+// Protocol versions (negotiated in subscription handshake)
+constexpr uint8_t PROTOCOL_V1 = 1;   // double prices
+constexpr uint8_t PROTOCOL_V2 = 2;   // fixed-point prices
+
+// Order book side / action for depth updates
+enum class BookSide : uint8_t {
+    BID = 0,
+    ASK = 1
+};
+
+enum class BookAction : uint8_t {
+    ADD = 0,        // Insert level, shifting deeper levels down
+    MODIFY = 1,     // Replace quantity at level
+    DELETE = 2      // Remove level, shifting deeper levels up
 };
 
-// Subscription command
+// Subscription commands
 constexpr uint8_t SUBSCRIBE_CMD = 0xFF;
+constexpr uint8_t SUBSCRIBE_V2_CMD = 0xFE;   // Carries requested protocol version
+constexpr uint8_t RETRANSMIT_CMD = 0xFD;     // Resend a sequence range over TCP
 
 // Header size
 constexpr size_t HEADER_SIZE = 16;
 constexpr size_t TRADE_PAYLOAD_SIZE = 12;    // Price(8) + Quantity(4)
 constexpr size_t QUOTE_PAYLOAD_SIZE = 24;    // BidPrice(8) + BidQty(4) + AskPrice(8) + AskQty(4)
+constexpr size_t DEPTH_PAYLOAD_SIZE = 16;    // Side(1) + Action(1) + Level(1) + Reserved(1) + Price(8) + Qty(4)
 constexpr size_t CHECKSUM_SIZE = 4;
 
 constexpr size_t TRADE_MSG_SIZE = HEADER_SIZE + TRADE_PAYLOAD_SIZE + CHECKSUM_SIZE;
 constexpr size_t QUOTE_MSG_SIZE = HEADER_SIZE + QUOTE_PAYLOAD_SIZE + CHECKSUM_SIZE;
 constexpr size_t HEARTBEAT_MSG_SIZE = HEADER_SIZE + CHECKSUM_SIZE;
+constexpr size_t DEPTH_MSG_SIZE = HEADER_SIZE + DEPTH_PAYLOAD_SIZE + CHECKSUM_SIZE;
+constexpr size_t MAX_MSG_SIZE = QUOTE_MSG_SIZE;   // Largest message type
 
+// v2 payloads replace double prices with int32 paisa
+constexpr size_t TRADE_V2_PAYLOAD_SIZE = 8;  // Price(4) + Quantity(4)
+constexpr size_t QUOTE_V2_PAYLOAD_SIZE = 16; // BidPrice(4) + BidQty(4) + AskPrice(4) + AskQty(4)
+constexpr size_t DEPTH_V2_PAYLOAD_SIZE = 12; // Side(1) + Action(1) + Level(1) + Reserved(1) + Price(4) + Qty(4)
+
+constexpr size_t TRADE_V2_MSG_SIZE = HEADER_SIZE + TRADE_V2_PAYLOAD_SIZE + CHECKSUM_SIZE;
+constexpr size_t QUOTE_V2_MSG_SIZE = HEADER_SIZE + QUOTE_V2_PAYLOAD_SIZE + CHECKSUM_SIZE;
+constexpr size_t DEPTH_V2_MSG_SIZE = HEADER_SIZE + DEPTH_V2_PAYLOAD_SIZE + CHECKSUM_SIZE;
+
+// Batched packets: BatchHeader + N * (BatchRecord + payload) + checksum
+constexpr size_t BATCH_HEADER_SIZE = 20;
+constexpr size_t BATCH_RECORD_SIZE = 8;
+constexpr size_t MAX_BATCH_PACKET_SIZE = 1472;   // Fits one Ethernet frame as UDP
+
+// UDP distribution: datagrams carry whole messages, gaps recovered over TCP
+constexpr size_t MAX_DATAGRAM_SIZE = 1472;
+constexpr size_t MAX_RETRANSMIT_COUNT = 1024;    // Messages per retransmit request
+
+// Fixed-point scale: 1 unit = 1 paisa
+constexpr int64_t PRICE_SCALE = 100;
+
+// Default symbol universe; caches are sized at runtime up to
+// MAX_SYMBOL_CAPACITY (symbol_id is 16 bits)
 constexpr size_t MAX_SYMBOLS = 500;
+constexpr size_t MAX_SYMBOL_CAPACITY = 65535;
 constexpr uint16_t DEFAULT_PORT = 9876;
 
+// Market-by-price depth
+constexpr size_t MIN_BOOK_LEVELS = 5;
+constexpr size_t MAX_BOOK_LEVELS = 20;
+constexpr size_t DEFAULT_BOOK_LEVELS = 10;
+
 // Message Header (16 bytes)
 #pragma pack(push, 1)
 struct MessageHeader {
-    uint16_t message_type;      // 0x01=Trade, 0x02=Quote, 0x03=Heartbeat
+    uint16_t message_type;      // 0x01=Trade, 0x02=Quote, 0x03=Heartbeat, 0x04=Depth
     uint32_t sequence_number;   // Monotonically increasing
     uint64_t timestamp_ns;      // Nanoseconds since epoch
     uint16_t symbol_id;         // 0-499 for 500 symbols
@@ -51,6 +111,40 @@ struct QuotePayload {
     uint32_t ask_quantity;      // 4 bytes
 };
 
+// Depth Update Payload (16 bytes) - incremental market-by-price change
+struct DepthUpdatePayload {
+    uint8_t side;               // BookSide
+    uint8_t action;             // BookAction
+    uint8_t level;              // 0 = best price
+    uint8_t reserved;
+    double price;               // 8 bytes
+    uint32_t quantity;          // 4 bytes (aggregate at level)
+};
+
+// v2 Trade Payload (8 bytes)
+struct TradePayloadV2 {
+    int32_t price;              // Paisa
+    uint32_t quantity;
+};
+
+// v2 Quote Payload (16 bytes)
+struct QuotePayloadV2 {
+    int32_t bid_price;          // Paisa
+    uint32_t bid_quantity;
+    int32_t ask_price;          // Paisa
+    uint32_t ask_quantity;
+};
+
+// v2 Depth Update Payload (12 bytes)
+struct DepthUpdatePayloadV2 {
+    uint8_t side;
+    uint8_t action;
+    uint8_t level;
+    uint8_t reserved;
+    int32_t price;              // Paisa
+    uint32_t quantity;
+};
+
 // Complete Trade Message
 struct TradeMessage {
     MessageHeader header;
@@ -65,18 +159,62 @@ struct QuoteMessage {
     uint32_t checksum;
 };
 
+// Complete Depth Update Message
+struct DepthUpdateMessage {
+    MessageHeader header;
+    DepthUpdatePayload payload;
+    uint32_t checksum;
+};
+
 // Heartbeat Message
 struct HeartbeatMessage {
     MessageHeader header;
     uint32_t checksum;
 };
 
+// Batch Packet Header (20 bytes)
+// Record sequence/timestamp are deltas from the previous record,
+// the first record's deltas are relative to the base values
+struct BatchHeader {
+    uint16_t message_type;      // 0x20
+    uint16_t message_count;
+    uint32_t base_sequence;
+    uint64_t base_timestamp_ns;
+    uint16_t packet_length;     // Header + records + checksum
+    uint16_t reserved;
+};
+
+// Per-message record in a batch (8 bytes), followed by the payload
+struct BatchRecord {
+    uint8_t message_type;       // Low byte of MessageType (v1 or v2 payload)
+    uint8_t sequence_delta;
+    uint16_t symbol_id;
+    uint32_t timestamp_delta_ns;
+};
+
 // Subscription Request
 struct SubscriptionRequest {
     uint8_t command;            // 0xFF
     uint16_t symbol_count;
     // Followed by symbol_count * uint16_t symbol_ids
 };
+
+// Versioned Subscription Request (symbol_count 0 = all symbols)
+struct SubscriptionRequestV2 {
+    uint8_t command;            // 0xFE
+    uint8_t protocol_version;   // PROTOCOL_V1 or PROTOCOL_V2
+    uint16_t symbol_count;
+    // Followed by symbol_count * uint16_t symbol_ids
+};
+
+// Retransmit Request (8 bytes) - server resends retained messages
+// [start_sequence, start_sequence + count) on the TCP connection
+struct RetransmitRequest {
+    uint8_t command;            // 0xFD
+    uint8_t reserved;
+    uint16_t count;
+    uint32_t start_sequence;
+};
 #pragma pack(pop)
 
 // Calculate XOR checksum of bytes
@@ -106,32 +244,106 @@ inline size_t get_message_size(MessageType type) {
         case MessageType::TRADE: return TRADE_MSG_SIZE;
         case MessageType::QUOTE: return QUOTE_MSG_SIZE;
         case MessageType::HEARTBEAT: return HEARTBEAT_MSG_SIZE;
+        case MessageType::DEPTH_UPDATE: return DEPTH_MSG_SIZE;
+        case MessageType::TRADE_V2: return TRADE_V2_MSG_SIZE;
+        case MessageType::QUOTE_V2: return QUOTE_V2_MSG_SIZE;
+        case MessageType::DEPTH_UPDATE_V2: return DEPTH_V2_MSG_SIZE;
         default: return 0;
     }
 }
 
-// Symbol names for display (sample NSE stocks)
-inline const char* get_symbol_name(uint16_t symbol_id) {
-    static const char* symbols[] = {
-        "RELIANCE", "TCS", "INFY", "HDFC", "ICICIBANK",
-        "HDFCBANK", "SBIN", "BHARTIARTL", "ITC", "KOTAKBANK",
-        "LT", "HINDUNILVR", "AXISBANK", "BAJFINANCE", "MARUTI",
-        "ASIANPAINT", "TITAN", "SUNPHARMA", "ULTRACEMCO", "WIPRO",
-        "HCLTECH", "TECHM", "POWERGRID", "NTPC", "ONGC",
-        "TATASTEEL", "JSWSTEEL", "COALINDIA", "BPCL", "IOC",
-        "GRASIM", "ADANIPORTS", "DRREDDY", "DIVISLAB", "CIPLA",
-        "APOLLOHOSP", "EICHERMOT", "HEROMOTOCO", "BAJAJ-AUTO", "M&M",
-        "TATAMOTORS", "NESTLEIND", "BRITANNIA", "DABUR", "GODREJCP",
-        "PIDILITIND", "BERGER", "HAVELLS", "VOLTAS", "BLUESTAR"
-        // Add more as needed, will use generic names for rest
-    };
+// Payload size for a message type (0 if unknown)
+inline size_t get_payload_size(MessageType type) {
+    size_t msg_size = get_message_size(type);
+    return msg_size ? msg_size - HEADER_SIZE - CHECKSUM_SIZE : 0;
+}
+
+// Fixed-point price conversion (round to nearest paisa)
+inline int32_t to_fixed_price(double price) {
+    double scaled = price * PRICE_SCALE;
+    return static_cast<int32_t>(scaled >= 0 ? scaled + 0.5 : scaled - 0.5);
+}
+
+inline double from_fixed_price(int32_t price) {
+    return static_cast<double>(price) / PRICE_SCALE;
+}
+
+// Re-encode a complete v1 message in v2 layout
+// Heartbeats carry no prices and are copied unchanged
+// Returns encoded size, or 0 if msg is not a valid v1 message
+inline size_t encode_v2(const uint8_t* msg, uint8_t* out) {
+    MessageHeader header;
+    std::memcpy(&header, msg, sizeof(header));
+    const uint8_t* payload = msg + HEADER_SIZE;
+    size_t payload_size;
+    
+    switch (static_cast<MessageType>(header.message_type)) {
+        case MessageType::TRADE: {
+            TradePayload v1;
+            std::memcpy(&v1, payload, sizeof(v1));
+            TradePayloadV2 v2{to_fixed_price(v1.price), v1.quantity};
+            header.message_type = static_cast<uint16_t>(MessageType::TRADE_V2);
+            std::memcpy(out + HEADER_SIZE, &v2, sizeof(v2));
+            payload_size = sizeof(v2);
+            break;
+        }
+        case MessageType::QUOTE: {
+            QuotePayload v1;
+            std::memcpy(&v1, payload, sizeof(v1));
+            QuotePayloadV2 v2{to_fixed_price(v1.bid_price), v1.bid_quantity,
+                              to_fixed_price(v1.ask_price), v1.ask_quantity};
+            header.message_type = static_cast<uint16_t>(MessageType::QUOTE_V2);
+            std::memcpy(out + HEADER_SIZE, &v2, sizeof(v2));
+            payload_size = sizeof(v2);
+            break;
+        }
+        case MessageType::DEPTH_UPDATE: {
+            DepthUpdatePayload v1;
+            std::memcpy(&v1, payload, sizeof(v1));
+            DepthUpdatePayloadV2 v2{v1.side, v1.action, v1.level, 0,
+                                    to_fixed_price(v1.price), v1.quantity};
+            header.message_type = static_cast<uint16_t>(MessageType::DEPTH_UPDATE_V2);
+            std::memcpy(out + HEADER_SIZE, &v2, sizeof(v2));
+            payload_size = sizeof(v2);
+            break;
+        }
+        case MessageType::HEARTBEAT:
+            payload_size = 0;
+            break;
+        default:
+            return 0;
+    }
     
-    constexpr size_t num_named = sizeof(symbols) / sizeof(symbols[0]);
-    if (symbol_id < num_named) {
-        return symbols[symbol_id];
+    std::memcpy(out, &header, sizeof(header));
+    size_t msg_size = HEADER_SIZE + payload_size;
+    uint32_t checksum = calculate_checksum(out, msg_size);
+    std::memcpy(out + msg_size, &checksum, sizeof(checksum));
+    return msg_size + CHECKSUM_SIZE;
+}
+
+// Sample NSE stocks, the built-in names for the first symbol ids
+constexpr const char* SAMPLE_SYMBOL_NAMES[] = {
+    "RELIANCE", "TCS", "INFY", "HDFC", "ICICIBANK",
+    "HDFCBANK", "SBIN", "BHARTIARTL", "ITC", "KOTAKBANK",
+    "LT", "HINDUNILVR", "AXISBANK", "BAJFINANCE", "MARUTI",
+    "ASIANPAINT", "TITAN", "SUNPHARMA", "ULTRACEMCO", "WIPRO",
+    "HCLTECH", "TECHM", "POWERGRID", "NTPC", "ONGC",
+    "TATASTEEL", "JSWSTEEL", "COALINDIA", "BPCL", "IOC",
+    "GRASIM", "ADANIPORTS", "DRREDDY", "DIVISLAB", "CIPLA",
+    "APOLLOHOSP", "EICHERMOT", "HEROMOTOCO", "BAJAJ-AUTO", "M&M",
+    "TATAMOTORS", "NESTLEIND", "BRITANNIA", "DABUR", "GODREJCP",
+    "PIDILITIND", "BERGER", "HAVELLS", "VOLTAS", "BLUESTAR"
+};
+constexpr size_t NUM_SAMPLE_SYMBOLS = sizeof(SAMPLE_SYMBOL_NAMES) / sizeof(SAMPLE_SYMBOL_NAMES[0]);
+
+// Symbol name for display (generic SYMnnn past the sample names)
+// Formats into a per-thread buffer; hot paths use SymbolMaster instead
+inline const char* get_symbol_name(uint16_t symbol_id) {
+    if (symbol_id < NUM_SAMPLE_SYMBOLS) {
+        return SAMPLE_SYMBOL_NAMES[symbol_id];
     }
     
-    static char buffer[16];
+    thread_local char buffer[16];
     snprintf(buffer, sizeof(buffer), "SYM%03u", symbol_id);
     return buffer;
 }
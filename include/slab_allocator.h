@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include "memory_pool.h"
+
+namespace mdf {
+
+// Size-class slab allocator for variable-size allocations
+// One MemoryPool per power-of-two class from 64B to 64KB, so each class
+// gets the pool's lock-free free stack and per-thread magazines. A request
+// is rounded up to its class; a request above the largest class, or one
+// whose class is exhausted, goes to the upstream resource and is counted
+// against the class it missed. Blocks are freed by address, so a size
+// given to deallocate() only has to name the right class.
+//
+// Usable directly (allocate/deallocate from std::pmr::memory_resource) or
+// behind std::pmr containers. Class storage is a HugePageBuffer per class
+// under the process memory policy.
+class SlabAllocator : public std::pmr::memory_resource {
+public:
+    static constexpr size_t MIN_CLASS_SIZE = 64;
+    static constexpr size_t MAX_CLASS_SIZE = 64 * 1024;
+    static constexpr size_t NUM_CLASSES = 11;
+
+    // Storage per class; below the 256KB huge page threshold, so a class
+    // costs what it holds rather than a 2MB page
+    static constexpr size_t DEFAULT_CLASS_BYTES = 128 * 1024;
+
+    struct ClassStats {
+        size_t block_size = 0;
+        size_t capacity = 0;        // Blocks
+        size_t in_use = 0;          // Allocated, or cached by a thread
+        uint64_t fallbacks = 0;     // Requests sent upstream: class exhausted
+    };
+
+    // Every class gets class_bytes of storage (at least one block each)
+    explicit SlabAllocator(size_t class_bytes = DEFAULT_CLASS_BYTES,
+                           std::pmr::memory_resource* upstream =
+                               std::pmr::new_delete_resource());
+
+    // Class for a request of bytes; NUM_CLASSES if above the largest
+    static size_t class_index(size_t bytes) {
+        if (bytes <= MIN_CLASS_SIZE) return 0;
+        return static_cast<size_t>(64 - __builtin_clzll(bytes - 1)) - 6;
+    }
+    static size_t class_size(size_t index) { return MIN_CLASS_SIZE << index; }
+
+    // Pool serving requests of bytes, or nullptr above the largest class
+    MemoryPool* class_pool(size_t bytes) {
+        size_t index = class_index(bytes);
+        return index < NUM_CLASSES ? classes_[index].get() : nullptr;
+    }
+
+    // Whether ptr is a block of one of the classes
+    bool owns(const void* ptr) const;
+
+    ClassStats class_stats(size_t index) const;
+    uint64_t oversize_allocations() const {
+        return oversize_.load(std::memory_order_relaxed);
+    }
+    std::pmr::memory_resource* upstream() const { return upstream_; }
+
+    // Non-copyable
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+private:
+    std::array<std::unique_ptr<MemoryPool>, NUM_CLASSES> classes_;
+    std::array<std::atomic<uint64_t>, NUM_CLASSES> fallbacks_{};
+    std::atomic<uint64_t> oversize_{0};
+    std::pmr::memory_resource* upstream_;
+
+    // Class blocks are aligned to their size, up to the page alignment
+    // of the pool storage; a larger alignment goes upstream
+    static constexpr size_t MAX_ALIGNMENT = 4096;
+
+    // Class that meets alignment too, or NUM_CLASSES for upstream
+    static size_t class_for(size_t bytes, size_t alignment) {
+        if (alignment > MAX_ALIGNMENT) return NUM_CLASSES;
+        return class_index(bytes > alignment ? bytes : alignment);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace mdf
@@ -5,6 +5,8 @@
 #include <vector>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include "protocol.h"
 
 namespace mdf {
 
@@ -13,6 +15,8 @@ public:
     static constexpr size_t DEFAULT_RECV_BUFFER = 4 * 1024 * 1024;  // 4MB
     static constexpr uint32_t DEFAULT_TIMEOUT_MS = 5000;
     static constexpr int MAX_RETRY_COUNT = 5;
+    static constexpr size_t UDP_RECV_BUFFER = 16 * 1024 * 1024;  // 16MB
+    static constexpr size_t UDP_BATCH_SIZE = 64;  // Datagrams per recvmmsg
     
     MarketDataSocket();
     ~MarketDataSocket();
@@ -26,7 +30,27 @@ public:
     ssize_t receive(void* buffer, size_t max_len);
     
     // Send subscription request
-    bool send_subscription(const std::vector<uint16_t>& symbol_ids);
+    // PROTOCOL_V1 uses the legacy request; later versions use the
+    // versioned request so the server knows which layout to send
+    bool send_subscription(const std::vector<uint16_t>& symbol_ids,
+                           uint8_t protocol_version = PROTOCOL_V1);
+    
+    // Ask server to resend [start_sequence, start_sequence + count) over TCP
+    bool send_retransmit_request(uint32_t start_sequence, uint16_t count);
+    
+    // Open UDP receive socket (joins the group if address is multicast)
+    // Port 0 binds an ephemeral port, see udp_port()
+    bool open_udp(const std::string& address, uint16_t port,
+                  const std::string& interface_addr = "127.0.0.1");
+    void close_udp();
+    bool udp_open() const { return udp_fd_ >= 0; }
+    uint16_t udp_port() const;
+    
+    // Receive up to UDP_BATCH_SIZE datagrams with one recvmmsg call
+    // Returns datagram count, 0 for no data, -1 for error
+    int receive_datagrams();
+    const uint8_t* datagram(size_t i) const { return udp_buffers_.get() + i * MAX_DATAGRAM_SIZE; }
+    size_t datagram_size(size_t i) const { return datagram_sizes_[i]; }
     
     // Connection management
     bool is_connected() const { return connected_.load(); }
@@ -44,10 +68,15 @@ public:
     // Returns: 1 = data available, 0 = timeout, -1 = error
     int wait_for_data(uint32_t timeout_ms);
     
+    // kqueue/epoll fd the socket waits on (valid after connect or open_udp)
+    int event_fd() const { return event_fd_; }
+    
     // Statistics
     uint64_t bytes_received() const { return bytes_received_.load(); }
     uint64_t recv_calls() const { return recv_calls_.load(); }
     uint32_t reconnect_count() const { return reconnect_count_; }
+    uint64_t datagrams_received() const { return datagrams_received_; }
+    uint64_t truncated_datagrams() const { return truncated_datagrams_; }
     
     // Get last error message
     const std::string& last_error() const { return last_error_; }
@@ -59,6 +88,13 @@ public:
 private:
     int fd_ = -1;
     int event_fd_ = -1;  // kqueue/epoll fd
+    int udp_fd_ = -1;
+    
+    // recvmmsg destination buffers (allocated by open_udp)
+    std::unique_ptr<uint8_t[]> udp_buffers_;
+    size_t datagram_sizes_[UDP_BATCH_SIZE] = {};
+    uint64_t datagrams_received_ = 0;
+    uint64_t truncated_datagrams_ = 0;
     
     std::string host_;
     uint16_t port_ = 0;
@@ -77,6 +113,7 @@ private:
     
     // Update event system with socket
     bool register_socket();
+    bool register_fd(int fd);
     
     // Internal connect with timeout
     bool do_connect();
@@ -85,4 +122,32 @@ private:
     void configure_socket();
 };
 
+// Waits on several sockets at once
+// Registers each socket's own kqueue/epoll fd, which is itself pollable,
+// so a reconnect (new TCP fd, re-registered inside the socket) needs no
+// change here. A ready socket still needs its own wait_for_data(0) to
+// collect its events and detect errors.
+class SocketPoller {
+public:
+    SocketPoller();
+    ~SocketPoller();
+    
+    // Watch a connected socket; index is reported back by wait()
+    bool add(const MarketDataSocket& socket, uint32_t index);
+    
+    // Fill ready with the indices of sockets that have events
+    // Returns count, 0 for timeout, -1 for error
+    int wait(uint32_t timeout_ms, uint32_t* ready, int max_ready);
+    
+    const std::string& last_error() const { return last_error_; }
+    
+    // Non-copyable
+    SocketPoller(const SocketPoller&) = delete;
+    SocketPoller& operator=(const SocketPoller&) = delete;
+    
+private:
+    int event_fd_ = -1;
+    std::string last_error_;
+};
+
 } // namespace mdf
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace mdf {
+
+// Bounded single-producer single-consumer ring
+// Capacity is rounded up to a power of two. Each side caches the other's
+// index and only re-reads it when the ring looks full (producer) or when
+// the cached view cannot fill the batch (consumer), so the shared
+// indices' cache lines bounce only then.
+template <typename T>
+class SpscQueue {
+public:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        slots_.reset(new T[size]);
+    }
+
+    // Producer side
+    bool try_push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: up to max items, oldest first
+    size_t pop_batch(T* out, size_t max) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (tail_cache_ - head < max) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+
+            // Exact depth at each refresh; the high-water mark samples it
+            size_t depth = tail_cache_ - head;
+            if (depth > max_depth_.load(std::memory_order_relaxed)) {
+                max_depth_.store(depth, std::memory_order_relaxed);
+            }
+        }
+        size_t n = tail_cache_ - head;
+        if (n > max) n = max;
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = slots_[(head + i) & mask_];
+        }
+        if (n > 0) {
+            head_.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    bool try_pop(T& out) { return pop_batch(&out, 1) == 1; }
+
+    // Approximate from any thread
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return mask_ + 1; }
+    size_t max_depth() const { return max_depth_.load(std::memory_order_relaxed); }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+private:
+    // Consumer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t tail_cache_ = 0;
+    std::atomic<size_t> max_depth_{0};
+
+    // Producer-owned line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t head_cache_ = 0;
+
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<T[]> slots_;
+    size_t mask_ = 0;
+};
+
+} // namespace mdf
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "protocol.h"
+
+namespace mdf {
+
+// Reference data for one symbol (24 bytes, stored contiguously by id)
+struct SymbolInfo {
+    const char* name;       // Interned, NUL-terminated, owned by the table
+    double tick_size;       // Minimum price increment
+    uint32_t lot_size;      // Minimum tradable quantity
+    uint16_t name_length;
+    uint16_t id;
+};
+
+// Symbol master: names, tick sizes and lot sizes for ids [0, size())
+//
+// Built once at startup, then shared read-only: every lookup is const,
+// allocation-free and safe from any thread. Id lookup is an array index;
+// name lookup is a perfect hash (hash-and-displace) followed by a single
+// string compare. Names live in one contiguous arena.
+//
+// Reference-data file format, one symbol per line:
+//     symbol_id,name[,tick_size[,lot_size]]
+// Blank lines and lines starting with '#' are ignored. Ids the file does
+// not list keep their built-in defaults.
+class SymbolMaster {
+public:
+    static constexpr double DEFAULT_TICK_SIZE = 0.05;
+    static constexpr uint32_t DEFAULT_LOT_SIZE = 1;
+    static constexpr size_t MAX_NAME_LENGTH = 31;
+
+    // Built-in universe: the sample NSE names, then SYMnnn
+    explicit SymbolMaster(size_t num_symbols = MAX_SYMBOLS);
+
+    // Overlay a reference-data file. Returns false with last_error() set on
+    // a malformed file, unreadable file, id out of range or duplicate name;
+    // the table is unchanged then. Call before sharing the table.
+    bool load(const std::string& path);
+
+    // nullptr if id is out of range
+    const SymbolInfo* find(uint16_t symbol_id) const {
+        return symbol_id < records_.size() ? &records_[symbol_id] : nullptr;
+    }
+
+    // "?" if id is out of range
+    const char* name(uint16_t symbol_id) const {
+        return symbol_id < records_.size() ? records_[symbol_id].name : "?";
+    }
+
+    // Symbol id for a name, -1 if unknown
+    int id_of(std::string_view name) const;
+
+    size_t size() const { return records_.size(); }
+    const std::string& last_error() const { return last_error_; }
+
+private:
+    static constexpr uint16_t EMPTY_SLOT = 0xFFFF;  // Ids stop at 65534
+
+    std::vector<SymbolInfo> records_;
+    std::vector<char> names_;           // Arena behind SymbolInfo::name
+
+    // Perfect hash: a name's bucket picks a seed; the seeded hash picks a
+    // slot holding the id. Seeds are chosen at build time so that no two
+    // names share a slot.
+    std::vector<uint32_t> seeds_;
+    std::vector<uint16_t> slots_;
+    uint64_t bucket_mask_ = 0;
+    uint64_t slot_mask_ = 0;
+
+    std::string last_error_;
+
+    // Rebuild arena, records and index; false if two names collide
+    bool build(const std::vector<std::string>& names,
+               const std::vector<double>& tick_sizes,
+               const std::vector<uint32_t>& lot_sizes);
+};
+
+} // namespace mdf
@@ -5,6 +5,7 @@
 #include <random>
 #include <chrono>
 #include "protocol.h"
+#include "order_book.h"
 
 namespace mdf {
 
@@ -42,6 +43,10 @@ public:
     void generate_tick_for_symbol(uint16_t symbol_id,
                                    uint8_t* out_buffer, size_t& out_size);
     
+    // Generate incremental depth update (add/modify/delete) for symbol
+    void generate_depth_update(uint16_t symbol_id,
+                               uint8_t* out_buffer, size_t& out_size);
+    
     // Generate heartbeat message
     void generate_heartbeat(uint8_t* out_buffer, size_t& out_size);
     
@@ -52,12 +57,21 @@ public:
     void set_market_condition(MarketCondition condition);
     void set_time_step(double dt) { dt_ = dt; }
     
+    // Enable depth simulation with given number of levels (0 = disabled)
+    void set_depth_levels(size_t levels);
+    size_t depth_levels() const { return depth_levels_; }
+    
+    // Simulated order book for a symbol (empty if depth disabled)
+    const OrderBook& get_order_book(uint16_t symbol_id) const;
+    
     // Reset all symbol prices to initial values
     void reset();
     
     // Current sequence number
     uint32_t current_sequence() const { return sequence_; }
     
+    size_t num_symbols() const { return num_symbols_; }
+    
 private:
     size_t num_symbols_;
     std::vector<SymbolState> symbols_;
@@ -65,11 +79,18 @@ private:
     double dt_ = 0.001;  // Time step (1ms default)
     MarketCondition market_condition_ = MarketCondition::NEUTRAL;
     
+    // Depth simulation
+    static constexpr double DEPTH_UPDATE_RATIO = 0.3;   // Share of ticks that are depth updates
+    static constexpr double BOOK_TICK_SIZE = 0.05;      // Price step between levels
+    size_t depth_levels_ = 0;
+    std::vector<OrderBook> books_;
+    
     // Random number generation
     std::mt19937 rng_;
     std::normal_distribution<double> normal_dist_{0.0, 1.0};
     std::uniform_real_distribution<double> uniform_dist_{0.0, 1.0};
     std::uniform_int_distribution<uint16_t> symbol_dist_;
+    std::uniform_int_distribution<int32_t> qty_change_{-500, 500};   // Per quote side
     
     // Box-Muller transform state (for optimization)
     bool has_spare_ = false;
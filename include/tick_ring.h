@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "huge_pages.h"
+#include "protocol.h"
+
+namespace mdf {
+
+// Single-producer broadcast ring of encoded messages
+// The producer writes each message once, whatever the number of readers;
+// every reader keeps its own cursor and never writes shared state, so
+// readers don't slow the producer or each other. Each slot carries the
+// position it holds, stored after the payload (SeqLock style): a reader
+// that falls a whole ring behind finds its slots reused, skips to the
+// oldest message still there, and counts what it lost instead of
+// holding the producer back.
+class TickRing {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 16384;
+
+    enum class Kind : uint8_t { Tick, Heartbeat };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> position{0};  // position + 1 once written, 0 while writing
+        uint16_t symbol_id = 0;
+        Kind kind = Kind::Tick;
+        uint8_t size = 0;
+        uint8_t data[MAX_MSG_SIZE];
+    };
+    static_assert(sizeof(Slot) == 64, "Slot should fill one cache line");
+
+    // Capacity is rounded up to a power of two
+    explicit TickRing(size_t capacity = DEFAULT_CAPACITY)
+        : slots_(round_up(capacity)), mask_(slots_.size() - 1) {}
+
+    // Producer side: write the message into the returned buffer (up to
+    // MAX_MSG_SIZE bytes), then publish() it
+    uint8_t* claim() {
+        Slot& slot = slots_[head_local_ & mask_];
+        slot.position.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return slot.data;
+    }
+
+    void publish(size_t size, uint16_t symbol_id, Kind kind = Kind::Tick) {
+        Slot& slot = slots_[head_local_ & mask_];
+        slot.symbol_id = symbol_id;
+        slot.kind = kind;
+        slot.size = static_cast<uint8_t>(size);
+        slot.position.store(head_local_ + 1, std::memory_order_release);
+        head_.store(++head_local_, std::memory_order_release);
+    }
+
+    // Reader side: fn(data, size, symbol_id, kind) for every message from
+    // cursor up to the producer's head (or the next max of them), oldest
+    // first, advancing cursor. Returns messages lost to overwriting since
+    // the last call.
+    template <typename Fn>
+    uint64_t read(uint64_t& cursor, Fn&& fn, size_t max = SIZE_MAX) const {
+        uint64_t lost = 0;
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if (head - cursor > capacity()) {
+            lost += head - capacity() - cursor;
+            cursor = head - capacity();
+        }
+        if (head - cursor > max) {
+            head = cursor + max;
+        }
+
+        uint8_t data[MAX_MSG_SIZE];
+        for (; cursor < head; ++cursor) {
+            const Slot& slot = slots_[cursor & mask_];
+            uint64_t before = slot.position.load(std::memory_order_acquire);
+            if (before != cursor + 1) {
+                lost++;   // Already reused (or being rewritten)
+                continue;
+            }
+            uint16_t symbol_id = slot.symbol_id;
+            Kind kind = slot.kind;
+            size_t size = slot.size <= MAX_MSG_SIZE ? slot.size : MAX_MSG_SIZE;
+            std::memcpy(data, slot.data, size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.position.load(std::memory_order_relaxed) != before) {
+                lost++;   // Overwritten while we copied
+                continue;
+            }
+            fn(data, size, symbol_id, kind);
+        }
+        return lost;
+    }
+
+    // Position the next message will take; a reader starting here sees
+    // only messages published from now on
+    uint64_t head() const { return head_.load(std::memory_order_acquire); }
+    size_t capacity() const { return mask_ + 1; }
+    HugePageBuffer::Backing backing() const { return slots_.backing(); }
+
+    TickRing(const TickRing&) = delete;
+    TickRing& operator=(const TickRing&) = delete;
+
+private:
+    static size_t round_up(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    HugeArray<Slot> slots_;
+    size_t mask_;
+
+    // Producer-owned, on its own line
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t head_local_ = 0;
+};
+
+} // namespace mdf
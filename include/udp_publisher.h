@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <netinet/in.h>
+#include "protocol.h"
+
+namespace mdf {
+
+// UDP fan-out for the tick stream
+// Messages are packed into datagrams of up to MAX_DATAGRAM_SIZE bytes and
+// sent with one sendto per destination: a single multicast group, or a list
+// of unicast endpoints where multicast isn't routable. Recent messages are
+// retained so gaps can be resent over the client's TCP connection.
+class UdpPublisher {
+public:
+    static constexpr size_t RETRANSMIT_DEPTH = 65536;   // Messages retained (power of 2)
+
+    UdpPublisher();
+    ~UdpPublisher();
+
+    // Add destination (multicast group or unicast address)
+    // interface_addr selects the outgoing interface for multicast
+    bool add_destination(const std::string& address, uint16_t port,
+                         const std::string& interface_addr = "127.0.0.1");
+
+    // Queue complete message into the current datagram
+    // Sends the datagram first if the message doesn't fit
+    void publish(const void* msg, size_t len);
+
+    // Send the current datagram to all destinations
+    // Returns number of datagrams sent
+    size_t flush();
+
+    // Copy retained message with given sequence into out (MAX_MSG_SIZE)
+    // Returns message size, 0 if no longer retained
+    size_t lookup(uint32_t sequence, uint8_t* out) const;
+
+    // Statistics
+    size_t destination_count() const { return destinations_.size(); }
+    bool is_multicast() const { return multicast_; }
+    uint64_t datagrams_sent() const { return datagrams_sent_; }
+    uint64_t bytes_sent() const { return bytes_sent_; }
+    uint64_t send_errors() const { return send_errors_; }
+
+    const std::string& last_error() const { return last_error_; }
+
+    // Non-copyable
+    UdpPublisher(const UdpPublisher&) = delete;
+    UdpPublisher& operator=(const UdpPublisher&) = delete;
+
+private:
+    struct RetainedMessage {
+        uint32_t sequence;
+        uint8_t size;
+        uint8_t data[MAX_MSG_SIZE];
+    };
+
+    int fd_ = -1;
+    bool multicast_ = false;
+    std::vector<sockaddr_in> destinations_;
+
+    uint8_t datagram_[MAX_DATAGRAM_SIZE];
+    size_t datagram_size_ = 0;
+
+    std::unique_ptr<RetainedMessage[]> retained_;
+
+    uint64_t datagrams_sent_ = 0;
+    uint64_t bytes_sent_ = 0;
+    uint64_t send_errors_ = 0;
+    std::string last_error_;
+
+    // Create socket on first destination
+    bool open_socket();
+};
+
+} // namespace mdf
@@ -2,9 +2,12 @@
 
 #include <cstdint>
 #include <atomic>
+#include <chrono>
 #include <string>
+#include <vector>
 #include "cache.h"
 #include "latency_tracker.h"
+#include "symbol_master.h"
 
 namespace mdf {
 
@@ -24,8 +27,9 @@ public:
     void stop();
     
     // Set data sources
-    void set_cache(SymbolCache* cache) { cache_ = cache; }
+    void set_cache(SymbolCache* cache);
     void set_latency_tracker(LatencyTracker* tracker) { latency_tracker_ = tracker; }
+    void set_symbols(const SymbolMaster* symbols) { symbols_ = symbols; }
     
     // Update connection status
     void set_connected(bool connected, const std::string& server = "");
@@ -46,7 +50,14 @@ public:
     
 private:
     SymbolCache* cache_ = nullptr;
+    
+    // Local copy of every symbol, refreshed from the cache's change
+    // notifications so a render reads only what changed
+    int change_reader_ = -1;
+    std::vector<MarketState> states_;
+    std::vector<uint16_t> changed_ids_;
     LatencyTracker* latency_tracker_ = nullptr;
+    const SymbolMaster* symbols_ = nullptr;
     
     std::atomic<bool> running_{false};
     std::atomic<bool> connected_{false};
@@ -79,6 +90,9 @@ private:
     // Render the display
     void render();
     
+    // Pull changed symbols into states_
+    void refresh_states();
+    
     // Render sections
     void render_header();
     void render_market_table();
@@ -1,84 +1,335 @@
 #include "feed_handler.h"
+#include "cpu_affinity.h"
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 
 namespace mdf {
 
+static uint64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Pipeline stage idle wait: yield first (returns at once on a dedicated
+// core, so the stage stays hot), then sleep so an idle feed does not burn
+// a core per stage
+class Backoff {
+public:
+  void reset() { count_ = 0; }
+  void wait() {
+    if (++count_ < 256) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+
+private:
+  unsigned count_ = 0;
+};
+
+static void pin_stage(const char *stage, int core) {
+  if (!pin_current_thread(core)) {
+    std::cerr << "Could not pin " << stage << " thread to core " << core
+              << "\n";
+  }
+}
+
 FeedHandler::FeedHandler()
-    : socket_(std::make_unique<MarketDataSocket>()),
-      parser_(std::make_unique<MessageParser>()),
-      cache_(std::make_unique<SymbolCache>()),
+    : cache_(std::make_unique<SymbolCache>()),
+      depth_cache_(std::make_unique<DepthCache>()),
+      analytics_(std::make_unique<AnalyticsEngine>()),
       visualizer_(std::make_unique<Visualizer>()),
       latency_tracker_(std::make_unique<LatencyTracker>()),
-      recv_buffer_(new uint8_t[RECV_BUFFER_SIZE]) {
+      symbols_(std::make_shared<SymbolMaster>()) {
 
-  // Set up parser callbacks
-  parser_->set_trade_callback(
+  // Primary connection (and its parser callbacks)
+  create_connections();
+
+  // Set up visualizer
+  visualizer_->set_cache(cache_.get());
+  visualizer_->set_latency_tracker(latency_tracker_.get());
+  visualizer_->set_symbols(symbols_.get());
+}
+
+FeedHandler::~FeedHandler() {
+  stop();
+  for (auto *thread : {&recv_thread_, &parse_thread_, &apply_thread_}) {
+    if (thread->joinable()) {
+      thread->join();
+    }
+  }
+}
+
+void FeedHandler::set_parser_callbacks(MessageParser &parser) {
+  parser.set_trade_callback(
       [this](const MessageHeader &h, const TradePayload &p) {
         on_trade(h, p);
       });
 
-  parser_->set_quote_callback(
+  parser.set_quote_callback(
       [this](const MessageHeader &h, const QuotePayload &p) {
         on_quote(h, p);
       });
 
-  parser_->set_heartbeat_callback(
+  parser.set_depth_callback(
+      [this](const MessageHeader &h, const DepthUpdatePayload &p) {
+        on_depth(h, p);
+      });
+
+  parser.set_heartbeat_callback(
       [this](const MessageHeader &h) { on_heartbeat(h); });
+}
 
-  parser_->set_gap_callback([this](uint32_t expected, uint32_t received) {
-    on_sequence_gap(expected, received);
+void FeedHandler::set_line_callbacks(MessageParser &parser, size_t line) {
+  parser.set_trade_callback(
+      [this, line](const MessageHeader &h, const TradePayload &p) {
+        LineMessage msg;
+        msg.header = h;
+        msg.kind = MessageKind::Trade;
+        msg.trade = p;
+        arbiter_->on_message(line, msg, recv_ns_);
+      });
+
+  parser.set_quote_callback(
+      [this, line](const MessageHeader &h, const QuotePayload &p) {
+        LineMessage msg;
+        msg.header = h;
+        msg.kind = MessageKind::Quote;
+        msg.quote = p;
+        arbiter_->on_message(line, msg, recv_ns_);
+      });
+
+  parser.set_depth_callback(
+      [this, line](const MessageHeader &h, const DepthUpdatePayload &p) {
+        LineMessage msg;
+        msg.header = h;
+        msg.kind = MessageKind::Depth;
+        msg.depth = p;
+        arbiter_->on_message(line, msg, recv_ns_);
+      });
+
+  // Heartbeats are sequenced too: the arbiter needs them to see gaps close
+  parser.set_heartbeat_callback([this, line](const MessageHeader &h) {
+    LineMessage msg;
+    msg.header = h;
+    msg.kind = MessageKind::Heartbeat;
+    arbiter_->on_message(line, msg, recv_ns_);
   });
 
-  // Set up visualizer
-  visualizer_->set_cache(cache_.get());
-  visualizer_->set_latency_tracker(latency_tracker_.get());
+  // A line's own gaps are expected; only the arbiter's are losses
+  parser.set_gap_callback(nullptr);
+}
+
+void FeedHandler::apply_message(const LineMessage &msg) {
+  switch (msg.kind) {
+  case MessageKind::Trade:
+    on_trade(msg.header, msg.trade);
+    break;
+  case MessageKind::Quote:
+    on_quote(msg.header, msg.quote);
+    break;
+  case MessageKind::Depth:
+    on_depth(msg.header, msg.depth);
+    break;
+  case MessageKind::Heartbeat:
+    on_heartbeat(msg.header);
+    break;
+  }
+}
+
+void FeedHandler::create_connections() {
+  std::vector<FeedEndpoint> endpoints = config_.feeds;
+  if (endpoints.empty()) {
+    FeedEndpoint primary;
+    primary.host = config_.host;
+    primary.port = config_.port;
+    endpoints.push_back(primary);
+  }
+
+  arbiter_.reset();
+  if (config_.arbitrate && endpoints.size() > 1) {
+    arbiter_ = std::make_unique<LineArbiter>(
+        endpoints.size(), config_.arbitration_window,
+        static_cast<uint64_t>(config_.arbitration_hold_us) * 1000);
+    arbiter_->set_deliver_callback([this](const LineMessage &msg, size_t line) {
+      current_ = connections_[line].get();  // Latency goes to the winner
+      apply_message(msg);
+    });
+    arbiter_->set_gap_callback([this](uint32_t expected, uint32_t received) {
+      on_sequence_gap(expected, received);
+    });
+  }
+
+  connections_.clear();
+  for (const auto &endpoint : endpoints) {
+    auto conn = std::make_unique<FeedConnection>();
+    conn->endpoint = endpoint;
+    conn->socket = std::make_unique<MarketDataSocket>();
+    conn->parser = std::make_unique<MessageParser>();
+    conn->parser->set_symbol_limit(config_.num_symbols);
+    if (arbiter_) {
+      set_line_callbacks(*conn->parser, connections_.size());
+    } else {
+      set_parser_callbacks(*conn->parser);
+      conn->parser->set_gap_callback(
+          [this](uint32_t expected, uint32_t received) {
+            on_sequence_gap(expected, received);
+          });
+
+      // In UDP mode TCP carries retransmissions, which are out of order
+      if (config_.udp_port == 0) {
+        conn->parser->set_reorder_window(
+            config_.reorder_window,
+            static_cast<uint64_t>(config_.reorder_hold_us) * 1000);
+      }
+    }
+    if (endpoints.size() > 1) {
+      conn->latency = std::make_unique<LatencyTracker>();
+    }
+    connections_.push_back(std::move(conn));
+  }
+
+  socket_ = connections_[0]->socket.get();
+  parser_ = connections_[0]->parser.get();
+}
+
+const std::vector<uint16_t> &
+FeedHandler::subscriptions(const FeedConnection &conn) const {
+  return conn.endpoint.subscribe_symbols.empty() ? config_.subscribe_symbols
+                                                 : conn.endpoint.subscribe_symbols;
 }
 
-FeedHandler::~FeedHandler() { stop(); }
+bool FeedHandler::subscribe(FeedConnection &conn) {
+  // No request needed for the server's default (all symbols, v1)
+  const auto &symbols = subscriptions(conn);
+  if (symbols.empty() && config_.protocol_version == PROTOCOL_V1) {
+    return true;
+  }
+  return conn.socket->send_subscription(symbols, config_.protocol_version);
+}
 
 void FeedHandler::configure(const FeedHandlerConfig &config) {
   config_ = config;
+  config_.num_symbols = std::min(config_.num_symbols, MAX_SYMBOL_CAPACITY);
+  create_connections();
+
+  if (cache_->layout() != config_.cache_layout ||
+      cache_->num_symbols() != config_.num_symbols) {
+    visualizer_->set_cache(nullptr);
+    cache_ = std::make_unique<SymbolCache>(config_.num_symbols,
+                                           config_.cache_layout);
+    visualizer_->set_cache(cache_.get());
+  }
+  if (depth_cache_->num_symbols() != config_.num_symbols) {
+    depth_cache_ = std::make_unique<DepthCache>(config_.num_symbols);
+  }
+  if (!config_.enable_analytics) {
+    analytics_.reset();
+  } else if (!analytics_ || analytics_->num_symbols() != config_.num_symbols) {
+    analytics_ = std::make_unique<AnalyticsEngine>(config_.num_symbols);
+  }
+
+  if (config_.symbols) {
+    symbols_ = config_.symbols;
+  } else if (symbols_->size() != config_.num_symbols) {
+    symbols_ = std::make_shared<SymbolMaster>(config_.num_symbols);
+  }
+  visualizer_->set_symbols(symbols_.get());
 }
 
 bool FeedHandler::start() {
-  // Connect to server
-  std::cout << "Connecting to " << config_.host << ":" << config_.port
-            << "...\n";
-
-  if (!socket_->connect(config_.host, config_.port,
-                        config_.connect_timeout_ms)) {
-    std::cerr << "Failed to connect: " << socket_->last_error() << "\n";
+  if (config_.udp_port != 0 && connections_.size() > 1) {
+    std::cerr << "UDP mode needs a single feed\n";
     return false;
   }
+  if (arbiter_ && connections_.size() > LineArbiter::MAX_LINES) {
+    std::cerr << "Arbitration supports at most " << LineArbiter::MAX_LINES
+              << " lines\n";
+    return false;
+  }
+
+  for (auto &conn : connections_) {
+    // Connect to server
+    const FeedEndpoint &endpoint = conn->endpoint;
+    std::cout << "Connecting to " << endpoint.host << ":" << endpoint.port
+              << "...\n";
 
-  std::cout << "Connected!\n";
+    if (!conn->socket->connect(endpoint.host, endpoint.port,
+                               config_.connect_timeout_ms)) {
+      std::cerr << "Failed to connect: " << conn->socket->last_error() << "\n";
+      return false;
+    }
+
+    std::cout << "Connected!\n";
 
-  // Send subscription if specified
-  if (!config_.subscribe_symbols.empty()) {
-    if (!socket_->send_subscription(config_.subscribe_symbols)) {
+    // Send subscription if specified (or to negotiate a newer protocol)
+    if (!subscribe(*conn)) {
       std::cerr << "Failed to send subscription\n";
       return false;
     }
-    std::cout << "Subscribed to " << config_.subscribe_symbols.size()
-              << " symbols\n";
+    const auto &symbols = subscriptions(*conn);
+    if (!symbols.empty() || config_.protocol_version != PROTOCOL_V1) {
+      std::cout << "Subscribed to "
+                << (symbols.empty() ? std::string("all")
+                                    : std::to_string(symbols.size()))
+                << " symbols (protocol v"
+                << static_cast<int>(config_.protocol_version) << ")\n";
+    }
+  }
+
+  // UDP mode: ticks arrive on UDP, TCP carries heartbeats and retransmissions
+  if (config_.udp_port != 0 && !udp_parser_) {
+    if (!socket_->open_udp(config_.udp_address, config_.udp_port,
+                           config_.udp_interface)) {
+      std::cerr << "Failed to open UDP feed: " << socket_->last_error() << "\n";
+      return false;
+    }
+    std::cout << "Receiving UDP feed on " << config_.udp_address << ":"
+              << config_.udp_port << "\n";
+
+    udp_parser_ = std::make_unique<MessageParser>();
+    udp_parser_->set_symbol_limit(config_.num_symbols);
+    set_parser_callbacks(*udp_parser_);
+    udp_parser_->set_gap_callback(
+        [this](uint32_t expected, uint32_t received) {
+          on_udp_gap(expected, received);
+        });
+    udp_parser_->set_reorder_window(
+        config_.reorder_window,
+        static_cast<uint64_t>(config_.reorder_hold_us) * 1000);
+
+    // Retransmissions aren't contiguous, so TCP gaps mean nothing here
+    parser_->set_gap_callback(nullptr);
+    symbol_sequence_.assign(config_.num_symbols, 0);
   }
 
   // Start visualizer if enabled
   if (config_.enable_visualization) {
-    visualizer_->set_connected(true, config_.host + ":" +
-                                         std::to_string(config_.port));
+    visualizer_->set_connected(
+        true, connections_.size() == 1
+                  ? connections_[0]->endpoint.host + ":" +
+                        std::to_string(connections_[0]->endpoint.port)
+                  : std::to_string(connections_.size()) + " feeds");
     visualizer_->start();
   }
 
+  // Receive buffers follow the memory policy set by now
+  if (!chunk_pool_) {
+    chunk_pool_ = std::make_unique<MemoryPool>(RECV_CHUNK_SIZE, RECV_CHUNKS);
+  }
+
   // Open dump file if specified
   if (!config_.dump_file.empty()) {
     dump_file_ = std::make_unique<std::ofstream>(config_.dump_file);
     if (dump_file_->is_open()) {
       std::cout << "Dumping messages to: " << config_.dump_file << "\n";
       *dump_file_
-          << "Type,Seq,Timestamp,Symbol,Price,Quantity,Bid,BidQty,Ask,AskQty\n";
+          << "Type,Seq,Timestamp,Symbol,Price,Quantity,Bid,BidQty,Ask,AskQty,"
+             "Level,Action\n";
     } else {
       std::cerr << "Failed to open dump file: " << config_.dump_file << "\n";
       dump_file_.reset();
@@ -96,6 +347,22 @@ void FeedHandler::run() {
     }
   }
 
+  if (connections_.size() > 1) {
+    if (config_.pipeline) {
+      std::cerr << "Pipeline mode needs a single feed, running inline\n";
+    }
+    run_feeds();
+    return;
+  }
+
+  if (config_.pipeline) {
+    if (config_.udp_port == 0) {
+      run_pipeline();
+      return;
+    }
+    std::cerr << "Pipeline mode is TCP-only, running inline\n";
+  }
+
   while (running_.load()) {
     // Check for user input (quit/reset)
     if (config_.enable_visualization && visualizer_->process_input()) {
@@ -103,96 +370,451 @@ void FeedHandler::run() {
       break;
     }
 
-    // Wait for data with timeout
-    int result = socket_->wait_for_data(100); // 100ms timeout
+    // Wait for data with timeout (short while the reorder buffer holds
+    // messages, so a gap is declared on time even if the feed goes quiet)
+    bool holding = tick_parser().reorder_depth() > 0;
+    int result = socket_->wait_for_data(holding ? 1 : 100);
 
     if (result < 0) {
       // Error - try to reconnect
-      if (config_.enable_visualization) {
-        visualizer_->set_connected(false);
-      }
-
-      if (config_.auto_reconnect) {
-        std::cerr << "Connection lost, attempting reconnect...\n";
-        if (socket_->reconnect()) {
-          std::cout << "Reconnected!\n";
-          if (config_.enable_visualization) {
-            visualizer_->set_connected(true);
-          }
-          if (!config_.subscribe_symbols.empty()) {
-            socket_->send_subscription(config_.subscribe_symbols);
-          }
-        } else if (socket_->reconnect_count() >=
-                   MarketDataSocket::MAX_RETRY_COUNT) {
-          std::cerr << "Failed to reconnect after "
-                    << socket_->reconnect_count() << " attempts\n";
-          stop();
-          break;
-        }
-      } else {
+      if (!handle_connection_loss(*connections_[0])) {
         stop();
         break;
       }
       continue;
     }
 
+    if (result == 0 && holding) {
+      tick_parser().expire_reorder(steady_now_ns());
+    }
+
     if (result > 0) {
-      process_data();
+      process_datagrams();
+      process_data(*connections_[0]);
+
+      auto now = std::chrono::steady_clock::now();
+      if (now - last_snapshot_ >= SNAPSHOT_INTERVAL) {
+        cache_->publish_snapshot();
+        last_snapshot_ = now;
+      }
+    }
+
+    // Update visualizer
+    if (config_.enable_visualization) {
+      update_visualizer();
+    }
+  }
+}
+
+void FeedHandler::run_feeds() {
+  SocketPoller poller;
+  for (uint32_t i = 0; i < connections_.size(); ++i) {
+    if (!poller.add(*connections_[i]->socket, i)) {
+      std::cerr << "Failed to poll feed: " << poller.last_error() << "\n";
+      stop();
+      return;
+    }
+  }
+
+  // Each feed gets a bounded number of receives per round, so one busy
+  // feed cannot starve the others; leftovers carry over to the next round
+  constexpr int FEED_RECV_BUDGET = 64;
+  std::vector<uint32_t> ready(connections_.size());
+
+  while (running_.load()) {
+    // Check for user input (quit/reset)
+    if (config_.enable_visualization && visualizer_->process_input()) {
+      stop();
+      break;
+    }
+
+    bool backlog = false;
+    bool holding = arbiter_ && arbiter_->held() > 0;
+    for (const auto &conn : connections_) {
+      backlog |= conn->pending;
+      holding |= conn->parser->reorder_depth() > 0;
+    }
+
+    // A gap waiting on the other lines (or in a reorder buffer) needs its
+    // hold timer checked soon
+    int timeout = backlog ? 0 : (holding ? 1 : 100);
+    int count = poller.wait(timeout, ready.data(),
+                            static_cast<int>(ready.size()));
+    if (count < 0) {
+      std::cerr << "Feed poll failed: " << poller.last_error() << "\n";
+      stop();
+      break;
+    }
+    for (int i = 0; i < count; ++i) {
+      // Collect the socket's own events (marks it disconnected on error)
+      FeedConnection &conn = *connections_[ready[i]];
+      if (conn.active && conn.socket->wait_for_data(0) > 0) {
+        conn.pending = true;
+      }
+    }
+
+    size_t active = 0;
+    bool applied = false;
+    for (auto &conn : connections_) {
+      if (!running_.load()) {
+        break;  // Stopped: sockets were closed on purpose
+      }
+      if (conn->active && !conn->socket->is_connected() &&
+          !handle_connection_loss(*conn)) {
+        std::cerr << "Dropping feed " << conn->endpoint.host << ":"
+                  << conn->endpoint.port << "\n";
+        conn->active = false;
+        conn->pending = false;
+      }
+      if (!conn->active) {
+        continue;
+      }
+      active++;
+      if (conn->pending) {
+        conn->pending = !process_data(*conn, FEED_RECV_BUDGET);
+        applied = true;
+      }
+    }
+    if (holding && running_.load()) {
+      uint64_t now = steady_now_ns();
+      if (arbiter_) {
+        arbiter_->poll(now);
+      }
+      for (auto &conn : connections_) {
+        conn->parser->expire_reorder(now);
+      }
+    }
+    current_ = nullptr;
+
+    if (active == 0 && running_.load()) {
+      stop();
+      break;
+    }
+
+    if (applied) {
+      auto now = std::chrono::steady_clock::now();
+      if (now - last_snapshot_ >= SNAPSHOT_INTERVAL) {
+        cache_->publish_snapshot();
+        last_snapshot_ = now;
+      }
     }
 
     // Update visualizer
     if (config_.enable_visualization) {
-      visualizer_->update_stats(messages_received_.load(),
-                                bytes_received_.load(),
-                                parser_->sequence_gaps());
+      update_visualizer();
+    }
+  }
+}
+
+bool FeedHandler::handle_connection_loss(FeedConnection &conn) {
+  // May run on the receive stage; the main thread tells the visualizer
+  connection_changed_.store(true, std::memory_order_release);
+
+  if (!config_.auto_reconnect) {
+    return false;
+  }
+
+  std::cerr << "Connection to " << conn.endpoint.host << ":"
+            << conn.endpoint.port << " lost, attempting reconnect...\n";
+  if (conn.socket->reconnect()) {
+    std::cout << "Reconnected!\n";
+    connection_changed_.store(true, std::memory_order_release);
+    subscribe(conn);
+  } else if (conn.socket->reconnect_count() >=
+             MarketDataSocket::MAX_RETRY_COUNT) {
+    std::cerr << "Failed to reconnect after " << conn.socket->reconnect_count()
+              << " attempts\n";
+    return false;
+  }
+  return true;
+}
+
+void FeedHandler::update_visualizer() {
+  if (connection_changed_.exchange(false, std::memory_order_acq_rel)) {
+    visualizer_->set_connected(is_connected());
+  }
+  visualizer_->update_stats(messages_received_.load(), bytes_received_.load(),
+                            sequence_gaps());
+}
+
+void FeedHandler::run_pipeline() {
+  raw_queue_ = std::make_unique<SpscQueue<RawChunk>>(RECV_CHUNKS);
+  event_queue_ = std::make_unique<SpscQueue<FeedEvent>>(PIPELINE_EVENTS);
+  if (!parse_wait_) {
+    parse_wait_ = std::make_unique<LatencyTracker>();
+    apply_wait_ = std::make_unique<LatencyTracker>();
+  }
+
+  // The parser decodes on the parse thread; everything else (sequence
+  // filter, latency, cache, analytics, dump) happens on the apply thread.
+  // Heartbeats carry nothing to apply and are not forwarded.
+  parser_->set_trade_callback(
+      [this](const MessageHeader &h, const TradePayload &p) {
+        FeedEvent event;
+        event.header = h;
+        event.kind = EventKind::Trade;
+        event.trade = p;
+        push_event(event);
+      });
+  parser_->set_quote_callback(
+      [this](const MessageHeader &h, const QuotePayload &p) {
+        FeedEvent event;
+        event.header = h;
+        event.kind = EventKind::Quote;
+        event.quote = p;
+        push_event(event);
+      });
+  parser_->set_depth_callback(
+      [this](const MessageHeader &h, const DepthUpdatePayload &p) {
+        FeedEvent event;
+        event.header = h;
+        event.kind = EventKind::Depth;
+        event.depth = p;
+        push_event(event);
+      });
+  parser_->set_heartbeat_callback(nullptr);
+
+  apply_thread_ = std::thread(&FeedHandler::apply_stage, this);
+  parse_thread_ = std::thread(&FeedHandler::parse_stage, this);
+  recv_thread_ = std::thread(&FeedHandler::recv_stage, this);
+
+  while (running_.load()) {
+    if (config_.enable_visualization) {
+      if (visualizer_->process_input()) {
+        stop();
+        break;
+      }
+      update_visualizer();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  recv_thread_.join();
+  parse_thread_.join();
+  apply_thread_.join();
+
+  // Buffers still queued at shutdown go back to the pool
+  RawChunk chunk;
+  while (raw_queue_->try_pop(chunk)) {
+    chunk_pool_->deallocate(chunk.data);
+  }
+  set_parser_callbacks(*parser_);
+}
+
+void FeedHandler::recv_stage() {
+  pin_stage("receive", config_.recv_core);
+
+  Backoff stalled;
+  while (running_.load()) {
+    int result = socket_->wait_for_data(10);
+    if (result < 0) {
+      if (running_.load() && !handle_connection_loss(*connections_[0])) {
+        stop();
+      }
+      continue;
+    }
+    if (result == 0) {
+      continue;
+    }
+
+    // Drain the socket, one pool buffer per receive
+    while (running_.load()) {
+      void *block = chunk_pool_->allocate();
+      if (!block) {
+        // Every buffer is queued: the parser is behind
+        recv_stalls_.fetch_add(1, std::memory_order_relaxed);
+        stalled.wait();
+        continue;
+      }
+      stalled.reset();
+
+      ssize_t n = socket_->receive(block, RECV_CHUNK_SIZE);
+      if (n <= 0) {
+        chunk_pool_->deallocate(block);
+        break;  // Drained, or an error the next wait reports
+      }
+      bytes_received_.fetch_add(n, std::memory_order_relaxed);
+
+      // Never full: the queue holds as many entries as the pool has buffers
+      raw_queue_->try_push(
+          RawChunk{block, static_cast<uint32_t>(n), steady_now_ns()});
+    }
+  }
+}
+
+void FeedHandler::parse_stage() {
+  pin_stage("parse", config_.parse_core);
+
+  RawChunk chunks[16];
+  Backoff idle;
+  while (running_.load()) {
+    size_t n = raw_queue_->pop_batch(chunks, 16);
+    if (n == 0) {
+      if (parser_->reorder_depth() > 0) {
+        parser_->expire_reorder(steady_now_ns());
+      }
+      idle.wait();
+      continue;
+    }
+    idle.reset();
+
+    uint64_t now = steady_now_ns();
+    for (size_t i = 0; i < n; ++i) {
+      parse_wait_->record(now - chunks[i].recv_ns);
+      parse_chunk_ns_ = chunks[i].recv_ns;
+      size_t parsed = parser_->parse_buffer(chunks[i].data, chunks[i].size);
+      chunk_pool_->deallocate(chunks[i].data);
+      messages_received_.fetch_add(parsed, std::memory_order_relaxed);
     }
   }
 }
 
-void FeedHandler::process_data() {
+void FeedHandler::push_event(const FeedEvent &event) {
+  FeedEvent stamped = event;
+  stamped.recv_ns = parse_chunk_ns_;
+  if (event_queue_->try_push(stamped)) {
+    return;
+  }
+
+  parse_stalls_.fetch_add(1, std::memory_order_relaxed);
+  Backoff full;
+  while (running_.load() && !event_queue_->try_push(stamped)) {
+    full.wait();
+  }
+}
+
+void FeedHandler::apply_stage() {
+  pin_stage("apply", config_.apply_core);
+
+  std::unique_ptr<FeedEvent[]> events(new FeedEvent[PIPELINE_BATCH]);
+  Backoff idle;
+  while (running_.load()) {
+    size_t n = event_queue_->pop_batch(events.get(), PIPELINE_BATCH);
+    if (n == 0) {
+      idle.wait();
+      continue;
+    }
+    idle.reset();
+
+    apply_wait_->record(steady_now_ns() - events[0].recv_ns);
+    for (size_t i = 0; i < n; ++i) {
+      const FeedEvent &event = events[i];
+      switch (event.kind) {
+      case EventKind::Trade:
+        on_trade(event.header, event.trade);
+        break;
+      case EventKind::Quote:
+        on_quote(event.header, event.quote);
+        break;
+      case EventKind::Depth:
+        on_depth(event.header, event.depth);
+        break;
+      }
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_snapshot_ >= SNAPSHOT_INTERVAL) {
+      cache_->publish_snapshot();
+      last_snapshot_ = now;
+    }
+  }
+}
+
+bool FeedHandler::process_data(FeedConnection &conn, int max_iterations) {
   // Receive data but limit iterations to allow visualization updates
-  // Process up to 1000 recv calls or 50ms, whichever comes first
+  // Process up to max_iterations recv calls or 50ms, whichever comes first
   auto start = std::chrono::steady_clock::now();
   int iterations = 0;
-  const int max_iterations = 1000;
   const auto max_duration = std::chrono::milliseconds(50);
+  current_ = &conn;
 
   while (running_.load() && iterations < max_iterations) {
     // Check if we've been processing too long
     if (iterations % 100 == 0) {
       auto elapsed = std::chrono::steady_clock::now() - start;
       if (elapsed >= max_duration) {
-        break; // Return to main loop for visualization update
+        return false; // Return to main loop for visualization update
       }
     }
 
-    ssize_t n = socket_->receive(recv_buffer_.get(), RECV_BUFFER_SIZE);
+    PoolBuffer block(chunk_pool_.get(), chunk_pool_->allocate());
+    if (!block) {
+      return true; // Every buffer is in use
+    }
+    ssize_t n = conn.socket->receive(block.data(), RECV_CHUNK_SIZE);
 
     if (n < 0) {
       // Error - will be handled in main loop
-      return;
+      return true;
     }
 
     if (n == 0) {
       // No more data available
-      break;
+      return true;
     }
 
-    // Feed to parser
-    parser_->append_data(recv_buffer_.get(), static_cast<size_t>(n));
     bytes_received_.fetch_add(n, std::memory_order_relaxed);
+    conn.bytes_received.fetch_add(n, std::memory_order_relaxed);
 
-    // Parse all complete messages
-    size_t parsed = parser_->parse_messages();
+    // Parse all complete messages in place
+    if (arbiter_) {
+      recv_ns_ = steady_now_ns();
+    }
+    size_t parsed =
+        conn.parser->parse_buffer(block.data(), static_cast<size_t>(n));
     messages_received_.fetch_add(parsed, std::memory_order_relaxed);
+    conn.messages_received.fetch_add(parsed, std::memory_order_relaxed);
 
     iterations++;
   }
+  return !running_.load();
 }
 
-void FeedHandler::on_trade(const MessageHeader &header,
-                           const TradePayload &payload) {
-  // Record latency (time from message timestamp to now)
+void FeedHandler::process_datagrams() {
+  if (!udp_parser_) {
+    return;
+  }
+
+  // Drain the socket (edge-triggered), bounded like process_data()
+  auto start = std::chrono::steady_clock::now();
+  const auto max_duration = std::chrono::milliseconds(50);
+
+  while (running_.load() &&
+         std::chrono::steady_clock::now() - start < max_duration) {
+    int count = socket_->receive_datagrams();
+    if (count <= 0) {
+      break;
+    }
+
+    // Each datagram holds whole messages
+    for (int i = 0; i < count; ++i) {
+      size_t size = socket_->datagram_size(i);
+      if (size == 0) {
+        continue;  // Truncated - dropped
+      }
+      udp_parser_->append_data(socket_->datagram(i), size);
+      bytes_received_.fetch_add(size, std::memory_order_relaxed);
+      messages_received_.fetch_add(udp_parser_->parse_messages(),
+                                   std::memory_order_relaxed);
+    }
+  }
+}
+
+bool FeedHandler::accept_sequence(const MessageHeader &header) {
+  // TCP mode: one ordered stream, always newer
+  if (symbol_sequence_.empty() || header.symbol_id >= symbol_sequence_.size()) {
+    return true;
+  }
+
+  uint32_t &last = symbol_sequence_[header.symbol_id];
+  if (last != 0 && header.sequence_number < last) {
+    return false;  // Late retransmission
+  }
+  last = header.sequence_number + 1;
+  return true;
+}
+
+void FeedHandler::record_latency(const MessageHeader &header) {
   auto now = std::chrono::high_resolution_clock::now();
   uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
                         now.time_since_epoch())
@@ -200,17 +822,34 @@ void FeedHandler::on_trade(const MessageHeader &header,
 
   if (now_ns > header.timestamp_ns) {
     latency_tracker_->record(now_ns - header.timestamp_ns);
+    if (current_ && current_->latency) {
+      current_->latency->record(now_ns - header.timestamp_ns);
+    }
+  }
+}
+
+void FeedHandler::on_trade(const MessageHeader &header,
+                           const TradePayload &payload) {
+  if (!accept_sequence(header)) {
+    return;
   }
 
+  // Record latency (time from message timestamp to now)
+  record_latency(header);
+
   // Update cache
   cache_->update_trade(header.symbol_id, payload.price, payload.quantity,
                        header.timestamp_ns);
+  if (analytics_) {
+    analytics_->on_trade(header.symbol_id, payload.price, payload.quantity,
+                         header.timestamp_ns);
+  }
 
   // Dump to file if enabled
   if (dump_file_ && dump_file_->is_open()) {
     *dump_file_ << "TRADE," << header.sequence_number << ","
                 << header.timestamp_ns << ","
-                << get_symbol_name(header.symbol_id) << "," << std::fixed
+                << symbols_->name(header.symbol_id) << "," << std::fixed
                 << std::setprecision(2) << payload.price << ","
                 << payload.quantity << ",,,\n";
   }
@@ -218,32 +857,64 @@ void FeedHandler::on_trade(const MessageHeader &header,
 
 void FeedHandler::on_quote(const MessageHeader &header,
                            const QuotePayload &payload) {
-  // Record latency
-  auto now = std::chrono::high_resolution_clock::now();
-  uint64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        now.time_since_epoch())
-                        .count();
-
-  if (now_ns > header.timestamp_ns) {
-    latency_tracker_->record(now_ns - header.timestamp_ns);
+  if (!accept_sequence(header)) {
+    return;
   }
 
+  // Record latency
+  record_latency(header);
+
   // Update cache
   cache_->update_quote(header.symbol_id, payload.bid_price,
                        payload.bid_quantity, payload.ask_price,
                        payload.ask_quantity, header.timestamp_ns);
+  if (analytics_) {
+    analytics_->on_quote(header.symbol_id, payload.bid_price,
+                         payload.ask_price);
+  }
 
   // Dump to file if enabled
   if (dump_file_ && dump_file_->is_open()) {
     *dump_file_ << "QUOTE," << header.sequence_number << ","
                 << header.timestamp_ns << ","
-                << get_symbol_name(header.symbol_id) << ",," << std::fixed
+                << symbols_->name(header.symbol_id) << ",," << std::fixed
                 << std::setprecision(2) << payload.bid_price << ","
                 << payload.bid_quantity << "," << payload.ask_price << ","
                 << payload.ask_quantity << "\n";
   }
 }
 
+void FeedHandler::on_depth(const MessageHeader &header,
+                           const DepthUpdatePayload &payload) {
+  if (!accept_sequence(header)) {
+    return;
+  }
+
+  // Record latency
+  record_latency(header);
+
+  // Update book
+  depth_cache_->apply_update(header.symbol_id, payload, header.timestamp_ns);
+
+  // Dump to file if enabled (price/qty go in the Bid or Ask columns)
+  if (dump_file_ && dump_file_->is_open()) {
+    static const char *actions[] = {"ADD", "MODIFY", "DELETE"};
+    const char *action = payload.action < 3 ? actions[payload.action] : "?";
+    bool is_bid = payload.side == static_cast<uint8_t>(BookSide::BID);
+
+    *dump_file_ << "DEPTH," << header.sequence_number << ","
+                << header.timestamp_ns << ","
+                << symbols_->name(header.symbol_id) << ",,," << std::fixed
+                << std::setprecision(2);
+    if (is_bid) {
+      *dump_file_ << payload.price << "," << payload.quantity << ",,,";
+    } else {
+      *dump_file_ << ",," << payload.price << "," << payload.quantity << ",";
+    }
+    *dump_file_ << static_cast<int>(payload.level) << "," << action << "\n";
+  }
+}
+
 void FeedHandler::on_heartbeat(const MessageHeader &header) {
   // Just update timestamp for connection monitoring
   (void)header;
@@ -258,6 +929,21 @@ void FeedHandler::on_sequence_gap(uint32_t expected, uint32_t received) {
   }
 }
 
+void FeedHandler::on_udp_gap(uint32_t expected, uint32_t received) {
+  // Only forward gaps are recoverable; a late datagram is a duplicate
+  if (static_cast<int32_t>(received - expected) <= 0) {
+    return;
+  }
+
+  uint32_t missing =
+      std::min<uint32_t>(received - expected, MAX_RETRANSMIT_COUNT);
+  if (socket_->send_retransmit_request(expected,
+                                       static_cast<uint16_t>(missing))) {
+    retransmit_requests_.fetch_add(1, std::memory_order_relaxed);
+  }
+  on_sequence_gap(expected, received);
+}
+
 void FeedHandler::stop() {
   running_.store(false);
 
@@ -265,27 +951,128 @@ void FeedHandler::stop() {
     visualizer_->stop();
   }
 
-  socket_->disconnect();
+  for (auto &conn : connections_) {
+    conn->socket->disconnect();
+  }
 }
 
 MarketState FeedHandler::get_market_state(uint16_t symbol_id) const {
   return cache_->get_snapshot(symbol_id);
 }
 
+Analytics FeedHandler::get_analytics(uint16_t symbol_id) const {
+  return analytics_ ? analytics_->get(symbol_id) : Analytics{};
+}
+
+size_t FeedHandler::get_bars(uint16_t symbol_id, BarInterval interval,
+                             Bar *out, size_t max_bars) const {
+  return analytics_ ? analytics_->get_bars(symbol_id, interval, out, max_bars)
+                    : 0;
+}
+
+PipelineStats FeedHandler::get_pipeline_stats() const {
+  PipelineStats stats;
+  if (!raw_queue_) {
+    return stats;
+  }
+  stats.raw_queue_depth = raw_queue_->size();
+  stats.raw_queue_max_depth = raw_queue_->max_depth();
+  stats.event_queue_depth = event_queue_->size();
+  stats.event_queue_max_depth = event_queue_->max_depth();
+  stats.recv_stalls = recv_stalls_.load();
+  stats.parse_stalls = parse_stalls_.load();
+  stats.parse_wait = parse_wait_->get_stats();
+  stats.apply_wait = apply_wait_->get_stats();
+  return stats;
+}
+
+bool FeedHandler::get_cache_snapshot(CacheSnapshot &out) const {
+  return cache_->read_snapshot(out);
+}
+
+size_t FeedHandler::get_book_levels(uint16_t symbol_id, BookSide side,
+                                    PriceLevel *out, size_t max_levels) const {
+  return depth_cache_->get_levels(symbol_id, side, out, max_levels);
+}
+
 uint64_t FeedHandler::messages_received() const {
   return messages_received_.load();
 }
 
 uint64_t FeedHandler::bytes_received() const { return bytes_received_.load(); }
 
-uint64_t FeedHandler::sequence_gaps() const { return parser_->sequence_gaps(); }
+uint64_t FeedHandler::sequence_gaps() const {
+  if (udp_parser_) {
+    return udp_parser_->sequence_gaps();
+  }
+  if (arbiter_) {
+    return arbiter_->gap_events();  // Lines' own gaps are in their stats
+  }
+  uint64_t gaps = 0;
+  for (const auto &conn : connections_) {
+    gaps += conn->parser->sequence_gaps();
+  }
+  return gaps;
+}
+
+uint64_t FeedHandler::messages_recovered() const {
+  if (!udp_parser_) {
+    return 0;
+  }
+  return parser_->trades_parsed() + parser_->quotes_parsed() +
+         parser_->depth_updates_parsed();
+}
+
+ReorderStats FeedHandler::get_reorder_stats() const {
+  return udp_parser_ ? udp_parser_->reorder_stats()
+                     : connections_[0]->parser->reorder_stats();
+}
 
 LatencyStats FeedHandler::get_latency_stats() const {
   return latency_tracker_->get_stats();
 }
 
-bool FeedHandler::is_connected() const { return socket_->is_connected(); }
+std::vector<ConnectionStats> FeedHandler::get_connection_stats() const {
+  // A single feed's totals include UDP and pipeline traffic
+  bool single = connections_.size() == 1;
+  std::vector<ConnectionStats> stats;
+  for (const auto &conn : connections_) {
+    ConnectionStats s;
+    s.endpoint = conn->endpoint.host + ":" + std::to_string(conn->endpoint.port);
+    s.connected = conn->socket->is_connected();
+    s.messages_received =
+        single ? messages_received_.load() : conn->messages_received.load();
+    s.bytes_received =
+        single ? bytes_received_.load() : conn->bytes_received.load();
+    s.sequence_gaps = single ? sequence_gaps() : conn->parser->sequence_gaps();
+    s.checksum_errors = conn->parser->checksum_errors();
+    s.reconnects = conn->socket->reconnect_count();
+    s.latency = conn->latency ? conn->latency->get_stats()
+                              : latency_tracker_->get_stats();
+    stats.push_back(s);
+  }
+  return stats;
+}
+
+ArbitrationStats FeedHandler::get_arbitration_stats() const {
+  return arbiter_ ? arbiter_->stats() : ArbitrationStats{};
+}
 
-bool FeedHandler::reconnect() { return socket_->reconnect(); }
+bool FeedHandler::is_connected() const {
+  for (const auto &conn : connections_) {
+    if (conn->socket->is_connected()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FeedHandler::reconnect() {
+  bool all = true;
+  for (auto &conn : connections_) {
+    all = conn->socket->reconnect() && all;
+  }
+  return all;
+}
 
 } // namespace mdf
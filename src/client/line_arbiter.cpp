@@ -0,0 +1,212 @@
+#include "line_arbiter.h"
+#include <algorithm>
+
+namespace mdf {
+
+LineArbiter::LineArbiter(size_t num_lines, size_t window, uint64_t max_hold_ns)
+    : window_(std::max<size_t>(window, 1))
+    , max_hold_ns_(max_hold_ns)
+    , lines_(std::min(std::max<size_t>(num_lines, 1), MAX_LINES))
+    , line_state_(lines_.size()) {
+    size_t size = 2;
+    while (size < window_ * 2) size <<= 1;
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+}
+
+void LineArbiter::on_message(size_t line, const LineMessage& msg, uint64_t now_ns) {
+    if (line >= lines_.size()) {
+        return;
+    }
+    uint32_t sequence = msg.header.sequence_number;
+    lines_[line].messages++;
+
+    // What the line itself skipped, whether or not another line had it
+    LineState& state = line_state_[line];
+    int32_t skipped = static_cast<int32_t>(sequence - state.next);
+    if (!state.started || skipped >= 0) {
+        if (state.started) {
+            lines_[line].missed += static_cast<uint32_t>(skipped);
+        }
+        state.next = sequence + 1;
+        state.started = true;
+    }
+
+    if (!started_) {
+        started_ = true;
+        next_ = sequence;
+    }
+
+    int32_t ahead = static_cast<int32_t>(sequence - next_);
+    if (ahead < 0) {
+        record_duplicate(sequence, now_ns);
+        return;
+    }
+
+    if (static_cast<size_t>(ahead) >= window_) {
+        // No room to wait: give up on the gap that has to make room,
+        // through to the next sequence a line did deliver
+        uint32_t base = sequence - static_cast<uint32_t>(window_) + 1;
+        while (base != sequence && !(slot(base).held && slot(base).sequence == base)) {
+            base++;
+        }
+        skip_to(base, now_ns);
+        ahead = static_cast<int32_t>(sequence - next_);
+    }
+
+    Slot& s = slot(sequence);
+    if (ahead > 0 && s.valid && s.sequence == sequence) {
+        record_duplicate(sequence, now_ns);  // Already waiting
+        return;
+    }
+
+    s.sequence = sequence;
+    s.valid = true;
+    s.winner = static_cast<uint8_t>(line);
+    s.first_ns = now_ns;
+    lines_[line].wins++;
+
+    if (ahead > 0) {
+        s.held = true;
+        s.msg = msg;
+        if (held_count_++ == 0) {
+            gap_since_ns_ = now_ns;
+        }
+        held_total_++;
+        max_held_ = std::max(max_held_, held_count_);
+        return;
+    }
+
+    s.held = false;
+    deliver(msg, line);
+    next_++;
+    release_held(now_ns);
+}
+
+void LineArbiter::poll(uint64_t now_ns) {
+    if (held_count_ == 0 || now_ns - gap_since_ns_ < max_hold_ns_) {
+        return;
+    }
+
+    // Every line had its chance: resume at the oldest held sequence
+    uint32_t sequence = next_;
+    while (!(slot(sequence).held && slot(sequence).sequence == sequence)) {
+        sequence++;
+    }
+    skip_to(sequence, now_ns);
+}
+
+void LineArbiter::deliver(const LineMessage& msg, size_t line) {
+    delivered_++;
+    if (deliver_cb_) {
+        deliver_cb_(msg, line);
+    }
+}
+
+void LineArbiter::record_duplicate(uint32_t sequence, uint64_t now_ns) {
+    duplicates_++;
+
+    // Still in the history: credit the winner with its lead
+    const Slot& s = slot(sequence);
+    if (s.valid && s.sequence == sequence && now_ns >= s.first_ns) {
+        LineStats& winner = lines_[s.winner];
+        uint64_t lead = now_ns - s.first_ns;
+        winner.lead_samples++;
+        winner.lead_ns_total += lead;
+        winner.max_lead_ns = std::max(winner.max_lead_ns, lead);
+    }
+}
+
+void LineArbiter::release_held(uint64_t now_ns) {
+    while (held_count_ > 0) {
+        Slot& s = slot(next_);
+        if (!(s.held && s.sequence == next_)) {
+            break;
+        }
+        s.held = false;
+        held_count_--;
+        deliver(s.msg, s.winner);
+        next_++;
+    }
+
+    // A new gap starts waiting now
+    if (held_count_ > 0) {
+        gap_since_ns_ = now_ns;
+    }
+}
+
+void LineArbiter::skip_to(uint32_t base, uint64_t now_ns) {
+    uint32_t gap_start = next_;
+    bool in_gap = false;
+    while (static_cast<int32_t>(base - next_) > 0) {
+        if (held_count_ == 0) {
+            // Nothing waiting: jump the rest in one step
+            if (!in_gap) {
+                gap_start = next_;
+                in_gap = true;
+            }
+            next_ = base;
+            break;
+        }
+
+        Slot& s = slot(next_);
+        if (s.held && s.sequence == next_) {
+            if (in_gap) {
+                declare_gap(gap_start, next_);
+                in_gap = false;
+            }
+            s.held = false;
+            held_count_--;
+            deliver(s.msg, s.winner);
+        } else if (!in_gap) {
+            gap_start = next_;
+            in_gap = true;
+        }
+        next_++;
+    }
+    if (in_gap) {
+        declare_gap(gap_start, next_);
+    }
+    release_held(now_ns);
+}
+
+void LineArbiter::declare_gap(uint32_t expected, uint32_t received) {
+    gap_events_++;
+    lost_ += received - expected;
+    if (gap_cb_) {
+        gap_cb_(expected, received);
+    }
+}
+
+ArbitrationStats LineArbiter::stats() const {
+    ArbitrationStats stats;
+    stats.delivered = delivered_;
+    stats.duplicates = duplicates_;
+    stats.gap_events = gap_events_;
+    stats.lost = lost_;
+    stats.held = held_total_;
+    stats.max_held = max_held_;
+    stats.lines = lines_;
+    return stats;
+}
+
+void LineArbiter::reset() {
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].valid = false;
+        slots_[i].held = false;
+    }
+    next_ = 0;
+    started_ = false;
+    held_count_ = 0;
+    gap_since_ns_ = 0;
+    std::fill(lines_.begin(), lines_.end(), LineStats{});
+    std::fill(line_state_.begin(), line_state_.end(), LineState{});
+    delivered_ = 0;
+    duplicates_ = 0;
+    gap_events_ = 0;
+    lost_ = 0;
+    held_total_ = 0;
+    max_held_ = 0;
+}
+
+} // namespace mdf
@@ -1,8 +1,13 @@
 #include "feed_handler.h"
+#include <algorithm>
 #include <csignal>
+#include <cstdio>
 #include <cstdlib>
 #include <getopt.h>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
 
 mdf::FeedHandler *g_handler = nullptr;
 
@@ -22,10 +27,40 @@ void print_usage(const char *program) {
       << "  -h, --host <host>      Server hostname (default: localhost)\n";
   std::cout << "  -p, --port <port>      Server port (default: 9876)\n";
   std::cout << "  -t, --timeout <ms>     Connection timeout (default: 5000)\n";
+  std::cout << "      --feed <host:port> Add a feed connection (repeat for "
+               "several; replaces -h/-p)\n";
+  std::cout << "      --reorder <window> Hold up to window early messages until "
+               "missing ones arrive\n";
+  std::cout << "      --arbitrate        Treat the --feed connections as "
+               "redundant A/B lines\n";
+  std::cout << "      --arb-hold <us>    How long a gap waits for another line "
+               "(default: 5000)\n";
+  std::cout << "  -s, --symbols <count>  Symbol capacity, ids 0..count-1 (default: "
+            << mdf::MAX_SYMBOLS << ")\n";
   std::cout << "  -n, --no-visual        Disable terminal visualization\n";
   std::cout << "  -r, --no-reconnect     Disable auto-reconnect\n";
   std::cout
       << "  -d, --dump <file>      Dump all messages to file (CSV format)\n";
+  std::cout << "  -v, --protocol <1|2>   Wire protocol version (default: 1, "
+               "2 = fixed-point prices)\n";
+  std::cout << "  -u, --udp <addr:port>  Receive ticks over UDP (multicast group "
+               "or unicast)\n";
+  std::cout << "      --udp-iface <addr> Multicast interface (default: "
+               "127.0.0.1)\n";
+  std::cout << "      --cache-layout <l> Symbol cache layout: wide, compact or "
+               "fixed (default: wide)\n";
+  std::cout << "      --symbol-file <f>  Symbol reference data "
+               "(id,name[,tick_size[,lot_size]] per line)\n";
+  std::cout << "  -S, --subscribe <list> Comma-separated symbol names or ids "
+               "(default: all)\n";
+  std::cout << "      --no-analytics     Skip VWAP/volatility/bar analytics\n";
+  std::cout << "      --pipeline         Receive, parse and apply on separate "
+               "threads (TCP)\n";
+  std::cout << "      --cores <r,p,a>    Pin pipeline receive/parse/apply "
+               "threads to cores\n";
+  std::cout << "      --memory <spec>    Large buffer policy: 4k|huge,node=<n|local>,"
+               "lock,prefault\n"
+               "                         (default: huge)\n";
   std::cout << "  --help                 Show this help message\n";
   std::cout << "\nDuring operation:\n";
   std::cout << "  Press 'q' to quit\n";
@@ -34,19 +69,37 @@ void print_usage(const char *program) {
 
 int main(int argc, char *argv[]) {
   mdf::FeedHandlerConfig config;
+  std::string symbol_file;
+  std::string subscribe_list;
+  std::string memory_spec;
 
   static struct option long_options[] = {
       {"host", required_argument, nullptr, 'h'},
       {"port", required_argument, nullptr, 'p'},
       {"timeout", required_argument, nullptr, 't'},
+      {"symbols", required_argument, nullptr, 's'},
       {"no-visual", no_argument, nullptr, 'n'},
       {"no-reconnect", no_argument, nullptr, 'r'},
       {"dump", required_argument, nullptr, 'd'},
+      {"protocol", required_argument, nullptr, 'v'},
+      {"udp", required_argument, nullptr, 'u'},
+      {"udp-iface", required_argument, nullptr, 'I'},
+      {"cache-layout", required_argument, nullptr, 'L'},
+      {"symbol-file", required_argument, nullptr, 'F'},
+      {"subscribe", required_argument, nullptr, 'S'},
+      {"no-analytics", no_argument, nullptr, 'A'},
+      {"pipeline", no_argument, nullptr, 'P'},
+      {"cores", required_argument, nullptr, 'C'},
+      {"feed", required_argument, nullptr, 'E'},
+      {"reorder", required_argument, nullptr, 'O'},
+      {"arbitrate", no_argument, nullptr, 'B'},
+      {"arb-hold", required_argument, nullptr, 'H'},
+      {"memory", required_argument, nullptr, 'M'},
       {"help", no_argument, nullptr, '?'},
       {nullptr, 0, nullptr, 0}};
 
   int opt;
-  while ((opt = getopt_long(argc, argv, "h:p:t:nrd:", long_options, nullptr)) !=
+  while ((opt = getopt_long(argc, argv, "h:p:t:s:nrd:v:u:S:", long_options, nullptr)) !=
          -1) {
     switch (opt) {
     case 'h':
@@ -58,6 +111,15 @@ int main(int argc, char *argv[]) {
     case 't':
       config.connect_timeout_ms = static_cast<uint32_t>(std::atoi(optarg));
       break;
+    case 's': {
+      int count = std::atoi(optarg);
+      if (count <= 0 || static_cast<size_t>(count) > mdf::MAX_SYMBOL_CAPACITY) {
+        std::cerr << "Symbols must be 1-" << mdf::MAX_SYMBOL_CAPACITY << "\n";
+        return 1;
+      }
+      config.num_symbols = static_cast<size_t>(count);
+      break;
+    }
     case 'n':
       config.enable_visualization = false;
       break;
@@ -67,6 +129,108 @@ int main(int argc, char *argv[]) {
     case 'd':
       config.dump_file = optarg;
       break;
+    case 'v':
+      config.protocol_version = std::atoi(optarg) == 2 ? mdf::PROTOCOL_V2
+                                                       : mdf::PROTOCOL_V1;
+      break;
+    case 'u': {
+      std::string spec = optarg;
+      size_t colon = spec.rfind(':');
+      int udp_port = colon == std::string::npos
+                         ? 0
+                         : std::atoi(spec.c_str() + colon + 1);
+      if (udp_port <= 0 || udp_port > 65535) {
+        std::cerr << "Invalid UDP endpoint: " << spec << "\n";
+        return 1;
+      }
+      config.udp_address = spec.substr(0, colon);
+      config.udp_port = static_cast<uint16_t>(udp_port);
+      break;
+    }
+    case 'I':
+      config.udp_interface = optarg;
+      break;
+    case 'E': {
+      std::string spec = optarg;
+      size_t colon = spec.rfind(':');
+      int feed_port = colon == std::string::npos
+                          ? 0
+                          : std::atoi(spec.c_str() + colon + 1);
+      if (colon == 0 || feed_port <= 0 || feed_port > 65535) {
+        std::cerr << "Invalid feed endpoint: " << spec << "\n";
+        return 1;
+      }
+      mdf::FeedEndpoint endpoint;
+      endpoint.host = spec.substr(0, colon);
+      endpoint.port = static_cast<uint16_t>(feed_port);
+      config.feeds.push_back(endpoint);
+      break;
+    }
+    case 'O': {
+      int window = std::atoi(optarg);
+      if (window < 0 ||
+          static_cast<size_t>(window) > mdf::MessageParser::MAX_REORDER_WINDOW) {
+        std::cerr << "Reorder window must be 0-"
+                  << mdf::MessageParser::MAX_REORDER_WINDOW << "\n";
+        return 1;
+      }
+      config.reorder_window = static_cast<size_t>(window);
+      break;
+    }
+    case 'B':
+      config.arbitrate = true;
+      break;
+    case 'H':
+      config.arbitration_hold_us = static_cast<uint32_t>(std::atoi(optarg));
+      break;
+    case 'L': {
+      std::string layout = optarg;
+      if (layout == "wide") {
+        config.cache_layout = mdf::CacheLayout::Wide;
+      } else if (layout == "compact") {
+        config.cache_layout = mdf::CacheLayout::Compact;
+      } else if (layout == "fixed") {
+        config.cache_layout = mdf::CacheLayout::CompactFixed;
+      } else {
+        std::cerr << "Invalid cache layout: " << layout << "\n";
+        return 1;
+      }
+      break;
+    }
+    case 'F':
+      symbol_file = optarg;
+      break;
+    case 'S':
+      subscribe_list = optarg;
+      break;
+    case 'A':
+      config.enable_analytics = false;
+      break;
+    case 'P':
+      config.pipeline = true;
+      break;
+    case 'C': {
+      int cores[3];
+      if (std::sscanf(optarg, "%d,%d,%d", &cores[0], &cores[1], &cores[2]) !=
+          3) {
+        std::cerr << "Cores must be <recv>,<parse>,<apply>\n";
+        return 1;
+      }
+      config.recv_core = cores[0];
+      config.parse_core = cores[1];
+      config.apply_core = cores[2];
+      break;
+    }
+    case 'M': {
+      mdf::MemoryPolicy policy;
+      if (!mdf::parse_memory_policy(optarg, policy)) {
+        std::cerr << "Invalid memory policy: " << optarg << "\n";
+        return 1;
+      }
+      mdf::set_memory_policy(policy);
+      memory_spec = optarg;
+      break;
+    }
     case '?':
     default:
       print_usage(argv[0]);
@@ -74,6 +238,33 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  // Symbol reference data, then resolve subscriptions against it
+  auto symbols = std::make_shared<mdf::SymbolMaster>(config.num_symbols);
+  if (!symbol_file.empty() && !symbols->load(symbol_file)) {
+    std::cerr << "Failed to load symbols: " << symbols->last_error() << "\n";
+    return 1;
+  }
+  config.symbols = symbols;
+
+  std::stringstream list(subscribe_list);
+  std::string item;
+  while (std::getline(list, item, ',')) {
+    if (item.empty()) {
+      continue;
+    }
+    int id = symbols->id_of(item);
+    if (id < 0 && item.size() <= 5 &&
+        item.find_first_not_of("0123456789") == std::string::npos &&
+        static_cast<size_t>(std::atoi(item.c_str())) < symbols->size()) {
+      id = std::atoi(item.c_str());  // Numeric ids for unnamed symbols
+    }
+    if (id < 0) {
+      std::cerr << "Unknown symbol: " << item << "\n";
+      return 1;
+    }
+    config.subscribe_symbols.push_back(static_cast<uint16_t>(id));
+  }
+
   // Set up signal handlers
   std::signal(SIGINT, signal_handler);
   std::signal(SIGTERM, signal_handler);
@@ -88,10 +279,31 @@ int main(int argc, char *argv[]) {
     std::cout << "============================================\n";
     std::cout << "      NSE Market Data Feed Handler          \n";
     std::cout << "============================================\n";
-    std::cout << "Server:        " << config.host << ":" << config.port << "\n";
+    if (config.feeds.empty()) {
+      std::cout << "Server:        " << config.host << ":" << config.port
+                << "\n";
+    }
+    for (size_t i = 0; i < config.feeds.size(); ++i) {
+      const auto &feed = config.feeds[i];
+      if (config.arbitrate && config.feeds.size() > 1) {
+        std::cout << "Line " << static_cast<char>('A' + i) << ":        ";
+      } else {
+        std::cout << "Feed:          ";
+      }
+      std::cout << feed.host << ":" << feed.port << "\n";
+    }
     std::cout << "Timeout:       " << config.connect_timeout_ms << "ms\n";
+    std::cout << "Protocol:      v" << static_cast<int>(config.protocol_version)
+              << "\n";
+    if (config.udp_port != 0) {
+      std::cout << "UDP Feed:      " << config.udp_address << ":"
+                << config.udp_port << "\n";
+    }
     std::cout << "Auto-Reconnect: "
               << (config.auto_reconnect ? "Enabled" : "Disabled") << "\n";
+    if (!memory_spec.empty()) {
+      std::cout << "Memory:        " << memory_spec << "\n";
+    }
     std::cout << "============================================\n";
     std::cout << "Press Ctrl+C to stop\n\n";
   }
@@ -105,11 +317,68 @@ int main(int argc, char *argv[]) {
   std::cout << "  Messages received: " << handler.messages_received() << "\n";
   std::cout << "  Bytes received: " << handler.bytes_received() << "\n";
   std::cout << "  Sequence gaps: " << handler.sequence_gaps() << "\n";
+  if (config.udp_port != 0) {
+    std::cout << "  Retransmit requests: " << handler.retransmit_requests()
+              << "\n";
+    std::cout << "  Messages recovered: " << handler.messages_recovered()
+              << "\n";
+  }
 
   auto stats = handler.get_latency_stats();
   std::cout << "  Latency (ns): min=" << stats.min << " p50=" << stats.p50
             << " p99=" << stats.p99 << " max=" << stats.max << "\n";
 
+  if (handler.connection_count() > 1) {
+    for (const auto &feed : handler.get_connection_stats()) {
+      std::cout << "  Feed " << feed.endpoint << ": messages="
+                << feed.messages_received << " gaps=" << feed.sequence_gaps
+                << " reconnects=" << feed.reconnects
+                << " p50=" << feed.latency.p50 << " p99=" << feed.latency.p99
+                << (feed.connected ? "" : " (disconnected)") << "\n";
+    }
+  }
+
+  auto reorder = handler.get_reorder_stats();
+  if (reorder.window > 0) {
+    std::cout << "  Reorder buffer: window=" << reorder.window
+              << " held=" << reorder.held << " max depth=" << reorder.max_depth
+              << " late=" << reorder.late << "\n";
+    std::cout << "  Reorder gaps: overflow=" << reorder.overflow_gaps
+              << " timeout=" << reorder.timeout_gaps
+              << " lost=" << reorder.lost << " hold (ns): mean="
+              << reorder.mean_hold_ns << " max=" << reorder.max_hold_ns << "\n";
+  }
+
+  auto arbitration = handler.get_arbitration_stats();
+  if (!arbitration.lines.empty()) {
+    std::cout << "  Arbitration: delivered=" << arbitration.delivered
+              << " duplicates=" << arbitration.duplicates
+              << " lost=" << arbitration.lost << " (in "
+              << arbitration.gap_events << " gaps) max held="
+              << arbitration.max_held << "\n";
+    uint64_t delivered = std::max<uint64_t>(arbitration.delivered, 1);
+    for (size_t i = 0; i < arbitration.lines.size(); ++i) {
+      const auto &line = arbitration.lines[i];
+      std::cout << "  Line " << static_cast<char>('A' + i)
+                << ": wins=" << (100.0 * line.wins / delivered)
+                << "% missed=" << line.missed
+                << " mean lead=" << line.mean_lead_ns() << "ns"
+                << " max lead=" << line.max_lead_ns << "ns\n";
+    }
+  }
+
+  if (config.pipeline) {
+    auto pipeline = handler.get_pipeline_stats();
+    std::cout << "  Pipeline queue max depth: raw=" << pipeline.raw_queue_max_depth
+              << " events=" << pipeline.event_queue_max_depth << "\n";
+    std::cout << "  Pipeline stalls: recv=" << pipeline.recv_stalls
+              << " parse=" << pipeline.parse_stalls << "\n";
+    std::cout << "  Receive->parse (ns): p50=" << pipeline.parse_wait.p50
+              << " p99=" << pipeline.parse_wait.p99 << "\n";
+    std::cout << "  Receive->apply (ns): p50=" << pipeline.apply_wait.p50
+              << " p99=" << pipeline.apply_wait.p99 << "\n";
+  }
+
   std::cout << "  Reconnect count: " << handler.is_connected() << "\n";
 
   return 0;
@@ -1,9 +1,61 @@
 #include "parser.h"
 #include <cstring>
 #include <algorithm>
+#include <chrono>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace mdf {
 
+static uint64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline bool is_type_byte(uint8_t b) {
+    return (b >= 0x01 && b <= 0x04) || b == 0x11 || b == 0x12 || b == 0x14 || b == 0x20;
+}
+
+// First offset in [pos, end) that could start a message: a known type in
+// the low byte of the little-endian type field and zero in the high byte.
+// May return end - 1 when that byte could be a type field still arriving.
+static size_t next_type_candidate(const uint8_t* data, size_t pos, size_t end) {
+#if defined(__SSE2__)
+    // Types 0x01-0x04 and 0x11-0x14 are ranges of four (0x13 is weeded out
+    // later); SSE2 has no unsigned byte compare, so x <= 3 is min(x, 3) == x
+    const __m128i one = _mm_set1_epi8(0x01);
+    const __m128i v2 = _mm_set1_epi8(0x11);
+    const __m128i three = _mm_set1_epi8(0x03);
+    const __m128i batch = _mm_set1_epi8(0x20);
+    const __m128i zero = _mm_setzero_si128();
+    while (pos + 17 <= end) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 1));
+        __m128i a = _mm_sub_epi8(lo, one);
+        __m128i b = _mm_sub_epi8(lo, v2);
+        __m128i type = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(a, three), a),
+                         _mm_cmpeq_epi8(_mm_min_epu8(b, three), b)),
+            _mm_cmpeq_epi8(lo, batch));
+        int mask = _mm_movemask_epi8(_mm_and_si128(type, _mm_cmpeq_epi8(hi, zero)));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+        pos += 16;
+    }
+#endif
+    for (; pos + 1 < end; ++pos) {
+        if (is_type_byte(data[pos]) && data[pos + 1] == 0) {
+            return pos;
+        }
+    }
+    if (pos < end && !is_type_byte(data[pos])) {
+        pos = end;
+    }
+    return pos;
+}
+
 MessageParser::MessageParser()
     : buffer_(INITIAL_BUFFER_SIZE) {
 }
@@ -17,51 +69,114 @@ size_t MessageParser::append_data(const void* data, size_t len) {
         compact_buffer();
         available = buffer_.size() - write_pos_;
         
-        // Still not enough? Grow buffer
+        // Still not enough? Grow buffer, doubling until the data fits
         if (available < len) {
-            size_t new_size = std::min(buffer_.size() * 2, MAX_BUFFER_SIZE);
-            if (new_size <= buffer_.size()) {
+            size_t new_size = buffer_.size();
+            while (new_size - write_pos_ < len && new_size < MAX_BUFFER_SIZE) {
+                new_size = std::min(new_size * 2, MAX_BUFFER_SIZE);
+            }
+            if (new_size - write_pos_ < len) {
                 // Can't grow anymore, drop oldest data
                 malformed_messages_.fetch_add(1, std::memory_order_relaxed);
                 return 0;
             }
-            buffer_.resize(new_size);
+            HugePageBuffer grown(new_size);
+            std::memcpy(grown.data(), buffer_.data(), write_pos_);
+            buffer_ = std::move(grown);
         }
     }
     
     // Copy data to buffer
-    std::memcpy(buffer_.data() + write_pos_, data, len);
+    std::memcpy(buffer() + write_pos_, data, len);
     write_pos_ += len;
+    bytes_copied_.fetch_add(len, std::memory_order_relaxed);
     
     return len;
 }
 
+size_t MessageParser::missing_bytes() const {
+    size_t available = write_pos_ - read_pos_;
+    const uint8_t* start = buffer() + read_pos_;
+    size_t needed = HEADER_SIZE;
+    if (available >= HEADER_SIZE) {
+        uint16_t type;
+        std::memcpy(&type, start, sizeof(type));
+        if (type == static_cast<uint16_t>(MessageType::BATCH)) {
+            needed = BATCH_HEADER_SIZE;
+            if (available >= BATCH_HEADER_SIZE) {
+                BatchHeader batch;
+                std::memcpy(&batch, start, sizeof(batch));
+                needed = batch.packet_length;
+            }
+        } else {
+            needed = get_message_size(static_cast<MessageType>(type));
+        }
+    }
+    // parse_messages() leaves nothing it could decide, so this is a guard
+    return needed > available ? needed - available : 1;
+}
+
+size_t MessageParser::parse_buffer(const void* data, size_t len) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    size_t parsed = 0;
+    
+    // A partial message is waiting: copy in only the bytes that finish it
+    // (a header first, if even that is incomplete)
+    while (read_pos_ != write_pos_ && len > 0) {
+        size_t take = std::min(missing_bytes(), len);
+        append_data(in, take);
+        in += take;
+        len -= take;
+        parsed += parse_messages();
+    }
+    if (read_pos_ != write_pos_) {
+        return parsed;
+    }
+    
+    // Positions index the caller's buffer until parsing stops
+    view_ = in;
+    read_pos_ = 0;
+    write_pos_ = len;
+    parsed += parse_messages();
+    
+    const uint8_t* rest = view_ + read_pos_;
+    size_t rest_len = write_pos_ - read_pos_;
+    view_ = nullptr;
+    read_pos_ = 0;
+    write_pos_ = 0;
+    append_data(rest, rest_len);
+    return parsed;
+}
+
 void MessageParser::compact_buffer() {
     if (read_pos_ == 0) return;
     
     size_t used = write_pos_ - read_pos_;
     if (used > 0) {
-        std::memmove(buffer_.data(), buffer_.data() + read_pos_, used);
+        std::memmove(buffer(), buffer() + read_pos_, used);
     }
     write_pos_ = used;
     read_pos_ = 0;
 }
 
 size_t MessageParser::parse_messages() {
-    size_t count = 0;
+    // Count delivered messages rather than parse_one() calls, since one
+    // batched packet carries many messages
+    uint64_t before = messages_parsed_.load(std::memory_order_relaxed);
     
     while (true) {
         ParseResult result = parse_one();
         if (result == ParseResult::NEED_MORE_DATA) {
             break;
         }
-        if (result == ParseResult::SUCCESS || result == ParseResult::SEQUENCE_GAP) {
-            count++;
-        }
         // Continue parsing even on errors (skip to next message attempt)
     }
     
-    return count;
+    if (reorder_depth_.load(std::memory_order_relaxed) > 0) {
+        expire_reorder(steady_now_ns());
+    }
+    
+    return messages_parsed_.load(std::memory_order_relaxed) - before;
 }
 
 ParseResult MessageParser::parse_one() {
@@ -72,17 +187,20 @@ ParseResult MessageParser::parse_one() {
         return ParseResult::NEED_MORE_DATA;
     }
     
-    const uint8_t* msg_start = buffer_.data() + read_pos_;
+    const uint8_t* msg_start = buffer() + read_pos_;
     const MessageHeader* header = reinterpret_cast<const MessageHeader*>(msg_start);
     
     // Validate message type and get expected size
     MessageType type = static_cast<MessageType>(header->message_type);
+    if (type == MessageType::BATCH) {
+        return parse_batch(msg_start, available);
+    }
+    
     size_t msg_size = get_message_size(type);
     
     if (msg_size == 0) {
-        // Invalid message type - skip one byte and try again
-        read_pos_++;
         malformed_messages_.fetch_add(1, std::memory_order_relaxed);
+        resync();
         return ParseResult::INVALID_MESSAGE;
     }
     
@@ -92,29 +210,172 @@ ParseResult MessageParser::parse_one() {
     }
     
     // Prevent buffer overflow with malicious large message
-    if (msg_size > QUOTE_MSG_SIZE) {
-        read_pos_++;
+    if (msg_size > MAX_MSG_SIZE) {
         malformed_messages_.fetch_add(1, std::memory_order_relaxed);
+        resync();
         return ParseResult::INVALID_MESSAGE;
     }
     
     // Validate checksum
     if (!validate_checksum(msg_start, msg_size)) {
-        read_pos_++;
         checksum_errors_.fetch_add(1, std::memory_order_relaxed);
+        resync();
         return ParseResult::CHECKSUM_ERROR;
     }
+    in_resync_ = false;
     
-    // Check sequence
-    bool has_gap = !check_sequence(header->sequence_number);
+    // Check sequence and dispatch (or hold until earlier sequences arrive)
+    bool has_gap = !deliver(*header, msg_start + HEADER_SIZE);
+    read_pos_ += msg_size;
     
+    return has_gap ? ParseResult::SEQUENCE_GAP : ParseResult::SUCCESS;
+}
+
+ParseResult MessageParser::parse_batch(const uint8_t* packet, size_t available) {
+    if (available < BATCH_HEADER_SIZE) {
+        return ParseResult::NEED_MORE_DATA;
+    }
+    
+    BatchHeader batch;
+    std::memcpy(&batch, packet, sizeof(batch));
+    size_t packet_size = batch.packet_length;
+    
+    if (packet_size < BATCH_HEADER_SIZE + CHECKSUM_SIZE ||
+        packet_size > MAX_BATCH_PACKET_SIZE) {
+        malformed_messages_.fetch_add(1, std::memory_order_relaxed);
+        resync();
+        return ParseResult::INVALID_MESSAGE;
+    }
+    
+    if (available < packet_size) {
+        return ParseResult::NEED_MORE_DATA;
+    }
+    
+    if (!validate_checksum(packet, packet_size)) {
+        checksum_errors_.fetch_add(1, std::memory_order_relaxed);
+        resync();
+        return ParseResult::CHECKSUM_ERROR;
+    }
+    in_resync_ = false;
+    
+    // Decode records, rebuilding full headers from the deltas
+    const uint8_t* pos = packet + BATCH_HEADER_SIZE;
+    const uint8_t* end = packet + packet_size - CHECKSUM_SIZE;
+    MessageHeader header;
+    header.sequence_number = batch.base_sequence;
+    header.timestamp_ns = batch.base_timestamp_ns;
+    bool has_gap = false;
+    
+    for (uint16_t i = 0; i < batch.message_count; ++i) {
+        if (pos + BATCH_RECORD_SIZE > end) break;
+        
+        BatchRecord record;
+        std::memcpy(&record, pos, sizeof(record));
+        pos += BATCH_RECORD_SIZE;
+        
+        size_t payload_size = get_payload_size(static_cast<MessageType>(record.message_type));
+        if (payload_size == 0 || pos + payload_size > end) {
+            malformed_messages_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        
+        header.message_type = record.message_type;
+        header.sequence_number += record.sequence_delta;
+        header.timestamp_ns += record.timestamp_delta_ns;
+        header.symbol_id = record.symbol_id;
+        
+        has_gap |= !deliver(header, pos);
+        pos += payload_size;
+    }
+    
+    read_pos_ += packet_size;
+    
+    return has_gap ? ParseResult::SEQUENCE_GAP : ParseResult::SUCCESS;
+}
+
+void MessageParser::resync() {
+    if (!in_resync_) {
+        in_resync_ = true;
+        resync_skipped_ = 0;
+        resync_events_.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    size_t pos = read_pos_ + 1;
+    if (resync_scan_) {
+        const uint8_t* data = buffer();
+        while (true) {
+            pos = next_type_candidate(data, pos, write_pos_);
+            if (pos >= write_pos_) {
+                break;
+            }
+            resync_candidates_.fetch_add(1, std::memory_order_relaxed);
+            if (plausible_header(data + pos, write_pos_ - pos)) {
+                break;
+            }
+            resync_rejected_.fetch_add(1, std::memory_order_relaxed);
+            pos++;
+        }
+    }
+    
+    resync_skipped_ += pos - read_pos_;
+    resync_bytes_skipped_.fetch_add(pos - read_pos_, std::memory_order_relaxed);
+    read_pos_ = pos;
+}
+
+bool MessageParser::plausible_header(const uint8_t* data, size_t available) {
+    // Only the type's first byte has arrived: keep it until the rest does
+    if (available < sizeof(uint16_t)) {
+        return true;
+    }
+    
+    uint16_t type;
+    std::memcpy(&type, data, sizeof(type));
+    
+    uint32_t sequence;
+    if (type == static_cast<uint16_t>(MessageType::BATCH)) {
+        if (available < BATCH_HEADER_SIZE) {
+            return true;
+        }
+        BatchHeader batch;
+        std::memcpy(&batch, data, sizeof(batch));
+        if (batch.message_count == 0 ||
+            batch.packet_length < BATCH_HEADER_SIZE + CHECKSUM_SIZE ||
+            batch.packet_length > MAX_BATCH_PACKET_SIZE) {
+            return false;
+        }
+        sequence = batch.base_sequence;
+    } else {
+        if (get_message_size(static_cast<MessageType>(type)) == 0) {
+            return false;
+        }
+        if (available < HEADER_SIZE) {
+            return true;
+        }
+        MessageHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (header.symbol_id >= symbol_limit_) {
+            return false;
+        }
+        sequence = header.sequence_number;
+    }
+    
+    // Sequence numbers only move forward, bar retransmissions and
+    // reordering; give up on that after a long stretch (a restarted stream)
+    if (first_message_ || resync_skipped_ >= RESYNC_STRICT_BYTES) {
+        return true;
+    }
+    uint32_t distance = sequence - expected_sequence_ + RESYNC_SEQUENCE_RANGE;
+    return distance <= 2 * RESYNC_SEQUENCE_RANGE;
+}
+
+void MessageParser::dispatch(const MessageHeader& header, const uint8_t* payload_ptr) {
     // Parse based on message type
-    switch (type) {
+    switch (static_cast<MessageType>(header.message_type)) {
         case MessageType::TRADE: {
             if (trade_cb_) {
                 const TradePayload* payload = 
-                    reinterpret_cast<const TradePayload*>(msg_start + HEADER_SIZE);
-                trade_cb_(*header, *payload);
+                    reinterpret_cast<const TradePayload*>(payload_ptr);
+                trade_cb_(header, *payload);
             }
             trades_parsed_.fetch_add(1, std::memory_order_relaxed);
             break;
@@ -123,16 +384,63 @@ ParseResult MessageParser::parse_one() {
         case MessageType::QUOTE: {
             if (quote_cb_) {
                 const QuotePayload* payload = 
-                    reinterpret_cast<const QuotePayload*>(msg_start + HEADER_SIZE);
-                quote_cb_(*header, *payload);
+                    reinterpret_cast<const QuotePayload*>(payload_ptr);
+                quote_cb_(header, *payload);
+            }
+            quotes_parsed_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        
+        case MessageType::DEPTH_UPDATE: {
+            if (depth_cb_) {
+                const DepthUpdatePayload* payload = 
+                    reinterpret_cast<const DepthUpdatePayload*>(payload_ptr);
+                depth_cb_(header, *payload);
+            }
+            depth_updates_parsed_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        
+        // v2 messages are widened to the v1 payloads so callbacks
+        // don't need to know which protocol version is on the wire
+        case MessageType::TRADE_V2: {
+            if (trade_cb_) {
+                TradePayloadV2 v2;
+                std::memcpy(&v2, payload_ptr, sizeof(v2));
+                TradePayload payload{from_fixed_price(v2.price), v2.quantity};
+                trade_cb_(header, payload);
+            }
+            trades_parsed_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        
+        case MessageType::QUOTE_V2: {
+            if (quote_cb_) {
+                QuotePayloadV2 v2;
+                std::memcpy(&v2, payload_ptr, sizeof(v2));
+                QuotePayload payload{from_fixed_price(v2.bid_price), v2.bid_quantity,
+                                     from_fixed_price(v2.ask_price), v2.ask_quantity};
+                quote_cb_(header, payload);
             }
             quotes_parsed_.fetch_add(1, std::memory_order_relaxed);
             break;
         }
         
+        case MessageType::DEPTH_UPDATE_V2: {
+            if (depth_cb_) {
+                DepthUpdatePayloadV2 v2;
+                std::memcpy(&v2, payload_ptr, sizeof(v2));
+                DepthUpdatePayload payload{v2.side, v2.action, v2.level, 0,
+                                           from_fixed_price(v2.price), v2.quantity};
+                depth_cb_(header, payload);
+            }
+            depth_updates_parsed_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        
         case MessageType::HEARTBEAT: {
             if (heartbeat_cb_) {
-                heartbeat_cb_(*header);
+                heartbeat_cb_(header);
             }
             break;
         }
@@ -142,9 +450,6 @@ ParseResult MessageParser::parse_one() {
     }
     
     messages_parsed_.fetch_add(1, std::memory_order_relaxed);
-    read_pos_ += msg_size;
-    
-    return has_gap ? ParseResult::SEQUENCE_GAP : ParseResult::SUCCESS;
 }
 
 bool MessageParser::validate_checksum(const void* data, size_t msg_len) {
@@ -181,18 +486,245 @@ bool MessageParser::check_sequence(uint32_t received_seq) {
     return true;
 }
 
+bool MessageParser::deliver(const MessageHeader& header, const uint8_t* payload) {
+    if (reorder_slots_) {
+        return reorder(header, payload);
+    }
+    bool in_order = check_sequence(header.sequence_number);
+    dispatch(header, payload);
+    return in_order;
+}
+
+bool MessageParser::reorder(const MessageHeader& header, const uint8_t* payload) {
+    uint32_t sequence = header.sequence_number;
+    if (first_message_) {
+        first_message_ = false;
+        expected_sequence_ = sequence;
+    }
+    
+    uint64_t gaps_before = sequence_gaps_.load(std::memory_order_relaxed);
+    size_t window = reorder_mask_ + 1;
+    int32_t ahead = static_cast<int32_t>(sequence - expected_sequence_);
+    
+    if (ahead < 0) {
+        if (static_cast<uint32_t>(-static_cast<int64_t>(ahead)) <= REORDER_RESYNC_DISTANCE) {
+            // Already dispatched, or declared lost
+            reorder_late_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        
+        // Far behind: the stream restarted, so start over from here
+        flush_reorder();
+        bool in_order = check_sequence(sequence);
+        dispatch(header, payload);
+        return in_order;
+    }
+    
+    if (static_cast<size_t>(ahead) >= window) {
+        // No room to hold it: give up on the gap that has to make room,
+        // through to the next message that did arrive
+        uint32_t base = sequence - static_cast<uint32_t>(window) + 1;
+        while (base != sequence && !is_held(base)) {
+            base++;
+        }
+        skip_to(base, reorder_overflow_gaps_);
+        ahead = static_cast<int32_t>(sequence - expected_sequence_);
+    }
+    
+    if (ahead == 0) {
+        dispatch(header, payload);
+        expected_sequence_++;
+        release_held();
+        return sequence_gaps_.load(std::memory_order_relaxed) == gaps_before;
+    }
+    
+    ReorderSlot& slot = reorder_slots_[sequence & reorder_mask_];
+    if (is_held(sequence)) {
+        reorder_late_.fetch_add(1, std::memory_order_relaxed);  // Duplicate
+        return sequence_gaps_.load(std::memory_order_relaxed) == gaps_before;
+    }
+    
+    uint64_t now = steady_now_ns();
+    slot.header = header;
+    slot.held = true;
+    slot.held_ns = now;
+    std::memcpy(slot.payload, payload,
+                get_payload_size(static_cast<MessageType>(header.message_type)));
+    
+    size_t depth = reorder_depth_.load(std::memory_order_relaxed) + 1;
+    reorder_depth_.store(depth, std::memory_order_relaxed);
+    if (depth == 1) {
+        gap_since_ns_ = now;
+    }
+    if (depth > reorder_max_depth_.load(std::memory_order_relaxed)) {
+        reorder_max_depth_.store(depth, std::memory_order_relaxed);
+    }
+    reorder_held_.fetch_add(1, std::memory_order_relaxed);
+    return sequence_gaps_.load(std::memory_order_relaxed) == gaps_before;
+}
+
+void MessageParser::release_held() {
+    size_t depth = reorder_depth_.load(std::memory_order_relaxed);
+    if (depth == 0) {
+        return;
+    }
+    
+    uint64_t now = steady_now_ns();
+    uint64_t hold_total = 0;
+    uint64_t hold_max = reorder_hold_ns_max_.load(std::memory_order_relaxed);
+    size_t released = 0;
+    while (depth > 0 && is_held(expected_sequence_)) {
+        ReorderSlot& slot = reorder_slots_[expected_sequence_ & reorder_mask_];
+        slot.held = false;
+        depth--;
+        released++;
+        
+        uint64_t hold = now - slot.held_ns;
+        hold_total += hold;
+        hold_max = std::max(hold_max, hold);
+        
+        dispatch(slot.header, slot.payload);
+        expected_sequence_++;
+    }
+    
+    reorder_depth_.store(depth, std::memory_order_relaxed);
+    reorder_released_.fetch_add(released, std::memory_order_relaxed);
+    reorder_hold_ns_total_.fetch_add(hold_total, std::memory_order_relaxed);
+    reorder_hold_ns_max_.store(hold_max, std::memory_order_relaxed);
+    
+    // A new gap starts waiting now
+    if (depth > 0 && released > 0) {
+        gap_since_ns_ = now;
+    }
+}
+
+void MessageParser::skip_to(uint32_t base, std::atomic<uint64_t>& reason) {
+    // Consecutive missing sequences are one gap
+    while (static_cast<int32_t>(base - expected_sequence_) > 0) {
+        uint32_t gap_start = expected_sequence_;
+        uint32_t gap_end = base;
+        if (reorder_depth_.load(std::memory_order_relaxed) > 0) {
+            gap_end = gap_start;
+            while (gap_end != base && !is_held(gap_end)) {
+                gap_end++;
+            }
+        }
+        
+        if (gap_end != gap_start) {
+            if (gap_cb_) {
+                gap_cb_(gap_start, gap_end);
+            }
+            sequence_gaps_.fetch_add(1, std::memory_order_relaxed);
+            reason.fetch_add(1, std::memory_order_relaxed);
+            reorder_lost_.fetch_add(gap_end - gap_start, std::memory_order_relaxed);
+            expected_sequence_ = gap_end;
+        }
+        release_held();
+    }
+}
+
+void MessageParser::set_reorder_window(size_t window, uint64_t max_hold_ns) {
+    flush_reorder();
+    reorder_hold_ns_ = max_hold_ns;
+    if (window == 0) {
+        reorder_slots_.reset();
+        reorder_mask_ = 0;
+        return;
+    }
+    
+    size_t size = 2;
+    while (size < std::min(window, MAX_REORDER_WINDOW)) size <<= 1;
+    reorder_slots_.reset(new ReorderSlot[size]);
+    reorder_mask_ = size - 1;
+}
+
+void MessageParser::expire_reorder(uint64_t now_ns) {
+    if (reorder_depth_.load(std::memory_order_relaxed) == 0 ||
+        now_ns - gap_since_ns_ < reorder_hold_ns_) {
+        return;
+    }
+    
+    // Resume at the oldest held message
+    uint32_t base = expected_sequence_;
+    while (!is_held(base)) {
+        base++;
+    }
+    skip_to(base, reorder_timeout_gaps_);
+}
+
+void MessageParser::flush_reorder() {
+    while (reorder_slots_ && reorder_depth_.load(std::memory_order_relaxed) > 0) {
+        uint32_t base = expected_sequence_;
+        while (!is_held(base)) {
+            base++;
+        }
+        skip_to(base, reorder_timeout_gaps_);
+    }
+}
+
+ResyncStats MessageParser::resync_stats() const {
+    ResyncStats stats;
+    stats.events = resync_events_.load(std::memory_order_relaxed);
+    stats.bytes_skipped = resync_bytes_skipped_.load(std::memory_order_relaxed);
+    stats.candidates = resync_candidates_.load(std::memory_order_relaxed);
+    stats.rejected = resync_rejected_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ReorderStats MessageParser::reorder_stats() const {
+    ReorderStats stats;
+    stats.window = reorder_slots_ ? reorder_mask_ + 1 : 0;
+    stats.depth = reorder_depth_.load(std::memory_order_relaxed);
+    stats.max_depth = reorder_max_depth_.load(std::memory_order_relaxed);
+    stats.held = reorder_held_.load(std::memory_order_relaxed);
+    stats.late = reorder_late_.load(std::memory_order_relaxed);
+    stats.overflow_gaps = reorder_overflow_gaps_.load(std::memory_order_relaxed);
+    stats.timeout_gaps = reorder_timeout_gaps_.load(std::memory_order_relaxed);
+    stats.lost = reorder_lost_.load(std::memory_order_relaxed);
+    uint64_t released = reorder_released_.load(std::memory_order_relaxed);
+    stats.mean_hold_ns =
+        released ? reorder_hold_ns_total_.load(std::memory_order_relaxed) / released : 0;
+    stats.max_hold_ns = reorder_hold_ns_max_.load(std::memory_order_relaxed);
+    return stats;
+}
+
 void MessageParser::reset() {
     read_pos_ = 0;
     write_pos_ = 0;
     expected_sequence_ = 0;
     first_message_ = true;
+    in_resync_ = false;
+    resync_skipped_ = 0;
+    
+    // Held messages belong to the old stream
+    if (reorder_slots_) {
+        for (size_t i = 0; i <= reorder_mask_; ++i) {
+            reorder_slots_[i].held = false;
+        }
+    }
+    reorder_depth_.store(0, std::memory_order_relaxed);
+    reorder_max_depth_.store(0, std::memory_order_relaxed);
+    reorder_held_.store(0, std::memory_order_relaxed);
+    reorder_late_.store(0, std::memory_order_relaxed);
+    reorder_overflow_gaps_.store(0, std::memory_order_relaxed);
+    reorder_timeout_gaps_.store(0, std::memory_order_relaxed);
+    reorder_lost_.store(0, std::memory_order_relaxed);
+    reorder_released_.store(0, std::memory_order_relaxed);
+    reorder_hold_ns_total_.store(0, std::memory_order_relaxed);
+    reorder_hold_ns_max_.store(0, std::memory_order_relaxed);
     
     messages_parsed_.store(0, std::memory_order_relaxed);
+    bytes_copied_.store(0, std::memory_order_relaxed);
     trades_parsed_.store(0, std::memory_order_relaxed);
     quotes_parsed_.store(0, std::memory_order_relaxed);
+    depth_updates_parsed_.store(0, std::memory_order_relaxed);
     checksum_errors_.store(0, std::memory_order_relaxed);
     sequence_gaps_.store(0, std::memory_order_relaxed);
     malformed_messages_.store(0, std::memory_order_relaxed);
+    resync_events_.store(0, std::memory_order_relaxed);
+    resync_bytes_skipped_.store(0, std::memory_order_relaxed);
+    resync_candidates_.store(0, std::memory_order_relaxed);
+    resync_rejected_.store(0, std::memory_order_relaxed);
 }
 
 } // namespace mdf
@@ -10,6 +10,7 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <cerrno>
+#include <algorithm>
 #include <cstring>
 #include <thread>
 #include <chrono>
@@ -26,6 +27,7 @@ MarketDataSocket::MarketDataSocket() = default;
 
 MarketDataSocket::~MarketDataSocket() {
     disconnect();
+    close_udp();
     
     if (event_fd_ >= 0) {
         ::close(event_fd_);
@@ -55,9 +57,13 @@ bool MarketDataSocket::init_event_system() {
 }
 
 bool MarketDataSocket::register_socket() {
+    return register_fd(fd_);
+}
+
+bool MarketDataSocket::register_fd(int fd) {
 #ifdef USE_KQUEUE
     struct kevent ev;
-    EV_SET(&ev, fd_, EVFILT_READ, EV_ADD | EV_ENABLE | EV_CLEAR, 0, 0, nullptr);
+    EV_SET(&ev, fd, EVFILT_READ, EV_ADD | EV_ENABLE | EV_CLEAR, 0, 0, nullptr);
     if (kevent(event_fd_, &ev, 1, nullptr, 0, nullptr) < 0) {
         last_error_ = "Failed to register socket: " + std::string(strerror(errno));
         return false;
@@ -65,8 +71,8 @@ bool MarketDataSocket::register_socket() {
 #else
     struct epoll_event ev;
     ev.events = EPOLLIN | EPOLLET;  // Edge-triggered
-    ev.data.fd = fd_;
-    if (epoll_ctl(event_fd_, EPOLL_CTL_ADD, fd_, &ev) < 0) {
+    ev.data.fd = fd;
+    if (epoll_ctl(event_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
         last_error_ = "Failed to register socket: " + std::string(strerror(errno));
         return false;
     }
@@ -239,12 +245,12 @@ int MarketDataSocket::wait_for_data(uint32_t timeout_ms) {
     }
     
 #ifdef USE_KQUEUE
-    struct kevent events[1];
+    struct kevent events[2];  // TCP + UDP
     struct timespec ts;
     ts.tv_sec = timeout_ms / 1000;
     ts.tv_nsec = (timeout_ms % 1000) * 1000000;
     
-    int nev = kevent(event_fd_, nullptr, 0, events, 1, &ts);
+    int nev = kevent(event_fd_, nullptr, 0, events, 2, &ts);
     
     if (nev < 0) {
         last_error_ = "kqueue wait error: " + std::string(strerror(errno));
@@ -255,17 +261,19 @@ int MarketDataSocket::wait_for_data(uint32_t timeout_ms) {
         return 0;  // Timeout
     }
     
-    // Check for errors
-    if (events[0].flags & EV_EOF) {
-        connected_.store(false);
-        last_error_ = "Connection closed";
-        return -1;
+    // Check for errors on the TCP connection
+    for (int i = 0; i < nev; ++i) {
+        if (static_cast<int>(events[i].ident) == fd_ && (events[i].flags & EV_EOF)) {
+            connected_.store(false);
+            last_error_ = "Connection closed";
+            return -1;
+        }
     }
     
     return 1;  // Data available
 #else
-    struct epoll_event events[1];
-    int nev = epoll_wait(event_fd_, events, 1, timeout_ms);
+    struct epoll_event events[2];  // TCP + UDP
+    int nev = epoll_wait(event_fd_, events, 2, timeout_ms);
     
     if (nev < 0) {
         last_error_ = "epoll wait error: " + std::string(strerror(errno));
@@ -276,38 +284,225 @@ int MarketDataSocket::wait_for_data(uint32_t timeout_ms) {
         return 0;  // Timeout
     }
     
-    // Check for errors
-    if (events[0].events & (EPOLLERR | EPOLLHUP)) {
-        connected_.store(false);
-        last_error_ = "Connection error";
-        return -1;
+    // Check for errors on the TCP connection
+    for (int i = 0; i < nev; ++i) {
+        if (events[i].data.fd == fd_ && (events[i].events & (EPOLLERR | EPOLLHUP))) {
+            connected_.store(false);
+            last_error_ = "Connection error";
+            return -1;
+        }
     }
     
     return 1;  // Data available
 #endif
 }
 
-bool MarketDataSocket::send_subscription(const std::vector<uint16_t>& symbol_ids) {
+bool MarketDataSocket::send_subscription(const std::vector<uint16_t>& symbol_ids,
+                                         uint8_t protocol_version) {
     if (!connected_.load() || fd_ < 0) {
         return false;
     }
     
     // Build subscription message
-    size_t msg_size = 1 + 2 + (symbol_ids.size() * 2);
+    bool versioned = (protocol_version != PROTOCOL_V1);
+    size_t prefix = versioned ? sizeof(SubscriptionRequestV2) : sizeof(SubscriptionRequest);
+    size_t msg_size = prefix + (symbol_ids.size() * 2);
     std::vector<uint8_t> buffer(msg_size);
     
-    buffer[0] = SUBSCRIBE_CMD;
     uint16_t count = static_cast<uint16_t>(symbol_ids.size());
-    std::memcpy(buffer.data() + 1, &count, 2);
+    if (versioned) {
+        buffer[0] = SUBSCRIBE_V2_CMD;
+        buffer[1] = protocol_version;
+        std::memcpy(buffer.data() + 2, &count, 2);
+    } else {
+        buffer[0] = SUBSCRIBE_CMD;
+        std::memcpy(buffer.data() + 1, &count, 2);
+    }
     
     for (size_t i = 0; i < symbol_ids.size(); ++i) {
-        std::memcpy(buffer.data() + 3 + (i * 2), &symbol_ids[i], 2);
+        std::memcpy(buffer.data() + prefix + (i * 2), &symbol_ids[i], 2);
     }
     
     ssize_t sent = send(fd_, buffer.data(), msg_size, 0);
     return sent == static_cast<ssize_t>(msg_size);
 }
 
+bool MarketDataSocket::send_retransmit_request(uint32_t start_sequence, uint16_t count) {
+    if (!connected_.load() || fd_ < 0) {
+        return false;
+    }
+    
+    RetransmitRequest request{};
+    request.command = RETRANSMIT_CMD;
+    request.count = count;
+    request.start_sequence = start_sequence;
+    
+    ssize_t sent = send(fd_, &request, sizeof(request), 0);
+    return sent == static_cast<ssize_t>(sizeof(request));
+}
+
+bool MarketDataSocket::open_udp(const std::string& address, uint16_t port,
+                                const std::string& interface_addr) {
+    close_udp();
+    
+    if (!init_event_system()) {
+        return false;
+    }
+    
+    in_addr group{};
+    in_addr iface{};
+    if (inet_pton(AF_INET, address.c_str(), &group) != 1 ||
+        inet_pton(AF_INET, interface_addr.c_str(), &iface) != 1) {
+        last_error_ = "Invalid UDP address: " + address;
+        return false;
+    }
+    bool is_group = IN_MULTICAST(ntohl(group.s_addr));
+    
+    udp_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (udp_fd_ < 0) {
+        last_error_ = "Failed to create UDP socket: " + std::string(strerror(errno));
+        return false;
+    }
+    
+    // Several receivers on one host can share a group port
+    int opt = 1;
+    setsockopt(udp_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    
+    // Large buffer absorbs bursts between polls (capped by rmem_max
+    // unless SO_RCVBUFFORCE is permitted)
+    int size = static_cast<int>(UDP_RECV_BUFFER);
+#ifdef SO_RCVBUFFORCE
+    if (setsockopt(udp_fd_, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0)
+#endif
+    setsockopt(udp_fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    
+    // Groups bind to the group address so unrelated traffic to the port is ignored
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr = is_group ? group : in_addr{htonl(INADDR_ANY)};
+    if (bind(udp_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        last_error_ = "Failed to bind UDP socket: " + std::string(strerror(errno));
+        close_udp();
+        return false;
+    }
+    
+    if (is_group) {
+        struct ip_mreq mreq{};
+        mreq.imr_multiaddr = group;
+        mreq.imr_interface = iface;
+        if (setsockopt(udp_fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+            last_error_ = "Failed to join multicast group: " + std::string(strerror(errno));
+            close_udp();
+            return false;
+        }
+    }
+    
+    int flags = fcntl(udp_fd_, F_GETFL, 0);
+    fcntl(udp_fd_, F_SETFL, flags | O_NONBLOCK);
+    
+    if (!register_fd(udp_fd_)) {
+        close_udp();
+        return false;
+    }
+    
+    udp_buffers_.reset(new uint8_t[UDP_BATCH_SIZE * MAX_DATAGRAM_SIZE]);
+    return true;
+}
+
+void MarketDataSocket::close_udp() {
+    if (udp_fd_ < 0) {
+        return;
+    }
+    
+#ifdef USE_KQUEUE
+    if (event_fd_ >= 0) {
+        struct kevent ev;
+        EV_SET(&ev, udp_fd_, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+        kevent(event_fd_, &ev, 1, nullptr, 0, nullptr);
+    }
+#else
+    if (event_fd_ >= 0) {
+        epoll_ctl(event_fd_, EPOLL_CTL_DEL, udp_fd_, nullptr);
+    }
+#endif
+    
+    ::close(udp_fd_);
+    udp_fd_ = -1;
+}
+
+uint16_t MarketDataSocket::udp_port() const {
+    struct sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (udp_fd_ < 0 ||
+        getsockname(udp_fd_, reinterpret_cast<struct sockaddr*>(&addr), &len) < 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+int MarketDataSocket::receive_datagrams() {
+    if (udp_fd_ < 0) {
+        return -1;
+    }
+    
+    recv_calls_.fetch_add(1, std::memory_order_relaxed);
+    
+    int count = 0;
+#ifdef USE_KQUEUE
+    // No recvmmsg - one recv per datagram
+    while (count < static_cast<int>(UDP_BATCH_SIZE)) {
+        ssize_t n = recv(udp_fd_, udp_buffers_.get() + count * MAX_DATAGRAM_SIZE,
+                         MAX_DATAGRAM_SIZE, MSG_DONTWAIT);
+        if (n < 0) {
+            break;
+        }
+        datagram_sizes_[count++] = static_cast<size_t>(n);
+    }
+    if (count == 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        last_error_ = "UDP receive error: " + std::string(strerror(errno));
+        return -1;
+    }
+#else
+    struct mmsghdr msgs[UDP_BATCH_SIZE];
+    struct iovec iovecs[UDP_BATCH_SIZE];
+    for (size_t i = 0; i < UDP_BATCH_SIZE; ++i) {
+        iovecs[i].iov_base = udp_buffers_.get() + i * MAX_DATAGRAM_SIZE;
+        iovecs[i].iov_len = MAX_DATAGRAM_SIZE;
+        std::memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    
+    count = recvmmsg(udp_fd_, msgs, UDP_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (count < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        last_error_ = "UDP receive error: " + std::string(strerror(errno));
+        return -1;
+    }
+    
+    for (int i = 0; i < count; ++i) {
+        // A truncated datagram would split a message - drop it, recovery fills the gap
+        if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+            truncated_datagrams_++;
+            datagram_sizes_[i] = 0;
+        } else {
+            datagram_sizes_[i] = msgs[i].msg_len;
+        }
+    }
+#endif
+    
+    size_t bytes = 0;
+    for (int i = 0; i < count; ++i) {
+        bytes += datagram_sizes_[i];
+    }
+    bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+    datagrams_received_ += count;
+    return count;
+}
+
 void MarketDataSocket::disconnect() {
     connected_.store(false);
     
@@ -350,4 +545,88 @@ bool MarketDataSocket::reconnect() {
     return false;
 }
 
+SocketPoller::SocketPoller() {
+#ifdef USE_KQUEUE
+    event_fd_ = kqueue();
+#else
+    event_fd_ = epoll_create1(0);
+#endif
+    if (event_fd_ < 0) {
+        last_error_ = "Failed to create poller: " + std::string(strerror(errno));
+    }
+}
+
+SocketPoller::~SocketPoller() {
+    if (event_fd_ >= 0) {
+        ::close(event_fd_);
+    }
+}
+
+bool SocketPoller::add(const MarketDataSocket& socket, uint32_t index) {
+    if (event_fd_ < 0 || socket.event_fd() < 0) {
+        last_error_ = "Socket not connected";
+        return false;
+    }
+    
+    // Level-triggered: stays ready until the socket collects its events
+#ifdef USE_KQUEUE
+    struct kevent ev;
+    EV_SET(&ev, socket.event_fd(), EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0,
+           reinterpret_cast<void*>(static_cast<uintptr_t>(index)));
+    if (kevent(event_fd_, &ev, 1, nullptr, 0, nullptr) < 0) {
+        last_error_ = "Failed to register socket: " + std::string(strerror(errno));
+        return false;
+    }
+#else
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u32 = index;
+    if (epoll_ctl(event_fd_, EPOLL_CTL_ADD, socket.event_fd(), &ev) < 0) {
+        last_error_ = "Failed to register socket: " + std::string(strerror(errno));
+        return false;
+    }
+#endif
+    
+    return true;
+}
+
+int SocketPoller::wait(uint32_t timeout_ms, uint32_t* ready, int max_ready) {
+    constexpr int MAX_EVENTS = 64;
+    int max = std::min(max_ready, MAX_EVENTS);
+    
+#ifdef USE_KQUEUE
+    struct kevent events[MAX_EVENTS];
+    struct timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (timeout_ms % 1000) * 1000000;
+    
+    int nev = kevent(event_fd_, nullptr, 0, events, max, &ts);
+    if (nev < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        last_error_ = "kqueue wait error: " + std::string(strerror(errno));
+        return -1;
+    }
+    for (int i = 0; i < nev; ++i) {
+        ready[i] = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(events[i].udata));
+    }
+#else
+    struct epoll_event events[MAX_EVENTS];
+    int nev = epoll_wait(event_fd_, events, max, timeout_ms);
+    if (nev < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        last_error_ = "epoll wait error: " + std::string(strerror(errno));
+        return -1;
+    }
+    for (int i = 0; i < nev; ++i) {
+        ready[i] = events[i].data.u32;
+    }
+#endif
+    
+    return nev;
+}
+
 } // namespace mdf
@@ -1,6 +1,7 @@
 #include "visualizer.h"
 #include "protocol.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
@@ -22,7 +23,38 @@ Visualizer::Visualizer() {
   last_update_ = start_time_;
 }
 
-Visualizer::~Visualizer() { stop(); }
+Visualizer::~Visualizer() {
+  stop();
+  set_cache(nullptr);
+}
+
+void Visualizer::set_cache(SymbolCache *cache) {
+  if (cache_ && change_reader_ >= 0) {
+    cache_->unregister_change_reader(change_reader_);
+  }
+
+  cache_ = cache;
+  change_reader_ = -1;
+  size_t num_symbols = cache_ ? cache_->num_symbols() : 0;
+  states_.assign(num_symbols, MarketState{});
+  changed_ids_.resize(num_symbols);
+
+  if (cache_) {
+    // Everything is stale until the first refresh
+    for (size_t i = 0; i < num_symbols; ++i) {
+      states_[i] = cache_->get_snapshot(i);
+    }
+    change_reader_ = cache_->register_change_reader();
+  }
+}
+
+void Visualizer::refresh_states() {
+  size_t n = cache_->poll_changes(change_reader_, changed_ids_.data(),
+                                  changed_ids_.size());
+  for (size_t i = 0; i < n; ++i) {
+    states_[changed_ids_[i]] = cache_->get_snapshot(changed_ids_[i]);
+  }
+}
 
 void Visualizer::init_terminal() {
   if (terminal_initialized_)
@@ -130,6 +162,7 @@ void Visualizer::reset_stats() {
 
   if (cache_) {
     cache_->reset();
+    std::fill(states_.begin(), states_.end(), MarketState{});
   }
   if (latency_tracker_) {
     latency_tracker_->reset();
@@ -226,7 +259,28 @@ void Visualizer::render_market_table() {
   // Get top symbols
   uint16_t symbol_ids[MAX_SYMBOLS_DISPLAY];
   MarketState states[MAX_SYMBOLS_DISPLAY];
-  cache_->get_top_symbols(symbol_ids, states, MAX_SYMBOLS_DISPLAY);
+  if (change_reader_ >= 0) {
+    refresh_states();
+
+    std::vector<std::pair<uint64_t, uint16_t>> ranked;
+    ranked.reserve(states_.size());
+    for (size_t i = 0; i < states_.size(); ++i) {
+      if (states_[i].update_count > 0) {
+        ranked.emplace_back(states_[i].update_count, static_cast<uint16_t>(i));
+      }
+    }
+
+    size_t n = std::min(MAX_SYMBOLS_DISPLAY, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + n, ranked.end(),
+                      std::greater<std::pair<uint64_t, uint16_t>>());
+    for (size_t i = 0; i < MAX_SYMBOLS_DISPLAY; ++i) {
+      symbol_ids[i] = i < n ? ranked[i].second : 0;
+      states[i] = i < n ? states_[ranked[i].second] : MarketState{};
+    }
+  } else {
+    // All change reader slots taken
+    cache_->get_top_symbols(symbol_ids, states, MAX_SYMBOLS_DISPLAY);
+  }
 
   for (size_t i = 0; i < MAX_SYMBOLS_DISPLAY; ++i) {
     const auto &state = states[i];
@@ -242,7 +296,8 @@ void Visualizer::render_market_table() {
     }
 
     // Symbol name
-    std::cout << std::left << std::setw(12) << get_symbol_name(symbol_ids[i]);
+    std::cout << std::left << std::setw(12)
+              << (symbols_ ? symbols_->name(symbol_ids[i]) : "?");
 
     // Prices
     std::cout << std::right << std::setw(12) << format_price(state.best_bid);
@@ -0,0 +1,82 @@
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace mdf {
+
+namespace {
+
+// Plain thread_local integers need no constructor, so the first
+// allocation on a new thread can safely count itself
+thread_local uint64_t t_allocations = 0;
+thread_local uint64_t t_bytes = 0;
+
+// Constant-initialised, so usable before any constructor has run
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<AllocationHook> g_hook{nullptr};
+
+void count(std::size_t size) {
+    ++t_allocations;
+    t_bytes += size;
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (AllocationHook hook = g_hook.load(std::memory_order_acquire)) {
+        hook(size);
+    }
+}
+
+void* counted_alloc(std::size_t size) {
+    count(size);
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* counted_aligned_alloc(std::size_t size, std::align_val_t align) {
+    count(size);
+    std::size_t alignment = static_cast<std::size_t>(align);
+    void* ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+AllocationCounts thread_allocations() {
+    return {t_allocations, t_bytes};
+}
+
+AllocationCounts process_allocations() {
+    return {g_allocations.load(std::memory_order_relaxed),
+            g_bytes.load(std::memory_order_relaxed)};
+}
+
+void set_allocation_hook(AllocationHook hook) {
+    g_hook.store(hook, std::memory_order_release);
+}
+
+} // namespace mdf
+
+void* operator new(std::size_t size) { return mdf::counted_alloc(size); }
+void* operator new[](std::size_t size) { return mdf::counted_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) {
+    return mdf::counted_aligned_alloc(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return mdf::counted_aligned_alloc(size, align);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
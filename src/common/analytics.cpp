@@ -0,0 +1,183 @@
+#include "analytics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mdf {
+
+static constexpr size_t MAX_BAR_HISTORY = 1024;
+
+AnalyticsEngine::AnalyticsEngine(size_t num_symbols, size_t bar_history)
+    : num_symbols_(std::min(num_symbols, MAX_SYMBOL_CAPACITY))
+    , bar_history_(std::clamp<size_t>(bar_history, 1, MAX_BAR_HISTORY))
+    , entries_(num_symbols_)
+    , bars_(num_symbols_ * NUM_INTERVALS * bar_history_) {
+}
+
+void AnalyticsEngine::on_trade(uint16_t symbol_id, double price, uint32_t quantity,
+                               uint64_t timestamp_ns) {
+    if (symbol_id >= num_symbols_ || price <= 0.0) return;
+
+    auto& entry = entries_[symbol_id];
+    uint64_t seq = entry.sequence.load(std::memory_order_relaxed);
+    entry.sequence.store(seq + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.pv_sum += price * quantity;
+    entry.volume += quantity;
+    entry.trades++;
+
+    // Simple return instead of log return: same to first order for tick
+    // moves, and keeps log() off the per-trade path
+    if (entry.last_price > 0.0) {
+        double r = (price - entry.last_price) / entry.last_price;
+        entry.variance = VOLATILITY_DECAY * entry.variance + (1.0 - VOLATILITY_DECAY) * r * r;
+    }
+    entry.last_price = price;
+
+    for (size_t i = 0; i < NUM_INTERVALS; ++i) {
+        update_bar(entry, symbol_id, i, price, quantity, timestamp_ns);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.sequence.store(seq + 2, std::memory_order_release);
+}
+
+void AnalyticsEngine::update_bar(Entry& entry, uint16_t symbol_id, size_t interval,
+                                 double price, uint32_t quantity, uint64_t timestamp_ns) {
+    uint64_t length = bar_interval_ns(static_cast<BarInterval>(interval));
+    uint64_t start = timestamp_ns - timestamp_ns % length;
+
+    Bar* bars = ring(symbol_id, interval);
+    uint16_t& head = entry.bar_head[interval];
+    uint16_t& count = entry.bar_count[interval];
+    Bar& current = bars[head];
+
+    // A late trade from an earlier interval folds into the current bar
+    // rather than rewriting closed history
+    if (count > 0 && start <= current.start_ns) {
+        current.high = std::max(current.high, price);
+        current.low = std::min(current.low, price);
+        current.close = price;
+        current.volume += quantity;
+        current.trades++;
+        return;
+    }
+
+    if (count > 0) {
+        size_t next_head = static_cast<size_t>(head) + 1;
+        head = static_cast<uint16_t>(next_head == bar_history_ ? 0 : next_head);
+    }
+    if (static_cast<size_t>(count) < bar_history_) {
+        count++;
+    }
+    Bar& next = bars[head];
+    next.start_ns = start;
+    next.open = next.high = next.low = next.close = price;
+    next.volume = quantity;
+    next.trades = 1;
+}
+
+void AnalyticsEngine::on_quote(uint16_t symbol_id, double bid_price, double ask_price) {
+    if (symbol_id >= num_symbols_) return;
+
+    auto& entry = entries_[symbol_id];
+    uint64_t seq = entry.sequence.load(std::memory_order_relaxed);
+    entry.sequence.store(seq + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.mid = (bid_price + ask_price) * 0.5;
+    entry.spread = ask_price - bid_price;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.sequence.store(seq + 2, std::memory_order_release);
+}
+
+Analytics AnalyticsEngine::get(uint16_t symbol_id) const {
+    Analytics out;
+    if (symbol_id >= num_symbols_) return out;
+
+    const auto& entry = entries_[symbol_id];
+    double pv_sum, variance;
+    uint64_t seq1, seq2;
+    do {
+        seq1 = entry.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = entry.sequence.load(std::memory_order_acquire);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        pv_sum = entry.pv_sum;
+        variance = entry.variance;
+        out.volume = entry.volume;
+        out.trades = entry.trades;
+        out.mid = entry.mid;
+        out.spread = entry.spread;
+        out.second_bar = entry.bar_count[0] ? ring(symbol_id, 0)[entry.bar_head[0]] : Bar{};
+        out.minute_bar = entry.bar_count[1] ? ring(symbol_id, 1)[entry.bar_head[1]] : Bar{};
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        seq2 = entry.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+
+    // Derived on read so the writer only keeps sums
+    out.vwap = out.volume ? pv_sum / out.volume : 0.0;
+    out.volatility = std::sqrt(variance);
+    return out;
+}
+
+size_t AnalyticsEngine::get_bars(uint16_t symbol_id, BarInterval interval, Bar* out,
+                                 size_t max_bars) const {
+    if (symbol_id >= num_symbols_) return 0;
+
+    size_t i = static_cast<size_t>(interval);
+    const auto& entry = entries_[symbol_id];
+    const Bar* bars = ring(symbol_id, i);
+    size_t n;
+    uint64_t seq1, seq2;
+    do {
+        seq1 = entry.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = entry.sequence.load(std::memory_order_acquire);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        size_t slot = entry.bar_head[i];
+        n = std::min<size_t>(entry.bar_count[i], max_bars);
+        for (size_t k = 0; k < n; ++k) {
+            out[k] = bars[slot];
+            slot = slot == 0 ? bar_history_ - 1 : slot - 1;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        seq2 = entry.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+
+    return n;
+}
+
+void AnalyticsEngine::reset() {
+    for (size_t s = 0; s < num_symbols_; ++s) {
+        auto& entry = entries_[s];
+        uint64_t seq = entry.sequence.load(std::memory_order_relaxed);
+        entry.sequence.store(seq + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        entry.pv_sum = 0.0;
+        entry.volume = 0;
+        entry.trades = 0;
+        entry.last_price = 0.0;
+        entry.variance = 0.0;
+        entry.mid = 0.0;
+        entry.spread = 0.0;
+        for (size_t i = 0; i < NUM_INTERVALS; ++i) {
+            entry.bar_head[i] = 0;
+            entry.bar_count[i] = 0;
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.sequence.store(seq + 2, std::memory_order_release);
+    }
+}
+
+} // namespace mdf
@@ -0,0 +1,84 @@
+#include "batch_encoder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace mdf {
+
+BatchEncoder::BatchEncoder(size_t max_packet_size)
+    : max_size_(std::min(max_packet_size, MAX_BATCH_PACKET_SIZE)) {
+}
+
+bool BatchEncoder::append(const uint8_t* msg, size_t len) {
+    if (len < HEADER_SIZE + CHECKSUM_SIZE) return false;
+
+    MessageHeader header;
+    std::memcpy(&header, msg, sizeof(header));
+
+    // Heartbeats and unknown types go out unbatched
+    MessageType type = static_cast<MessageType>(header.message_type);
+    size_t payload_size = get_payload_size(type);
+    if (payload_size == 0 || header.message_type > 0xFF ||
+        len != HEADER_SIZE + payload_size + CHECKSUM_SIZE) {
+        return false;
+    }
+
+    if (write_pos_ + BATCH_RECORD_SIZE + payload_size + CHECKSUM_SIZE > max_size_) {
+        return false;
+    }
+
+    BatchRecord record;
+    if (count_ == 0) {
+        base_sequence_ = header.sequence_number;
+        base_timestamp_ = header.timestamp_ns;
+        record.sequence_delta = 0;
+        record.timestamp_delta_ns = 0;
+    } else {
+        // Deltas must fit the record fields
+        uint32_t seq_delta = header.sequence_number - last_sequence_;
+        if (seq_delta > UINT8_MAX || header.timestamp_ns < last_timestamp_ ||
+            header.timestamp_ns - last_timestamp_ > UINT32_MAX) {
+            return false;
+        }
+        record.sequence_delta = static_cast<uint8_t>(seq_delta);
+        record.timestamp_delta_ns =
+            static_cast<uint32_t>(header.timestamp_ns - last_timestamp_);
+    }
+
+    record.message_type = static_cast<uint8_t>(header.message_type);
+    record.symbol_id = header.symbol_id;
+
+    std::memcpy(buffer_.data() + write_pos_, &record, sizeof(record));
+    write_pos_ += sizeof(record);
+    std::memcpy(buffer_.data() + write_pos_, msg + HEADER_SIZE, payload_size);
+    write_pos_ += payload_size;
+
+    last_sequence_ = header.sequence_number;
+    last_timestamp_ = header.timestamp_ns;
+    count_++;
+    return true;
+}
+
+size_t BatchEncoder::finish() {
+    if (count_ == 0) return 0;
+
+    BatchHeader header{};
+    header.message_type = static_cast<uint16_t>(MessageType::BATCH);
+    header.message_count = count_;
+    header.base_sequence = base_sequence_;
+    header.base_timestamp_ns = base_timestamp_;
+    header.packet_length = static_cast<uint16_t>(write_pos_ + CHECKSUM_SIZE);
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+
+    uint32_t checksum = calculate_checksum(buffer_.data(), write_pos_);
+    std::memcpy(buffer_.data() + write_pos_, &checksum, sizeof(checksum));
+    write_pos_ += CHECKSUM_SIZE;
+
+    return write_pos_;
+}
+
+void BatchEncoder::clear() {
+    write_pos_ = BATCH_HEADER_SIZE;
+    count_ = 0;
+}
+
+} // namespace mdf
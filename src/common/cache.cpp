@@ -1,109 +1,422 @@
 #include "cache.h"
 #include <algorithm>
 #include <vector>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#ifndef USE_KQUEUE
+#include <sys/eventfd.h>
+#endif
 
 namespace mdf {
 
-SymbolCache::SymbolCache(size_t num_symbols) 
-    : num_symbols_(std::min(num_symbols, MAX_SYMBOLS)) {
+namespace {
+
+// Prices as stored by each layout
+template <typename Price> Price to_cache_price(double price);
+template <> double to_cache_price<double>(double price) { return price; }
+template <> int32_t to_cache_price<int32_t>(double price) { return to_fixed_price(price); }
+
+inline double from_cache_price(double price) { return price; }
+inline double from_cache_price(int32_t price) { return from_fixed_price(price); }
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Increment sequence to odd (indicates write in progress)
+// shared: other writers may hold the symbol, so wait for an even sequence
+// and claim it with a CAS instead of a plain store
+template <typename Seq>
+inline void begin_write(std::atomic<Seq>& sequence, bool shared) {
+    Seq seq = sequence.load(std::memory_order_relaxed);
+    if (shared) {
+        unsigned spins = 0;
+        while ((seq & 1) || !sequence.compare_exchange_weak(seq, seq + 1,
+                                                            std::memory_order_acquire,
+                                                            std::memory_order_relaxed)) {
+            if (seq & 1) {
+                // Holder may be descheduled - stop burning its time slice
+                if (++spins % 64 == 0) {
+                    std::this_thread::yield();
+                } else {
+                    cpu_relax();
+                }
+                seq = sequence.load(std::memory_order_relaxed);
+            }
+        }
+    } else {
+        sequence.store(seq + 1, std::memory_order_release);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+// Stripe for the calling writer thread, assigned round-robin on first use
+inline size_t writer_stripe(size_t stripes) {
+    static std::atomic<size_t> next_stripe{0};
+    thread_local size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed);
+    return stripe % stripes;
+}
+
+// Increment sequence to even (indicates write complete)
+template <typename Seq>
+inline void end_write(std::atomic<Seq>& sequence) {
+    std::atomic_thread_fence(std::memory_order_release);
+    Seq seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_release);
+}
+
+// Fill field by field: building a temporary and copying it whole makes
+// the compiler reload it with one wide load that can't be store-forwarded
+template <typename Entry>
+inline void to_state(const Entry& entry, double opening_price, MarketState& state) {
+    state.best_bid = from_cache_price(entry.best_bid);
+    state.best_ask = from_cache_price(entry.best_ask);
+    state.bid_quantity = entry.bid_quantity;
+    state.ask_quantity = entry.ask_quantity;
+    state.last_traded_price = from_cache_price(entry.last_traded_price);
+    state.last_traded_quantity = entry.last_traded_quantity;
+    state.last_update_time = entry.last_update_time;
+    state.update_count = entry.update_count;
+    state.opening_price = opening_price;
+}
+
+template <typename Entry>
+inline void clear_entry(Entry& entry) {
+    entry.sequence.store(0, std::memory_order_relaxed);
+    entry.bid_quantity = 0;
+    entry.ask_quantity = 0;
+    entry.last_traded_quantity = 0;
+    entry.has_opening = 0;
+    entry.best_bid = 0;
+    entry.best_ask = 0;
+    entry.last_traded_price = 0;
+    entry.last_update_time = 0;
+    entry.update_count = 0;
+}
+
+} // namespace
+
+SymbolCache::SymbolCache(size_t num_symbols, CacheLayout layout)
+    : num_symbols_(std::min(num_symbols, MAX_SYMBOL_CAPACITY))
+    , layout_(layout)
+    , snapshots_(new SnapshotBuffer[2])
+    , change_words_((num_symbols_ + 63) / 64) {
+    switch (layout_) {
+    case CacheLayout::Wide:
+        entries_ = HugeArray<SymbolEntry>(num_symbols_);
+        break;
+    case CacheLayout::Compact:
+        compact_ = HugeArray<CompactEntry<double>>(num_symbols_);
+        opening_prices_ = HugeArray<double>(num_symbols_);
+        break;
+    case CacheLayout::CompactFixed:
+        compact_fixed_ = HugeArray<CompactEntry<int32_t>>(num_symbols_);
+        opening_prices_ = HugeArray<double>(num_symbols_);
+        break;
+    }
+    
+    for (size_t i = 0; i < 2; ++i) {
+        snapshots_[i].snapshot.states.resize(num_symbols_);
+    }
+    for (auto& reader : change_readers_) {
+        reader.dirty.reset(new std::atomic<uint64_t>[change_words_]);
+    }
     reset();
 }
 
-void SymbolCache::begin_write(uint16_t symbol_id) {
-    if (symbol_id >= num_symbols_) return;
+HugePageBuffer::Backing SymbolCache::backing() const {
+    switch (layout_) {
+    case CacheLayout::Compact:      return compact_.backing();
+    case CacheLayout::CompactFixed: return compact_fixed_.backing();
+    case CacheLayout::Wide:
+    default:                        return entries_.backing();
+    }
+}
+
+SymbolCache::~SymbolCache() {
+    for (auto& reader : change_readers_) {
+        if (reader.wake_write_fd >= 0 && reader.wake_write_fd != reader.wake_fd) {
+            ::close(reader.wake_write_fd);
+        }
+        if (reader.wake_fd >= 0) {
+            ::close(reader.wake_fd);
+        }
+    }
+}
+
+template <typename Fn>
+void SymbolCache::write(uint16_t symbol_id, Fn&& fn) {
+    switch (layout_) {
+    case CacheLayout::Wide: {
+        auto& entry = entries_[symbol_id];
+        begin_write(entry.sequence, writer_mode_ == WriterMode::Shared);
+        fn(entry.state, [&entry](double price) {
+            if (entry.state.opening_price == 0.0) {
+                entry.state.opening_price = price;
+            }
+        });
+        end_write(entry.sequence);
+        break;
+    }
+    case CacheLayout::Compact:
+        write_compact(compact_[symbol_id], symbol_id, fn);
+        break;
+    case CacheLayout::CompactFixed:
+        write_compact(compact_fixed_[symbol_id], symbol_id, fn);
+        break;
+    }
     
-    // Increment sequence to odd (indicates write in progress)
-    auto& entry = entries_[symbol_id];
-    uint64_t seq = entry.sequence.load(std::memory_order_relaxed);
-    entry.sequence.store(seq + 1, std::memory_order_release);
-    std::atomic_thread_fence(std::memory_order_release);
+    count_update();
+    mark_changed(symbol_id);
 }
 
-void SymbolCache::end_write(uint16_t symbol_id) {
-    if (symbol_id >= num_symbols_) return;
+template <typename Entry, typename Fn>
+void SymbolCache::write_compact(Entry& entry, uint16_t symbol_id, Fn& fn) {
+    begin_write(entry.sequence, writer_mode_ == WriterMode::Shared);
+    fn(entry, [&](double price) {
+        // Flag lives in the hot line so later updates never touch the cold one
+        if (!entry.has_opening && price != 0.0) {
+            opening_prices_[symbol_id] = price;
+            entry.has_opening = 1;
+        }
+    });
+    end_write(entry.sequence);
+}
+
+void SymbolCache::mark_changed(uint16_t symbol_id) {
+    uint32_t active = active_readers_.load(std::memory_order_acquire);
+    if (active == 0) {
+        return;
+    }
     
-    // Increment sequence to even (indicates write complete)
-    auto& entry = entries_[symbol_id];
-    std::atomic_thread_fence(std::memory_order_release);
-    uint64_t seq = entry.sequence.load(std::memory_order_relaxed);
-    entry.sequence.store(seq + 1, std::memory_order_release);
+    size_t word = symbol_id / 64;
+    uint64_t bit = 1ULL << (symbol_id % 64);
+    
+    while (active) {
+        auto& reader = change_readers_[__builtin_ctz(active)];
+        active &= active - 1;
+        
+        // Hot symbols are usually still dirty - skip the locked RMW
+        auto& dirty = reader.dirty[word];
+        if (!(dirty.load(std::memory_order_relaxed) & bit)) {
+            dirty.fetch_or(bit, std::memory_order_release);
+        }
+        
+        if (reader.wakeup.load(std::memory_order_acquire) &&
+            !reader.pending.load(std::memory_order_relaxed) &&
+            !reader.pending.exchange(true, std::memory_order_acq_rel)) {
+            wake(reader);
+        }
+    }
 }
 
-void SymbolCache::update_quote(uint16_t symbol_id, double bid_price, uint32_t bid_qty,
-                                double ask_price, uint32_t ask_qty, uint64_t timestamp) {
-    if (symbol_id >= num_symbols_) return;
+void SymbolCache::wake(ChangeReader& reader) {
+#ifdef USE_KQUEUE
+    uint8_t byte = 1;
+    ssize_t n = ::write(reader.wake_write_fd, &byte, sizeof(byte));
+#else
+    uint64_t one = 1;
+    ssize_t n = ::write(reader.wake_write_fd, &one, sizeof(one));
+#endif
+    (void)n;  // Full pipe/counter already means "wake up"
+}
+
+int SymbolCache::register_change_reader(bool with_wakeup) {
+    // Claim a free slot
+    uint32_t claimed = claimed_readers_.load();
+    int slot;
+    do {
+        uint32_t free_slots = ~claimed & ((1u << MAX_CHANGE_READERS) - 1);
+        if (free_slots == 0) {
+            return -1;
+        }
+        slot = __builtin_ctz(free_slots);
+    } while (!claimed_readers_.compare_exchange_weak(claimed, claimed | (1u << slot)));
+    
+    auto& reader = change_readers_[slot];
+    for (size_t w = 0; w < change_words_; ++w) {
+        reader.dirty[w].store(0, std::memory_order_relaxed);
+    }
+    reader.pending.store(false, std::memory_order_relaxed);
     
-    begin_write(symbol_id);
+    // Wakeup fds outlive unregister (see below) and are reused with the slot
+    if (with_wakeup && reader.wake_fd < 0) {
+#ifdef USE_KQUEUE
+        int fds[2];
+        if (pipe(fds) == 0) {
+            fcntl(fds[0], F_SETFL, O_NONBLOCK);
+            fcntl(fds[1], F_SETFL, O_NONBLOCK);
+            reader.wake_fd = fds[0];
+            reader.wake_write_fd = fds[1];
+        }
+#else
+        reader.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        reader.wake_write_fd = reader.wake_fd;
+#endif
+    }
+    if (reader.wake_fd >= 0) {
+        uint64_t drain[8];
+        while (::read(reader.wake_fd, drain, sizeof(drain)) > 0) {}
+    }
+    reader.wakeup.store(with_wakeup && reader.wake_fd >= 0, std::memory_order_release);
+    
+    // Start receiving changes
+    active_readers_.fetch_or(1u << slot, std::memory_order_release);
+    return slot;
+}
+
+void SymbolCache::unregister_change_reader(int reader_id) {
+    if (reader_id < 0 || reader_id >= static_cast<int>(MAX_CHANGE_READERS)) return;
+    
+    uint32_t bit = 1u << reader_id;
+    active_readers_.fetch_and(~bit, std::memory_order_acq_rel);
+    
+    // The writer may still be in mark_changed with the old mask, so the
+    // wakeup fd stays open (closed by the destructor) rather than risk a
+    // write to a closed or reused descriptor
+    claimed_readers_.fetch_and(~bit, std::memory_order_release);
+}
+
+size_t SymbolCache::poll_changes(int reader_id, uint16_t* out_ids, size_t max_ids) {
+    if (reader_id < 0 || reader_id >= static_cast<int>(MAX_CHANGE_READERS)) return 0;
+    auto& reader = change_readers_[reader_id];
     
-    auto& state = entries_[symbol_id].state;
-    state.best_bid = bid_price;
-    state.bid_quantity = bid_qty;
-    state.best_ask = ask_price;
-    state.ask_quantity = ask_qty;
-    state.last_update_time = timestamp;
-    state.update_count++;
+    // Clear before draining: a change landing after this re-arms the wakeup
+    reader.pending.store(false, std::memory_order_seq_cst);
     
-    // Set opening price on first update
-    if (state.opening_price == 0.0) {
-        state.opening_price = (bid_price + ask_price) / 2.0;
+    size_t count = 0;
+    for (size_t w = 0; w < change_words_; ++w) {
+        if (reader.dirty[w].load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        
+        uint64_t bits = reader.dirty[w].exchange(0, std::memory_order_acquire);
+        while (bits && count < max_ids) {
+            out_ids[count++] = static_cast<uint16_t>(w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+        
+        if (bits) {
+            // Out of room - leave the rest pending
+            reader.dirty[w].fetch_or(bits, std::memory_order_relaxed);
+            break;
+        }
     }
     
-    end_write(symbol_id);
+    return count;
 }
 
-void SymbolCache::update_trade(uint16_t symbol_id, double price, uint32_t quantity,
-                                uint64_t timestamp) {
-    if (symbol_id >= num_symbols_) return;
+bool SymbolCache::wait_for_changes(int reader_id, int timeout_ms) {
+    if (reader_id < 0 || reader_id >= static_cast<int>(MAX_CHANGE_READERS)) return false;
+    auto& reader = change_readers_[reader_id];
     
-    begin_write(symbol_id);
+    auto has_changes = [this, &reader]() {
+        for (size_t w = 0; w < change_words_; ++w) {
+            if (reader.dirty[w].load(std::memory_order_acquire)) return true;
+        }
+        return false;
+    };
     
-    auto& state = entries_[symbol_id].state;
-    state.last_traded_price = price;
-    state.last_traded_quantity = quantity;
-    state.last_update_time = timestamp;
-    state.update_count++;
+    if (has_changes()) {
+        return true;
+    }
+    if (!reader.wakeup.load(std::memory_order_acquire)) {
+        return false;
+    }
     
-    // Set opening price on first trade
-    if (state.opening_price == 0.0) {
-        state.opening_price = price;
+    struct pollfd pfd;
+    pfd.fd = reader.wake_fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, timeout_ms) > 0) {
+        // Consume the wakeup
+        uint64_t drain[8];
+        while (::read(reader.wake_fd, drain, sizeof(drain)) > 0) {}
     }
     
-    end_write(symbol_id);
+    return has_changes();
 }
 
-void SymbolCache::update_bid(uint16_t symbol_id, double price, uint32_t quantity,
-                              uint64_t timestamp) {
+int SymbolCache::change_fd(int reader_id) const {
+    if (reader_id < 0 || reader_id >= static_cast<int>(MAX_CHANGE_READERS)) return -1;
+    const auto& reader = change_readers_[reader_id];
+    return reader.wakeup.load(std::memory_order_acquire) ? reader.wake_fd : -1;
+}
+
+void SymbolCache::update_quote(uint16_t symbol_id, double bid_price, uint32_t bid_qty,
+                                double ask_price, uint32_t ask_qty, uint64_t timestamp) {
     if (symbol_id >= num_symbols_) return;
     
-    begin_write(symbol_id);
+    write(symbol_id, [&](auto& state, auto&& set_opening) {
+        using Price = decltype(state.best_bid);
+        state.best_bid = to_cache_price<Price>(bid_price);
+        state.bid_quantity = bid_qty;
+        state.best_ask = to_cache_price<Price>(ask_price);
+        state.ask_quantity = ask_qty;
+        state.last_update_time = timestamp;
+        state.update_count++;
+        
+        // Set opening price on first update
+        set_opening((bid_price + ask_price) / 2.0);
+    });
+}
+
+void SymbolCache::update_trade(uint16_t symbol_id, double price, uint32_t quantity,
+                                uint64_t timestamp) {
+    if (symbol_id >= num_symbols_) return;
     
-    auto& state = entries_[symbol_id].state;
-    state.best_bid = price;
-    state.bid_quantity = quantity;
-    state.last_update_time = timestamp;
-    state.update_count++;
+    write(symbol_id, [&](auto& state, auto&& set_opening) {
+        using Price = decltype(state.best_bid);
+        state.last_traded_price = to_cache_price<Price>(price);
+        state.last_traded_quantity = quantity;
+        state.last_update_time = timestamp;
+        state.update_count++;
+        
+        // Set opening price on first trade
+        set_opening(price);
+    });
+}
+
+void SymbolCache::update_bid(uint16_t symbol_id, double price, uint32_t quantity,
+                              uint64_t timestamp) {
+    if (symbol_id >= num_symbols_) return;
     
-    end_write(symbol_id);
+    write(symbol_id, [&](auto& state, auto&&) {
+        using Price = decltype(state.best_bid);
+        state.best_bid = to_cache_price<Price>(price);
+        state.bid_quantity = quantity;
+        state.last_update_time = timestamp;
+        state.update_count++;
+    });
 }
 
 void SymbolCache::update_ask(uint16_t symbol_id, double price, uint32_t quantity,
                               uint64_t timestamp) {
     if (symbol_id >= num_symbols_) return;
     
-    begin_write(symbol_id);
-    
-    auto& state = entries_[symbol_id].state;
-    state.best_ask = price;
-    state.ask_quantity = quantity;
-    state.last_update_time = timestamp;
-    state.update_count++;
-    
-    end_write(symbol_id);
+    write(symbol_id, [&](auto& state, auto&&) {
+        using Price = decltype(state.best_bid);
+        state.best_ask = to_cache_price<Price>(price);
+        state.ask_quantity = quantity;
+        state.last_update_time = timestamp;
+        state.update_count++;
+    });
 }
 
 MarketState SymbolCache::get_snapshot(uint16_t symbol_id) const {
     if (symbol_id >= num_symbols_) return MarketState{};
     
+    if (layout_ == CacheLayout::Compact) {
+        return read_compact(compact_[symbol_id], symbol_id);
+    }
+    if (layout_ == CacheLayout::CompactFixed) {
+        return read_compact(compact_fixed_[symbol_id], symbol_id);
+    }
+    
     const auto& entry = entries_[symbol_id];
     MarketState snapshot;
     
@@ -127,16 +440,59 @@ MarketState SymbolCache::get_snapshot(uint16_t symbol_id) const {
     return snapshot;
 }
 
+template <typename Entry>
+MarketState SymbolCache::read_compact(const Entry& entry, uint16_t symbol_id) const {
+    MarketState snapshot;
+    
+    uint32_t seq1, seq2;
+    do {
+        seq1 = entry.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = entry.sequence.load(std::memory_order_acquire);
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        to_state(entry, entry.has_opening ? opening_prices_[symbol_id] : 0.0, snapshot);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        
+        seq2 = entry.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+    
+    return snapshot;
+}
+
+MarketState SymbolCache::load_state(uint16_t symbol_id) const {
+    switch (layout_) {
+    case CacheLayout::Compact: {
+        const auto& entry = compact_[symbol_id];
+        MarketState state;
+        to_state(entry, entry.has_opening ? opening_prices_[symbol_id] : 0.0, state);
+        return state;
+    }
+    case CacheLayout::CompactFixed: {
+        const auto& entry = compact_fixed_[symbol_id];
+        MarketState state;
+        to_state(entry, entry.has_opening ? opening_prices_[symbol_id] : 0.0, state);
+        return state;
+    }
+    case CacheLayout::Wide:
+    default:
+        return entries_[symbol_id].state;
+    }
+}
+
 void SymbolCache::get_top_symbols(uint16_t* out_ids, MarketState* out_states,
                                    size_t count) const {
-    // Collect all symbols with their update counts
+    // Collect all symbols with their update counts, keeping the state read
+    // here so each winner isn't read a second time
     std::vector<std::pair<uint64_t, uint16_t>> symbols;
+    std::vector<MarketState> states(num_symbols_);
     symbols.reserve(num_symbols_);
     
     for (uint16_t i = 0; i < num_symbols_; ++i) {
-        MarketState state = get_snapshot(i);
-        if (state.update_count > 0) {
-            symbols.emplace_back(state.update_count, i);
+        states[i] = get_snapshot(i);
+        if (states[i].update_count > 0) {
+            symbols.emplace_back(states[i].update_count, i);
         }
     }
     
@@ -150,7 +506,7 @@ void SymbolCache::get_top_symbols(uint16_t* out_ids, MarketState* out_states,
     size_t n = std::min(count, symbols.size());
     for (size_t i = 0; i < n; ++i) {
         out_ids[i] = symbols[i].second;
-        out_states[i] = get_snapshot(symbols[i].second);
+        out_states[i] = states[symbols[i].second];
     }
     
     // Zero out remaining slots
@@ -160,20 +516,99 @@ void SymbolCache::get_top_symbols(uint16_t* out_ids, MarketState* out_states,
     }
 }
 
+void SymbolCache::count_update_striped() {
+    update_stripes_[writer_stripe(UPDATE_STRIPES)].count.fetch_add(1, std::memory_order_relaxed);
+}
+
 uint64_t SymbolCache::get_total_updates() const {
-    uint64_t total = 0;
-    for (size_t i = 0; i < num_symbols_; ++i) {
-        MarketState state = get_snapshot(i);
-        total += state.update_count;
+    uint64_t total = total_updates_.load(std::memory_order_relaxed);
+    if (writer_mode_ != WriterMode::Single) {
+        for (const auto& stripe : update_stripes_) {
+            total += stripe.count.load(std::memory_order_relaxed);
+        }
     }
     return total;
 }
 
+void SymbolCache::publish_snapshot() {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    uint64_t epoch = published_epoch_.load(std::memory_order_relaxed) + 1;
+    auto& buffer = snapshots_[epoch & 1];
+    
+    uint64_t seq = buffer.sequence.load(std::memory_order_relaxed);
+    buffer.sequence.store(seq + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    // Single writer: live entries can be read without the SeqLock
+    // Otherwise other writers may be mid-update, so read like a reader
+    auto& snapshot = buffer.snapshot;
+    bool single = writer_mode_ == WriterMode::Single;
+    for (uint16_t i = 0; i < num_symbols_; ++i) {
+        snapshot.states[i] = single ? load_state(i) : get_snapshot(i);
+    }
+    snapshot.num_symbols = num_symbols_;
+    snapshot.total_updates = get_total_updates();
+    snapshot.epoch = epoch;
+    
+    std::atomic_thread_fence(std::memory_order_release);
+    buffer.sequence.store(seq + 2, std::memory_order_release);
+    published_epoch_.store(epoch, std::memory_order_release);
+}
+
+bool SymbolCache::read_snapshot(CacheSnapshot& out) const {
+    while (true) {
+        uint64_t epoch = published_epoch_.load(std::memory_order_acquire);
+        if (epoch == 0) {
+            return false;
+        }
+        
+        const auto& buffer = snapshots_[epoch & 1];
+        uint64_t seq1 = buffer.sequence.load(std::memory_order_acquire);
+        if (seq1 & 1) {
+            continue;  // Writer lapped us and is republishing this buffer
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto& snapshot = buffer.snapshot;
+        size_t n = snapshot.num_symbols;
+        if (out.states.size() < n) {
+            out.states.resize(n);   // First read into this CacheSnapshot
+        }
+        std::copy(snapshot.states.begin(), snapshot.states.begin() + n, out.states.begin());
+        out.num_symbols = n;
+        out.total_updates = snapshot.total_updates;
+        out.epoch = snapshot.epoch;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        
+        if (buffer.sequence.load(std::memory_order_acquire) == seq1) {
+            return true;
+        }
+    }
+}
+
 void SymbolCache::reset() {
-    for (size_t i = 0; i < MAX_SYMBOLS; ++i) {
-        entries_[i].sequence.store(0, std::memory_order_relaxed);
-        entries_[i].state = MarketState{};
+    for (size_t i = 0; i < num_symbols_; ++i) {
+        switch (layout_) {
+        case CacheLayout::Wide:
+            entries_[i].sequence.store(0, std::memory_order_relaxed);
+            entries_[i].state = MarketState{};
+            break;
+        case CacheLayout::Compact:
+            clear_entry(compact_[i]);
+            opening_prices_[i] = 0.0;
+            break;
+        case CacheLayout::CompactFixed:
+            clear_entry(compact_fixed_[i]);
+            opening_prices_[i] = 0.0;
+            break;
+        }
+    }
+    
+    total_updates_.store(0, std::memory_order_relaxed);
+    for (auto& stripe : update_stripes_) {
+        stripe.count.store(0, std::memory_order_relaxed);
     }
+    published_epoch_.store(0, std::memory_order_release);
 }
 
 } // namespace mdf
@@ -0,0 +1,152 @@
+#include "huge_pages.h"
+#include "cpu_affinity.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+namespace mdf {
+
+static constexpr size_t PAGE_SIZE_4K = 4096;
+
+static MemoryPolicy g_policy;
+
+static size_t round_up(size_t bytes, size_t page) {
+    return (bytes + page - 1) / page * page;
+}
+
+bool parse_memory_policy(const std::string& spec, MemoryPolicy& policy) {
+    std::istringstream in(spec);
+    std::string field;
+    while (std::getline(in, field, ',')) {
+        if (field == "4k") {
+            policy.huge_pages = false;
+        } else if (field == "huge") {
+            policy.huge_pages = true;
+        } else if (field == "lock") {
+            policy.lock = true;
+        } else if (field == "prefault") {
+            policy.prefault = true;
+        } else if (field == "node=local") {
+            policy.numa_node = MemoryPolicy::LOCAL_NODE;
+        } else if (field.compare(0, 5, "node=") == 0 && field.size() > 5) {
+            char* end = nullptr;
+            long node = std::strtol(field.c_str() + 5, &end, 10);
+            if (*end != '\0' || node < 0 || node > 63) {
+                return false;
+            }
+            policy.numa_node = static_cast<int>(node);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void set_memory_policy(const MemoryPolicy& policy) {
+    g_policy = policy;
+}
+
+const MemoryPolicy& memory_policy() {
+    return g_policy;
+}
+
+HugePageBuffer::HugePageBuffer(size_t bytes)
+    : HugePageBuffer(bytes, memory_policy()) {
+}
+
+HugePageBuffer::HugePageBuffer(size_t bytes, const MemoryPolicy& policy) {
+    if (bytes == 0) {
+        return;
+    }
+
+    // Anonymous mappings are zero-filled and page-aligned, which covers any
+    // cache-line alignment the element type asks for
+    void* p = MAP_FAILED;
+
+    // Small tables stay on 4K pages rather than pin a whole 2MB page; past
+    // 64 pages the TLB reach is worth rounding up to a hugepage
+    bool large = policy.huge_pages && bytes >= HUGE_PAGE_SIZE / 8;
+    mapped_ = large ? round_up(bytes, HUGE_PAGE_SIZE) : bytes;
+
+#ifdef MAP_HUGETLB
+    // Explicit hugepages need a reserved pool (vm.nr_hugepages)
+    if (large) {
+        p = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            backing_ = Backing::HugeTlb;
+        }
+    }
+#endif
+
+    if (p == MAP_FAILED) {
+        p = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        backing_ = Backing::Normal;
+#ifdef MADV_HUGEPAGE
+        if (large && madvise(p, mapped_, MADV_HUGEPAGE) == 0) {
+            backing_ = Backing::Transparent;
+        }
+#endif
+    }
+
+    data_ = p;
+    size_ = bytes;
+    place(policy);
+}
+
+void HugePageBuffer::place(const MemoryPolicy& policy) {
+    // mbind only steers pages not yet faulted in, so it goes first
+    int node = policy.numa_node == MemoryPolicy::LOCAL_NODE ? current_numa_node()
+                                                            : policy.numa_node;
+#ifdef SYS_mbind
+    if (node >= 0 && node < 64) {
+        // MPOL_BIND without libnuma's header. The kernel reads one bit
+        // fewer than maxnode, hence the +1 (as libnuma does).
+        constexpr int MPOL_BIND_MODE = 2;
+        unsigned long mask = 1UL << node;
+        if (syscall(SYS_mbind, data_, mapped_, MPOL_BIND_MODE, &mask,
+                    sizeof(mask) * 8 + 1, 0) == 0) {
+            numa_node_ = node;
+        }
+    }
+#else
+    (void)node;
+#endif
+
+    // Locking faults every page in; otherwise prefault by touching one
+    // byte per 4K page, which for a hugepage mapping faults its 2MB page
+    if (policy.lock && mlock(data_, mapped_) == 0) {
+        locked_ = true;
+    } else if (policy.prefault) {
+        volatile uint8_t* bytes = static_cast<uint8_t*>(data_);
+        for (size_t offset = 0; offset < mapped_; offset += PAGE_SIZE_4K) {
+            bytes[offset] = 0;
+        }
+    }
+}
+
+HugePageBuffer::~HugePageBuffer() {
+    if (data_) {
+        munmap(data_, mapped_);
+    }
+}
+
+const char* backing_name(HugePageBuffer::Backing backing) {
+    switch (backing) {
+    case HugePageBuffer::Backing::HugeTlb:     return "hugetlb";
+    case HugePageBuffer::Backing::Transparent: return "thp";
+    case HugePageBuffer::Backing::Normal:      return "4k";
+    case HugePageBuffer::Backing::None:
+    default:                                   return "none";
+    }
+}
+
+} // namespace mdf
@@ -4,7 +4,8 @@
 
 namespace mdf {
 
-LatencyTracker::LatencyTracker() {
+LatencyTracker::LatencyTracker()
+    : ring_buffer_(RING_BUFFER_SIZE) {
     reset();
 }
 
@@ -92,8 +93,8 @@ void LatencyTracker::reset() {
         bucket.store(0, std::memory_order_relaxed);
     }
     
-    for (auto& sample : ring_buffer_) {
-        sample.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < ring_buffer_.size(); ++i) {
+        ring_buffer_[i].store(0, std::memory_order_relaxed);
     }
     
     write_index_.store(0, std::memory_order_relaxed);
@@ -1,71 +1,234 @@
 #include "memory_pool.h"
+#include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
 
 namespace mdf {
 
-MemoryPool::MemoryPool(size_t block_size, size_t num_blocks)
+namespace {
+
+constexpr size_t NO_SLOT = SIZE_MAX;
+
+// Pools with magazines, and the thread slots handed out, so an exiting
+// thread can return its cached blocks and free its slot for the next one
+struct Registry {
+    std::mutex mutex;
+    std::vector<MemoryPool*> pools;
+    std::bitset<MemoryPool::MAX_CACHED_THREADS> slots;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+struct ThreadSlot {
+    size_t index = NO_SLOT;
+    bool assigned = false;
+
+    ~ThreadSlot() {
+        if (index == NO_SLOT) return;
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (MemoryPool* pool : reg.pools) {
+            pool->flush_thread_cache();
+        }
+        reg.slots.reset(index);
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+std::atomic<uint64_t> g_heap_fallbacks{0};
+
+// This thread's magazine index in every pool, assigned on first use
+size_t thread_slot() {
+    if (!t_slot.assigned) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (size_t i = 0; i < reg.slots.size(); ++i) {
+            if (!reg.slots.test(i)) {
+                reg.slots.set(i);
+                t_slot.index = i;
+                break;
+            }
+        }
+        t_slot.assigned = true;
+    }
+    return t_slot.index;
+}
+
+} // namespace
+
+MemoryPool::MemoryPool(size_t block_size, size_t num_blocks, size_t thread_cache)
     : block_size_(std::max(block_size, sizeof(FreeNode)))
-    , num_blocks_(num_blocks) {
-    
+    , num_blocks_(num_blocks)
+    , cache_size_(std::min({thread_cache, MAX_THREAD_CACHE, num_blocks / 8})) {
+
+    assert(num_blocks_ < NIL);
+
     // Ensure block size is aligned
     block_size_ = (block_size_ + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
-    
-    // Allocate storage with extra space for alignment
-    size_t total_size = (block_size_ * num_blocks_) + CACHE_LINE_SIZE;
-    storage_ = std::make_unique<uint8_t[]>(total_size);
-    
-    // Align base pointer
-    uintptr_t base = reinterpret_cast<uintptr_t>(storage_.get());
-    uintptr_t aligned = (base + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
-    aligned_base_ = reinterpret_cast<uint8_t*>(aligned);
-    
+
+    // Mappings are page-aligned, so every block starts on a cache line
+    storage_ = HugePageBuffer(block_size_ * num_blocks_);
+    aligned_base_ = static_cast<uint8_t*>(storage_.data());
+
+    // A magazine moves half its size per refill or flush
+    if (cache_size_ < 2) {
+        cache_size_ = 0;
+    } else {
+        magazines_ = std::make_unique<Magazine[]>(MAX_CACHED_THREADS);
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.pools.push_back(this);
+    }
+
     // Initialize free list
     reset();
 }
 
-MemoryPool::~MemoryPool() = default;
+MemoryPool::~MemoryPool() {
+    if (magazines_) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.pools.erase(std::find(reg.pools.begin(), reg.pools.end(), this));
+    }
+}
+
+MemoryPool::Magazine* MemoryPool::local_magazine() {
+    if (cache_size_ == 0) return nullptr;
+    size_t slot = thread_slot();
+    return slot == NO_SLOT ? nullptr : &magazines_[slot];
+}
+
+size_t MemoryPool::pop_blocks(void** out, size_t max) {
+    uint64_t head = free_head_.load(std::memory_order_acquire);
+
+    for (;;) {
+        uint32_t index = static_cast<uint32_t>(head);
+        if (index == NIL) {
+            return 0;  // Pool exhausted
+        }
+
+        // Walk the chain under the head. Another thread may pop these
+        // blocks and write over their links meanwhile, but then the head's
+        // tag has moved on and the CAS below fails.
+        size_t count = 0;
+        while (count < max && index < num_blocks_) {
+            out[count++] = node(index);
+            index = node(index)->next.load(std::memory_order_relaxed);
+        }
+        if (index != NIL && index >= num_blocks_) {
+            // Read a link from a block already handed out
+            head = free_head_.load(std::memory_order_acquire);
+            continue;
+        }
+
+        uint64_t next = (((head >> 32) + 1) << 32) | index;
+        if (free_head_.compare_exchange_weak(head, next,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire)) {
+            outstanding_.fetch_add(count, std::memory_order_relaxed);
+            return count;
+        }
+        // CAS failed, head is updated to the current head, retry
+    }
+}
+
+void MemoryPool::push_blocks(void* const* blocks, size_t count) {
+    // Link the blocks privately, then splice the chain in with one CAS
+    for (size_t i = 0; i + 1 < count; ++i) {
+        static_cast<FreeNode*>(blocks[i])->next.store(index_of(blocks[i + 1]),
+                                                      std::memory_order_relaxed);
+    }
+    uint64_t first = index_of(blocks[0]);
+    FreeNode* last = static_cast<FreeNode*>(blocks[count - 1]);
+    outstanding_.fetch_sub(count, std::memory_order_relaxed);
+
+    uint64_t head = free_head_.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        last->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = (((head >> 32) + 1) << 32) | first;
+    } while (!free_head_.compare_exchange_weak(head, next,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
 
 void* MemoryPool::allocate() {
-    FreeNode* node = free_list_.load(std::memory_order_acquire);
-    
-    while (node) {
-        FreeNode* next = node->next.load(std::memory_order_relaxed);
-        if (free_list_.compare_exchange_weak(node, next,
-                                              std::memory_order_release,
-                                              std::memory_order_relaxed)) {
-            allocated_count_.fetch_add(1, std::memory_order_relaxed);
-            return node;
+    Magazine* mag = local_magazine();
+    if (!mag) {
+        void* block;
+        return pop_blocks(&block, 1) ? block : nullptr;
+    }
+
+    uint32_t count = mag->count.load(std::memory_order_relaxed);
+    if (count == 0) {
+        count = static_cast<uint32_t>(pop_blocks(mag->blocks, cache_size_ / 2));
+        if (count == 0) {
+            return nullptr;  // Pool exhausted
         }
-        // CAS failed, node is updated to current head, retry
     }
-    
-    return nullptr;  // Pool exhausted
+    --count;
+    mag->count.store(count, std::memory_order_relaxed);
+    return mag->blocks[count];
 }
 
 void MemoryPool::deallocate(void* ptr) {
     if (!ptr) return;
-    
+
     // Verify pointer is within our pool
-    if (ptr < aligned_base_ || 
-        ptr >= aligned_base_ + (block_size_ * num_blocks_)) {
+    if (!owns(ptr)) {
         return;  // Not our pointer
     }
-    
-    FreeNode* node = static_cast<FreeNode*>(ptr);
-    FreeNode* expected = free_list_.load(std::memory_order_relaxed);
-    
-    do {
-        node->next.store(expected, std::memory_order_relaxed);
-    } while (!free_list_.compare_exchange_weak(expected, node,
-                                                std::memory_order_release,
-                                                std::memory_order_relaxed));
-    
-    allocated_count_.fetch_sub(1, std::memory_order_relaxed);
+
+    Magazine* mag = local_magazine();
+    if (!mag) {
+        push_blocks(&ptr, 1);
+        return;
+    }
+
+    uint32_t count = mag->count.load(std::memory_order_relaxed);
+    if (count == cache_size_) {
+        // Full: return the older half, keeping the recently freed (warm)
+        // blocks for the next allocations
+        uint32_t half = static_cast<uint32_t>(cache_size_ / 2);
+        count -= half;
+        mag->count.store(count, std::memory_order_relaxed);
+        push_blocks(mag->blocks, half);
+        std::memmove(mag->blocks, mag->blocks + half, count * sizeof(void*));
+    }
+    mag->blocks[count] = ptr;
+    mag->count.store(count + 1, std::memory_order_relaxed);
+}
+
+void MemoryPool::flush_thread_cache() {
+    Magazine* mag = local_magazine();
+    if (!mag) return;
+
+    uint32_t count = mag->count.load(std::memory_order_relaxed);
+    if (count > 0) {
+        mag->count.store(0, std::memory_order_relaxed);
+        push_blocks(mag->blocks, count);
+    }
 }
 
 size_t MemoryPool::get_allocated_count() const {
-    return allocated_count_.load(std::memory_order_relaxed);
+    // Magazines first: a refill or flush in flight then overstates the
+    // count rather than taking it below zero
+    size_t cached = 0;
+    if (magazines_) {
+        for (size_t i = 0; i < MAX_CACHED_THREADS; ++i) {
+            cached += magazines_[i].count.load(std::memory_order_relaxed);
+        }
+    }
+    size_t outstanding = outstanding_.load(std::memory_order_relaxed);
+    return outstanding > cached ? outstanding - cached : 0;
 }
 
 size_t MemoryPool::get_available_count() const {
@@ -73,18 +236,57 @@ size_t MemoryPool::get_available_count() const {
 }
 
 void MemoryPool::reset() {
-    allocated_count_.store(0, std::memory_order_relaxed);
-    
-    // Build free list from all blocks
-    FreeNode* head = nullptr;
-    
+    if (magazines_) {
+        for (size_t i = 0; i < MAX_CACHED_THREADS; ++i) {
+            magazines_[i].count.store(0, std::memory_order_relaxed);
+        }
+    }
+    outstanding_.store(0, std::memory_order_relaxed);
+
+    // Build free list from all blocks, in address order
     for (size_t i = 0; i < num_blocks_; ++i) {
-        FreeNode* node = reinterpret_cast<FreeNode*>(aligned_base_ + (i * block_size_));
-        node->next.store(head, std::memory_order_relaxed);
-        head = node;
+        uint32_t next = i + 1 < num_blocks_ ? static_cast<uint32_t>(i + 1) : NIL;
+        node(static_cast<uint32_t>(i))->next.store(next, std::memory_order_relaxed);
+    }
+
+    uint64_t tag = (free_head_.load(std::memory_order_relaxed) >> 32) + 1;
+    free_head_.store((tag << 32) | (num_blocks_ > 0 ? 0 : NIL),
+                     std::memory_order_release);
+}
+
+MessageRef MessageRef::allocate(MemoryPool& pool, size_t size) {
+    Header* header = nullptr;
+    if (size <= capacity(pool)) {
+        header = static_cast<Header*>(pool.allocate());
+    }
+    if (header) {
+        header->pool = &pool;
+    } else {
+        g_heap_fallbacks.fetch_add(1, std::memory_order_relaxed);
+        header = static_cast<Header*>(::operator new(sizeof(Header) + size));
+        header->pool = nullptr;
+    }
+    new (&header->refs) std::atomic<uint32_t>(1);
+    header->size = static_cast<uint32_t>(size);
+    return MessageRef(header);
+}
+
+MessageRef MessageRef::copy_of(MemoryPool& pool, const void* data, size_t size) {
+    MessageRef msg = allocate(pool, size);
+    std::memcpy(msg.data(), data, size);
+    return msg;
+}
+
+uint64_t MessageRef::heap_fallbacks() {
+    return g_heap_fallbacks.load(std::memory_order_relaxed);
+}
+
+void MessageRef::free_block(Header* header) {
+    if (header->pool) {
+        header->pool->deallocate(header);
+    } else {
+        ::operator delete(header);
     }
-    
-    free_list_.store(head, std::memory_order_release);
 }
 
 } // namespace mdf
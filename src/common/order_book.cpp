@@ -0,0 +1,168 @@
+#include "order_book.h"
+#include <algorithm>
+#include <cstring>
+
+namespace mdf {
+
+bool OrderBook::apply(BookSide side, BookAction action, uint8_t level,
+                      double price, uint32_t quantity) {
+    double* prices = side == BookSide::BID ? bid_prices : ask_prices;
+    uint32_t* quantities = side == BookSide::BID ? bid_quantities : ask_quantities;
+    uint8_t& count = side == BookSide::BID ? bid_count : ask_count;
+
+    switch (action) {
+        case BookAction::ADD: {
+            if (level > count || level >= MAX_BOOK_LEVELS) return false;
+
+            // Shift deeper levels down, dropping the last one if full
+            size_t tail = std::min<size_t>(count, MAX_BOOK_LEVELS - 1) - level;
+            std::memmove(prices + level + 1, prices + level, tail * sizeof(double));
+            std::memmove(quantities + level + 1, quantities + level, tail * sizeof(uint32_t));
+
+            prices[level] = price;
+            quantities[level] = quantity;
+            if (count < MAX_BOOK_LEVELS) count++;
+            return true;
+        }
+
+        case BookAction::MODIFY: {
+            if (level >= count) return false;
+            prices[level] = price;
+            quantities[level] = quantity;
+            return true;
+        }
+
+        case BookAction::DELETE: {
+            if (level >= count) return false;
+
+            size_t tail = count - level - 1;
+            std::memmove(prices + level, prices + level + 1, tail * sizeof(double));
+            std::memmove(quantities + level, quantities + level + 1, tail * sizeof(uint32_t));
+
+            count--;
+            prices[count] = 0.0;
+            quantities[count] = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t OrderBook::top_levels(BookSide side, PriceLevel* out, size_t max_levels) const {
+    const double* prices = side == BookSide::BID ? bid_prices : ask_prices;
+    const uint32_t* quantities = side == BookSide::BID ? bid_quantities : ask_quantities;
+
+    size_t n = std::min(max_levels, level_count(side));
+    for (size_t i = 0; i < n; ++i) {
+        out[i].price = prices[i];
+        out[i].quantity = quantities[i];
+    }
+    return n;
+}
+
+void OrderBook::clear() {
+    std::memset(bid_prices, 0, sizeof(bid_prices));
+    std::memset(ask_prices, 0, sizeof(ask_prices));
+    std::memset(bid_quantities, 0, sizeof(bid_quantities));
+    std::memset(ask_quantities, 0, sizeof(ask_quantities));
+    bid_count = 0;
+    ask_count = 0;
+}
+
+DepthCache::DepthCache(size_t num_symbols)
+    : num_symbols_(std::min(num_symbols, MAX_SYMBOL_CAPACITY))
+    , entries_(num_symbols_) {
+}
+
+bool DepthCache::apply_update(uint16_t symbol_id, const DepthUpdatePayload& update,
+                              uint64_t timestamp) {
+    if (symbol_id >= num_symbols_) return false;
+
+    auto& entry = entries_[symbol_id];
+
+    // Begin write - sequence goes odd
+    uint64_t seq = entry.sequence.load(std::memory_order_relaxed);
+    entry.sequence.store(seq + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    bool applied = entry.book.apply(update);
+    if (applied) {
+        entry.update_count++;
+        entry.last_update_time = timestamp;
+    }
+
+    // End write - sequence goes even
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.sequence.store(seq + 2, std::memory_order_release);
+
+    if (!applied) {
+        rejected_updates_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return applied;
+}
+
+size_t DepthCache::get_levels(uint16_t symbol_id, BookSide side,
+                              PriceLevel* out, size_t max_levels) const {
+    if (symbol_id >= num_symbols_) return 0;
+
+    const auto& entry = entries_[symbol_id];
+    size_t n;
+
+    // SeqLock read - retry if sequence changes during read
+    uint64_t seq1, seq2;
+    do {
+        seq1 = entry.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = entry.sequence.load(std::memory_order_acquire);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        n = entry.book.top_levels(side, out, max_levels);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        seq2 = entry.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+
+    return n;
+}
+
+OrderBook DepthCache::get_book(uint16_t symbol_id) const {
+    if (symbol_id >= num_symbols_) return OrderBook{};
+
+    const auto& entry = entries_[symbol_id];
+    OrderBook snapshot;
+
+    uint64_t seq1, seq2;
+    do {
+        seq1 = entry.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = entry.sequence.load(std::memory_order_acquire);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        snapshot = entry.book;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        seq2 = entry.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+
+    return snapshot;
+}
+
+uint64_t DepthCache::update_count(uint16_t symbol_id) const {
+    if (symbol_id >= num_symbols_) return 0;
+    return entries_[symbol_id].update_count;
+}
+
+void DepthCache::reset() {
+    for (size_t i = 0; i < num_symbols_; ++i) {
+        entries_[i].sequence.store(0, std::memory_order_relaxed);
+        entries_[i].update_count = 0;
+        entries_[i].last_update_time = 0;
+        entries_[i].book.clear();
+    }
+    rejected_updates_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace mdf
@@ -0,0 +1,53 @@
+#include "slab_allocator.h"
+#include <algorithm>
+
+namespace mdf {
+
+SlabAllocator::SlabAllocator(size_t class_bytes, std::pmr::memory_resource* upstream)
+    : upstream_(upstream) {
+    for (size_t i = 0; i < NUM_CLASSES; ++i) {
+        size_t size = class_size(i);
+        classes_[i] = std::make_unique<MemoryPool>(size, std::max<size_t>(class_bytes / size, 1));
+    }
+}
+
+bool SlabAllocator::owns(const void* ptr) const {
+    for (const auto& pool : classes_) {
+        if (pool->owns(ptr)) return true;
+    }
+    return false;
+}
+
+SlabAllocator::ClassStats SlabAllocator::class_stats(size_t index) const {
+    const MemoryPool& pool = *classes_[index];
+    ClassStats stats;
+    stats.block_size = pool.block_size();
+    stats.capacity = pool.capacity();
+    stats.in_use = pool.get_allocated_count();
+    stats.fallbacks = fallbacks_[index].load(std::memory_order_relaxed);
+    return stats;
+}
+
+void* SlabAllocator::do_allocate(size_t bytes, size_t alignment) {
+    size_t index = class_for(bytes, alignment);
+    if (index == NUM_CLASSES) {
+        oversize_.fetch_add(1, std::memory_order_relaxed);
+        return upstream_->allocate(bytes, alignment);
+    }
+    if (void* ptr = classes_[index]->allocate()) {
+        return ptr;
+    }
+    fallbacks_[index].fetch_add(1, std::memory_order_relaxed);
+    return upstream_->allocate(bytes, alignment);
+}
+
+void SlabAllocator::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    size_t index = class_for(bytes, alignment);
+    if (index < NUM_CLASSES && classes_[index]->owns(ptr)) {
+        classes_[index]->deallocate(ptr);
+    } else {
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+}
+
+} // namespace mdf
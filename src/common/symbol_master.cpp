@@ -0,0 +1,264 @@
+#include "symbol_master.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+namespace mdf {
+
+// murmur3 64-bit finalizer
+static uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// FNV-1a over the name, mixed so the top bits (the bucket) depend on every
+// byte; plain FNV barely moves them for names differing in the last digit
+static uint64_t hash_name(std::string_view name) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return mix(h);
+}
+
+// Re-mix the name hash with a bucket's seed
+static uint64_t slot_hash(uint64_t h, uint32_t seed) {
+    return mix(h ^ (seed * 0x9E3779B97F4A7C15ULL));
+}
+
+static size_t next_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+static std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+SymbolMaster::SymbolMaster(size_t num_symbols) {
+    num_symbols = std::min(num_symbols, MAX_SYMBOL_CAPACITY);
+
+    std::vector<std::string> names(num_symbols);
+    char buffer[24];   // "SYM" and any size_t
+    for (size_t i = 0; i < num_symbols; ++i) {
+        if (i < NUM_SAMPLE_SYMBOLS) {
+            names[i] = SAMPLE_SYMBOL_NAMES[i];
+        } else {
+            snprintf(buffer, sizeof(buffer), "SYM%03zu", i);
+            names[i] = buffer;
+        }
+    }
+    build(names, std::vector<double>(num_symbols, DEFAULT_TICK_SIZE),
+          std::vector<uint32_t>(num_symbols, DEFAULT_LOT_SIZE));
+}
+
+bool SymbolMaster::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        last_error_ = "Cannot open " + path;
+        return false;
+    }
+
+    size_t count = records_.size();
+    std::vector<std::string> names(count);
+    std::vector<double> tick_sizes(count);
+    std::vector<uint32_t> lot_sizes(count);
+    for (size_t i = 0; i < count; ++i) {
+        names[i].assign(records_[i].name, records_[i].name_length);
+        tick_sizes[i] = records_[i].tick_size;
+        lot_sizes[i] = records_[i].lot_size;
+    }
+
+    std::vector<bool> listed(count, false);
+    std::string line;
+    size_t line_no = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        std::string_view rest = trim(line);
+        if (rest.empty() || rest.front() == '#') continue;
+
+        std::string_view fields[4];
+        size_t num_fields = 0;
+        while (num_fields < 4) {
+            size_t comma = rest.find(',');
+            fields[num_fields++] = trim(rest.substr(0, comma));
+            if (comma == std::string_view::npos) {
+                rest = {};
+                break;
+            }
+            rest.remove_prefix(comma + 1);
+        }
+
+        std::string where = path + ":" + std::to_string(line_no) + ": ";
+        if (num_fields < 2 || !rest.empty()) {
+            last_error_ = where + "expected symbol_id,name[,tick_size[,lot_size]]";
+            return false;
+        }
+
+        std::string id_text(fields[0]);
+        char* end = nullptr;
+        unsigned long id = std::strtoul(id_text.c_str(), &end, 10);
+        if (id_text.empty() || *end != '\0' || id >= count) {
+            last_error_ = where + "symbol id '" + id_text + "' outside 0-" +
+                          std::to_string(count - 1);
+            return false;
+        }
+        if (listed[id]) {
+            last_error_ = where + "symbol id " + id_text + " listed twice";
+            return false;
+        }
+        listed[id] = true;
+
+        if (fields[1].empty() || fields[1].size() > MAX_NAME_LENGTH) {
+            last_error_ = where + "name must be 1-" + std::to_string(MAX_NAME_LENGTH) +
+                          " characters";
+            return false;
+        }
+        names[id] = std::string(fields[1]);
+
+        if (num_fields > 2 && !fields[2].empty()) {
+            std::string text(fields[2]);
+            double tick = std::strtod(text.c_str(), &end);
+            if (*end != '\0' || !(tick > 0)) {
+                last_error_ = where + "invalid tick size '" + text + "'";
+                return false;
+            }
+            tick_sizes[id] = tick;
+        }
+        if (num_fields > 3 && !fields[3].empty()) {
+            std::string text(fields[3]);
+            unsigned long lot = std::strtoul(text.c_str(), &end, 10);
+            if (*end != '\0' || lot == 0 || lot > UINT32_MAX) {
+                last_error_ = where + "invalid lot size '" + text + "'";
+                return false;
+            }
+            lot_sizes[id] = static_cast<uint32_t>(lot);
+        }
+    }
+
+    return build(names, tick_sizes, lot_sizes);
+}
+
+bool SymbolMaster::build(const std::vector<std::string>& names,
+                         const std::vector<double>& tick_sizes,
+                         const std::vector<uint32_t>& lot_sizes) {
+    size_t count = names.size();
+
+    // Startup-only check; the perfect hash cannot separate equal names
+    std::unordered_map<std::string_view, size_t> seen;
+    seen.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto inserted = seen.emplace(names[i], i);
+        if (!inserted.second) {
+            last_error_ = "Duplicate symbol name " + names[i] + " (ids " +
+                          std::to_string(inserted.first->second) + " and " +
+                          std::to_string(i) + ")";
+            return false;
+        }
+    }
+
+    // Arena first, so name pointers stay put once taken
+    size_t arena_size = 0;
+    for (const auto& name : names) arena_size += name.size() + 1;
+    std::vector<char> arena(arena_size);
+    std::vector<SymbolInfo> records(count);
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(&arena[offset], names[i].data(), names[i].size());
+        arena[offset + names[i].size()] = '\0';
+        records[i] = {&arena[offset], tick_sizes[i], lot_sizes[i],
+                      static_cast<uint16_t>(names[i].size()), static_cast<uint16_t>(i)};
+        offset += names[i].size() + 1;
+    }
+
+    // ~4 names per bucket, slots at most 80% full
+    size_t bucket_count = next_pow2(std::max<size_t>(1, count / 4));
+    size_t slot_count = next_pow2(std::max<size_t>(1, count + count / 4));
+    uint64_t bucket_mask = bucket_count - 1;
+    uint64_t slot_mask = slot_count - 1;
+
+    std::vector<uint64_t> hashes(count);
+    std::vector<std::vector<uint16_t>> buckets(bucket_count);
+    for (size_t i = 0; i < count; ++i) {
+        hashes[i] = hash_name(names[i]);
+        buckets[(hashes[i] >> 32) & bucket_mask].push_back(static_cast<uint16_t>(i));
+    }
+
+    // Place the largest buckets first, while the table is emptiest
+    std::vector<size_t> order(bucket_count);
+    for (size_t b = 0; b < bucket_count; ++b) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    constexpr uint32_t MAX_SEED = 1u << 20;
+    std::vector<uint32_t> seeds(bucket_count, 0);
+    std::vector<uint16_t> slots(slot_count, EMPTY_SLOT);
+    std::vector<uint64_t> placed;
+    for (size_t b : order) {
+        const auto& ids = buckets[b];
+        if (ids.empty()) break;
+
+        uint32_t seed = 0;
+        for (; seed < MAX_SEED; ++seed) {
+            placed.clear();
+            bool ok = true;
+            for (uint16_t id : ids) {
+                uint64_t slot = slot_hash(hashes[id], seed) & slot_mask;
+                if (slots[slot] != EMPTY_SLOT ||
+                    std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                    ok = false;
+                    break;
+                }
+                placed.push_back(slot);
+            }
+            if (ok) break;
+        }
+        if (seed == MAX_SEED) {
+            last_error_ = "Symbol name hash could not be built";
+            return false;
+        }
+
+        seeds[b] = seed;
+        for (size_t k = 0; k < ids.size(); ++k) {
+            slots[placed[k]] = ids[k];
+        }
+    }
+
+    records_.swap(records);
+    names_.swap(arena);
+    seeds_.swap(seeds);
+    slots_.swap(slots);
+    bucket_mask_ = bucket_mask;
+    slot_mask_ = slot_mask;
+    return true;
+}
+
+int SymbolMaster::id_of(std::string_view name) const {
+    if (records_.empty()) return -1;
+
+    uint64_t h = hash_name(name);
+    uint32_t seed = seeds_[(h >> 32) & bucket_mask_];
+    uint16_t id = slots_[slot_hash(h, seed) & slot_mask_];
+    if (id == EMPTY_SLOT) return -1;
+
+    const SymbolInfo& info = records_[id];
+    if (info.name_length != name.size() ||
+        std::memcmp(info.name, name.data(), name.size()) != 0) {
+        return -1;
+    }
+    return id;
+}
+
+} // namespace mdf
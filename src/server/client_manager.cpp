@@ -1,27 +1,39 @@
 #include "client_manager.h"
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <algorithm>
+#include <cassert>
 #include <cerrno>
+#include <cstddef>
 #include <cstring>
 
 namespace mdf {
 
-ClientManager::ClientManager() = default;
+namespace {
+constexpr size_t MAX_FLUSH_IOVECS = 64;
+} // namespace
+
+ClientManager::ClientManager(size_t num_symbols)
+    : message_pool_(MESSAGE_BLOCK_SIZE, MESSAGE_POOL_BLOCKS)
+    , num_symbols_(std::min(num_symbols, MAX_SYMBOL_CAPACITY))
+    , subscription_words_((num_symbols_ + 63) / 64) {
+    drain_order_.reserve(num_symbols_ * 2);
+}
 
 ClientManager::~ClientManager() {
     // Close all client connections
-    for (auto& [fd, client] : clients_) {
+    for (int fd : slot_fds_) {
         ::close(fd);
     }
-    clients_.clear();
 }
 
 bool ClientManager::add_client(int fd, const std::string& address, uint16_t port) {
-    if (clients_.find(fd) != clients_.end()) {
+    if (fd < 0 || slot_of(fd) >= 0) {
         return false;  // Already exists
     }
     
@@ -42,152 +54,716 @@ bool ClientManager::add_client(int fd, const std::string& address, uint16_t port
     conn.address = address;
     conn.port = port;
     conn.connect_time = std::chrono::steady_clock::now();
-    conn.last_activity = conn.connect_time;
+    conn.queue = std::make_unique<SendQueue>(SEND_QUEUE_DEPTH);
     
-    clients_[fd] = std::move(conn);
+    // Per-connection impairments override the default
+    size_t connection = connections_accepted_++;
+    auto impaired = connection_impairments_.find(connection);
+    if (impaired != connection_impairments_.end()) {
+        if (impaired->second.enabled()) {
+            conn.impairer = std::make_unique<Impairer>(impaired->second);
+        }
+    } else if (default_impairments_.enabled()) {
+        ImpairmentConfig config = default_impairments_;
+        config.seed += connection;
+        conn.impairer = std::make_unique<Impairer>(config);
+    }
+    uint8_t slot_flags = SUBSCRIBE_ALL;
+    if (conn.impairer) {
+        slot_flags |= IMPAIRED;
+        impaired_clients_++;
+    }
+    
+    if (static_cast<size_t>(fd) >= slot_of_fd_.size()) {
+        slot_of_fd_.resize(std::max<size_t>(fd + 1, slot_of_fd_.size() * 2), -1);
+    }
+    slot_of_fd_[fd] = static_cast<int32_t>(slot_fds_.size());
+    slot_fds_.push_back(fd);
+    slot_flags_.push_back(slot_flags);
+    slot_lines_.push_back(0);
+    slot_subscriptions_.resize(slot_subscriptions_.size() + subscription_words_, 0);
+    slot_messages_.push_back(0);
+    slot_bytes_.push_back(0);
+    connections_.push_back(std::move(conn));
     return true;
 }
 
 void ClientManager::remove_client(int fd) {
-    auto it = clients_.find(fd);
-    if (it != clients_.end()) {
-        ::close(fd);
-        clients_.erase(it);
+    int32_t slot = slot_of(fd);
+    if (slot < 0) {
+        return;
+    }
+    
+    ClientConnection& client = connections_[slot];
+    if (client.protocol_version != PROTOCOL_V1) {
+        v2_client_count_--;
     }
+    if (client.impairer) {
+        retired_impairments_ += client.impairer->stats();
+        impaired_clients_--;
+    }
+    if (!client.queue->empty()) {
+        queued_clients_--;
+    }
+    ::close(fd);
+    
+    // The last slot moves into the hole
+    size_t last = slot_fds_.size() - 1;
+    if (static_cast<size_t>(slot) != last) {
+        slot_fds_[slot] = slot_fds_[last];
+        slot_flags_[slot] = slot_flags_[last];
+        slot_lines_[slot] = slot_lines_[last];
+        std::copy_n(slot_subscriptions_.begin() + last * subscription_words_, subscription_words_,
+                    slot_subscriptions_.begin() + slot * subscription_words_);
+        slot_messages_[slot] = slot_messages_[last];
+        slot_bytes_[slot] = slot_bytes_[last];
+        connections_[slot] = std::move(connections_[last]);
+        slot_of_fd_[slot_fds_[slot]] = slot;
+    }
+    slot_of_fd_[fd] = -1;
+    slot_fds_.pop_back();
+    slot_flags_.pop_back();
+    slot_lines_.pop_back();
+    slot_subscriptions_.resize(last * subscription_words_);
+    slot_messages_.pop_back();
+    slot_bytes_.pop_back();
+    connections_.pop_back();
 }
 
 bool ClientManager::has_client(int fd) const {
-    return clients_.find(fd) != clients_.end();
+    return slot_of(fd) >= 0;
 }
 
 const ClientConnection* ClientManager::get_client(int fd) const {
-    auto it = clients_.find(fd);
-    if (it != clients_.end()) {
-        return &it->second;
-    }
-    return nullptr;
+    int32_t slot = slot_of(fd);
+    return slot >= 0 ? &connections_[slot] : nullptr;
+}
+
+bool ClientManager::is_slow(int fd) const {
+    int32_t slot = slot_of(fd);
+    return slot >= 0 && (slot_flags_[slot] & SLOW);
+}
+
+uint64_t ClientManager::client_messages_sent(int fd) const {
+    int32_t slot = slot_of(fd);
+    return slot >= 0 ? slot_messages_[slot] : 0;
+}
+
+uint64_t ClientManager::client_bytes_sent(int fd) const {
+    int32_t slot = slot_of(fd);
+    return slot >= 0 ? slot_bytes_[slot] : 0;
 }
 
 bool ClientManager::handle_subscription(int fd, const uint16_t* symbol_ids, size_t count) {
-    auto it = clients_.find(fd);
-    if (it == clients_.end()) {
+    int32_t slot = slot_of(fd);
+    if (slot < 0) {
         return false;
     }
     
-    auto& client = it->second;
-    client.subscribed_symbols.clear();
-    client.subscribe_all = (count == 0);
+    uint64_t* words = &slot_subscriptions_[slot * subscription_words_];
+    std::fill_n(words, subscription_words_, 0);
+    if (count == 0) {
+        slot_flags_[slot] |= SUBSCRIBE_ALL;
+    } else {
+        slot_flags_[slot] &= ~SUBSCRIBE_ALL;
+    }
     
+    // Ids past num_symbols never tick, so they need no bit
     for (size_t i = 0; i < count; ++i) {
-        client.subscribed_symbols.insert(symbol_ids[i]);
+        if (symbol_ids[i] < num_symbols_) {
+            words[symbol_ids[i] / 64] |= 1ULL << (symbol_ids[i] % 64);
+        }
     }
     
     return true;
 }
 
-size_t ClientManager::broadcast(const void* data, size_t len, uint16_t symbol_id) {
+bool ClientManager::set_protocol_version(int fd, uint8_t version) {
+    int32_t slot = slot_of(fd);
+    if (slot < 0) {
+        return false;
+    }
+    
+    auto& client = connections_[slot];
+    if (client.protocol_version != PROTOCOL_V1) v2_client_count_--;
+    client.protocol_version = version;
+    if (client.protocol_version != PROTOCOL_V1) {
+        v2_client_count_++;
+        slot_flags_[slot] |= V2;
+    } else {
+        slot_flags_[slot] &= ~V2;
+    }
+    
+    return true;
+}
+
+bool ClientManager::set_line(int fd, uint8_t line) {
+    int32_t slot = slot_of(fd);
+    if (slot < 0) {
+        return false;
+    }
+    slot_lines_[slot] = line;
+    return true;
+}
+
+size_t ClientManager::broadcast(const MessageRef& msg, uint16_t symbol_id,
+                                const MessageRef& v2, int line) {
+    return deliver(msg.data(), msg.size(), &msg, symbol_id,
+                   v2 ? v2.data() : nullptr, v2.size(), v2 ? &v2 : nullptr, line);
+}
+
+size_t ClientManager::broadcast(const void* data, size_t len, uint16_t symbol_id,
+                                const void* v2_data, size_t v2_len, int line) {
+    if (queued_clients_ == 0) {
+        // Nobody is backed up; a partial write copies just its remainder
+        return deliver(data, len, nullptr, symbol_id, v2_data, v2_len, nullptr, line);
+    }
+    
+    // Copy into the pool once and let every backed-up client share it
+    MessageRef msg = MessageRef::copy_of(message_pool_, data, len);
+    MessageRef v2;
+    if (v2_data) {
+        v2 = MessageRef::copy_of(message_pool_, v2_data, v2_len);
+    }
+    return broadcast(msg, symbol_id, v2, line);
+}
+
+size_t ClientManager::send_to_all(const MessageRef& msg, int line) {
     size_t count = 0;
+    for (size_t slot = 0; slot < slot_fds_.size(); ++slot) {
+        if ((line >= 0 && slot_lines_[slot] != line) || (slot_flags_[slot] & RESET)) {
+            continue;
+        }
+        bool sent = (slot_flags_[slot] & IMPAIRED)
+                        ? send_impaired(slot, msg.data(), msg.size())
+                        : write_to_client(slot, msg.data(), msg.size(), &msg);
+        count += sent ? 1 : 0;
+    }
+    return count;
+}
+
+size_t ClientManager::deliver(const void* data, size_t len, const MessageRef* msg_ref,
+                              uint16_t symbol_id, const void* v2_data, size_t v2_len,
+                              const MessageRef* v2_ref, int line) {
+    size_t count = 0;
+    size_t bytes = 0;
     
-    for (auto& [fd, client] : clients_) {
-        // Skip slow consumers
-        if (client.is_slow) {
+    // One pass over the slot arrays; only clients that take the message
+    // touch their cold state
+    for (size_t slot = 0; slot < slot_fds_.size(); ++slot) {
+        if (line >= 0 && slot_lines_[slot] != line) {
             continue;
         }
         
         // Check subscription
-        if (!client.subscribe_all && 
-            client.subscribed_symbols.find(symbol_id) == client.subscribed_symbols.end()) {
+        if (!subscribed(slot, symbol_id)) {
+            continue;
+        }
+        
+        uint8_t flags = slot_flags_[slot];
+        bool use_v2 = v2_data && (flags & V2);
+        const void* msg = use_v2 ? v2_data : data;
+        size_t msg_len = use_v2 ? v2_len : len;
+        const MessageRef* ref = use_v2 ? v2_ref : msg_ref;
+        
+        // Slow consumers get conflated (or skipped)
+        if (flags & SLOW) {
+            if (conflation_) {
+                conflate(connections_[slot], msg, msg_len);
+            } else {
+                dropped_messages_++;
+            }
+            continue;
+        }
+        
+        if (batching_) {
+            // Bytes are accounted for when the packet is flushed
+            if (append_to_batch(slot, msg, msg_len)) {
+                ++count;
+                slot_messages_[slot]++;
+            }
             continue;
         }
         
-        if (send_to_client(fd, data, len)) {
+        bool sent = (flags & RESET) ? false
+                  : (flags & IMPAIRED) ? send_impaired(slot, msg, msg_len)
+                  : write_to_client(slot, msg, msg_len, ref);
+        if (sent) {
             ++count;
-            client.messages_sent++;
-            client.bytes_sent += len;
-            client.last_activity = std::chrono::steady_clock::now();
+            bytes += msg_len;
+            slot_messages_[slot]++;
+            slot_bytes_[slot] += msg_len;
         }
     }
     
     total_messages_sent_.fetch_add(count, std::memory_order_relaxed);
-    total_bytes_sent_.fetch_add(count * len, std::memory_order_relaxed);
+    total_bytes_sent_.fetch_add(bytes, std::memory_order_relaxed);
     
     return count;
 }
 
 bool ClientManager::send_to_client(int fd, const void* data, size_t len) {
-    auto it = clients_.find(fd);
-    if (it == clients_.end()) {
+    int32_t slot = slot_of(fd);
+    if (slot < 0) {
+        return false;
+    }
+    return send_to_slot(slot, data, len);
+}
+
+bool ClientManager::send_to_slot(size_t slot, const void* data, size_t len) {
+    uint8_t flags = slot_flags_[slot];
+    if (flags & RESET) {
+        return false;
+    }
+    if (flags & IMPAIRED) {
+        return send_impaired(slot, data, len);
+    }
+    return write_to_client(slot, data, len);
+}
+
+bool ClientManager::send_impaired(size_t slot, const void* data, size_t len) {
+    int fd = slot_fds_[slot];
+    Impairer& impairer = *connections_[slot].impairer;
+    auto action = impairer.apply(static_cast<const uint8_t*>(data), len,
+                                 std::chrono::steady_clock::now());
+    if (action == Impairer::Action::Reset) {
+        struct linger abort_close{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, &abort_close, sizeof(abort_close));
+        slot_flags_[slot] |= RESET;
+        pending_resets_.push_back(fd);
         return false;
     }
     
-    auto& client = it->second;
+    // Held back bytes still count as sent: they go out later
+    for (size_t i = 0; i < impairer.run_count(); ++i) {
+        if (!write_to_client(slot, impairer.run_data(i), impairer.run_size(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ClientManager::write_to_client(size_t slot, const void* data, size_t len,
+                                    const MessageRef* msg) {
+    int fd = slot_fds_[slot];
+    ClientConnection& client = connections_[slot];
+    SendQueue& queue = *client.queue;
+    if (!queue.empty()) {
+        flush_queue(slot);
+    }
     
-    // Check pending bytes before sending
-    size_t pending = get_pending_bytes(fd);
+    // Check pending bytes before sending; bytes still queued here count too
+    size_t pending = get_pending_bytes(fd) + queue.bytes;
     client.pending_bytes = pending;
     
     if (pending > slow_threshold_) {
-        mark_slow_consumer(fd);
+        mark_slow(slot);
         return false;
     }
     
-    ssize_t sent = ::send(fd, data, len, MSG_NOSIGNAL);
+    // Anything still queued goes first
+    size_t sent = 0;
+    if (queue.empty()) {
+        ssize_t n = ::send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                // Other error - connection issue
+                return false;
+            }
+            n = 0;
+        }
+        sent = static_cast<size_t>(n);
+    }
     
-    if (sent < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            // Would block - mark as slow
-            mark_slow_consumer(fd);
+    if (sent < len) {
+        // Socket full: the rest waits in the queue, so a partial write
+        // never leaves half a message on the wire. A full queue makes
+        // the client slow; only whole messages are turned away.
+        if (!enqueue(client, static_cast<const uint8_t*>(data), len, msg, sent)) {
+            mark_slow(slot);
             return false;
         }
-        // Other error - connection issue
-        return false;
+        return true;
+    }
+    
+    // Full send - clear slow status if it was set
+    if ((slot_flags_[slot] & SLOW) && pending < slow_threshold_ / 2) {
+        slot_flags_[slot] &= ~SLOW;
     }
     
-    if (static_cast<size_t>(sent) < len) {
-        // Partial send - mark as slow
-        mark_slow_consumer(fd);
+    return true;
+}
+
+bool ClientManager::enqueue(ClientConnection& client, const uint8_t* data, size_t len,
+                            const MessageRef* msg, size_t written) {
+    SendQueue& queue = *client.queue;
+    size_t capacity = MessageRef::capacity(message_pool_);
+    
+    // A copy too big for a send block (a batched packet, say) goes in one
+    // slab block of its size class rather than block-sized pieces
+    MemoryPool* slab_class = nullptr;
+    if (!msg && len - written > capacity) {
+        slab_class = slab_.class_pool(len - written + MessageRef::HEADER_SIZE);
+    }
+    size_t entries = msg || slab_class ? 1 : (len - written + capacity - 1) / capacity;
+    if (queue.size() + entries > queue.entries.size()) {
         return false;
     }
     
-    // Full send - clear slow status if it was set
-    if (client.is_slow && pending < slow_threshold_ / 2) {
-        clear_slow_status(fd);
+    // Only a write to an empty queue can go out in part
+    assert(written == 0 || queue.empty());
+    if (queue.empty()) {
+        queue.offset = 0;
+        queued_clients_++;
     }
     
+    if (msg) {
+        queue.offset += written;
+        queue.at(queue.tail++) = *msg;
+    } else if (slab_class) {
+        queue.at(queue.tail++) = MessageRef::copy_of(*slab_class, data + written, len - written);
+    } else {
+        // Copy just the rest, in block-sized pieces
+        for (size_t off = written; off < len; off += capacity) {
+            size_t n = std::min(capacity, len - off);
+            queue.at(queue.tail++) = MessageRef::copy_of(message_pool_, data + off, n);
+        }
+    }
+    queue.bytes += len - written;
     return true;
 }
 
-std::vector<int> ClientManager::get_all_client_fds() const {
-    std::vector<int> fds;
-    fds.reserve(clients_.size());
-    for (const auto& [fd, client] : clients_) {
-        fds.push_back(fd);
+size_t ClientManager::flush_queue(size_t slot) {
+    int fd = slot_fds_[slot];
+    SendQueue& queue = *connections_[slot].queue;
+    size_t total = 0;
+    
+    while (!queue.empty()) {
+        iovec iov[MAX_FLUSH_IOVECS];
+        size_t count = std::min(queue.size(), MAX_FLUSH_IOVECS);
+        size_t want = 0;
+        for (size_t i = 0; i < count; ++i) {
+            MessageRef& entry = queue.at(queue.head + i);
+            size_t skip = i == 0 ? queue.offset : 0;
+            iov[i].iov_base = entry.data() + skip;
+            iov[i].iov_len = entry.size() - skip;
+            want += iov[i].iov_len;
+        }
+        
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t n = ::sendmsg(fd, &message, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;  // Still full, or an error the event loop reports
+        }
+        total += n;
+        queue.bytes -= n;
+        
+        // Messages written out in full are complete: drop their reference
+        size_t left = static_cast<size_t>(n);
+        while (left > 0) {
+            MessageRef& head = queue.at(queue.head);
+            size_t remaining = head.size() - queue.offset;
+            if (left < remaining) {
+                queue.offset += left;
+                break;
+            }
+            left -= remaining;
+            head.reset();
+            queue.head++;
+            queue.offset = 0;
+        }
+        
+        if (static_cast<size_t>(n) < want) {
+            break;  // Socket full again
+        }
     }
+    
+    if (total > 0 && queue.empty()) {
+        queued_clients_--;
+    }
+    return total;
+}
+
+size_t ClientManager::flush_send_queues() {
+    if (queued_clients_ == 0) {
+        return 0;
+    }
+    
+    size_t bytes = 0;
+    for (size_t slot = 0; slot < connections_.size(); ++slot) {
+        if (!connections_[slot].queue->empty()) {
+            bytes += flush_queue(slot);
+        }
+    }
+    return bytes;
+}
+
+bool ClientManager::append_to_batch(size_t slot, const void* data, size_t len) {
+    ClientConnection& client = connections_[slot];
+    if (!client.batch) {
+        client.batch = std::make_unique<BatchEncoder>();
+    }
+    
+    const uint8_t* msg = static_cast<const uint8_t*>(data);
+    if (client.batch->append(msg, len)) {
+        return true;
+    }
+    
+    // Packet full or deltas out of range - flush and start a new one
+    flush_client_batch(slot);
+    if (client.batch->append(msg, len)) {
+        return true;
+    }
+    
+    // Not batchable (e.g. heartbeat) - send as-is
+    if (send_to_slot(slot, data, len)) {
+        slot_bytes_[slot] += len;
+        total_bytes_sent_.fetch_add(len, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+size_t ClientManager::flush_client_batch(size_t slot) {
+    ClientConnection& client = connections_[slot];
+    if (!client.batch || client.batch->empty()) {
+        return 0;
+    }
+    
+    size_t size = client.batch->finish();
+    bool sent = send_to_slot(slot, client.batch->data(), size);
+    client.batch->clear();
+    
+    if (!sent) {
+        return 0;  // Dropped, same as an unbatched message to a slow client
+    }
+    
+    slot_bytes_[slot] += size;
+    total_bytes_sent_.fetch_add(size, std::memory_order_relaxed);
+    return size;
+}
+
+size_t ClientManager::flush_batches() {
+    size_t packets = 0;
+    for (size_t slot = 0; slot < connections_.size(); ++slot) {
+        if (flush_client_batch(slot) > 0) {
+            ++packets;
+        }
+    }
+    return packets;
+}
+
+void ClientManager::conflate(ClientConnection& client, const void* data, size_t len) {
+    MessageHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    
+    size_t kind;
+    switch (static_cast<MessageType>(header.message_type)) {
+        case MessageType::QUOTE:
+        case MessageType::QUOTE_V2:
+            kind = 0;
+            break;
+        case MessageType::TRADE:
+        case MessageType::TRADE_V2:
+            kind = 1;
+            break;
+        default:
+            dropped_messages_++;  // Depth deltas can't be conflated
+            return;
+    }
+    
+    if (header.symbol_id >= num_symbols_ || len > MAX_MSG_SIZE) {
+        dropped_messages_++;
+        return;
+    }
+    
+    if (!client.conflation) {
+        client.conflation = std::make_unique<ConflationState>(num_symbols_);
+    }
+    
+    auto& state = *client.conflation;
+    size_t slot = header.symbol_id * 2 + kind;
+    uint64_t bit = 1ULL << (slot % 64);
+    uint64_t& word = state.dirty[slot / 64];
+    
+    if (word & bit) {
+        conflated_messages_++;  // Older value never reached the client
+    } else {
+        word |= bit;
+        state.dirty_count++;
+    }
+    
+    std::memcpy(state.slots[slot].data, data, len);
+    state.slots[slot].size = static_cast<uint8_t>(len);
+}
+
+size_t ClientManager::send_conflated(size_t slot) {
+    auto& state = *connections_[slot].conflation;
+    
+    // Collect dirty slots and deliver them in sequence order so the
+    // client sees gaps rather than sequence numbers going backwards
+    drain_order_.clear();
+    for (size_t w = 0; w < state.dirty.size(); ++w) {
+        uint64_t word = state.dirty[w];
+        while (word) {
+            size_t entry = w * 64 + __builtin_ctzll(word);
+            word &= word - 1;
+            
+            uint32_t seq;
+            std::memcpy(&seq, state.slots[entry].data + offsetof(MessageHeader, sequence_number),
+                        sizeof(seq));
+            drain_order_.emplace_back(seq, static_cast<uint32_t>(entry));
+        }
+    }
+    std::sort(drain_order_.begin(), drain_order_.end());
+    
+    size_t sent = 0;
+    for (const auto& [seq, index] : drain_order_) {
+        const auto& entry = state.slots[index];
+        if (!send_to_slot(slot, entry.data, entry.size)) {
+            break;  // Backed up again - keep the rest dirty
+        }
+        
+        state.dirty[index / 64] &= ~(1ULL << (index % 64));
+        state.dirty_count--;
+        slot_messages_[slot]++;
+        slot_bytes_[slot] += entry.size;
+        total_bytes_sent_.fetch_add(entry.size, std::memory_order_relaxed);
+        sent++;
+    }
+    
+    total_messages_sent_.fetch_add(sent, std::memory_order_relaxed);
+    return sent;
+}
+
+size_t ClientManager::drain_slow_clients() {
+    size_t sent = 0;
+    
+    for (size_t slot = 0; slot < slot_fds_.size(); ++slot) {
+        if (!(slot_flags_[slot] & SLOW)) {
+            continue;
+        }
+        
+        // Queued bytes go before any conflated state
+        ClientConnection& client = connections_[slot];
+        if (!client.queue->empty()) {
+            flush_queue(slot);
+            if (!client.queue->empty()) {
+                continue;
+            }
+        }
+        
+        // Socket drained below the low-water mark?
+        size_t pending = get_pending_bytes(slot_fds_[slot]);
+        client.pending_bytes = pending;
+        if (pending >= slow_threshold_ / 2) {
+            continue;
+        }
+        
+        slot_flags_[slot] &= ~SLOW;
+        if (client.conflation && client.conflation->dirty_count > 0) {
+            sent += send_conflated(slot);
+        }
+    }
+    
+    return sent;
+}
+
+void ClientManager::set_connection_impairments(size_t connection,
+                                               const ImpairmentConfig& config) {
+    connection_impairments_[connection] = config;
+}
+
+bool ClientManager::set_client_impairments(int fd, const ImpairmentConfig& config) {
+    int32_t slot = slot_of(fd);
+    if (slot < 0) {
+        return false;
+    }
+    
+    auto& client = connections_[slot];
+    if (client.impairer) {
+        retired_impairments_ += client.impairer->stats();
+        impaired_clients_--;
+    }
+    client.impairer.reset();
+    slot_flags_[slot] &= ~IMPAIRED;
+    if (config.enabled()) {
+        client.impairer = std::make_unique<Impairer>(config);
+        slot_flags_[slot] |= IMPAIRED;
+        impaired_clients_++;
+    }
+    return true;
+}
+
+size_t ClientManager::release_impairments(std::chrono::steady_clock::time_point now) {
+    size_t bytes = 0;
+    for (size_t slot = 0; slot < slot_fds_.size(); ++slot) {
+        if ((slot_flags_[slot] & (IMPAIRED | RESET)) != IMPAIRED) {
+            continue;
+        }
+        
+        Impairer& impairer = *connections_[slot].impairer;
+        if (!impairer.holding() || !impairer.release(now)) {
+            continue;
+        }
+        for (size_t i = 0; i < impairer.run_count(); ++i) {
+            if (!write_to_client(slot, impairer.run_data(i), impairer.run_size(i))) {
+                break;
+            }
+            bytes += impairer.run_size(i);
+        }
+    }
+    return bytes;
+}
+
+std::vector<int> ClientManager::take_pending_resets() {
+    std::vector<int> fds;
+    fds.swap(pending_resets_);
     return fds;
 }
 
+ImpairmentStats ClientManager::impairment_stats() const {
+    ImpairmentStats stats = retired_impairments_;
+    for (const ClientConnection& client : connections_) {
+        if (client.impairer) {
+            stats += client.impairer->stats();
+        }
+    }
+    return stats;
+}
+
+std::vector<int> ClientManager::get_all_client_fds() const {
+    return slot_fds_;
+}
+
 std::vector<int> ClientManager::get_slow_clients() const {
     std::vector<int> slow;
-    for (const auto& [fd, client] : clients_) {
-        if (client.is_slow) {
-            slow.push_back(fd);
+    for (size_t slot = 0; slot < slot_fds_.size(); ++slot) {
+        if (slot_flags_[slot] & SLOW) {
+            slow.push_back(slot_fds_[slot]);
         }
     }
     return slow;
 }
 
 void ClientManager::mark_slow_consumer(int fd) {
-    auto it = clients_.find(fd);
-    if (it != clients_.end()) {
-        it->second.is_slow = true;
-        it->second.slow_consumer_count++;
+    int32_t slot = slot_of(fd);
+    if (slot >= 0) {
+        mark_slow(slot);
     }
 }
 
+void ClientManager::mark_slow(size_t slot) {
+    slot_flags_[slot] |= SLOW;
+    connections_[slot].slow_consumer_count++;
+}
+
 void ClientManager::clear_slow_status(int fd) {
-    auto it = clients_.find(fd);
-    if (it != clients_.end()) {
-        it->second.is_slow = false;
+    int32_t slot = slot_of(fd);
+    if (slot >= 0) {
+        slot_flags_[slot] &= ~SLOW;
     }
 }
 
@@ -12,11 +12,13 @@
 #include <chrono>
 #include <thread>
 #include <iostream>
+#include <memory_resource>
 
 #ifdef USE_KQUEUE
 #include <sys/event.h>
 #else
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #endif
 
 namespace mdf {
@@ -24,54 +26,102 @@ namespace mdf {
 ExchangeSimulator::ExchangeSimulator(uint16_t port, size_t num_symbols)
     : port_(port)
     , tick_gen_(std::make_unique<TickGenerator>(num_symbols))
-    , client_mgr_(std::make_unique<ClientManager>()) {
+    , client_mgr_(std::make_unique<ClientManager>(num_symbols)) {
 }
 
 ExchangeSimulator::~ExchangeSimulator() {
     stop();
     
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+        for (int fd : {worker->listen_fd, worker->event_fd, worker->wake_fd}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
     if (event_fd_ >= 0) {
         ::close(event_fd_);
     }
     if (server_fd_ >= 0) {
         ::close(server_fd_);
     }
+    for (auto& line : lines_) {
+        if (line.server_fd >= 0) {
+            ::close(line.server_fd);
+        }
+    }
 }
 
 bool ExchangeSimulator::init_server_socket() {
-    server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    server_fd_ = open_listener(port_);
     if (server_fd_ < 0) {
-        std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
         return false;
     }
+    if (port_ == 0) {
+        struct sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        getsockname(server_fd_, reinterpret_cast<struct sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+    
+    for (size_t i = 1; i < lines_.size(); ++i) {
+        lines_[i].server_fd = open_listener(lines_[i].port);
+        if (lines_[i].server_fd < 0) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+int ExchangeSimulator::open_listener(uint16_t port, bool reuse_port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
+        return -1;
+    }
     
     // Set socket options
     int opt = 1;
-    setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-    setsockopt(server_fd_, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    
+    // Every worker binds the same port; the kernel hashes each new
+    // connection to one of the listeners
+    if (reuse_port && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        std::cerr << "Failed to set SO_REUSEPORT: " << strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
+    }
     
     // Set non-blocking
-    int flags = fcntl(server_fd_, F_GETFL, 0);
-    fcntl(server_fd_, F_SETFL, flags | O_NONBLOCK);
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
     
     // Bind
     struct sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = INADDR_ANY;
-    addr.sin_port = htons(port_);
+    addr.sin_port = htons(port);
     
-    if (bind(server_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
-        std::cerr << "Failed to bind: " << strerror(errno) << std::endl;
-        return false;
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "Failed to bind port " << port << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return -1;
     }
     
-    // Listen
-    if (listen(server_fd_, 128) < 0) {
+    // Listen; a connection storm overflows a short accept queue, and the
+    // client then waits out a SYN retransmit (1s or more)
+    if (listen(fd, SOMAXCONN) < 0) {
         std::cerr << "Failed to listen: " << strerror(errno) << std::endl;
-        return false;
+        ::close(fd);
+        return -1;
     }
     
-    return true;
+    return fd;
 }
 
 bool ExchangeSimulator::init_event_system() {
@@ -81,26 +131,41 @@ bool ExchangeSimulator::init_event_system() {
         std::cerr << "Failed to create kqueue: " << strerror(errno) << std::endl;
         return false;
     }
-    
-    // Add server socket to kqueue
-    struct kevent ev;
-    EV_SET(&ev, server_fd_, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, nullptr);
-    if (kevent(event_fd_, &ev, 1, nullptr, 0, nullptr) < 0) {
-        std::cerr << "Failed to add server to kqueue: " << strerror(errno) << std::endl;
-        return false;
-    }
 #else
     event_fd_ = epoll_create1(0);
     if (event_fd_ < 0) {
         std::cerr << "Failed to create epoll: " << strerror(errno) << std::endl;
         return false;
     }
+#endif
+    
+    if (!register_listener(event_fd_, server_fd_)) {
+        return false;
+    }
+    for (size_t i = 1; i < lines_.size(); ++i) {
+        if (!register_listener(event_fd_, lines_[i].server_fd)) {
+            return false;
+        }
+    }
     
+    return true;
+}
+
+bool ExchangeSimulator::register_listener(int event_fd, int fd) {
+#ifdef USE_KQUEUE
+    // Add server socket to kqueue
+    struct kevent ev;
+    EV_SET(&ev, fd, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, nullptr);
+    if (kevent(event_fd, &ev, 1, nullptr, 0, nullptr) < 0) {
+        std::cerr << "Failed to add server to kqueue: " << strerror(errno) << std::endl;
+        return false;
+    }
+#else
     // Add server socket to epoll
     struct epoll_event ev;
     ev.events = EPOLLIN | EPOLLET;  // Edge-triggered
-    ev.data.fd = server_fd_;
-    if (epoll_ctl(event_fd_, EPOLL_CTL_ADD, server_fd_, &ev) < 0) {
+    ev.data.fd = fd;
+    if (epoll_ctl(event_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
         std::cerr << "Failed to add server to epoll: " << strerror(errno) << std::endl;
         return false;
     }
@@ -109,18 +174,45 @@ bool ExchangeSimulator::init_event_system() {
     return true;
 }
 
+int ExchangeSimulator::listener_line(int fd) const {
+    if (fd == server_fd_) {
+        return 0;
+    }
+    for (size_t i = 1; i < lines_.size(); ++i) {
+        if (fd == lines_[i].server_fd) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
 void ExchangeSimulator::start() {
-    if (!init_server_socket()) {
+    if (!workers_.empty()) {
+        if (!init_workers()) {
+            return;
+        }
+    } else if (!init_server_socket() || !init_event_system()) {
         return;
     }
     
-    if (!init_event_system()) {
-        return;
+    // A line holds its delay's worth of ticks at the full rate, plus one
+    // catch-up burst and a heartbeat, so the queue never grows in steady state
+    for (auto& line : lines_) {
+        uint64_t backlog = static_cast<uint64_t>(line.faults.delay_us) * tick_rate_ / 1000000;
+        line.delayed.reserve(backlog + MAX_TICK_BURST + 1);
     }
     
     running_.store(true);
-    std::cout << "Exchange Simulator started on port " << port_ << std::endl;
-    std::cout << "Generating ticks for " << MAX_SYMBOLS << " symbols at " 
+    std::cout << "Exchange Simulator started on port " << port_;
+    if (!workers_.empty()) {
+        std::cout << " (" << workers_.size() << " workers)";
+    }
+    std::cout << std::endl;
+    for (size_t i = 1; i < lines_.size(); ++i) {
+        std::cout << "Redundant line " << static_cast<char>('A' + i) << " on port "
+                  << lines_[i].port << std::endl;
+    }
+    std::cout << "Generating ticks for " << tick_gen_->num_symbols() << " symbols at " 
               << tick_rate_ << " msgs/sec" << std::endl;
 }
 
@@ -132,62 +224,100 @@ void ExchangeSimulator::run() {
         }
     }
     
+    if (!workers_.empty()) {
+        run_tick_loop();
+        return;
+    }
+    
     // Calculate tick interval
     auto tick_interval = std::chrono::nanoseconds(1000000000 / tick_rate_);
     auto last_tick = std::chrono::steady_clock::now();
     auto last_heartbeat = last_tick;
     
-    uint8_t msg_buffer[QUOTE_MSG_SIZE];  // Largest message type
-    
     while (running_.load()) {
-        // Check for events with short timeout
+        // Check for events with short timeout; a full array means more are
+        // ready, and a connection storm's requests shouldn't wait a tick
+        // burst per 64 of them
+        int nev;
 #ifdef USE_KQUEUE
         struct kevent events[64];
         struct timespec timeout = {0, 1000000};  // 1ms
-        int nev = kevent(event_fd_, nullptr, 0, events, 64, &timeout);
-        
-        for (int i = 0; i < nev; ++i) {
-            int fd = static_cast<int>(events[i].ident);
+        do {
+            nev = kevent(event_fd_, nullptr, 0, events, 64, &timeout);
             
-            if (fd == server_fd_) {
-                handle_new_connection();
-            } else {
-                bool is_error = (events[i].flags & EV_EOF) || (events[i].flags & EV_ERROR);
-                bool is_read = (events[i].filter == EVFILT_READ);
-                handle_client_event(fd, is_read, is_error);
+            for (int i = 0; i < nev; ++i) {
+                int fd = static_cast<int>(events[i].ident);
+                int line = listener_line(fd);
+                
+                if (line >= 0) {
+                    handle_new_connection(*client_mgr_, event_fd_, fd, static_cast<uint8_t>(line));
+                } else {
+                    bool is_error = (events[i].flags & EV_EOF) || (events[i].flags & EV_ERROR);
+                    bool is_read = (events[i].filter == EVFILT_READ);
+                    handle_client_event(*client_mgr_, event_fd_, fd, is_read, is_error);
+                }
             }
-        }
+            timeout = {0, 0};
+        } while (nev == 64);
 #else
         struct epoll_event events[64];
-        int nev = epoll_wait(event_fd_, events, 64, 1);  // 1ms timeout
-        
-        for (int i = 0; i < nev; ++i) {
-            int fd = events[i].data.fd;
+        int timeout = 1;  // 1ms
+        do {
+            nev = epoll_wait(event_fd_, events, 64, timeout);
             
-            if (fd == server_fd_) {
-                handle_new_connection();
-            } else {
-                bool is_error = (events[i].events & EPOLLERR) || (events[i].events & EPOLLHUP);
-                bool is_read = (events[i].events & EPOLLIN);
-                handle_client_event(fd, is_read, is_error);
+            for (int i = 0; i < nev; ++i) {
+                int fd = events[i].data.fd;
+                int line = listener_line(fd);
+                
+                if (line >= 0) {
+                    handle_new_connection(*client_mgr_, event_fd_, fd, static_cast<uint8_t>(line));
+                } else {
+                    bool is_error = (events[i].events & EPOLLERR) || (events[i].events & EPOLLHUP);
+                    bool is_read = (events[i].events & EPOLLIN);
+                    handle_client_event(*client_mgr_, event_fd_, fd, is_read, is_error);
+                }
             }
-        }
+            timeout = 0;
+        } while (nev == 64);
 #endif
         
+        // Bytes clients' sockets couldn't take last time go out first
+        client_mgr_->flush_send_queues();
+        
         // Generate and broadcast ticks
         auto now = std::chrono::steady_clock::now();
+        if (!lines_.empty()) {
+            release_delayed(now);
+        }
         if (now - last_tick >= tick_interval) {
             // Generate multiple ticks if we're behind
-            int ticks_to_generate = std::min(100, 
+            int ticks_to_generate = std::min(MAX_TICK_BURST, 
                 static_cast<int>((now - last_tick).count() / tick_interval.count()));
             
-            for (int i = 0; i < ticks_to_generate && client_mgr_->client_count() > 0; ++i) {
+            // Multicast receivers don't need a TCP connection
+            bool has_receivers = client_mgr_->client_count() > 0 || udp_;
+            for (int i = 0; i < ticks_to_generate && has_receivers; ++i) {
                 generate_and_broadcast_tick();
             }
             
+            // One packet per client per burst when batching
+            flush_batches();
+            flush_udp();
+            drain_slow_clients();
+            
             last_tick = now;
         }
         
+        // Stalled and held-back bytes, and connections reset on the way
+        if (client_mgr_->impaired_client_count() > 0) {
+            client_mgr_->release_impairments(now);
+        }
+        if (client_mgr_->has_pending_resets()) {
+            for (int fd : client_mgr_->take_pending_resets()) {
+                handle_client_disconnect(*client_mgr_, event_fd_, fd, "Injected reset");
+            }
+        }
+        
         // Send heartbeat every second
         if (now - last_heartbeat >= std::chrono::seconds(1)) {
             send_heartbeat();
@@ -200,13 +330,226 @@ void ExchangeSimulator::stop() {
     running_.store(false);
 }
 
-void ExchangeSimulator::handle_new_connection() {
+bool ExchangeSimulator::set_workers(size_t n) {
+#ifdef USE_KQUEUE
+    return n == 0;  // SO_REUSEPORT doesn't balance connections there
+#else
+    if (running_.load() || (n > 0 && (!lines_.empty() || udp_ || impaired_))) {
+        return false;
+    }
+    workers_.clear();
+    for (size_t i = 0; i < n; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    return true;
+#endif
+}
+
+uint64_t ExchangeSimulator::ring_overruns() const {
+    uint64_t total = 0;
+    for (const auto& worker : workers_) {
+        total += worker->overruns.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+#ifdef USE_KQUEUE
+bool ExchangeSimulator::init_workers() { return false; }
+void ExchangeSimulator::run_tick_loop() {}
+void ExchangeSimulator::run_worker(Worker&) {}
+void ExchangeSimulator::wake_workers() {}
+#else
+bool ExchangeSimulator::init_workers() {
+    // Each of these needs the single tick loop and its one client manager
+    if (!lines_.empty() || udp_ || impaired_) {
+        std::cerr << "Workers can't be combined with UDP, redundant lines or impairments"
+                  << std::endl;
+        return false;
+    }
+    
+    ring_ = std::make_unique<TickRing>();
+    for (auto& worker : workers_) {
+        worker->listen_fd = open_listener(port_, true);
+        if (worker->listen_fd < 0) {
+            return false;
+        }
+        if (port_ == 0) {
+            // The rest join the port the OS picked for the first
+            struct sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            getsockname(worker->listen_fd, reinterpret_cast<struct sockaddr*>(&addr), &len);
+            port_ = ntohs(addr.sin_port);
+        }
+        
+        worker->event_fd = epoll_create1(0);
+        worker->wake_fd = eventfd(0, EFD_NONBLOCK);
+        if (worker->event_fd < 0 || worker->wake_fd < 0) {
+            std::cerr << "Failed to create worker epoll: " << strerror(errno) << std::endl;
+            return false;
+        }
+        if (!register_listener(worker->event_fd, worker->listen_fd)) {
+            return false;
+        }
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = worker->wake_fd;
+        epoll_ctl(worker->event_fd, EPOLL_CTL_ADD, worker->wake_fd, &ev);
+        
+        worker->clients = std::make_unique<ClientManager>(tick_gen_->num_symbols());
+        worker->clients->set_batching(client_mgr_->batching_enabled());
+        worker->clients->set_conflation(client_mgr_->conflation_enabled());
+    }
+    return true;
+}
+
+void ExchangeSimulator::run_tick_loop() {
+    for (auto& worker : workers_) {
+        worker->cursor = ring_->head();
+        worker->thread = std::thread([this, w = worker.get()]() { run_worker(*w); });
+    }
+    
+    auto tick_interval = std::chrono::nanoseconds(1000000000 / tick_rate_);
+    auto last_tick = std::chrono::steady_clock::now();
+    auto last_heartbeat = last_tick;
+    
+    while (running_.load()) {
+        // Same 1ms cadence as the single loop's epoll_wait
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        
+        bool published = false;
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_tick >= tick_interval) {
+            int ticks_to_generate = std::min(MAX_TICK_BURST,
+                static_cast<int>((now - last_tick).count() / tick_interval.count()));
+            bool has_receivers = client_count() > 0;
+            for (int i = 0; i < ticks_to_generate && has_receivers; ++i) {
+                // Each tick is generated once, straight into the ring
+                uint8_t* buffer = ring_->claim();
+                size_t size;
+                uint16_t symbol_id;
+                if (fault_injection_ && ++fault_skip_counter_ % 100 == 0) {
+                    tick_gen_->generate_tick(buffer, size, symbol_id);  // Skip this one
+                }
+                tick_gen_->generate_tick(buffer, size, symbol_id);
+                ring_->publish(size, symbol_id);
+                published = true;
+            }
+            last_tick = now;
+        }
+        
+        if (now - last_heartbeat >= std::chrono::seconds(1)) {
+            size_t size;
+            tick_gen_->generate_heartbeat(ring_->claim(), size);
+            ring_->publish(size, 0, TickRing::Kind::Heartbeat);
+            published = true;
+            last_heartbeat = now;
+        }
+        
+        if (published) {
+            wake_workers();
+        }
+    }
+    
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+void ExchangeSimulator::wake_workers() {
+    uint64_t one = 1;
+    for (auto& worker : workers_) {
+        ssize_t n = ::write(worker->wake_fd, &one, sizeof(one));
+        (void)n;  // Only fails when the counter is already huge: still awake
+    }
+}
+
+void ExchangeSimulator::run_worker(Worker& worker) {
+    ClientManager& clients = *worker.clients;
+    
+    while (running_.load()) {
+        // Woken by new connections, client requests, and the tick thread;
+        // no waiting while ring messages are still queued for this worker.
+        // Everything ready is handled before the next batch goes out.
+        struct epoll_event events[64];
+        int timeout = worker.cursor == ring_->head() ? 1 : 0;
+        int nev;
+        do {
+            nev = epoll_wait(worker.event_fd, events, 64, timeout);
+            for (int i = 0; i < nev; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == worker.listen_fd) {
+                    handle_new_connection(clients, worker.event_fd, fd, 0);
+                } else if (fd == worker.wake_fd) {
+                    uint64_t count;
+                    ssize_t n = ::read(fd, &count, sizeof(count));
+                    (void)n;
+                } else {
+                    bool is_error = (events[i].events & EPOLLERR) || (events[i].events & EPOLLHUP);
+                    bool is_read = (events[i].events & EPOLLIN);
+                    handle_client_event(clients, worker.event_fd, fd, is_read, is_error);
+                }
+            }
+            timeout = 0;
+        } while (nev == 64);
+        
+        clients.flush_send_queues();
+        
+        // What was published since the last pass, copied into this
+        // worker's pool and fanned out to its clients. A bounded batch,
+        // so a backlog can't hold off accepts and subscriptions.
+        uint64_t bytes_before = clients.total_bytes_sent();
+        size_t sent = 0;
+        bool ticked = false;
+        uint64_t lost = ring_->read(worker.cursor,
+            [&](const uint8_t* data, size_t size, uint16_t symbol_id, TickRing::Kind kind) {
+                if (kind == TickRing::Kind::Heartbeat) {
+                    if (clients.batching_enabled()) {
+                        clients.flush_batches();  // Keep heartbeat behind batched ticks
+                    }
+                    MessageRef heartbeat = clients.allocate_message(size);
+                    std::memcpy(heartbeat.data(), data, size);
+                    heartbeat.resize(size);
+                    clients.send_to_all(heartbeat);
+                    return;
+                }
+                if (clients.client_count() == 0) {
+                    return;
+                }
+                MessageRef msg = clients.allocate_message();
+                std::memcpy(msg.data(), data, size);
+                msg.resize(size);
+                MessageRef v2;
+                if (clients.v2_client_count() > 0) {
+                    v2 = clients.allocate_message();
+                    v2.resize(encode_v2(msg.data(), v2.data()));
+                }
+                sent += clients.broadcast(msg, symbol_id, v2);
+                ticked = true;
+            }, WORKER_BATCH);
+        if (lost > 0) {
+            worker.overruns.fetch_add(lost, std::memory_order_relaxed);
+        }
+        
+        if (ticked && clients.batching_enabled()) {
+            clients.flush_batches();
+        }
+        sent += clients.drain_slow_clients();
+        messages_sent_.fetch_add(sent, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(clients.total_bytes_sent() - bytes_before,
+                              std::memory_order_relaxed);
+        worker.client_count.store(clients.client_count(), std::memory_order_relaxed);
+    }
+}
+#endif
+
+void ExchangeSimulator::handle_new_connection(ClientManager& clients, int event_fd,
+                                              int listen_fd, uint8_t line) {
     // Accept all pending connections (edge-triggered mode)
     while (true) {
         struct sockaddr_in client_addr{};
         socklen_t addr_len = sizeof(client_addr);
         
-        int client_fd = accept(server_fd_, 
+        int client_fd = accept(listen_fd, 
                                reinterpret_cast<struct sockaddr*>(&client_addr),
                                &addr_len);
         
@@ -227,101 +570,330 @@ void ExchangeSimulator::handle_new_connection() {
 #ifdef USE_KQUEUE
         struct kevent ev;
         EV_SET(&ev, client_fd, EVFILT_READ, EV_ADD | EV_ENABLE | EV_CLEAR, 0, 0, nullptr);
-        kevent(event_fd_, &ev, 1, nullptr, 0, nullptr);
+        kevent(event_fd, &ev, 1, nullptr, 0, nullptr);
 #else
         struct epoll_event ev;
         ev.events = EPOLLIN | EPOLLET | EPOLLRDHUP;
         ev.data.fd = client_fd;
-        epoll_ctl(event_fd_, EPOLL_CTL_ADD, client_fd, &ev);
+        epoll_ctl(event_fd, EPOLL_CTL_ADD, client_fd, &ev);
 #endif
         
         // Add to client manager
-        client_mgr_->add_client(client_fd, ip_str, port);
+        clients.add_client(client_fd, ip_str, port);
+        clients.set_line(client_fd, line);
         
-        std::cout << "Client connected: " << ip_str << ":" << port << std::endl;
+        // One write per line, as workers may be logging at the same time
+        std::string message = "Client connected: " + std::string(ip_str) + ":" +
+                              std::to_string(port);
+        if (!lines_.empty()) {
+            message += " (line " + std::string(1, static_cast<char>('A' + line)) + ")";
+        }
+        std::cout << message + "\n" << std::flush;
     }
 }
 
-void ExchangeSimulator::handle_client_event(int client_fd, bool is_read, bool is_error) {
+void ExchangeSimulator::handle_client_event(ClientManager& clients, int event_fd, int client_fd,
+                                            bool is_read, bool is_error) {
     if (is_error) {
-        handle_client_disconnect(client_fd, "Connection error");
+        handle_client_disconnect(clients, event_fd, client_fd, "Connection error");
         return;
     }
     
     if (is_read) {
         // Try to read subscription request
-        process_subscription(client_fd);
+        process_subscription(clients, event_fd, client_fd);
     }
 }
 
-bool ExchangeSimulator::process_subscription(int client_fd) {
+bool ExchangeSimulator::process_subscription(ClientManager& clients, int event_fd,
+                                             int client_fd) {
     uint8_t buffer[1024];
     ssize_t n = recv(client_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
     
     if (n <= 0) {
         if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
-            handle_client_disconnect(client_fd, "Read failed");
+            handle_client_disconnect(clients, event_fd, client_fd, "Read failed");
         }
         return false;
     }
     
+    // Retransmit requests (UDP mode) may arrive back to back
+    if (buffer[0] == RETRANSMIT_CMD) {
+        size_t off = 0;
+        while (off + sizeof(RetransmitRequest) <= static_cast<size_t>(n) &&
+               buffer[off] == RETRANSMIT_CMD) {
+            RetransmitRequest request;
+            std::memcpy(&request, buffer + off, sizeof(request));
+            handle_retransmit(client_fd, request);
+            off += sizeof(request);
+        }
+        return true;
+    }
+    
     // Check for subscription command
     if (buffer[0] == SUBSCRIBE_CMD && n >= 3) {
         uint16_t count;
         std::memcpy(&count, buffer + 1, 2);
         
         if (n >= static_cast<ssize_t>(3 + count * 2)) {
-            std::vector<uint16_t> symbols(count);
+            std::pmr::vector<uint16_t> symbols(count, &clients.slab());
             for (uint16_t i = 0; i < count; ++i) {
                 std::memcpy(&symbols[i], buffer + 3 + i * 2, 2);
             }
-            client_mgr_->handle_subscription(client_fd, symbols.data(), count);
+            clients.handle_subscription(client_fd, symbols.data(), count);
             std::cout << "Client subscribed to " << count << " symbols" << std::endl;
             return true;
         }
     }
     
+    // Versioned subscription - negotiates wire format as well
+    if (buffer[0] == SUBSCRIBE_V2_CMD && n >= 4) {
+        uint8_t version = buffer[1];
+        uint16_t count;
+        std::memcpy(&count, buffer + 2, 2);
+        
+        if (version != PROTOCOL_V1 && version != PROTOCOL_V2) {
+            version = PROTOCOL_V1;  // Unknown version - fall back
+        }
+        
+        if (n >= static_cast<ssize_t>(4 + count * 2)) {
+            std::pmr::vector<uint16_t> symbols(count, &clients.slab());
+            for (uint16_t i = 0; i < count; ++i) {
+                std::memcpy(&symbols[i], buffer + 4 + i * 2, 2);
+            }
+            clients.handle_subscription(client_fd, symbols.data(), count);
+            clients.set_protocol_version(client_fd, version);
+            std::cout << "Client subscribed to " << count << " symbols (protocol v"
+                      << static_cast<int>(version) << ")" << std::endl;
+            return true;
+        }
+    }
+    
     return false;
 }
 
 void ExchangeSimulator::generate_and_broadcast_tick() {
-    uint8_t buffer[QUOTE_MSG_SIZE];
+    // Generated straight into a pooled buffer; clients whose socket is
+    // backed up queue a reference to it
+    MessageRef msg = client_mgr_->allocate_message();
     size_t size;
     uint16_t symbol_id;
     
     // Fault injection - skip sequence numbers occasionally
     if (fault_injection_) {
         if (++fault_skip_counter_ % 100 == 0) {
-            tick_gen_->generate_tick(buffer, size, symbol_id);  // Skip this one
+            tick_gen_->generate_tick(msg.data(), size, symbol_id);  // Skip this one
         }
     }
     
-    tick_gen_->generate_tick(buffer, size, symbol_id);
+    tick_gen_->generate_tick(msg.data(), size, symbol_id);
+    msg.resize(size);
+    
+    // UDP mode: one copy per destination regardless of client count
+    if (udp_) {
+        uint64_t bytes_before = udp_->bytes_sent();
+        udp_->publish(msg.data(), size);
+        messages_sent_.fetch_add(udp_->destination_count(), std::memory_order_relaxed);
+        bytes_sent_.fetch_add(udp_->bytes_sent() - bytes_before, std::memory_order_relaxed);
+        return;
+    }
+    
+    // Encode the fixed-point layout once per tick, only if someone wants it
+    MessageRef v2;
+    if (client_mgr_->v2_client_count() > 0) {
+        v2 = client_mgr_->allocate_message();
+        v2.resize(encode_v2(msg.data(), v2.data()));
+    }
     
-    size_t sent = client_mgr_->broadcast(buffer, size, symbol_id);
+    uint64_t bytes_before = client_mgr_->total_bytes_sent();
+    size_t sent = lines_.empty()
+        ? client_mgr_->broadcast(msg, symbol_id, v2)
+        : publish_to_lines(msg, symbol_id, v2, false);
     messages_sent_.fetch_add(sent, std::memory_order_relaxed);
-    bytes_sent_.fetch_add(sent * size, std::memory_order_relaxed);
+    bytes_sent_.fetch_add(client_mgr_->total_bytes_sent() - bytes_before,
+                          std::memory_order_relaxed);
+}
+
+void ExchangeSimulator::flush_batches() {
+    if (!client_mgr_->batching_enabled()) {
+        return;
+    }
+    
+    uint64_t bytes_before = client_mgr_->total_bytes_sent();
+    client_mgr_->flush_batches();
+    bytes_sent_.fetch_add(client_mgr_->total_bytes_sent() - bytes_before,
+                          std::memory_order_relaxed);
+}
+
+void ExchangeSimulator::flush_udp() {
+    if (!udp_) {
+        return;
+    }
+    
+    uint64_t bytes_before = udp_->bytes_sent();
+    udp_->flush();
+    bytes_sent_.fetch_add(udp_->bytes_sent() - bytes_before, std::memory_order_relaxed);
+}
+
+void ExchangeSimulator::handle_retransmit(int client_fd, const RetransmitRequest& request) {
+    if (!udp_) {
+        return;
+    }
+    
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t count = std::min<size_t>(request.count, MAX_RETRANSMIT_COUNT);
+    for (size_t i = 0; i < count; ++i) {
+        size_t size = udp_->lookup(request.start_sequence + static_cast<uint32_t>(i), buffer);
+        if (size == 0) {
+            continue;  // Aged out, or never sent (fault injection)
+        }
+        if (!client_mgr_->send_to_client(client_fd, buffer, size)) {
+            break;
+        }
+        retransmitted_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ExchangeSimulator::drain_slow_clients() {
+    uint64_t bytes_before = client_mgr_->total_bytes_sent();
+    size_t sent = client_mgr_->drain_slow_clients();
+    if (sent > 0) {
+        messages_sent_.fetch_add(sent, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(client_mgr_->total_bytes_sent() - bytes_before,
+                              std::memory_order_relaxed);
+    }
 }
 
 void ExchangeSimulator::send_heartbeat() {
-    uint8_t buffer[HEARTBEAT_MSG_SIZE];
+    // Keep heartbeat behind any pending batched ticks
+    flush_batches();
+    
+    MessageRef heartbeat = client_mgr_->allocate_message(HEARTBEAT_MSG_SIZE);
     size_t size;
-    tick_gen_->generate_heartbeat(buffer, size);
+    tick_gen_->generate_heartbeat(heartbeat.data(), size);
+    heartbeat.resize(size);
+    
+    // Heartbeat takes a sequence number, so UDP receivers need it too
+    if (udp_) {
+        uint64_t bytes_before = udp_->bytes_sent();
+        udp_->publish(heartbeat.data(), size);
+        udp_->flush();
+        bytes_sent_.fetch_add(udp_->bytes_sent() - bytes_before, std::memory_order_relaxed);
+    }
+    
+    // Heartbeats are sequenced, so each line drops and delays them too
+    if (!lines_.empty()) {
+        publish_to_lines(heartbeat, 0, MessageRef(), true);
+        return;
+    }
+    
+    // Every client gets it, subscribed or not
+    client_mgr_->send_to_all(heartbeat);
+}
+
+void ExchangeSimulator::ensure_lines() {
+    if (lines_.empty()) {
+        Line primary;
+        primary.port = port_;
+        primary.rng.seed(primary.faults.seed);
+        lines_.push_back(std::move(primary));
+    }
+}
+
+bool ExchangeSimulator::add_line(uint16_t port, const LineFaults& faults) {
+    if (running_.load() || port == port_ || lines_.size() >= 26) {
+        return false;
+    }
+    ensure_lines();
     
-    // Broadcast heartbeat to all (symbol_id 0 matches all)
-    for (int fd : client_mgr_->get_all_client_fds()) {
-        client_mgr_->send_to_client(fd, buffer, size);
+    Line line;
+    line.port = port;
+    line.faults = faults;
+    line.rng.seed(faults.seed);
+    lines_.push_back(std::move(line));
+    return true;
+}
+
+void ExchangeSimulator::set_line_faults(size_t line, const LineFaults& faults) {
+    ensure_lines();
+    if (line < lines_.size()) {
+        lines_[line].faults = faults;
+        lines_[line].rng.seed(faults.seed);
     }
 }
 
-void ExchangeSimulator::handle_client_disconnect(int client_fd, const std::string& reason) {
-    const ClientConnection* client = client_mgr_->get_client(client_fd);
+uint64_t ExchangeSimulator::line_dropped(size_t line) const {
+    return line < lines_.size() ? lines_[line].dropped : 0;
+}
+
+size_t ExchangeSimulator::publish_to_lines(const MessageRef& msg, uint16_t symbol_id,
+                                           const MessageRef& v2, bool heartbeat) {
+    size_t sent = 0;
+    auto now = std::chrono::steady_clock::now();
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    
+    for (size_t i = 0; i < lines_.size(); ++i) {
+        Line& line = lines_[i];
+        if (line.faults.drop_rate > 0 && chance(line.rng) < line.faults.drop_rate) {
+            line.dropped++;
+            continue;
+        }
+        
+        if (line.faults.delay_us == 0 && line.delayed.empty()) {
+            sent += send_on_line(i, msg, symbol_id, v2, heartbeat);
+            continue;
+        }
+        
+        // Queue behind anything already delayed, keeping the line in order
+        DelayedMessage& delayed = line.delayed.emplace_back();
+        delayed.due = now + std::chrono::microseconds(line.faults.delay_us);
+        delayed.symbol_id = symbol_id;
+        delayed.heartbeat = heartbeat;
+        delayed.msg = msg;
+        delayed.v2 = v2;
+    }
+    return sent;
+}
+
+size_t ExchangeSimulator::send_on_line(size_t line, const MessageRef& msg, uint16_t symbol_id,
+                                       const MessageRef& v2, bool heartbeat) {
+    if (!heartbeat) {
+        return client_mgr_->broadcast(msg, symbol_id, v2, static_cast<int>(line));
+    }
+    
+    return client_mgr_->send_to_all(msg, static_cast<int>(line));
+}
+
+void ExchangeSimulator::release_delayed(std::chrono::steady_clock::time_point now) {
+    for (size_t i = 0; i < lines_.size(); ++i) {
+        auto& delayed = lines_[i].delayed;
+        size_t sent = 0;
+        uint64_t bytes_before = client_mgr_->total_bytes_sent();
+        while (!delayed.empty() && delayed.front().due <= now) {
+            const DelayedMessage& entry = delayed.front();
+            if (entry.heartbeat) {
+                flush_batches();  // Keep heartbeat behind batched ticks
+            }
+            size_t n = send_on_line(i, entry.msg, entry.symbol_id, entry.v2, entry.heartbeat);
+            sent += entry.heartbeat ? 0 : n;
+            delayed.pop_front();
+        }
+        messages_sent_.fetch_add(sent, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(client_mgr_->total_bytes_sent() - bytes_before,
+                              std::memory_order_relaxed);
+    }
+}
+
+void ExchangeSimulator::handle_client_disconnect(ClientManager& clients, int event_fd,
+                                                 int client_fd, const std::string& reason) {
+    const ClientConnection* client = clients.get_client(client_fd);
     if (client) {
-        std::cout << "Client disconnected: " << client->address << ":" << client->port;
+        std::string message = "Client disconnected: " + client->address + ":" +
+                              std::to_string(client->port);
         if (!reason.empty()) {
-            std::cout << " (" << reason << ")";
+            message += " (" + reason + ")";
         }
-        std::cout << std::endl;
+        std::cout << message + "\n" << std::flush;
         
         if (disconnect_cb_) {
             disconnect_cb_(client_fd, reason);
@@ -332,12 +904,12 @@ void ExchangeSimulator::handle_client_disconnect(int client_fd, const std::strin
 #ifdef USE_KQUEUE
     struct kevent ev;
     EV_SET(&ev, client_fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
-    kevent(event_fd_, &ev, 1, nullptr, 0, nullptr);
+    kevent(event_fd, &ev, 1, nullptr, 0, nullptr);
 #else
-    epoll_ctl(event_fd_, EPOLL_CTL_DEL, client_fd, nullptr);
+    epoll_ctl(event_fd, EPOLL_CTL_DEL, client_fd, nullptr);
 #endif
     
-    client_mgr_->remove_client(client_fd);
+    clients.remove_client(client_fd);
 }
 
 void ExchangeSimulator::set_tick_rate(uint32_t ticks_per_second) {
@@ -353,7 +925,57 @@ void ExchangeSimulator::set_market_condition(TickGenerator::MarketCondition cond
     tick_gen_->set_market_condition(condition);
 }
 
+void ExchangeSimulator::enable_batching(bool enable) {
+    client_mgr_->set_batching(enable);
+}
+
+void ExchangeSimulator::enable_conflation(bool enable) {
+    client_mgr_->set_conflation(enable);
+}
+
+bool ExchangeSimulator::add_udp_destination(const std::string& address, uint16_t port,
+                                            const std::string& interface_addr) {
+    if (!udp_) {
+        udp_ = std::make_unique<UdpPublisher>();
+    }
+    
+    if (!udp_->add_destination(address, port, interface_addr)) {
+        std::cerr << udp_->last_error() << std::endl;
+        if (udp_->destination_count() == 0) {
+            udp_.reset();
+        }
+        return false;
+    }
+    return true;
+}
+
+void ExchangeSimulator::set_impairments(const ImpairmentConfig& config) {
+    client_mgr_->set_default_impairments(config);
+    impaired_ = impaired_ || config.enabled();
+}
+
+void ExchangeSimulator::set_connection_impairments(size_t connection,
+                                                   const ImpairmentConfig& config) {
+    client_mgr_->set_connection_impairments(connection, config);
+    impaired_ = impaired_ || config.enabled();
+}
+
+ImpairmentStats ExchangeSimulator::impairment_stats() const {
+    return client_mgr_->impairment_stats();
+}
+
+void ExchangeSimulator::set_depth_levels(size_t levels) {
+    tick_gen_->set_depth_levels(levels);
+}
+
 size_t ExchangeSimulator::client_count() const {
+    if (!workers_.empty()) {
+        size_t count = 0;
+        for (const auto& worker : workers_) {
+            count += worker->client_count.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
     return client_mgr_->client_count();
 }
 
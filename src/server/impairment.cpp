@@ -0,0 +1,157 @@
+#include "impairment.h"
+#include <cstdlib>
+#include <sstream>
+
+namespace mdf {
+
+ImpairmentStats& ImpairmentStats::operator+=(const ImpairmentStats& other) {
+    writes += other.writes;
+    bit_flips += other.bit_flips;
+    truncated += other.truncated;
+    duplicated += other.duplicated;
+    reordered += other.reordered;
+    delays += other.delays;
+    partial_writes += other.partial_writes;
+    resets += other.resets;
+    return *this;
+}
+
+bool parse_impairments(const std::string& spec, ImpairmentConfig& config) {
+    std::istringstream in(spec);
+    std::string field;
+    while (std::getline(in, field, ',')) {
+        size_t eq = field.find('=');
+        if (eq == std::string::npos || eq + 1 == field.size()) {
+            return false;
+        }
+        std::string key = field.substr(0, eq);
+        const char* value = field.c_str() + eq + 1;
+        char* end = nullptr;
+
+        if (key == "seed") {
+            config.seed = std::strtoull(value, &end, 10);
+        } else if (key == "delay_us") {
+            config.delay_us = static_cast<uint32_t>(std::strtoul(value, &end, 10));
+        } else {
+            double p = std::strtod(value, &end);
+            if (p < 0.0 || p > 1.0) {
+                return false;
+            }
+            if (key == "flip") config.bit_flip = p;
+            else if (key == "truncate") config.truncate = p;
+            else if (key == "dup") config.duplicate = p;
+            else if (key == "reorder") config.reorder = p;
+            else if (key == "delay") config.delay = p;
+            else if (key == "partial") config.partial_write = p;
+            else if (key == "reset") config.reset = p;
+            else return false;
+        }
+        if (*end != '\0') {
+            return false;
+        }
+    }
+    return true;
+}
+
+Impairer::Impairer(const ImpairmentConfig& config)
+    : config_(config)
+    , rng_(config.seed) {
+}
+
+Impairer::Action Impairer::apply(const uint8_t* data, size_t len,
+                                 std::chrono::steady_clock::time_point now) {
+    runs_.clear();
+    out_.clear();
+    stats_.writes++;
+
+    // An expired stall goes out ahead of this write
+    if (stalled_ && now >= stall_until_) {
+        stalled_ = false;
+        add_run(stalled_bytes_.data(), stalled_bytes_.size());
+        stalled_bytes_.clear();
+    }
+
+    if (roll(config_.reset)) {
+        stats_.resets++;
+        return Action::Reset;
+    }
+
+    scratch_.assign(data, data + len);
+    if (len > 0 && roll(config_.bit_flip)) {
+        size_t bit = pick(0, len * 8 - 1);
+        scratch_[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        stats_.bit_flips++;
+    }
+    if (len > 1 && roll(config_.truncate)) {
+        scratch_.resize(pick(1, len - 1));
+        stats_.truncated++;
+    }
+
+    if (!stalled_ && roll(config_.delay)) {
+        stalled_ = true;
+        stall_until_ = now + std::chrono::microseconds(config_.delay_us);
+        stats_.delays++;
+    }
+
+    if (reorder_.empty() && roll(config_.reorder)) {
+        reorder_.swap(scratch_);
+        reorder_since_ = now;
+        stats_.reordered++;
+        return Action::Send;
+    }
+
+    emit(scratch_.data(), scratch_.size());
+    if (roll(config_.duplicate)) {
+        emit(scratch_.data(), scratch_.size());
+        stats_.duplicated++;
+    }
+
+    // The write held back goes out behind this one
+    if (!reorder_.empty()) {
+        emit(reorder_.data(), reorder_.size());
+        reorder_.clear();
+    }
+    return Action::Send;
+}
+
+bool Impairer::release(std::chrono::steady_clock::time_point now) {
+    runs_.clear();
+    out_.clear();
+
+    if (stalled_ && now >= stall_until_) {
+        stalled_ = false;
+        add_run(stalled_bytes_.data(), stalled_bytes_.size());
+        stalled_bytes_.clear();
+    }
+    if (!reorder_.empty() &&
+        now - reorder_since_ >= std::chrono::microseconds(config_.delay_us)) {
+        emit(reorder_.data(), reorder_.size());
+        reorder_.clear();
+    }
+    return !runs_.empty();
+}
+
+void Impairer::emit(const uint8_t* data, size_t len) {
+    if (stalled_) {
+        stalled_bytes_.insert(stalled_bytes_.end(), data, data + len);
+        return;
+    }
+    if (len > 1 && roll(config_.partial_write)) {
+        size_t split = pick(1, len - 1);
+        add_run(data, split);
+        add_run(data + split, len - split);
+        stats_.partial_writes++;
+        return;
+    }
+    add_run(data, len);
+}
+
+void Impairer::add_run(const uint8_t* data, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    runs_.push_back(Run{out_.size(), len});
+    out_.insert(out_.end(), data, data + len);
+}
+
+} // namespace mdf
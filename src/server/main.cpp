@@ -1,11 +1,16 @@
 #include "exchange_simulator.h"
 #include <chrono>
 #include <csignal>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <getopt.h>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 mdf::ExchangeSimulator *g_simulator = nullptr;
 std::chrono::steady_clock::time_point g_start_time;
@@ -30,9 +35,61 @@ void print_usage(const char *program) {
                "(default: neutral)\n";
   std::cout
       << "  -f, --fault            Enable fault injection (1% sequence gaps)\n";
+  std::cout << "  -d, --depth <levels>   Simulate order book depth with N levels "
+               "(5-20, default: off)\n";
+  std::cout << "  -b, --batch            Send delta-encoded batched packets\n";
+  std::cout << "  -c, --conflate         Conflate quotes/trades for slow consumers\n";
+  std::cout << "  -u, --udp <addr:port>  Send ticks over UDP to a multicast group,\n"
+               "                         or repeat for a list of unicast endpoints\n";
+  std::cout << "      --udp-iface <addr> Multicast interface (default: 127.0.0.1)\n";
+  std::cout << "  -l, --line <port[:drop%[:delay_us]]>\n"
+               "                         Publish a redundant copy of the feed on\n"
+               "                         another port (repeat for more lines)\n";
+  std::cout << "      --line-faults <drop%[:delay_us]>\n"
+               "                         Impair the main port's line the same way\n";
+  std::cout << "      --impair <spec>    Inject line noise into every client's stream,\n"
+               "                         e.g. flip=0.001,truncate=0.001,dup=0.01,\n"
+               "                         reorder=0.01,delay=0.001,delay_us=2000,\n"
+               "                         partial=0.1,reset=0.0001,seed=7\n";
+  std::cout << "      --impair-conn <n:spec>\n"
+               "                         Impair only the nth connection (from 0)\n";
+  std::cout << "      --memory <spec>    Large buffer policy: 4k|huge,node=<n|local>,\n"
+               "                         lock,prefault (default: huge)\n";
+  std::cout << "  -w, --workers <n>      Accept and fan out on n threads, each with\n"
+               "                         its own SO_REUSEPORT listener (Linux; not\n"
+               "                         with UDP, lines or impairments)\n";
   std::cout << "  -h, --help             Show this help message\n";
 }
 
+// Parse "drop%[:delay_us]" into faults, returns false if malformed
+bool parse_line_faults(const char *spec, mdf::LineFaults &faults) {
+  double drop_pct = 0;
+  unsigned delay_us = 0;
+  int fields = std::sscanf(spec, "%lf:%u", &drop_pct, &delay_us);
+  if (fields < 1 || drop_pct < 0 || drop_pct > 100) {
+    return false;
+  }
+  faults.drop_rate = drop_pct / 100.0;
+  faults.delay_us = delay_us;
+  return true;
+}
+
+// Parse "address:port", returns false if malformed
+bool parse_endpoint(const std::string &spec, std::string &address,
+                    uint16_t &port) {
+  size_t colon = spec.rfind(':');
+  if (colon == std::string::npos || colon == 0) {
+    return false;
+  }
+  address = spec.substr(0, colon);
+  int value = std::atoi(spec.c_str() + colon + 1);
+  if (value <= 0 || value > 65535) {
+    return false;
+  }
+  port = static_cast<uint16_t>(value);
+  return true;
+}
+
 std::string format_duration(std::chrono::seconds duration) {
   int hours = duration.count() / 3600;
   int mins = (duration.count() % 3600) / 60;
@@ -51,6 +108,18 @@ int main(int argc, char *argv[]) {
   mdf::TickGenerator::MarketCondition market =
       mdf::TickGenerator::MarketCondition::NEUTRAL;
   bool fault_injection = false;
+  size_t depth_levels = 0;
+  bool batching = false;
+  bool conflation = false;
+  std::vector<std::pair<std::string, uint16_t>> udp_endpoints;
+  std::string udp_iface = "127.0.0.1";
+  std::vector<std::pair<uint16_t, mdf::LineFaults>> lines;
+  mdf::LineFaults main_line_faults;
+  bool main_line_impaired = false;
+  mdf::ImpairmentConfig impairments;
+  std::vector<std::pair<size_t, mdf::ImpairmentConfig>> connection_impairments;
+  std::string memory_spec;
+  size_t workers = 0;
 
   static struct option long_options[] = {
       {"port", required_argument, nullptr, 'p'},
@@ -58,19 +127,36 @@ int main(int argc, char *argv[]) {
       {"rate", required_argument, nullptr, 'r'},
       {"market", required_argument, nullptr, 'm'},
       {"fault", no_argument, nullptr, 'f'},
+      {"depth", required_argument, nullptr, 'd'},
+      {"batch", no_argument, nullptr, 'b'},
+      {"conflate", no_argument, nullptr, 'c'},
+      {"udp", required_argument, nullptr, 'u'},
+      {"udp-iface", required_argument, nullptr, 'I'},
+      {"line", required_argument, nullptr, 'l'},
+      {"line-faults", required_argument, nullptr, 'F'},
+      {"impair", required_argument, nullptr, 'i'},
+      {"impair-conn", required_argument, nullptr, 'n'},
+      {"memory", required_argument, nullptr, 'M'},
+      {"workers", required_argument, nullptr, 'w'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, 0, nullptr, 0}};
 
   int opt;
-  while ((opt = getopt_long(argc, argv, "p:s:r:m:fh", long_options, nullptr)) !=
+  while ((opt = getopt_long(argc, argv, "p:s:r:m:fd:bcu:l:w:h", long_options, nullptr)) !=
          -1) {
     switch (opt) {
     case 'p':
       port = static_cast<uint16_t>(std::atoi(optarg));
       break;
-    case 's':
-      num_symbols = static_cast<size_t>(std::atoi(optarg));
+    case 's': {
+      int count = std::atoi(optarg);
+      if (count <= 0 || static_cast<size_t>(count) > mdf::MAX_SYMBOL_CAPACITY) {
+        std::cerr << "Symbols must be 1-" << mdf::MAX_SYMBOL_CAPACITY << "\n";
+        return 1;
+      }
+      num_symbols = static_cast<size_t>(count);
       break;
+    }
     case 'r':
       tick_rate = static_cast<uint32_t>(std::atoi(optarg));
       break;
@@ -84,6 +170,94 @@ int main(int argc, char *argv[]) {
     case 'f':
       fault_injection = true;
       break;
+    case 'd': {
+      int levels = std::atoi(optarg);
+      if (levels < static_cast<int>(mdf::MIN_BOOK_LEVELS) ||
+          levels > static_cast<int>(mdf::MAX_BOOK_LEVELS)) {
+        std::cerr << "Depth must be " << mdf::MIN_BOOK_LEVELS << "-"
+                  << mdf::MAX_BOOK_LEVELS << "\n";
+        return 1;
+      }
+      depth_levels = static_cast<size_t>(levels);
+      break;
+    }
+    case 'b':
+      batching = true;
+      break;
+    case 'c':
+      conflation = true;
+      break;
+    case 'u': {
+      std::string address;
+      uint16_t udp_port;
+      if (!parse_endpoint(optarg, address, udp_port)) {
+        std::cerr << "Invalid UDP endpoint: " << optarg << "\n";
+        return 1;
+      }
+      udp_endpoints.emplace_back(address, udp_port);
+      break;
+    }
+    case 'I':
+      udp_iface = optarg;
+      break;
+    case 'l': {
+      // Each line gets its own random stream
+      int line_port = std::atoi(optarg);
+      const char *colon = std::strchr(optarg, ':');
+      mdf::LineFaults faults;
+      faults.seed = lines.size() + 2;
+      if (line_port <= 0 || line_port > 65535 ||
+          (colon && !parse_line_faults(colon + 1, faults))) {
+        std::cerr << "Invalid line: " << optarg << "\n";
+        return 1;
+      }
+      lines.emplace_back(static_cast<uint16_t>(line_port), faults);
+      break;
+    }
+    case 'F':
+      if (!parse_line_faults(optarg, main_line_faults)) {
+        std::cerr << "Invalid line faults: " << optarg << "\n";
+        return 1;
+      }
+      main_line_impaired = true;
+      break;
+    case 'i':
+      if (!mdf::parse_impairments(optarg, impairments)) {
+        std::cerr << "Invalid impairments: " << optarg << "\n";
+        return 1;
+      }
+      break;
+    case 'n': {
+      const char *colon = std::strchr(optarg, ':');
+      mdf::ImpairmentConfig config;
+      if (!colon || colon == optarg ||
+          !mdf::parse_impairments(colon + 1, config)) {
+        std::cerr << "Invalid connection impairments: " << optarg << "\n";
+        return 1;
+      }
+      connection_impairments.emplace_back(
+          static_cast<size_t>(std::atoi(optarg)), config);
+      break;
+    }
+    case 'M': {
+      mdf::MemoryPolicy policy;
+      if (!mdf::parse_memory_policy(optarg, policy)) {
+        std::cerr << "Invalid memory policy: " << optarg << "\n";
+        return 1;
+      }
+      mdf::set_memory_policy(policy);
+      memory_spec = optarg;
+      break;
+    }
+    case 'w': {
+      int count = std::atoi(optarg);
+      if (count < 0 || count > 64) {
+        std::cerr << "Workers must be 0-64\n";
+        return 1;
+      }
+      workers = static_cast<size_t>(count);
+      break;
+    }
     case 'h':
     default:
       print_usage(argv[0]);
@@ -103,6 +277,34 @@ int main(int argc, char *argv[]) {
   simulator.set_tick_rate(tick_rate);
   simulator.set_market_condition(market);
   simulator.enable_fault_injection(fault_injection);
+  simulator.set_depth_levels(depth_levels);
+  simulator.enable_batching(batching);
+  simulator.enable_conflation(conflation);
+  for (const auto &[address, udp_port] : udp_endpoints) {
+    if (!simulator.add_udp_destination(address, udp_port, udp_iface)) {
+      return 1;
+    }
+  }
+  for (const auto &[line_port, faults] : lines) {
+    if (!simulator.add_line(line_port, faults)) {
+      std::cerr << "Invalid line port: " << line_port << "\n";
+      return 1;
+    }
+  }
+  if (main_line_impaired) {
+    simulator.set_line_faults(0, main_line_faults);
+  }
+  bool redundant = !lines.empty() || main_line_impaired;
+  simulator.set_impairments(impairments);
+  for (const auto &[connection, config] : connection_impairments) {
+    simulator.set_connection_impairments(connection, config);
+  }
+  bool impaired = impairments.enabled() || !connection_impairments.empty();
+  if (!simulator.set_workers(workers)) {
+    std::cerr << "Workers can't be combined with UDP, redundant lines or "
+                 "impairments\n";
+    return 1;
+  }
 
   // Set disconnect callback
   simulator.set_disconnect_callback([](int fd, const std::string &reason) {
@@ -124,6 +326,37 @@ int main(int argc, char *argv[]) {
             << "\n";
   std::cout << "Fault Inject:  " << (fault_injection ? "Enabled" : "Disabled")
             << "\n";
+  std::cout << "Book Depth:    "
+            << (depth_levels > 0 ? std::to_string(depth_levels) + " levels"
+                                 : std::string("Disabled"))
+            << "\n";
+  std::cout << "Batching:      " << (batching ? "Enabled" : "Disabled") << "\n";
+  std::cout << "Conflation:    " << (conflation ? "Enabled" : "Disabled")
+            << "\n";
+  std::cout << "UDP:           ";
+  if (udp_endpoints.empty()) {
+    std::cout << "Disabled";
+  }
+  for (size_t i = 0; i < udp_endpoints.size(); ++i) {
+    std::cout << (i ? ", " : "") << udp_endpoints[i].first << ":"
+              << udp_endpoints[i].second;
+  }
+  std::cout << "\n";
+  if (redundant) {
+    std::cout << "Lines:         " << simulator.line_count()
+              << " (A on port " << port << ")\n";
+  }
+  if (!memory_spec.empty()) {
+    std::cout << "Memory:        " << memory_spec << "\n";
+  }
+  if (workers > 0) {
+    std::cout << "Workers:       " << workers << " (SO_REUSEPORT)\n";
+  }
+  if (impaired) {
+    std::cout << "Impairments:   "
+              << (impairments.enabled() ? "All clients" : "Selected clients")
+              << "\n";
+  }
   std::cout << "============================================\n";
   std::cout << "Press Ctrl+C to stop\n\n";
 
@@ -143,6 +376,26 @@ int main(int argc, char *argv[]) {
   std::cout << "Uptime:             " << format_duration(uptime) << "\n";
   std::cout << "Total messages sent: " << simulator.messages_sent() << "\n";
   std::cout << "Total bytes sent:   " << simulator.total_bytes_sent() << "\n";
+  if (!udp_endpoints.empty()) {
+    std::cout << "Retransmitted:      " << simulator.retransmitted_messages()
+              << "\n";
+  }
+  if (workers > 0) {
+    std::cout << "Ring overruns:      " << simulator.ring_overruns() << "\n";
+  }
+  if (impaired) {
+    mdf::ImpairmentStats noise = simulator.impairment_stats();
+    std::cout << "Impaired writes:    " << noise.writes << " (flips "
+              << noise.bit_flips << ", truncated " << noise.truncated
+              << ", duplicated " << noise.duplicated << ", reordered "
+              << noise.reordered << ", stalls " << noise.delays
+              << ", partial " << noise.partial_writes << ", resets "
+              << noise.resets << ")\n";
+  }
+  for (size_t i = 0; redundant && i < simulator.line_count(); ++i) {
+    std::cout << "Line " << static_cast<char>('A' + i)
+              << " dropped:     " << simulator.line_dropped(i) << "\n";
+  }
 
   return 0;
 }
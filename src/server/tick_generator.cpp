@@ -1,4 +1,5 @@
 #include "tick_generator.h"
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -34,6 +35,10 @@ void TickGenerator::reset() {
         sym.ask_quantity = qty_dist(rng_);
         sym.last_trade_qty = 0;
     }
+    
+    for (auto& book : books_) {
+        book.clear();
+    }
 }
 
 double TickGenerator::generate_normal() {
@@ -109,6 +114,12 @@ void TickGenerator::generate_tick_for_symbol(uint16_t symbol_id,
         return;
     }
     
+    // Depth updates don't move the GBM price
+    if (depth_levels_ > 0 && uniform_dist_(rng_) < DEPTH_UPDATE_RATIO) {
+        generate_depth_update(symbol_id, out_buffer, out_size);
+        return;
+    }
+    
     auto& symbol = symbols_[symbol_id];
     
     // Update price using GBM
@@ -154,9 +165,8 @@ void TickGenerator::generate_tick_for_symbol(uint16_t symbol_id,
         payload.ask_price = symbol.ask_price;
         
         // Randomize quantities
-        std::uniform_int_distribution<uint32_t> qty_change(-500, 500);
-        int32_t bid_change = qty_change(rng_);
-        int32_t ask_change = qty_change(rng_);
+        int32_t bid_change = qty_change_(rng_);
+        int32_t ask_change = qty_change_(rng_);
         
         symbol.bid_quantity = static_cast<uint32_t>(
             std::max(100, static_cast<int32_t>(symbol.bid_quantity) + bid_change));
@@ -179,6 +189,90 @@ void TickGenerator::generate_tick_for_symbol(uint16_t symbol_id,
     }
 }
 
+void TickGenerator::generate_depth_update(uint16_t symbol_id,
+                                          uint8_t* out_buffer,
+                                          size_t& out_size) {
+    if (symbol_id >= num_symbols_ || depth_levels_ == 0) {
+        out_size = 0;
+        return;
+    }
+    
+    const auto& symbol = symbols_[symbol_id];
+    auto& book = books_[symbol_id];
+    
+    DepthUpdatePayload payload{};
+    BookSide side = uniform_dist_(rng_) < 0.5 ? BookSide::BID : BookSide::ASK;
+    bool is_bid = (side == BookSide::BID);
+    
+    size_t count = book.level_count(side);
+    const double* prices = is_bid ? book.bid_prices : book.ask_prices;
+    const uint32_t* quantities = is_bid ? book.bid_quantities : book.ask_quantities;
+    double r = uniform_dist_(rng_);
+    
+    if (count == 0 || (count < depth_levels_ && r < 0.4)) {
+        // Add a level - either improve the top of book or extend the tail
+        payload.action = static_cast<uint8_t>(BookAction::ADD);
+        payload.quantity = static_cast<uint32_t>(100 + uniform_dist_(rng_) * 9900);
+        
+        if (count == 0) {
+            payload.level = 0;
+            payload.price = is_bid ? symbol.bid_price : symbol.ask_price;
+        } else {
+            double step = is_bid ? BOOK_TICK_SIZE : -BOOK_TICK_SIZE;
+            double improved = prices[0] + step;
+            size_t opp_count = book.level_count(is_bid ? BookSide::ASK : BookSide::BID);
+            double opposite = opp_count > 0
+                ? (is_bid ? book.ask_prices[0] : book.bid_prices[0])
+                : (is_bid ? symbol.ask_price : symbol.bid_price);
+            bool can_improve = is_bid ? improved < opposite : improved > opposite;
+            
+            if (can_improve && r < 0.2) {
+                payload.level = 0;
+                payload.price = improved;
+            } else {
+                payload.level = static_cast<uint8_t>(count);
+                payload.price = prices[count - 1] - step;
+            }
+        }
+    } else if (count > 1 && r < 0.7) {
+        // Remove a level
+        payload.action = static_cast<uint8_t>(BookAction::DELETE);
+        payload.level = static_cast<uint8_t>(uniform_dist_(rng_) * count);
+        payload.price = prices[payload.level];
+        payload.quantity = 0;
+    } else {
+        // Change resting quantity at a level
+        payload.action = static_cast<uint8_t>(BookAction::MODIFY);
+        payload.level = static_cast<uint8_t>(uniform_dist_(rng_) * count);
+        payload.price = prices[payload.level];
+        int32_t change = static_cast<int32_t>((uniform_dist_(rng_) - 0.5) * 1000);
+        payload.quantity = static_cast<uint32_t>(
+            std::max(100, static_cast<int32_t>(quantities[payload.level]) + change));
+    }
+    
+    payload.side = static_cast<uint8_t>(side);
+    payload.price = std::round(payload.price * 100.0) / 100.0;
+    payload.price = std::max(payload.price, 0.01);
+    
+    // Keep our book in step with what clients will reconstruct
+    book.apply(payload);
+    
+    MessageHeader header;
+    header.message_type = static_cast<uint16_t>(MessageType::DEPTH_UPDATE);
+    header.sequence_number = ++sequence_;
+    header.timestamp_ns = get_timestamp_ns();
+    header.symbol_id = symbol_id;
+    
+    std::memcpy(out_buffer, &header, sizeof(header));
+    std::memcpy(out_buffer + sizeof(header), &payload, sizeof(payload));
+    
+    size_t msg_size = sizeof(header) + sizeof(payload);
+    uint32_t checksum = calculate_checksum(out_buffer, msg_size);
+    std::memcpy(out_buffer + msg_size, &checksum, sizeof(checksum));
+    
+    out_size = DEPTH_MSG_SIZE;
+}
+
 void TickGenerator::generate_heartbeat(uint8_t* out_buffer, size_t& out_size) {
     MessageHeader header;
     header.message_type = static_cast<uint16_t>(MessageType::HEARTBEAT);
@@ -200,6 +294,17 @@ const SymbolState& TickGenerator::get_symbol_state(uint16_t symbol_id) const {
     return symbols_[symbol_id];
 }
 
+void TickGenerator::set_depth_levels(size_t levels) {
+    depth_levels_ = std::min(levels, MAX_BOOK_LEVELS);
+    books_.assign(depth_levels_ > 0 ? num_symbols_ : 0, OrderBook{});
+}
+
+const OrderBook& TickGenerator::get_order_book(uint16_t symbol_id) const {
+    static const OrderBook empty{};
+    if (symbol_id >= books_.size()) return empty;
+    return books_[symbol_id];
+}
+
 void TickGenerator::set_market_condition(MarketCondition condition) {
     market_condition_ = condition;
     
@@ -0,0 +1,139 @@
+#include "udp_publisher.h"
+
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+
+namespace mdf {
+
+UdpPublisher::UdpPublisher()
+    : retained_(new RetainedMessage[RETRANSMIT_DEPTH]) {
+    for (size_t i = 0; i < RETRANSMIT_DEPTH; ++i) {
+        retained_[i].size = 0;
+    }
+}
+
+UdpPublisher::~UdpPublisher() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool UdpPublisher::open_socket() {
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        last_error_ = "Failed to create UDP socket: " + std::string(strerror(errno));
+        return false;
+    }
+
+    // Non-blocking: a full send buffer drops the datagram, like the wire would
+    int flags = fcntl(fd_, F_GETFL, 0);
+    fcntl(fd_, F_SETFL, flags | O_NONBLOCK);
+
+    int sendbuf = 4 * 1024 * 1024;
+    setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &sendbuf, sizeof(sendbuf));
+    return true;
+}
+
+bool UdpPublisher::add_destination(const std::string& address, uint16_t port,
+                                   const std::string& interface_addr) {
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &dest.sin_addr) != 1) {
+        last_error_ = "Invalid UDP address: " + address;
+        return false;
+    }
+
+    bool is_group = IN_MULTICAST(ntohl(dest.sin_addr.s_addr));
+    if (!destinations_.empty() && (is_group || multicast_)) {
+        last_error_ = "A multicast group can't be combined with other destinations";
+        return false;
+    }
+
+    if (!open_socket()) {
+        return false;
+    }
+
+    if (is_group) {
+        in_addr iface{};
+        if (inet_pton(AF_INET, interface_addr.c_str(), &iface) != 1) {
+            last_error_ = "Invalid multicast interface: " + interface_addr;
+            return false;
+        }
+
+        // Loop back so receivers on this host see the group too
+        uint8_t loop = 1;
+        uint8_t ttl = 1;
+        if (setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) < 0 ||
+            setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0 ||
+            setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
+            last_error_ = "Failed to configure multicast: " + std::string(strerror(errno));
+            return false;
+        }
+        multicast_ = true;
+    }
+
+    destinations_.push_back(dest);
+    return true;
+}
+
+void UdpPublisher::publish(const void* msg, size_t len) {
+    if (len > MAX_MSG_SIZE) {
+        return;
+    }
+
+    // Retain for retransmission
+    MessageHeader header;
+    std::memcpy(&header, msg, sizeof(header));
+    RetainedMessage& slot = retained_[header.sequence_number & (RETRANSMIT_DEPTH - 1)];
+    slot.sequence = header.sequence_number;
+    slot.size = static_cast<uint8_t>(len);
+    std::memcpy(slot.data, msg, len);
+
+    if (datagram_size_ + len > MAX_DATAGRAM_SIZE) {
+        flush();
+    }
+    std::memcpy(datagram_ + datagram_size_, msg, len);
+    datagram_size_ += len;
+}
+
+size_t UdpPublisher::flush() {
+    if (datagram_size_ == 0) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    for (const auto& dest : destinations_) {
+        ssize_t n = sendto(fd_, datagram_, datagram_size_, 0,
+                           reinterpret_cast<const sockaddr*>(&dest), sizeof(dest));
+        if (n == static_cast<ssize_t>(datagram_size_)) {
+            bytes_sent_ += n;
+            sent++;
+        } else {
+            send_errors_++;  // Receivers see a gap and recover over TCP
+        }
+    }
+
+    datagrams_sent_ += sent;
+    datagram_size_ = 0;
+    return sent;
+}
+
+size_t UdpPublisher::lookup(uint32_t sequence, uint8_t* out) const {
+    const RetainedMessage& slot = retained_[sequence & (RETRANSMIT_DEPTH - 1)];
+    if (slot.size == 0 || slot.sequence != sequence) {
+        return 0;
+    }
+    std::memcpy(out, slot.data, slot.size);
+    return slot.size;
+}
+
+} // namespace mdf
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "../include/analytics.h"
+
+using namespace mdf;
+
+static constexpr uint64_t SEC = 1000000000ULL;
+
+void test_vwap_and_quotes() {
+    std::cout << "Testing VWAP, mid and spread... ";
+
+    AnalyticsEngine engine(10);
+    Analytics a = engine.get(3);
+    assert(a.vwap == 0.0 && a.volume == 0 && a.second_bar.start_ns == 0);
+
+    engine.on_trade(3, 100.0, 100, 1 * SEC);
+    engine.on_trade(3, 102.0, 300, 1 * SEC + 1);
+    engine.on_quote(3, 101.90, 102.10);
+
+    a = engine.get(3);
+    assert(a.trades == 2);
+    assert(a.volume == 400);
+    assert(std::abs(a.vwap - 101.5) < 1e-9);
+    assert(std::abs(a.mid - 102.0) < 1e-9);
+    assert(std::abs(a.spread - 0.20) < 1e-9);
+
+    // Other symbols and out-of-range ids untouched
+    assert(engine.get(4).trades == 0);
+    engine.on_trade(10, 100.0, 1, 0);
+    assert(engine.get(10).trades == 0);
+
+    engine.reset();
+    assert(engine.get(3).volume == 0);
+    assert(engine.get_bars(3, BarInterval::Second, nullptr, 0) == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_volatility() {
+    std::cout << "Testing EWMA volatility... ";
+
+    AnalyticsEngine engine(1);
+    engine.on_trade(0, 100.0, 1, 0);
+    assert(engine.get(0).volatility == 0.0);   // No return yet
+
+    // Constant price: stays 0
+    engine.on_trade(0, 100.0, 1, 1);
+    assert(engine.get(0).volatility == 0.0);
+
+    // One 1% move: variance = (1 - lambda) * 0.01^2
+    engine.on_trade(0, 101.0, 1, 2);
+    double expected = std::sqrt((1.0 - AnalyticsEngine::VOLATILITY_DECAY) * 1e-4);
+    assert(std::abs(engine.get(0).volatility - expected) < 1e-12);
+
+    // Decays once prices settle: std dev scales by sqrt(lambda) per trade
+    double before = engine.get(0).volatility;
+    for (int i = 0; i < 50; ++i) engine.on_trade(0, 101.0, 1, 3 + i);
+    assert(engine.get(0).volatility < before * 0.25);
+
+    std::cout << "PASSED\n";
+}
+
+void test_bars() {
+    std::cout << "Testing OHLCV bars... ";
+
+    AnalyticsEngine engine(2, 4);
+
+    // Second 10: 100, 105, 95, 101
+    engine.on_trade(1, 100.0, 10, 10 * SEC + 1);
+    engine.on_trade(1, 105.0, 20, 10 * SEC + 2);
+    engine.on_trade(1, 95.0, 30, 10 * SEC + 3);
+    engine.on_trade(1, 101.0, 40, 10 * SEC + 999999999);
+
+    Analytics a = engine.get(1);
+    assert(a.second_bar.start_ns == 10 * SEC);
+    assert(a.second_bar.open == 100.0 && a.second_bar.high == 105.0);
+    assert(a.second_bar.low == 95.0 && a.second_bar.close == 101.0);
+    assert(a.second_bar.volume == 100 && a.second_bar.trades == 4);
+
+    // Second 12 (11 had no trades, so leaves no bar)
+    engine.on_trade(1, 102.0, 5, 12 * SEC);
+
+    Bar bars[8];
+    size_t n = engine.get_bars(1, BarInterval::Second, bars, 8);
+    assert(n == 2);
+    assert(bars[0].start_ns == 12 * SEC && bars[0].open == 102.0 && bars[0].volume == 5);
+    assert(bars[1].start_ns == 10 * SEC && bars[1].close == 101.0);
+
+    // Late trade folds into the bar in progress
+    engine.on_trade(1, 90.0, 1, 11 * SEC);
+    n = engine.get_bars(1, BarInterval::Second, bars, 8);
+    assert(n == 2 && bars[0].low == 90.0 && bars[0].trades == 2);
+
+    // All of it lands in one minute bar
+    n = engine.get_bars(1, BarInterval::Minute, bars, 8);
+    assert(n == 1);
+    assert(bars[0].start_ns == 0 && bars[0].open == 100.0 && bars[0].low == 90.0);
+    assert(bars[0].volume == 106 && bars[0].trades == 6);
+
+    // Ring keeps the newest 4
+    for (uint64_t s = 20; s < 30; ++s) {
+        engine.on_trade(1, static_cast<double>(s), 1, s * SEC);
+    }
+    n = engine.get_bars(1, BarInterval::Second, bars, 8);
+    assert(n == 4);
+    for (size_t i = 0; i < n; ++i) {
+        assert(bars[i].start_ns == (29 - i) * SEC);
+        assert(bars[i].open == static_cast<double>(29 - i));
+    }
+    assert(engine.get_bars(1, BarInterval::Second, bars, 2) == 2);
+
+    std::cout << "PASSED\n";
+}
+
+void test_concurrent_read() {
+    std::cout << "Testing concurrent analytics reads... ";
+
+    // Each trade has price == quantity == i, so a consistent read has
+    // vwap == sum(i^2) / sum(i) and a bar whose close is its trade count
+    auto engine = std::make_unique<AnalyticsEngine>(1);
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= 200000; ++i) {
+            engine->on_trade(0, static_cast<double>(i), i, 0);
+        }
+        done.store(true);
+    });
+
+    bool inconsistent = false;
+    uint64_t reads = 0;
+    while (!done.load() || reads == 0) {
+        Analytics a = engine->get(0);
+        reads++;
+        uint64_t n = a.trades;
+        if (n == 0) continue;
+        double sum = n * (n + 1) / 2.0;
+        double sum_sq = n * (n + 1) * (2.0 * n + 1) / 6.0;
+        if (a.volume != static_cast<uint64_t>(sum) ||
+            std::abs(a.vwap - sum_sq / sum) > 1e-6 * a.vwap ||
+            a.second_bar.trades != n || a.second_bar.close != static_cast<double>(n)) {
+            inconsistent = true;
+        }
+    }
+    writer.join();
+    assert(!inconsistent);
+
+    std::cout << "PASSED (reads: " << reads << ")\n";
+}
+
+int main() {
+    std::cout << "=== Analytics Tests ===\n";
+
+    test_vwap_and_quotes();
+    test_volatility();
+    test_bars();
+    test_concurrent_read();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -2,6 +2,9 @@
 #include <cassert>
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <cmath>
+#include <vector>
 #include "../include/cache.h"
 
 using namespace mdf;
@@ -120,6 +123,11 @@ void test_concurrent_read() {
         }
     });
     
+    // Wait for the first write (the writer may not have run yet on one core)
+    while (cache.get_snapshot(0).update_count == 0) {
+        std::this_thread::yield();
+    }
+    
     // Reader checks consistency
     int read_count = 0;
     bool inconsistent = false;
@@ -145,6 +153,334 @@ void test_concurrent_read() {
     std::cout << "PASSED (reads: " << read_count << ")\n";
 }
 
+void test_consistent_snapshot() {
+    std::cout << "Testing cross-symbol snapshot... ";
+    
+    SymbolCache cache(10);
+    CacheSnapshot snap;
+    bool published = cache.read_snapshot(snap);
+    assert(!published);  // Nothing published yet
+    
+    // Each round sets every symbol to the same price, then publishes
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        for (int round = 1; !stop.load() && round <= 20000; ++round) {
+            for (uint16_t s = 0; s < 10; ++s) {
+                cache.update_trade(s, round, 1, round);
+            }
+            cache.publish_snapshot();
+        }
+    });
+    
+    // Every snapshot must come from a single round
+    auto snapshot = std::make_unique<CacheSnapshot>();
+    uint64_t last_epoch = 0;
+    int reads = 0;
+    bool inconsistent = false;
+    while (reads < 5000) {
+        if (!cache.read_snapshot(*snapshot)) continue;
+        double price = snapshot->states[0].last_traded_price;
+        for (size_t s = 1; s < snapshot->num_symbols; ++s) {
+            inconsistent |= snapshot->states[s].last_traded_price != price;
+        }
+        inconsistent |= snapshot->total_updates != static_cast<uint64_t>(price) * 10;
+        inconsistent |= snapshot->epoch < last_epoch;
+        last_epoch = snapshot->epoch;
+        reads++;
+    }
+    
+    stop.store(true);
+    writer.join();
+    
+    assert(!inconsistent);
+    assert(snapshot->num_symbols == 10);
+    
+    std::cout << "PASSED (reads: " << reads << ")\n";
+}
+
+void test_compact_layouts() {
+    std::cout << "Testing compact layouts... ";
+    
+    auto apply = [](SymbolCache& cache) {
+        cache.update_quote(5, 100.05, 100, 100.10, 200, 1);
+        cache.update_trade(5, 100.07, 10, 2);
+        cache.update_bid(5, 100.00, 50, 3);
+        cache.update_ask(6, 99.95, 70, 4);   // No opening price from one side
+        cache.update_trade(6, 99.90, 5, 5);
+    };
+    
+    auto wide = std::make_unique<SymbolCache>(10, CacheLayout::Wide);
+    apply(*wide);
+    
+    for (CacheLayout layout : {CacheLayout::Compact, CacheLayout::CompactFixed}) {
+        auto cache = std::make_unique<SymbolCache>(10, layout);
+        assert(cache->layout() == layout);
+        int reader = cache->register_change_reader();
+        apply(*cache);
+        
+        for (uint16_t s : {5, 6, 7}) {
+            MarketState a = wide->get_snapshot(s);
+            MarketState b = cache->get_snapshot(s);
+            assert(std::abs(a.best_bid - b.best_bid) < 1e-9);
+            assert(std::abs(a.best_ask - b.best_ask) < 1e-9);
+            assert(std::abs(a.last_traded_price - b.last_traded_price) < 1e-9);
+            assert(std::abs(a.opening_price - b.opening_price) < 1e-9);
+            assert(a.bid_quantity == b.bid_quantity && a.ask_quantity == b.ask_quantity);
+            assert(a.last_traded_quantity == b.last_traded_quantity);
+            assert(a.last_update_time == b.last_update_time);
+            assert(a.update_count == b.update_count);
+        }
+        assert(std::abs(cache->get_snapshot(6).opening_price - 99.90) < 1e-9);
+        assert(cache->get_total_updates() == 5);
+        
+        uint16_t ids[MAX_SYMBOLS];
+        size_t changed = cache->poll_changes(reader, ids, MAX_SYMBOLS);
+        assert(changed == 2);
+        
+        auto snap = std::make_unique<CacheSnapshot>();
+        cache->publish_snapshot();
+        bool published = cache->read_snapshot(*snap);
+        assert(published);
+        assert(snap->states[5].update_count == 3);
+        assert(std::abs(snap->states[5].opening_price - 100.075) < 1e-9);
+        
+        cache->reset();
+        assert(cache->get_snapshot(5).update_count == 0);
+        assert(cache->get_snapshot(5).opening_price == 0.0);
+        cache->update_trade(5, 101.0, 1, 6);
+        assert(cache->get_snapshot(5).opening_price == 101.0);
+    }
+    
+    // SeqLock still gives consistent reads
+    for (CacheLayout layout : {CacheLayout::Compact, CacheLayout::CompactFixed}) {
+        SymbolCache cache(1, layout);
+        std::atomic<bool> stop{false};
+        std::thread writer([&]() {
+            double price = 100.0;
+            for (int i = 0; !stop.load() && i < 100000; ++i) {
+                price += 0.01;
+                cache.update_quote(0, price - 0.1, 1000, price + 0.1, 2000, i);
+            }
+        });
+        while (cache.get_snapshot(0).update_count == 0) {
+            std::this_thread::yield();
+        }
+        bool inconsistent = false;
+        for (int i = 0; i < 10000; ++i) {
+            MarketState state = cache.get_snapshot(0);
+            double spread = state.best_ask - state.best_bid;
+            inconsistent |= spread < 0.19 || spread > 0.21;
+        }
+        stop.store(true);
+        writer.join();
+        assert(!inconsistent);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+void test_multi_writer() {
+    std::cout << "Testing multi-writer modes... ";
+    
+    constexpr int WRITERS = 4;
+    constexpr int UPDATES = 300000;
+    constexpr uint16_t SYMBOLS = 8;
+    
+    for (WriterMode mode : {WriterMode::Partitioned, WriterMode::Shared}) {
+        for (CacheLayout layout : {CacheLayout::Wide, CacheLayout::Compact}) {
+            auto cache = std::make_unique<SymbolCache>(SYMBOLS, layout);
+            cache->set_writer_mode(mode);
+            
+            // Partitioned: writer w owns symbols s % WRITERS == w
+            // Shared: every writer updates every symbol
+            std::atomic<bool> stop{false};
+            std::vector<std::thread> writers;
+            for (int w = 0; w < WRITERS; ++w) {
+                writers.emplace_back([&, w]() {
+                    for (int i = 0; i < UPDATES; ++i) {
+                        uint16_t s = mode == WriterMode::Shared
+                                         ? static_cast<uint16_t>(i % SYMBOLS)
+                                         : static_cast<uint16_t>((i * WRITERS + w) % SYMBOLS);
+                        double bid = 100.0 + w * 10 + (i % 100) * 0.05;
+                        cache->update_quote(s, bid, w + 1, bid + 0.2, (w + 1) * 2, i);
+                    }
+                });
+            }
+            
+            // Readers must never see a mix of two writers' quotes
+            bool inconsistent = false;
+            int reads = 0;
+            std::thread reader([&]() {
+                while (!stop.load()) {
+                    MarketState state = cache->get_snapshot(static_cast<uint16_t>(reads % SYMBOLS));
+                    if (state.update_count > 0) {
+                        double spread = state.best_ask - state.best_bid;
+                        inconsistent |= spread < 0.19 || spread > 0.21;
+                        inconsistent |= state.ask_quantity != state.bid_quantity * 2;
+                    }
+                    reads++;
+                }
+            });
+            
+            for (auto& t : writers) t.join();
+            stop.store(true);
+            reader.join();
+            assert(!inconsistent);
+            
+            // No update lost
+            uint64_t sum = 0;
+            for (uint16_t s = 0; s < SYMBOLS; ++s) {
+                sum += cache->get_snapshot(s).update_count;
+            }
+            assert(sum == static_cast<uint64_t>(WRITERS) * UPDATES);
+            assert(cache->get_total_updates() == sum);
+            
+            auto snap = std::make_unique<CacheSnapshot>();
+            cache->publish_snapshot();
+            bool published = cache->read_snapshot(*snap);
+            assert(published);
+            assert(snap->total_updates == sum);
+        }
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+void test_change_notification() {
+    std::cout << "Testing change notification... ";
+    
+    auto cache = std::make_unique<SymbolCache>();
+    uint16_t ids[MAX_SYMBOLS];
+    
+    // Updates before registering aren't reported
+    cache->update_quote(1, 100.0, 100, 100.05, 100, 1);
+    int a = cache->register_change_reader();
+    int b = cache->register_change_reader();
+    assert(a >= 0 && b >= 0 && a != b);
+    size_t n = cache->poll_changes(a, ids, MAX_SYMBOLS);
+    assert(n == 0);
+    
+    cache->update_quote(70, 100.0, 100, 100.05, 100, 2);
+    cache->update_trade(3, 100.0, 10, 3);
+    cache->update_quote(3, 100.0, 100, 100.05, 100, 4);
+    
+    // Each symbol once, ascending
+    n = cache->poll_changes(a, ids, MAX_SYMBOLS);
+    assert(n == 2);
+    assert(ids[0] == 3 && ids[1] == 70);
+    n = cache->poll_changes(a, ids, MAX_SYMBOLS);
+    assert(n == 0);
+    
+    // Readers have independent cursors
+    cache->update_trade(499, 100.0, 10, 5);
+    n = cache->poll_changes(b, ids, MAX_SYMBOLS);
+    assert(n == 3);
+    assert(ids[0] == 3 && ids[1] == 70 && ids[2] == 499);
+    n = cache->poll_changes(a, ids, MAX_SYMBOLS);
+    assert(n == 1 && ids[0] == 499);
+    
+    // Changes that don't fit stay pending
+    for (uint16_t s = 0; s < 10; ++s) {
+        cache->update_trade(s * 50, 100.0, 10, s);
+    }
+    n = cache->poll_changes(a, ids, 4);
+    assert(n == 4);
+    assert(ids[3] == 150);
+    n = cache->poll_changes(a, ids, MAX_SYMBOLS);
+    assert(n == 6);
+    assert(ids[0] == 200 && ids[5] == 450);
+    
+    // Slots are reused after unregistering
+    cache->unregister_change_reader(b);
+    for (size_t i = 1; i < SymbolCache::MAX_CHANGE_READERS; ++i) {
+        int id = cache->register_change_reader();
+        assert(id >= 0);
+    }
+    int full = cache->register_change_reader();
+    assert(full == -1);
+    
+    std::cout << "PASSED\n";
+}
+
+void test_change_wakeup() {
+    std::cout << "Testing change wakeup... ";
+    
+    auto cache = std::make_unique<SymbolCache>();
+    int reader = cache->register_change_reader(true);
+    assert(reader >= 0);
+    assert(cache->change_fd(reader) >= 0);
+    
+    // Nothing pending: times out
+    bool woke = cache->wait_for_changes(reader, 10);
+    assert(!woke);
+    
+    std::thread writer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        cache->update_trade(42, 100.0, 10, 1);
+    });
+    
+    woke = cache->wait_for_changes(reader, 2000);
+    writer.join();
+    assert(woke);
+    
+    uint16_t ids[MAX_SYMBOLS];
+    size_t n = cache->poll_changes(reader, ids, MAX_SYMBOLS);
+    assert(n == 1 && ids[0] == 42);
+    woke = cache->wait_for_changes(reader, 10);
+    assert(!woke);
+    
+    // A change after the poll re-arms the wakeup
+    cache->update_trade(7, 100.0, 10, 2);
+    woke = cache->wait_for_changes(reader, 0);
+    assert(woke);
+    
+    std::cout << "PASSED\n";
+}
+
+void test_large_capacity() {
+    std::cout << "Testing runtime symbol capacity... ";
+    
+    // Above the default universe; past 256KB the table moves to hugepages
+    // when the system allows, otherwise it must still be ordinary memory
+    constexpr size_t SYMBOLS = 50000;
+    for (CacheLayout layout : {CacheLayout::Wide, CacheLayout::Compact}) {
+        auto cache = std::make_unique<SymbolCache>(SYMBOLS, layout);
+        assert(cache->num_symbols() == SYMBOLS);
+        assert(cache->backing() != HugePageBuffer::Backing::None);
+        
+        int reader = cache->register_change_reader();
+        for (uint16_t s = 0; s < SYMBOLS; s += 7) {
+            cache->update_quote(s, 100.0 + s, 100, 100.5 + s, 200, s);
+        }
+        
+        MarketState last = cache->get_snapshot(SYMBOLS - 1);
+        assert(last.update_count == ((SYMBOLS - 1) % 7 == 0 ? 1u : 0u));
+        MarketState state = cache->get_snapshot(49994);
+        assert(state.update_count == 1);
+        assert(std::abs(state.best_bid - 50094.0) < 0.01);
+        
+        std::vector<uint16_t> ids(SYMBOLS);
+        size_t n = cache->poll_changes(reader, ids.data(), ids.size());
+        assert(n == (SYMBOLS + 6) / 7);
+        assert(ids[n - 1] == 49994);
+        
+        auto snap = std::make_unique<CacheSnapshot>();
+        cache->publish_snapshot();
+        bool published = cache->read_snapshot(*snap);
+        assert(published);
+        assert(snap->num_symbols == SYMBOLS);
+        assert(snap->states.size() >= SYMBOLS);
+        assert(snap->total_updates == n);
+        assert(snap->states[49994].update_count == 1);
+    }
+    
+    // Requests beyond the id space are clamped
+    SymbolCache clamped(100000);
+    assert(clamped.num_symbols() == MAX_SYMBOL_CAPACITY);
+    
+    std::cout << "PASSED\n";
+}
+
 int main() {
     std::cout << "=== Symbol Cache Tests ===\n";
     
@@ -153,6 +489,12 @@ int main() {
     test_total_updates();
     test_top_symbols();
     test_concurrent_read();
+    test_consistent_snapshot();
+    test_compact_layouts();
+    test_multi_writer();
+    test_change_notification();
+    test_change_wakeup();
+    test_large_capacity();
     
     std::cout << "\nAll tests passed!\n";
     return 0;
@@ -0,0 +1,211 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/client_manager.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+
+// Read everything currently queued on fd into the parser
+static void drain_socket(int fd, MessageParser& parser) {
+    uint8_t buffer[4096];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+        parser.append_data(buffer, n);
+        parser.parse_messages();
+    }
+}
+
+void test_slow_client_dropped() {
+    std::cout << "Testing slow client without conflation... ";
+
+    int fds[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+
+    ClientManager mgr;
+    mgr.add_client(fds[0], "local", 0);
+    mgr.mark_slow_consumer(fds[0]);
+
+    TickGenerator gen(10);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (int i = 0; i < 100; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        size_t delivered = mgr.broadcast(buffer, size, symbol_id);
+        assert(delivered == 0);
+    }
+    assert(mgr.dropped_messages() == 100);
+
+    // Socket is empty, so the client recovers but has nothing to catch up on
+    size_t sent = mgr.drain_slow_clients();
+    assert(sent == 0);
+    assert(!mgr.is_slow(fds[0]));
+
+    mgr.remove_client(fds[0]);
+    close(fds[1]);
+    std::cout << "PASSED\n";
+}
+
+void test_conflation_latest_value() {
+    std::cout << "Testing conflation keeps latest value... ";
+
+    int fds[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+
+    ClientManager mgr;
+    mgr.set_conflation(true);
+    mgr.add_client(fds[0], "local", 0);
+    mgr.mark_slow_consumer(fds[0]);
+
+    // Track the newest quote/trade per symbol the server produced
+    TickGenerator gen(10);
+    gen.set_depth_levels(5);
+    std::vector<uint32_t> latest(10, 0);
+    size_t depth = 0;
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (int i = 0; i < 1000; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        MessageHeader header;
+        std::memcpy(&header, buffer, sizeof(header));
+        if (header.message_type == static_cast<uint16_t>(MessageType::DEPTH_UPDATE)) {
+            depth++;
+        } else {
+            latest[symbol_id] = header.sequence_number;
+        }
+        mgr.broadcast(buffer, size, symbol_id);
+    }
+    assert(mgr.dropped_messages() == depth);
+
+    size_t sent = mgr.drain_slow_clients();
+    assert(sent > 0 && sent <= 20);
+    assert(mgr.conflated_messages() + sent + depth == 1000);
+
+    std::vector<uint32_t> seen(10, 0);
+    uint32_t last_seq = 0;
+    MessageParser parser;
+    auto on_message = [&](const MessageHeader& h) {
+        assert(h.sequence_number > last_seq);  // Delivered in sequence order
+        last_seq = h.sequence_number;
+        seen[h.symbol_id] = std::max(seen[h.symbol_id], h.sequence_number);
+    };
+    parser.set_trade_callback([&](const MessageHeader& h, const TradePayload&) { on_message(h); });
+    parser.set_quote_callback([&](const MessageHeader& h, const QuotePayload&) { on_message(h); });
+    drain_socket(fds[1], parser);
+
+    assert(parser.checksum_errors() == 0);
+    assert(seen == latest);
+
+    // Nothing left dirty
+    sent = mgr.drain_slow_clients();
+    assert(sent == 0);
+
+    mgr.remove_client(fds[0]);
+    close(fds[1]);
+    std::cout << "PASSED\n";
+}
+
+// Eight socket pairs; every client but the ones removed reads what it
+// subscribed to, whichever slot it ends up in
+void test_slot_table() {
+    std::cout << "Testing slot table across removals... ";
+
+    constexpr int CLIENTS = 8;
+    int fds[CLIENTS][2];
+    ClientManager mgr(200);
+    for (int i = 0; i < CLIENTS; ++i) {
+        int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds[i]);
+        assert(rc == 0);
+        bool added = mgr.add_client(fds[i][0], "local", 0);
+        assert(added);
+    }
+    bool added = mgr.add_client(fds[3][0], "local", 0);
+    assert(!added);
+    assert(mgr.client_count() == CLIENTS);
+
+    // Client i subscribes to symbol i and to 100 + i; ids past
+    // num_symbols are ignored
+    for (int i = 0; i < CLIENTS; ++i) {
+        uint16_t symbols[] = {static_cast<uint16_t>(i), static_cast<uint16_t>(100 + i), 60000};
+        bool subscribed = mgr.handle_subscription(fds[i][0], symbols, 3);
+        assert(subscribed);
+    }
+    mgr.set_line(fds[7][0], 1);
+
+    // Removing the first and a middle client moves later slots down
+    mgr.remove_client(fds[0][0]);
+    mgr.remove_client(fds[4][0]);
+    close(fds[0][1]);
+    close(fds[4][1]);
+    assert(mgr.client_count() == CLIENTS - 2);
+    assert(!mgr.has_client(fds[0][0]) && !mgr.has_client(fds[4][0]));
+    assert(mgr.get_client(fds[5][0])->fd == fds[5][0]);
+    assert(mgr.get_all_client_fds().size() == CLIENTS - 2);
+
+    TickGenerator gen(200);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    gen.generate_tick(buffer, size, symbol_id);
+    for (uint16_t symbol = 0; symbol < 200; ++symbol) {
+        size_t expected = 0;
+        for (int i = 1; i < CLIENTS - 1; ++i) {
+            expected += i != 4 && (symbol == i || symbol == 100 + i);
+        }
+        size_t delivered = mgr.broadcast(buffer, size, symbol, nullptr, 0, 0);
+        assert(delivered == expected);
+    }
+    size_t delivered = mgr.broadcast(buffer, size, 107, nullptr, 0, 1);
+    assert(delivered == 1);
+    delivered = mgr.broadcast(buffer, size, 60000);
+    assert(delivered == 0);
+
+    for (int i = 1; i < CLIENTS; ++i) {
+        if (i == 4) continue;
+        size_t messages = i == CLIENTS - 1 ? 1 : 2;   // Line 1 saw only 107
+        assert(mgr.client_messages_sent(fds[i][0]) == messages);
+        assert(mgr.client_bytes_sent(fds[i][0]) == messages * size);
+        uint8_t received[2 * MAX_MSG_SIZE];
+        ssize_t n = recv(fds[i][1], received, sizeof(received), MSG_DONTWAIT);
+        assert(n == static_cast<ssize_t>(messages * size));
+    }
+
+    // A new client takes the next slot with default state
+    int extra[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, extra);
+    assert(rc == 0);
+    added = mgr.add_client(extra[0], "local", 0);
+    assert(added);
+    assert(mgr.client_messages_sent(extra[0]) == 0 && !mgr.is_slow(extra[0]));
+    delivered = mgr.broadcast(buffer, size, 150, nullptr, 0, 0);
+    assert(delivered == 1);
+
+    mgr.remove_client(extra[0]);
+    close(extra[1]);
+    for (int i = 1; i < CLIENTS; ++i) {
+        if (i == 4) continue;
+        mgr.remove_client(fds[i][0]);
+        close(fds[i][1]);
+    }
+    assert(mgr.client_count() == 0);
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Client Manager Tests ===\n";
+
+    test_slow_client_dropped();
+    test_conflation_latest_value();
+    test_slot_table();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
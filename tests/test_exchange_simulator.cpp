@@ -0,0 +1,249 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/alloc_counter.h"
+#include "../include/exchange_simulator.h"
+#include "../include/parser.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    int rc = connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    assert(rc == 0);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+// Subscription to the first count even symbols (0 = all)
+static std::vector<uint8_t> subscription(uint8_t version, uint16_t count) {
+    std::vector<uint8_t> request{SUBSCRIBE_V2_CMD, version};
+    request.push_back(static_cast<uint8_t>(count));
+    request.push_back(static_cast<uint8_t>(count >> 8));
+    for (uint16_t i = 0; i < count; ++i) {
+        uint16_t symbol = static_cast<uint16_t>(i * 2);
+        request.push_back(static_cast<uint8_t>(symbol));
+        request.push_back(static_cast<uint8_t>(symbol >> 8));
+    }
+    return request;
+}
+
+static void send_request(int fd, const std::vector<uint8_t>& request) {
+    ssize_t n = send(fd, request.data(), request.size(), 0);
+    assert(n == static_cast<ssize_t>(request.size()));
+}
+
+static void fail_on_allocation(std::size_t size) {
+    std::fprintf(stderr, "\nheap allocation of %zu bytes in steady state\n", size);
+    std::abort();
+}
+
+struct Client {
+    int fd = -1;
+    MessageParser parser;
+    uint64_t bytes = 0;
+    uint64_t heartbeats = 0;
+};
+
+// Read every client for the given time, the way a feed handler would
+static void pump(std::vector<Client>& clients, std::chrono::milliseconds duration) {
+    static uint8_t block[64 * 1024];
+    auto end = Clock::now() + duration;
+    while (Clock::now() < end) {
+        for (Client& c : clients) {
+            ssize_t n;
+            while ((n = recv(c.fd, block, sizeof(block), 0)) > 0) {
+                c.bytes += static_cast<uint64_t>(n);
+                c.parser.parse_buffer(block, static_cast<size_t>(n));
+            }
+        }
+        usleep(200);
+    }
+}
+
+// Four clients: one on everything, one subscribed to 50 symbols, one on
+// protocol v2, one that never reads. After warm-up, ticks, heartbeats,
+// a resubscription and the backed-up client's queue must not touch the
+// heap on any thread.
+static void run_steady_state(ExchangeSimulator& sim) {
+    sim.set_tick_rate(20000);
+    sim.start();
+    assert(sim.port() != 0);
+    std::thread runner([&sim]() { sim.run(); });
+
+    std::vector<Client> clients(3);
+    for (Client& c : clients) {
+        c.fd = connect_client(sim.port());
+        c.parser.set_heartbeat_callback([&c](const MessageHeader&) { c.heartbeats++; });
+    }
+    send_request(clients[1].fd, subscription(PROTOCOL_V1, 50));
+    send_request(clients[2].fd, subscription(PROTOCOL_V2, 0));
+    int stalled = connect_client(sim.port());
+    std::vector<uint8_t> resubscribe = subscription(PROTOCOL_V1, 80);
+
+    pump(clients, std::chrono::milliseconds(1200));   // Warm up, past a heartbeat
+    uint64_t bytes_before[3] = {clients[0].bytes, clients[1].bytes, clients[2].bytes};
+    uint64_t heartbeats_before = clients[0].heartbeats;
+
+    AllocationCounts before = process_allocations();
+    set_allocation_hook(fail_on_allocation);
+    pump(clients, std::chrono::milliseconds(700));
+    send_request(clients[1].fd, resubscribe);
+    pump(clients, std::chrono::milliseconds(800));
+    set_allocation_hook(nullptr);
+    AllocationCounts after = process_allocations();
+
+    sim.stop();
+    runner.join();
+
+    assert(after.allocations == before.allocations);
+    assert(clients[0].bytes - bytes_before[0] > 100000);
+    assert(clients[0].heartbeats > heartbeats_before);
+    assert(clients[1].bytes > bytes_before[1] && clients[2].bytes > bytes_before[2]);
+    for (Client& c : clients) {
+        assert(c.parser.checksum_errors() == 0);
+        close(c.fd);
+    }
+    close(stalled);
+}
+
+void test_steady_state() {
+    std::cout << "Testing simulator steady state makes no heap allocations... ";
+
+    ExchangeSimulator sim(0, 100);
+    run_steady_state(sim);
+
+    std::cout << "PASSED\n";
+}
+
+void test_steady_state_delayed_line() {
+    std::cout << "Testing delayed, lossy line makes no heap allocations... ";
+
+    ExchangeSimulator sim(0, 100);
+    LineFaults faults;
+    faults.drop_rate = 0.01;
+    faults.delay_us = 2000;
+    sim.set_line_faults(0, faults);
+    run_steady_state(sim);
+    assert(sim.line_dropped(0) > 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_steady_state_workers() {
+    std::cout << "Testing worker mode makes no heap allocations... ";
+
+    ExchangeSimulator sim(0, 100);
+    bool ok = sim.set_workers(2);
+    assert(ok && sim.worker_count() == 2);
+    run_steady_state(sim);
+    assert(sim.ring_overruns() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+// Clients spread over three SO_REUSEPORT listeners all read the one
+// tick stream: same sequence numbers, in order, nothing lost
+void test_workers_share_stream() {
+    std::cout << "Testing workers fan out one sequenced stream... ";
+
+    constexpr size_t CLIENTS = 9;
+    ExchangeSimulator sim(0, 100);
+    bool ok = sim.set_workers(3);
+    assert(ok && sim.worker_count() == 3);
+    sim.set_tick_rate(20000);
+    sim.start();
+    assert(sim.port() != 0);
+    std::thread runner([&sim]() { sim.run(); });
+
+    std::vector<Client> clients(CLIENTS);
+    std::vector<uint32_t> first_seq(CLIENTS, 0), last_seq(CLIENTS, 0);
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        clients[i].fd = connect_client(sim.port());
+        Client& c = clients[i];
+        c.parser.set_heartbeat_callback([&c](const MessageHeader&) { c.heartbeats++; });
+        c.parser.set_quote_callback([&, i](const MessageHeader& h, const QuotePayload&) {
+            if (first_seq[i] == 0) first_seq[i] = h.sequence_number;
+            last_seq[i] = h.sequence_number;
+        });
+    }
+    auto deadline = Clock::now() + std::chrono::seconds(2);
+    while (sim.client_count() < CLIENTS && Clock::now() < deadline) {
+        usleep(1000);
+    }
+    assert(sim.client_count() == CLIENTS);
+
+    pump(clients, std::chrono::milliseconds(2200));   // Past a heartbeat after the last join
+    sim.stop();
+    runner.join();
+    pump(clients, std::chrono::milliseconds(50));   // What was already sent
+
+    // Every client joined the stream once and followed it without a gap
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        assert(clients[i].parser.messages_parsed() > 1000);
+        assert(clients[i].parser.sequence_gaps() == 0);
+        assert(clients[i].parser.checksum_errors() == 0);
+        assert(clients[i].heartbeats > 0);
+        assert(last_seq[i] > first_seq[i]);
+        close(clients[i].fd);
+    }
+    assert(sim.ring_overruns() == 0);
+    assert(sim.messages_sent() > 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_workers_exclusive() {
+    std::cout << "Testing worker mode refuses single-loop features... ";
+
+    ExchangeSimulator lines(0, 10);
+    bool ok = lines.add_line(1);
+    assert(ok);
+    ok = lines.set_workers(2);
+    assert(!ok);
+    ok = lines.set_workers(0);
+    assert(ok);
+
+    ExchangeSimulator udp(0, 10);
+    ok = udp.add_udp_destination("127.0.0.1", 9);
+    assert(ok);
+    ok = udp.set_workers(2);
+    assert(!ok);
+
+    ExchangeSimulator impaired(0, 10);
+    ImpairmentConfig noise;
+    noise.bit_flip = 0.01;
+    impaired.set_impairments(noise);
+    ok = impaired.set_workers(1);
+    assert(!ok);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Exchange Simulator Tests ===\n";
+
+    test_steady_state();
+    test_steady_state_delayed_line();
+    test_steady_state_workers();
+    test_workers_share_stream();
+    test_workers_exclusive();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
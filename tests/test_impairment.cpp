@@ -0,0 +1,246 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/client_manager.h"
+#include "../include/impairment.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+using Clock = std::chrono::steady_clock;
+
+// Everything the last apply() or release() produced, one vector per run
+static std::vector<std::vector<uint8_t>> runs(const Impairer& impairer) {
+    std::vector<std::vector<uint8_t>> out;
+    for (size_t i = 0; i < impairer.run_count(); ++i) {
+        out.emplace_back(impairer.run_data(i), impairer.run_data(i) + impairer.run_size(i));
+    }
+    return out;
+}
+
+static std::vector<uint8_t> bytes(uint8_t first, size_t len) {
+    std::vector<uint8_t> out(len);
+    for (size_t i = 0; i < len; ++i) out[i] = static_cast<uint8_t>(first + i);
+    return out;
+}
+
+void test_each_impairment() {
+    std::cout << "Testing each impairment... ";
+
+    auto now = Clock::now();
+    auto msg = bytes(1, 40);
+
+    ImpairmentConfig config;
+    config.bit_flip = 1.0;
+    Impairer flip(config);
+    Impairer::Action action = flip.apply(msg.data(), msg.size(), now);
+    assert(action == Impairer::Action::Send);
+    auto out = runs(flip);
+    assert(out.size() == 1 && out[0].size() == msg.size());
+    int flipped = 0;
+    for (size_t i = 0; i < msg.size(); ++i) {
+        flipped += __builtin_popcount(out[0][i] ^ msg[i]);
+    }
+    assert(flipped == 1 && flip.stats().bit_flips == 1);
+
+    config = ImpairmentConfig{};
+    config.truncate = 1.0;
+    Impairer truncate(config);
+    truncate.apply(msg.data(), msg.size(), now);
+    out = runs(truncate);
+    assert(out.size() == 1 && out[0].size() < msg.size() && !out[0].empty());
+    assert(std::memcmp(out[0].data(), msg.data(), out[0].size()) == 0);
+
+    config = ImpairmentConfig{};
+    config.duplicate = 1.0;
+    Impairer dup(config);
+    dup.apply(msg.data(), msg.size(), now);
+    assert(runs(dup) == (std::vector<std::vector<uint8_t>>{msg, msg}));
+
+    config = ImpairmentConfig{};
+    config.partial_write = 1.0;
+    Impairer partial(config);
+    partial.apply(msg.data(), msg.size(), now);
+    out = runs(partial);
+    assert(out.size() == 2);
+    out[0].insert(out[0].end(), out[1].begin(), out[1].end());
+    assert(out[0] == msg);
+
+    config = ImpairmentConfig{};
+    config.reset = 1.0;
+    Impairer reset(config);
+    action = reset.apply(msg.data(), msg.size(), now);
+    assert(action == Impairer::Action::Reset);
+    assert(reset.run_count() == 0 && reset.stats().resets == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void test_reorder_and_stall() {
+    std::cout << "Testing reorder and stalled flush... ";
+
+    auto now = Clock::now();
+    auto a = bytes(1, 20);
+    auto b = bytes(50, 20);
+    auto c = bytes(100, 20);
+
+    // Held back, then sent behind the next write
+    ImpairmentConfig config;
+    config.reorder = 1.0;
+    config.delay_us = 500;
+    Impairer reorder(config);
+    reorder.apply(a.data(), a.size(), now);
+    assert(reorder.run_count() == 0 && reorder.holding());
+    reorder.apply(b.data(), b.size(), now);
+    assert(runs(reorder) == (std::vector<std::vector<uint8_t>>{b, a}));
+
+    // Nothing behind it: released once delay_us has passed
+    reorder.apply(c.data(), c.size(), now);
+    bool released = reorder.release(now + std::chrono::microseconds(499));
+    assert(!released);
+    released = reorder.release(now + std::chrono::microseconds(500));
+    assert(released);
+    assert(runs(reorder) == (std::vector<std::vector<uint8_t>>{c}));
+    assert(reorder.stats().reordered == 2);
+
+    // A stall queues everything until it ends, then sends one burst
+    config = ImpairmentConfig{};
+    config.delay = 1.0;
+    config.delay_us = 1000;
+    Impairer stall(config);
+    stall.apply(a.data(), a.size(), now);
+    stall.apply(b.data(), b.size(), now + std::chrono::microseconds(10));
+    assert(stall.run_count() == 0);
+    released = stall.release(now + std::chrono::microseconds(999));
+    assert(!released);
+    released = stall.release(now + std::chrono::microseconds(1000));
+    assert(released);
+    auto out = runs(stall);
+    std::vector<uint8_t> burst = a;
+    burst.insert(burst.end(), b.begin(), b.end());
+    assert(out.size() == 1 && out[0] == burst);
+    assert(stall.stats().delays == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void test_seeded_and_parsed() {
+    std::cout << "Testing seeds and spec parsing... ";
+
+    ImpairmentConfig config;
+    bool parsed = parse_impairments("flip=0.1,truncate=0.05,dup=0.1,reorder=0.1,partial=0.2,"
+                                    "delay=0,delay_us=250,reset=0,seed=42", config);
+    assert(parsed);
+    assert(config.bit_flip == 0.1 && config.partial_write == 0.2);
+    assert(config.delay_us == 250 && config.seed == 42);
+    assert(config.enabled());
+    assert(!ImpairmentConfig{}.enabled());
+
+    ImpairmentConfig bad;
+    for (const char* spec : {"flip=2", "flip", "jitter=0.1", "dup=0.1x"}) {
+        parsed = parse_impairments(spec, bad);
+        assert(!parsed);
+    }
+
+    // Same seed, same noise; another seed, other noise
+    auto record = [](const ImpairmentConfig& cfg) {
+        Impairer impairer(cfg);
+        auto now = Clock::now();
+        std::vector<std::vector<uint8_t>> all;
+        for (uint8_t i = 0; i < 200; ++i) {
+            auto msg = bytes(i, 32);
+            impairer.apply(msg.data(), msg.size(), now);
+            auto out = runs(impairer);
+            all.insert(all.end(), out.begin(), out.end());
+        }
+        return all;
+    };
+    auto first = record(config);
+    auto again = record(config);
+    assert(first == again);
+    config.seed = 43;
+    auto other = record(config);
+    assert(first != other);
+
+    std::cout << "PASSED\n";
+}
+
+void test_client_stream() {
+    std::cout << "Testing impaired client stream... ";
+
+    int fds[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+
+    ImpairmentConfig config;
+    config.bit_flip = 0.05;
+    config.partial_write = 0.5;
+    config.seed = 9;
+
+    ClientManager mgr;
+    mgr.set_default_impairments(config);
+    mgr.add_client(fds[0], "local", 0);
+    assert(mgr.impaired_client_count() == 1);
+
+    TickGenerator gen(10);
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    MessageParser parser;
+    const int count = 1000;
+    for (int i = 0; i < count; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        size_t delivered = mgr.broadcast(buffer, size, symbol_id);
+        assert(delivered == 1);
+
+        uint8_t in[4096];
+        ssize_t n;
+        while ((n = recv(fds[1], in, sizeof(in), MSG_DONTWAIT)) > 0) {
+            parser.append_data(in, n);
+        }
+    }
+    parser.parse_messages();
+
+    // Every flipped message fails its checksum; partial writes are harmless
+    ImpairmentStats stats = mgr.impairment_stats();
+    assert(stats.writes == count);
+    assert(stats.bit_flips > 0 && stats.partial_writes > 0);
+    assert(parser.checksum_errors() + parser.malformed_messages() >= stats.bit_flips);
+    assert(parser.messages_parsed() <= count - stats.bit_flips);
+    assert(parser.messages_parsed() + 2 * stats.bit_flips >= count);
+
+    // An injected reset flags the client for the owner to remove
+    ImpairmentConfig reset;
+    reset.reset = 1.0;
+    bool ok = mgr.set_client_impairments(fds[0], reset);
+    assert(ok);
+    ok = mgr.send_to_client(fds[0], buffer, size);
+    assert(!ok);
+    assert(mgr.has_pending_resets());
+    auto resets = mgr.take_pending_resets();
+    assert(resets.size() == 1 && resets[0] == fds[0]);
+    assert(!mgr.has_pending_resets());
+    mgr.remove_client(fds[0]);
+    assert(mgr.impaired_client_count() == 0);
+    assert(mgr.impairment_stats().resets == 1);
+    assert(mgr.impairment_stats().writes == count + 1);
+
+    close(fds[1]);
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Impairment Tests ===\n";
+
+    test_each_impairment();
+    test_reorder_and_stall();
+    test_seeded_and_parsed();
+    test_client_stream();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
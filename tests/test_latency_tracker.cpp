@@ -2,6 +2,7 @@
 #include <cassert>
 #include <thread>
 #include <chrono>
+#include <vector>
 #include "../include/latency_tracker.h"
 
 using namespace mdf;
@@ -0,0 +1,235 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include "../include/line_arbiter.h"
+
+using namespace mdf;
+
+static LineMessage trade(uint32_t seq) {
+    LineMessage msg{};
+    msg.header.message_type = static_cast<uint16_t>(MessageType::TRADE);
+    msg.header.sequence_number = seq;
+    msg.header.symbol_id = 1;
+    msg.kind = MessageKind::Trade;
+    msg.trade.price = 100.0 + seq;
+    msg.trade.quantity = 100;
+    return msg;
+}
+
+// Records what the arbiter delivers, and from which line
+struct Delivered {
+    std::vector<uint32_t> sequences;
+    std::vector<size_t> lines;
+    std::vector<std::pair<uint32_t, uint32_t>> gaps;
+
+    void attach(LineArbiter& arbiter) {
+        arbiter.set_deliver_callback([this](const LineMessage& msg, size_t line) {
+            uint32_t seq = msg.header.sequence_number;  // Packed header: copy out
+            assert(msg.trade.price == 100.0 + seq);
+            sequences.push_back(seq);
+            lines.push_back(line);
+        });
+        arbiter.set_gap_callback([this](uint32_t expected, uint32_t received) {
+            gaps.emplace_back(expected, received);
+        });
+    }
+};
+
+static bool in_order(const std::vector<uint32_t>& sequences, uint32_t first, uint32_t count) {
+    if (sequences.size() != count) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (sequences[i] != first + i) return false;
+    }
+    return true;
+}
+
+void test_dedupe() {
+    std::cout << "Testing duplicate suppression... ";
+
+    LineArbiter arbiter(2);
+    Delivered out;
+    out.attach(arbiter);
+
+    // A leads B by 10us on every message
+    for (uint32_t seq = 1; seq <= 100; ++seq) {
+        arbiter.on_message(0, trade(seq), seq * 1000);
+        arbiter.on_message(1, trade(seq), seq * 1000 + 10000);
+    }
+
+    assert(in_order(out.sequences, 1, 100));
+    for (size_t line : out.lines) assert(line == 0);
+
+    ArbitrationStats stats = arbiter.stats();
+    assert(stats.delivered == 100);
+    assert(stats.duplicates == 100);
+    assert(stats.gap_events == 0 && stats.lost == 0);
+    assert(stats.lines[0].messages == 100 && stats.lines[1].messages == 100);
+    assert(stats.lines[0].wins == 100 && stats.lines[1].wins == 0);
+    assert(stats.lines[0].lead_samples == 100);
+    assert(stats.lines[0].mean_lead_ns() == 10000);
+    assert(stats.lines[0].max_lead_ns == 10000);
+    assert(stats.lines[1].lead_samples == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_gap_filled_by_other_line() {
+    std::cout << "Testing gap filled from the other line... ";
+
+    LineArbiter arbiter(2);
+    Delivered out;
+    out.attach(arbiter);
+
+    // A drops 4-6; B is behind and supplies them
+    for (uint32_t seq = 1; seq <= 10; ++seq) {
+        if (seq < 4 || seq > 6) arbiter.on_message(0, trade(seq), 0);
+    }
+    assert(in_order(out.sequences, 1, 3));
+    assert(arbiter.held() == 4);
+
+    for (uint32_t seq = 1; seq <= 10; ++seq) {
+        arbiter.on_message(1, trade(seq), 0);
+    }
+    assert(in_order(out.sequences, 1, 10));
+    assert(arbiter.held() == 0);
+    assert(out.gaps.empty());
+
+    // 7-10 were held for A, then delivered once 4-6 came in on B
+    assert(out.lines[3] == 1 && out.lines[5] == 1 && out.lines[6] == 0);
+
+    ArbitrationStats stats = arbiter.stats();
+    assert(stats.delivered == 10);
+    assert(stats.duplicates == 7);
+    assert(stats.gap_events == 0);
+    assert(stats.held == 4 && stats.max_held == 4);
+    assert(stats.lines[0].missed == 3 && stats.lines[1].missed == 0);
+    assert(stats.lines[0].wins == 7 && stats.lines[1].wins == 3);
+
+    std::cout << "PASSED\n";
+}
+
+void test_window_overflow() {
+    std::cout << "Testing gap declared on window overflow... ";
+
+    LineArbiter arbiter(2, 8);
+    Delivered out;
+    out.attach(arbiter);
+
+    arbiter.on_message(0, trade(1), 0);
+
+    // Both lines lose 2-3; 10 is too far ahead to hold behind them
+    for (uint32_t seq = 4; seq <= 9; ++seq) {
+        arbiter.on_message(0, trade(seq), 0);
+    }
+    assert(out.sequences.size() == 1);
+    assert(arbiter.held() == 6);
+
+    arbiter.on_message(0, trade(10), 0);
+    assert(out.gaps.size() == 1);
+    assert(out.gaps[0].first == 2 && out.gaps[0].second == 4);
+    assert(arbiter.held() == 0);
+    assert(out.sequences.size() == 8);
+    assert(in_order(std::vector<uint32_t>(out.sequences.begin() + 1, out.sequences.end()), 4, 7));
+
+    // Later copies of the lost sequences are late duplicates
+    arbiter.on_message(1, trade(2), 0);
+    assert(out.sequences.size() == 8);
+
+    ArbitrationStats stats = arbiter.stats();
+    assert(stats.gap_events == 1 && stats.lost == 2);
+    assert(arbiter.gap_events() == 1);
+    assert(arbiter.next_sequence() == 11);
+
+    // A jump far past the window with nothing held
+    arbiter.on_message(0, trade(1000), 0);
+    assert(out.sequences.back() == 1000);
+    assert(out.gaps.back().first == 11 && out.gaps.back().second == 1000);
+    assert(arbiter.stats().lost == 2 + 989);
+
+    std::cout << "PASSED\n";
+}
+
+void test_hold_timeout() {
+    std::cout << "Testing gap declared on hold timeout... ";
+
+    LineArbiter arbiter(2, 64, 5000);
+    Delivered out;
+    out.attach(arbiter);
+
+    arbiter.on_message(0, trade(1), 0);
+    arbiter.on_message(0, trade(3), 1000);
+    arbiter.on_message(0, trade(5), 2000);
+    arbiter.on_message(0, trade(6), 2000);
+    assert(arbiter.held() == 3);
+
+    // Not yet: B still has time to send 2
+    arbiter.poll(5999);
+    assert(arbiter.held() == 3);
+
+    // Timed out: skip 2, deliver 3, and 4 starts its own wait
+    arbiter.poll(6000);
+    assert(out.gaps.size() == 1 && out.gaps[0].first == 2 && out.gaps[0].second == 3);
+    assert(out.sequences.size() == 2 && out.sequences.back() == 3);
+    assert(arbiter.held() == 2);
+
+    arbiter.poll(10999);
+    assert(arbiter.held() == 2);
+    arbiter.poll(11000);
+    assert(out.gaps.size() == 2 && out.gaps[1].first == 4);
+    assert(in_order(std::vector<uint32_t>(out.sequences.begin() + 2, out.sequences.end()), 5, 2));
+    assert(arbiter.held() == 0);
+
+    ArbitrationStats stats = arbiter.stats();
+    assert(stats.gap_events == 2 && stats.lost == 2);
+    assert(stats.delivered == 4);
+
+    std::cout << "PASSED\n";
+}
+
+void test_interleaved_wins() {
+    std::cout << "Testing per-line wins and lead times... ";
+
+    LineArbiter arbiter(2);
+    Delivered out;
+    out.attach(arbiter);
+
+    // Lines alternate leading: A by 3us on even sequences, B by 7us on odd
+    for (uint32_t seq = 0; seq < 1000; ++seq) {
+        uint64_t t = seq * 100000ULL;
+        if (seq % 2 == 0) {
+            arbiter.on_message(0, trade(seq), t);
+            arbiter.on_message(1, trade(seq), t + 3000);
+        } else {
+            arbiter.on_message(1, trade(seq), t);
+            arbiter.on_message(0, trade(seq), t + 7000);
+        }
+    }
+
+    assert(in_order(out.sequences, 0, 1000));
+    ArbitrationStats stats = arbiter.stats();
+    assert(stats.lines[0].wins == 500 && stats.lines[1].wins == 500);
+    assert(stats.lines[0].mean_lead_ns() == 3000);
+    assert(stats.lines[1].mean_lead_ns() == 7000);
+    assert(stats.duplicates == 1000);
+
+    arbiter.reset();
+    stats = arbiter.stats();
+    assert(stats.delivered == 0 && stats.lines[0].wins == 0);
+    arbiter.on_message(1, trade(5), 0);
+    assert(out.sequences.back() == 5);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Line Arbiter Tests ===\n";
+
+    test_dedupe();
+    test_gap_filled_by_other_line();
+    test_window_overflow();
+    test_hold_timeout();
+    test_interleaved_wins();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
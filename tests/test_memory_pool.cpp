@@ -0,0 +1,236 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include "../include/cpu_affinity.h"
+#include "../include/memory_pool.h"
+
+using namespace mdf;
+
+// Take every block the calling thread can see; they must all be distinct
+static std::vector<void*> drain(MemoryPool& pool) {
+    std::vector<void*> blocks;
+    while (void* block = pool.allocate()) {
+        blocks.push_back(block);
+    }
+    assert(std::set<void*>(blocks.begin(), blocks.end()).size() == blocks.size());
+    return blocks;
+}
+
+void test_basic() {
+    std::cout << "Testing allocate and deallocate... ";
+
+    MemoryPool pool(100, 64, 0);
+    assert(pool.block_size() == 128);   // Rounded to a cache line
+    assert(pool.thread_cache_size() == 0);
+
+    auto blocks = drain(pool);
+    assert(blocks.size() == 64);
+    for (void* block : blocks) {
+        assert(reinterpret_cast<uintptr_t>(block) % MemoryPool::CACHE_LINE_SIZE == 0);
+    }
+    assert(pool.get_allocated_count() == 64 && pool.get_available_count() == 0);
+
+    int foreign;
+    pool.deallocate(&foreign);          // Ignored
+    pool.deallocate(nullptr);
+    void* extra = pool.allocate();
+    assert(extra == nullptr);
+
+    for (void* block : blocks) {
+        pool.deallocate(block);
+    }
+    assert(pool.get_allocated_count() == 0);
+    blocks = drain(pool);
+    assert(blocks.size() == 64);
+
+    pool.reset();
+    assert(pool.get_available_count() == 64);
+    blocks = drain(pool);
+    assert(blocks.size() == 64);
+
+    std::cout << "PASSED\n";
+}
+
+void test_thread_cache() {
+    std::cout << "Testing per-thread caches... ";
+
+    // Clamped to an eighth of the pool; too small to be worth caching
+    assert(MemoryPool(64, 1024).thread_cache_size() == MemoryPool::MAX_THREAD_CACHE);
+    assert(MemoryPool(64, 1024, 8).thread_cache_size() == 8);
+    assert(MemoryPool(64, 64).thread_cache_size() == 8);
+    assert(MemoryPool(64, 8).thread_cache_size() == 0);
+
+    MemoryPool pool(64, 256);
+    void* block = pool.allocate();
+    assert(block);
+    assert(pool.get_allocated_count() == 1);   // The refill's rest is cached, not allocated
+    pool.deallocate(block);
+    assert(pool.get_allocated_count() == 0);
+
+    // Blocks cached on another thread come back when it exits
+    std::thread worker([&]() {
+        std::vector<void*> held;
+        for (int i = 0; i < 40; ++i) held.push_back(pool.allocate());
+        for (void* b : held) pool.deallocate(b);
+    });
+    worker.join();
+
+    pool.flush_thread_cache();
+    size_t drained = drain(pool).size();
+    assert(drained == 256);
+    assert(pool.get_allocated_count() == 256);
+
+    std::cout << "PASSED\n";
+}
+
+// Threads allocate, stamp the whole block, hold it a while, and free it,
+// half of the time handing it to another thread to free. A block handed
+// out twice at once shows up as a torn stamp.
+void test_stress(size_t num_threads) {
+    std::cout << "Testing stress with " << num_threads << " threads... ";
+
+    constexpr size_t BLOCKS = 512;
+    constexpr size_t TOTAL_OPS = 2000000;
+    constexpr size_t WORDS = 64 / sizeof(uint32_t);
+    MemoryPool pool(64, BLOCKS);
+
+    struct Held {
+        uint32_t* block;
+        uint32_t stamp;
+    };
+    std::mutex handoff_mutex;
+    std::vector<Held> handoff;
+    bool torn = false;
+    std::mutex torn_mutex;
+
+    auto check_and_free = [&](const Held& held) {
+        for (size_t w = 0; w < WORDS; ++w) {
+            if (held.block[w] != held.stamp) {
+                std::lock_guard<std::mutex> lock(torn_mutex);
+                torn = true;
+            }
+        }
+        pool.deallocate(held.block);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(static_cast<uint32_t>(t + 1));
+            std::vector<Held> held;
+            uint32_t seq = 0;
+            for (size_t op = 0; op < TOTAL_OPS / num_threads; ++op) {
+                if (held.size() < 16 && rng() % 2 == 0) {
+                    auto* block = static_cast<uint32_t*>(pool.allocate());
+                    if (!block) continue;   // Others hold or cache the rest
+                    uint32_t stamp = static_cast<uint32_t>(t << 24) | (++seq & 0xFFFFFF);
+                    for (size_t w = 0; w < WORDS; ++w) block[w] = stamp;
+                    held.push_back({block, stamp});
+                } else if (!held.empty()) {
+                    Held h = held.back();
+                    held.pop_back();
+                    if (rng() % 2 == 0) {
+                        std::lock_guard<std::mutex> lock(handoff_mutex);
+                        handoff.push_back(h);
+                        continue;
+                    }
+                    check_and_free(h);
+                } else {
+                    Held h{nullptr, 0};
+                    {
+                        std::lock_guard<std::mutex> lock(handoff_mutex);
+                        if (!handoff.empty()) {
+                            h = handoff.back();
+                            handoff.pop_back();
+                        }
+                    }
+                    if (h.block) check_and_free(h);
+                }
+            }
+            for (const Held& h : held) check_and_free(h);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (const Held& h : handoff) check_and_free(h);
+
+    assert(!torn);
+    assert(pool.get_allocated_count() == 0);
+    assert(pool.get_available_count() == BLOCKS);
+    size_t drained = drain(pool).size();
+    assert(drained == BLOCKS);
+
+    std::cout << "PASSED\n";
+}
+
+void test_memory_policy() {
+    std::cout << "Testing memory policy... ";
+
+    MemoryPolicy policy;
+    bool parsed = parse_memory_policy("huge,node=0,lock,prefault", policy);
+    assert(parsed);
+    assert(policy.huge_pages && policy.numa_node == 0);
+    assert(policy.lock && policy.prefault);
+    parsed = parse_memory_policy("4k,node=local", policy);
+    assert(parsed);
+    assert(!policy.huge_pages && policy.numa_node == MemoryPolicy::LOCAL_NODE);
+
+    MemoryPolicy bad;
+    for (const char* spec : {"node=", "node=64", "node=1x", "huge,pin"}) {
+        parsed = parse_memory_policy(spec, bad);
+        assert(!parsed);
+    }
+
+    // 4k keeps even a 2MB buffer on small pages
+    MemoryPolicy small;
+    small.huge_pages = false;
+    HugePageBuffer flat(HugePageBuffer::HUGE_PAGE_SIZE, small);
+    assert(flat.backing() == HugePageBuffer::Backing::Normal);
+
+    // Binding, locking and prefaulting are best effort; the buffer is
+    // usable and zeroed whatever took effect
+    MemoryPolicy placed;
+    placed.numa_node = MemoryPolicy::LOCAL_NODE;
+    placed.lock = true;
+    placed.prefault = true;
+    HugePageBuffer buffer(HugePageBuffer::HUGE_PAGE_SIZE, placed);
+    assert(buffer.numa_node() == -1 || buffer.numa_node() == current_numa_node());
+    auto* bytes = static_cast<uint8_t*>(buffer.data());
+    for (size_t i = 0; i < buffer.size(); i += 4096) {
+        assert(bytes[i] == 0);
+        bytes[i] = 1;
+    }
+
+    // The process default reaches pool storage; moved-from buffers are empty
+    MemoryPolicy saved = memory_policy();
+    set_memory_policy(small);
+    MemoryPool pool(64 * 1024, 64);
+    set_memory_policy(saved);
+    assert(pool.storage().backing() == HugePageBuffer::Backing::Normal);
+    size_t drained = drain(pool).size();
+    assert(drained == 64);
+
+    HugePageBuffer moved(std::move(buffer));
+    assert(moved.data() == bytes && buffer.data() == nullptr);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Memory Pool Tests ===\n";
+
+    test_basic();
+    test_thread_cache();
+    test_memory_policy();
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        test_stress(threads);
+    }
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
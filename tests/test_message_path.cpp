@@ -0,0 +1,299 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/alloc_counter.h"
+#include "../include/client_manager.h"
+#include "../include/memory_pool.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+
+// Read everything queued on fd through a pool block, as the feed handler
+// does; returns bytes read
+static size_t drain_socket(int fd, MemoryPool& pool, MessageParser& parser) {
+    size_t total = 0;
+    for (;;) {
+        PoolBuffer block(&pool, pool.allocate());
+        ssize_t n = recv(fd, block.data(), pool.block_size(), MSG_DONTWAIT);
+        if (n <= 0) {
+            return total;
+        }
+        parser.parse_buffer(block.data(), static_cast<size_t>(n));
+        total += static_cast<size_t>(n);
+    }
+}
+
+void test_message_ref() {
+    std::cout << "Testing reference-counted messages... ";
+
+    MemoryPool pool(128, 16, 0);
+    assert(MessageRef::capacity(pool) == 112);
+
+    const char text[] = "market data";
+    MessageRef a = MessageRef::copy_of(pool, text, sizeof(text));
+    assert(a.pooled() && a.size() == sizeof(text) && a.use_count() == 1);
+    assert(std::memcmp(a.data(), text, sizeof(text)) == 0);
+    assert(pool.get_allocated_count() == 1);
+
+    {
+        MessageRef b = a;
+        MessageRef c;
+        c = b;
+        assert(a.use_count() == 3 && c.data() == a.data());
+        MessageRef d = std::move(c);
+        assert(!c && a.use_count() == 3);
+    }
+    assert(a.use_count() == 1);
+
+    a.resize(4);
+    assert(a.size() == 4);
+    a.resize(100);   // Never grows
+    assert(a.size() == 4);
+
+    a.reset();
+    assert(!a && pool.get_allocated_count() == 0);
+
+    // Too big for a block, or the pool is dry: the heap takes it
+    uint64_t fallbacks = MessageRef::heap_fallbacks();
+    AllocationScope scope;
+    MessageRef big = MessageRef::allocate(pool, 1000);
+    assert(big && !big.pooled() && big.size() == 1000);
+    assert(scope.allocations() == 1 && scope.bytes() >= 1000);
+    std::vector<MessageRef> held;
+    for (int i = 0; i < 17; ++i) {
+        held.push_back(MessageRef::allocate(pool, 64));
+    }
+    assert(held[15].pooled() && !held[16].pooled());
+    assert(MessageRef::heap_fallbacks() == fallbacks + 2);
+    held.clear();
+    assert(pool.get_allocated_count() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_backed_up_client() {
+    std::cout << "Testing send queue keeps the stream whole... ";
+
+    int fds[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+
+    ClientManager mgr;
+    mgr.add_client(fds[0], "local", 0);
+    int sendbuf = 16 * 1024;
+    setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendbuf, sizeof(sendbuf));
+
+    // Nobody reads: the socket fills, then the queue, then the client is slow
+    TickGenerator gen(10);
+    size_t accepted = 0;
+    size_t ticks = 0;
+    while (!mgr.is_slow(fds[0])) {
+        MessageRef msg = mgr.allocate_message();
+        size_t size;
+        uint16_t symbol_id;
+        gen.generate_tick(msg.data(), size, symbol_id);
+        msg.resize(size);
+        accepted += mgr.broadcast(msg, symbol_id);
+        ++ticks;
+    }
+    assert(accepted == ticks - 1);
+    assert(mgr.queued_clients() == 1);
+    assert(mgr.get_client(fds[0])->queue->full());
+    assert(mgr.message_pool().get_allocated_count() == ClientManager::SEND_QUEUE_DEPTH);
+
+    // Reading lets the queue drain in order; every accepted message arrives
+    MemoryPool blocks(4096, 8);
+    MessageParser parser;
+    size_t received = 0;
+    parser.set_trade_callback([&](const MessageHeader&, const TradePayload&) { received++; });
+    parser.set_quote_callback([&](const MessageHeader&, const QuotePayload&) { received++; });
+    while (drain_socket(fds[1], blocks, parser) > 0 || mgr.queued_clients() > 0) {
+        mgr.flush_send_queues();
+    }
+    assert(received == accepted);
+    assert(parser.checksum_errors() == 0 && parser.malformed_messages() == 0);
+    assert(parser.sequence_gaps() == 0);
+    assert(mgr.message_pool().get_allocated_count() == 0);
+
+    size_t drained = mgr.drain_slow_clients();
+    assert(drained == 0);
+    assert(!mgr.is_slow(fds[0]));
+
+    mgr.remove_client(fds[0]);
+    close(fds[1]);
+    std::cout << "PASSED\n";
+}
+
+void test_teardown_with_queue() {
+    std::cout << "Testing teardown with messages still queued... ";
+
+    int fds[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+    {
+        // Nobody reads, so the manager goes with its queue full
+        ClientManager mgr;
+        mgr.add_client(fds[0], "local", 0);
+        int sendbuf = 16 * 1024;
+        setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendbuf, sizeof(sendbuf));
+        TickGenerator gen(10);
+        while (mgr.queued_clients() == 0) {
+            MessageRef msg = mgr.allocate_message();
+            size_t size;
+            uint16_t symbol_id;
+            gen.generate_tick(msg.data(), size, symbol_id);
+            msg.resize(size);
+            mgr.broadcast(msg, symbol_id);
+        }
+        assert(mgr.message_pool().get_allocated_count() > 0);
+    }
+
+    close(fds[1]);
+    std::cout << "PASSED\n";
+}
+
+void test_slab_backed() {
+    std::cout << "Testing subscriptions stay off the heap, large copies use the slab... ";
+
+    int fds[2];
+    int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(rc == 0);
+    ClientManager mgr;
+    mgr.add_client(fds[0], "local", 0);
+    const SlabAllocator& slab = mgr.slab();
+
+    // Subscriptions set bits in the slot table, off the heap
+    std::vector<uint16_t> symbols(200);
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        symbols[i] = static_cast<uint16_t>(i * 2);
+    }
+    AllocationScope scope;
+    bool subscribed = mgr.handle_subscription(fds[0], symbols.data(), symbols.size());
+    assert(subscribed && scope.allocations() == 0);
+
+    // A packet bigger than a send block queues as one slab block
+    int sendbuf = 16 * 1024;
+    setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendbuf, sizeof(sendbuf));
+    std::vector<uint8_t> packet(1000);
+    size_t sent = 0;
+    while (mgr.queued_clients() == 0) {
+        std::memset(packet.data(), static_cast<int>(sent++), packet.size());
+        bool queued = mgr.send_to_client(fds[0], packet.data(), packet.size());
+        assert(queued);
+    }
+    size_t packet_class = SlabAllocator::class_index(packet.size() + MessageRef::HEADER_SIZE);
+    assert(mgr.get_client(fds[0])->queue->size() == 1);
+    assert(slab.class_stats(packet_class).in_use == 1);
+    assert(mgr.message_pool().get_allocated_count() == 0);
+
+    // And arrives whole, in order
+    std::vector<uint8_t> received;
+    uint8_t chunk[4096];
+    while (mgr.queued_clients() > 0 || received.size() < sent * packet.size()) {
+        ssize_t n = recv(fds[1], chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (n > 0) received.insert(received.end(), chunk, chunk + n);
+        mgr.flush_send_queues();
+    }
+    assert(received.size() == sent * packet.size());
+    for (size_t i = 0; i < sent; ++i) {
+        assert(received[i * packet.size()] == static_cast<uint8_t>(i));
+        assert(received[(i + 1) * packet.size() - 1] == static_cast<uint8_t>(i));
+    }
+    assert(slab.class_stats(packet_class).in_use == 0);
+
+    mgr.remove_client(fds[0]);
+    close(fds[1]);
+    std::cout << "PASSED\n";
+}
+
+// Server send path and client receive path together: ticks generated
+// into pooled messages, fanned out to four clients (one on protocol v2,
+// one reading rarely so its queue fills and drains), and parsed out of
+// pool blocks on the other end
+void test_zero_allocations() {
+    std::cout << "Testing steady state makes no heap allocations... ";
+
+    constexpr size_t CLIENTS = 4;
+    constexpr size_t SLOW = 3;
+    ClientManager mgr;
+    int fds[CLIENTS][2];
+    MessageParser parsers[CLIENTS];
+    size_t received[CLIENTS] = {};
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        int rc = socketpair(AF_UNIX, SOCK_STREAM, 0, fds[i]);
+        assert(rc == 0);
+        mgr.add_client(fds[i][0], "local", 0);
+        parsers[i].set_trade_callback(
+            [&received, i](const MessageHeader&, const TradePayload&) { received[i]++; });
+        parsers[i].set_quote_callback(
+            [&received, i](const MessageHeader&, const QuotePayload&) { received[i]++; });
+    }
+    mgr.set_protocol_version(fds[1][0], PROTOCOL_V2);
+    int sendbuf = 16 * 1024;
+    setsockopt(fds[SLOW][0], SOL_SOCKET, SO_SNDBUF, &sendbuf, sizeof(sendbuf));
+
+    TickGenerator gen(100);
+    MemoryPool blocks(64 * 1024, 16);
+    size_t peak_queue = 0;
+    auto run = [&](size_t ticks) {
+        for (size_t t = 1; t <= ticks; ++t) {
+            MessageRef msg = mgr.allocate_message();
+            size_t size;
+            uint16_t symbol_id;
+            gen.generate_tick(msg.data(), size, symbol_id);
+            msg.resize(size);
+            MessageRef v2 = mgr.allocate_message();
+            v2.resize(encode_v2(msg.data(), v2.data()));
+            mgr.broadcast(msg, symbol_id, v2);
+
+            if (t % 64 == 0) {
+                peak_queue = std::max(peak_queue, mgr.get_client(fds[SLOW][0])->queue->size());
+                for (size_t i = 0; i < CLIENTS; ++i) {
+                    if (i != SLOW || t % 512 == 0) {
+                        drain_socket(fds[i][1], blocks, parsers[i]);
+                    }
+                }
+                mgr.flush_send_queues();
+            }
+        }
+    };
+
+    run(20000);   // Warm up: parser buffers, magazines, queue high water
+    uint64_t fallbacks = MessageRef::heap_fallbacks();
+    size_t before = received[0];
+
+    AllocationScope scope;
+    run(200000);
+    uint64_t allocations = scope.allocations();
+
+    assert(received[0] - before > 150000);
+    assert(peak_queue > 0);
+    assert(mgr.get_client(fds[SLOW][0])->slow_consumer_count == 0);
+    assert(allocations == 0);
+    assert(MessageRef::heap_fallbacks() == fallbacks);
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        assert(parsers[i].checksum_errors() == 0);
+        mgr.remove_client(fds[i][0]);
+        close(fds[i][1]);
+    }
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Message Path Tests ===\n";
+
+    test_message_ref();
+    test_backed_up_client();
+    test_teardown_with_queue();
+    test_slab_backed();
+    test_zero_allocations();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../include/feed_handler.h"
+
+using namespace mdf;
+
+// Loopback TCP server standing in for one exchange feed
+struct TestFeed {
+    int listener = -1;
+    int client = -1;
+    uint16_t port = 0;
+
+    TestFeed() {
+        listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        int rc = ::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        assert(rc == 0);
+        rc = ::listen(listener, 1);
+        assert(rc == 0);
+        rc = ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+        assert(rc == 0);
+        port = ntohs(addr.sin_port);
+    }
+
+    ~TestFeed() {
+        if (client >= 0) ::close(client);
+        ::close(listener);
+    }
+
+    void accept() { client = ::accept(listener, nullptr, nullptr); }
+
+    void send_trade(uint32_t seq, uint16_t symbol_id, double price) {
+        TradeMessage msg{};
+        msg.header.message_type = static_cast<uint16_t>(MessageType::TRADE);
+        msg.header.sequence_number = seq;
+        msg.header.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        msg.header.symbol_id = symbol_id;
+        msg.payload.price = price;
+        msg.payload.quantity = 100;
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - sizeof(msg.checksum));
+        ssize_t n = ::send(client, &msg, sizeof(msg), MSG_NOSIGNAL);
+        assert(n == static_cast<ssize_t>(sizeof(msg)));
+    }
+};
+
+static bool wait_for_messages(const FeedHandler& handler, uint64_t count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handler.messages_received() < count) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void test_independent_feeds() {
+    std::cout << "Testing independent feed connections... ";
+
+    TestFeed a, b;
+    FeedHandlerConfig config;
+    config.enable_visualization = false;
+    config.auto_reconnect = false;
+    config.feeds.push_back(FeedEndpoint{"127.0.0.1", a.port, {}});
+    config.feeds.push_back(FeedEndpoint{"127.0.0.1", b.port, {}});
+
+    FeedHandler handler;
+    handler.configure(config);
+    assert(handler.connection_count() == 2);
+
+    // Keep the connect chatter out of the test output
+    std::ostringstream quiet;
+    auto* saved = std::cout.rdbuf(quiet.rdbuf());
+    bool started = handler.start();
+    std::cout.rdbuf(saved);
+    assert(started);
+    a.accept();
+    b.accept();
+    std::thread runner([&]() { handler.run(); });
+
+    // Both feeds number from 0: separate sequence spaces, so no gaps
+    for (uint32_t seq = 0; seq < 1000; ++seq) {
+        a.send_trade(seq, 1, 100.0 + seq);
+        b.send_trade(seq, 2, 200.0 + seq);
+    }
+    bool arrived = wait_for_messages(handler, 2000);
+    assert(arrived);
+    assert(handler.sequence_gaps() == 0);
+
+    // Both write the shared cache
+    assert(handler.get_market_state(1).last_traded_price == 1099.0);
+    assert(handler.get_market_state(2).last_traded_price == 1199.0);
+    assert(handler.get_market_state(2).update_count == 1000);
+
+    // A jump on one feed is that feed's gap only
+    b.send_trade(1005, 2, 300.0);
+    arrived = wait_for_messages(handler, 2001);
+    assert(arrived);
+    auto stats = handler.get_connection_stats();
+    assert(stats.size() == 2);
+    assert(stats[0].messages_received == 1000 && stats[0].sequence_gaps == 0);
+    assert(stats[1].messages_received == 1001 && stats[1].sequence_gaps == 1);
+    assert(stats[0].latency.sample_count == 1000);
+    assert(stats[1].latency.sample_count == 1001);
+    assert(handler.sequence_gaps() == 1);
+
+    // Losing one feed leaves the other running
+    ::close(a.client);
+    a.client = -1;
+    b.send_trade(1006, 2, 301.0);
+    arrived = wait_for_messages(handler, 2002);
+    assert(arrived);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handler.get_connection_stats()[0].connected &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stats = handler.get_connection_stats();
+    assert(!stats[0].connected && stats[1].connected);
+    assert(handler.is_connected());
+    assert(handler.get_market_state(2).last_traded_price == 301.0);
+
+    handler.stop();
+    runner.join();
+
+    std::cout << "PASSED\n";
+}
+
+void test_single_feed_stats() {
+    std::cout << "Testing single feed connection stats... ";
+
+    TestFeed a;
+    FeedHandlerConfig config;
+    config.host = "127.0.0.1";
+    config.port = a.port;
+    config.enable_visualization = false;
+    config.auto_reconnect = false;
+
+    FeedHandler handler;
+    handler.configure(config);
+    assert(handler.connection_count() == 1);
+
+    std::ostringstream quiet;
+    auto* saved = std::cout.rdbuf(quiet.rdbuf());
+    bool started = handler.start();
+    std::cout.rdbuf(saved);
+    assert(started);
+    a.accept();
+    std::thread runner([&]() { handler.run(); });
+
+    for (uint32_t seq = 0; seq < 100; ++seq) {
+        a.send_trade(seq, 3, 50.0);
+    }
+    bool arrived = wait_for_messages(handler, 100);
+    assert(arrived);
+
+    auto stats = handler.get_connection_stats();
+    assert(stats.size() == 1);
+    assert(stats[0].endpoint == "127.0.0.1:" + std::to_string(a.port));
+    assert(stats[0].connected);
+    assert(stats[0].messages_received == 100);
+    assert(stats[0].latency.sample_count == 100);
+
+    handler.stop();
+    runner.join();
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Multi-Feed Tests ===\n";
+
+    test_independent_feeds();
+    test_single_feed_stats();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include "../include/order_book.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+
+void test_add_modify_delete() {
+    std::cout << "Testing add/modify/delete... ";
+
+    OrderBook book;
+    assert(book.level_count(BookSide::BID) == 0);
+
+    // Build 3 bid levels: 100.00, 99.95, 99.90
+    bool ok = book.apply(BookSide::BID, BookAction::ADD, 0, 100.00, 500);
+    assert(ok);
+    ok = book.apply(BookSide::BID, BookAction::ADD, 1, 99.90, 300);
+    assert(ok);
+    ok = book.apply(BookSide::BID, BookAction::ADD, 1, 99.95, 400);
+    assert(ok);
+    assert(book.level_count(BookSide::BID) == 3);
+    assert(book.bid_prices[0] == 100.00);
+    assert(book.bid_prices[1] == 99.95);
+    assert(book.bid_prices[2] == 99.90);
+
+    // Modify middle level
+    ok = book.apply(BookSide::BID, BookAction::MODIFY, 1, 99.95, 1000);
+    assert(ok);
+    assert(book.bid_quantities[1] == 1000);
+
+    // Delete top level - everything shifts up
+    ok = book.apply(BookSide::BID, BookAction::DELETE, 0, 100.00, 0);
+    assert(ok);
+    assert(book.level_count(BookSide::BID) == 2);
+    assert(book.bid_prices[0] == 99.95);
+    assert(book.bid_quantities[0] == 1000);
+
+    // Asks are independent
+    assert(book.level_count(BookSide::ASK) == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_invalid_levels() {
+    std::cout << "Testing invalid levels... ";
+
+    OrderBook book;
+
+    // Can't add past the end, or modify/delete what isn't there
+    bool ok = book.apply(BookSide::ASK, BookAction::ADD, 1, 101.0, 100);
+    assert(!ok);
+    ok = book.apply(BookSide::ASK, BookAction::MODIFY, 0, 101.0, 100);
+    assert(!ok);
+    ok = book.apply(BookSide::ASK, BookAction::DELETE, 0, 101.0, 0);
+    assert(!ok);
+
+    // Full book drops the deepest level on insert
+    for (size_t i = 0; i < MAX_BOOK_LEVELS; ++i) {
+        ok = book.apply(BookSide::ASK, BookAction::ADD, static_cast<uint8_t>(i),
+                        101.0 + i, 100);
+        assert(ok);
+    }
+    assert(book.level_count(BookSide::ASK) == MAX_BOOK_LEVELS);
+    ok = book.apply(BookSide::ASK, BookAction::ADD, 0, 100.5, 100);
+    assert(ok);
+    assert(book.level_count(BookSide::ASK) == MAX_BOOK_LEVELS);
+    assert(book.ask_prices[0] == 100.5);
+    assert(book.ask_prices[MAX_BOOK_LEVELS - 1] == 101.0 + MAX_BOOK_LEVELS - 2);
+
+    std::cout << "PASSED\n";
+}
+
+void test_depth_cache_levels() {
+    std::cout << "Testing depth cache top-N read... ";
+
+    DepthCache cache(10);
+
+    DepthUpdatePayload update{};
+    update.side = static_cast<uint8_t>(BookSide::ASK);
+    update.action = static_cast<uint8_t>(BookAction::ADD);
+    for (uint8_t i = 0; i < 5; ++i) {
+        update.level = i;
+        update.price = 200.0 + i * 0.05;
+        update.quantity = 100 * (i + 1);
+        bool ok = cache.apply_update(3, update, i);
+        assert(ok);
+    }
+
+    PriceLevel levels[3];
+    size_t n = cache.get_levels(3, BookSide::ASK, levels, 3);
+    assert(n == 3);
+    assert(levels[0].price == 200.0);
+    assert(levels[2].quantity == 300);
+
+    assert(cache.get_levels(3, BookSide::BID, levels, 3) == 0);
+    assert(cache.update_count(3) == 5);
+
+    // Rejected updates don't count
+    update.action = static_cast<uint8_t>(BookAction::DELETE);
+    update.level = 10;
+    bool ok = cache.apply_update(3, update, 6);
+    assert(!ok);
+    assert(cache.rejected_updates() == 1);
+    assert(cache.update_count(3) == 5);
+
+    std::cout << "PASSED\n";
+}
+
+void test_generator_round_trip() {
+    std::cout << "Testing simulator/client book sync... ";
+
+    TickGenerator gen(5);
+    gen.set_depth_levels(10);
+    DepthCache cache(5);
+
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+
+    // Replay generated updates into the client cache
+    for (int i = 0; i < 20000; ++i) {
+        uint16_t symbol_id = static_cast<uint16_t>(i % 5);
+        gen.generate_depth_update(symbol_id, buffer, size);
+        assert(size == DEPTH_MSG_SIZE);
+
+        MessageHeader header;
+        DepthUpdatePayload payload;
+        std::memcpy(&header, buffer, sizeof(header));
+        std::memcpy(&payload, buffer + HEADER_SIZE, sizeof(payload));
+        assert(calculate_checksum(buffer, HEADER_SIZE + DEPTH_PAYLOAD_SIZE) ==
+               *reinterpret_cast<uint32_t*>(buffer + HEADER_SIZE + DEPTH_PAYLOAD_SIZE));
+        bool ok = cache.apply_update(header.symbol_id, payload, header.timestamp_ns);
+        assert(ok);
+    }
+
+    // Client book must match the simulator's book exactly
+    for (uint16_t s = 0; s < 5; ++s) {
+        const OrderBook& expected = gen.get_order_book(s);
+        OrderBook actual = cache.get_book(s);
+
+        assert(actual.bid_count == expected.bid_count);
+        assert(actual.ask_count == expected.ask_count);
+        assert(actual.bid_count <= 10 && actual.ask_count <= 10);
+        for (size_t i = 0; i < actual.bid_count; ++i) {
+            assert(actual.bid_prices[i] == expected.bid_prices[i]);
+            assert(actual.bid_quantities[i] == expected.bid_quantities[i]);
+            if (i > 0) assert(actual.bid_prices[i] < actual.bid_prices[i - 1]);
+        }
+        for (size_t i = 0; i < actual.ask_count; ++i) {
+            assert(actual.ask_prices[i] == expected.ask_prices[i]);
+            assert(actual.ask_quantities[i] == expected.ask_quantities[i]);
+            if (i > 0) assert(actual.ask_prices[i] > actual.ask_prices[i - 1]);
+        }
+    }
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Order Book Tests ===\n";
+
+    test_add_modify_delete();
+    test_invalid_levels();
+    test_depth_cache_levels();
+    test_generator_round_trip();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
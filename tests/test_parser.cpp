@@ -0,0 +1,621 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../include/batch_encoder.h"
+#include "../include/parser.h"
+#include "../include/tick_generator.h"
+
+using namespace mdf;
+
+// Generate a stream of v1 messages, optionally re-encoded as v2
+static std::vector<uint8_t> make_stream(TickGenerator& gen, size_t count, bool v2) {
+    std::vector<uint8_t> stream;
+    uint8_t buffer[MAX_MSG_SIZE];
+    uint8_t encoded[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+
+    for (size_t i = 0; i < count; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        if (v2) {
+            size = encode_v2(buffer, encoded);
+            stream.insert(stream.end(), encoded, encoded + size);
+        } else {
+            stream.insert(stream.end(), buffer, buffer + size);
+        }
+    }
+    return stream;
+}
+
+// One trade message with the given sequence (price encodes it)
+static void append_trade(std::vector<uint8_t>& stream, uint32_t seq) {
+    TradeMessage msg{};
+    msg.header.message_type = static_cast<uint16_t>(MessageType::TRADE);
+    msg.header.sequence_number = seq;
+    msg.header.symbol_id = 1;
+    msg.payload.price = 100.0 + seq;
+    msg.payload.quantity = 100;
+    msg.checksum = calculate_checksum(&msg, sizeof(msg) - sizeof(msg.checksum));
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&msg);
+    stream.insert(stream.end(), bytes, bytes + sizeof(msg));
+}
+
+static std::vector<uint8_t> trades(std::initializer_list<uint32_t> seqs) {
+    std::vector<uint8_t> stream;
+    for (uint32_t seq : seqs) append_trade(stream, seq);
+    return stream;
+}
+
+// Parser that records dispatched sequences and reported gaps
+struct ReorderHarness {
+    MessageParser parser;
+    std::vector<uint32_t> seqs;
+    std::vector<std::pair<uint32_t, uint32_t>> gaps;
+
+    explicit ReorderHarness(size_t window, uint64_t max_hold_ns = 60000000000ULL) {
+        parser.set_reorder_window(window, max_hold_ns);
+        parser.set_trade_callback([this](const MessageHeader& h, const TradePayload& p) {
+            uint32_t seq = h.sequence_number;
+            assert(p.price == 100.0 + seq);
+            seqs.push_back(seq);
+        });
+        parser.set_gap_callback([this](uint32_t expected, uint32_t received) {
+            gaps.emplace_back(expected, received);
+        });
+    }
+
+    size_t feed(std::initializer_list<uint32_t> seqs_in) {
+        auto stream = trades(seqs_in);
+        parser.append_data(stream.data(), stream.size());
+        return parser.parse_messages();
+    }
+};
+
+void test_parse_v1() {
+    std::cout << "Testing v1 parsing... ";
+
+    TickGenerator gen(10);
+    auto stream = make_stream(gen, 1000, false);
+
+    MessageParser parser;
+    parser.append_data(stream.data(), stream.size());
+    size_t parsed = parser.parse_messages();
+    assert(parsed == 1000);
+    assert(parser.trades_parsed() + parser.quotes_parsed() == 1000);
+    assert(parser.checksum_errors() == 0);
+    assert(parser.sequence_gaps() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_buffer_growth() {
+    std::cout << "Testing buffer growth... ";
+
+    // Past the initial buffer without parsing: grows by copying, keeps
+    // every byte, and stops at the maximum
+    TickGenerator gen(10);
+    auto stream = make_stream(gen, 150000, false);
+    assert(stream.size() > MessageParser::INITIAL_BUFFER_SIZE);
+    MessageParser parser;
+    assert(parser.buffer_capacity() == MessageParser::INITIAL_BUFFER_SIZE);
+
+    for (size_t offset = 0; offset < stream.size(); offset += 64 * 1024) {
+        size_t len = std::min<size_t>(64 * 1024, stream.size() - offset);
+        size_t appended = parser.append_data(stream.data() + offset, len);
+        assert(appended == len);
+    }
+    assert(parser.buffer_capacity() == 2 * MessageParser::INITIAL_BUFFER_SIZE);
+    assert(parser.buffer_used() == stream.size());
+    size_t parsed = parser.parse_messages();
+    assert(parsed == 150000);
+    assert(parser.checksum_errors() == 0 && parser.sequence_gaps() == 0);
+
+    std::vector<uint8_t> huge(MessageParser::MAX_BUFFER_SIZE + 1);
+    size_t appended = parser.append_data(huge.data(), huge.size());
+    assert(appended == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_parse_v2_matches_v1() {
+    std::cout << "Testing v2 parsing matches v1... ";
+
+    // Two generators with the same state would need a fixed seed, so
+    // instead encode one v1 stream both ways
+    TickGenerator gen(10);
+    std::vector<uint8_t> v1_stream, v2_stream;
+    uint8_t buffer[MAX_MSG_SIZE];
+    uint8_t encoded[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (int i = 0; i < 1000; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        v1_stream.insert(v1_stream.end(), buffer, buffer + size);
+        size_t v2_size = encode_v2(buffer, encoded);
+        assert(v2_size > 0 && v2_size < size);
+        v2_stream.insert(v2_stream.end(), encoded, encoded + v2_size);
+    }
+    assert(v2_stream.size() < v1_stream.size());
+
+    std::vector<double> v1_prices, v2_prices;
+    auto collect = [](std::vector<double>& out) {
+        return [&out](const MessageHeader&, const QuotePayload& q) {
+            out.push_back(q.bid_price);
+            out.push_back(q.ask_price);
+        };
+    };
+
+    MessageParser p1, p2;
+    p1.set_quote_callback(collect(v1_prices));
+    p2.set_quote_callback(collect(v2_prices));
+
+    p1.append_data(v1_stream.data(), v1_stream.size());
+    p2.append_data(v2_stream.data(), v2_stream.size());
+    size_t parsed1 = p1.parse_messages();
+    size_t parsed2 = p2.parse_messages();
+    assert(parsed1 == 1000 && parsed2 == 1000);
+    assert(p2.trades_parsed() == p1.trades_parsed());
+
+    // Prices are already at paisa precision, so fixed-point is lossless
+    assert(v1_prices == v2_prices);
+
+    std::cout << "PASSED\n";
+}
+
+void test_fragmented_input() {
+    std::cout << "Testing fragmented input... ";
+
+    TickGenerator gen(10);
+    auto stream = make_stream(gen, 500, true);
+
+    MessageParser parser;
+    size_t parsed = 0;
+    for (size_t off = 0; off < stream.size(); off += 7) {
+        size_t len = std::min<size_t>(7, stream.size() - off);
+        parser.append_data(stream.data() + off, len);
+        parsed += parser.parse_messages();
+    }
+    assert(parsed == 500);
+    assert(parser.checksum_errors() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+// Total size of the messages that straddle a multiple of chunk: the only
+// bytes parse_buffer() should copy when fed the stream in such pieces
+static size_t split_bytes(const std::vector<uint8_t>& stream, size_t chunk) {
+    size_t total = 0;
+    for (size_t off = 0; off < stream.size();) {
+        MessageHeader header;
+        std::memcpy(&header, stream.data() + off, sizeof(header));
+        size_t size = get_message_size(static_cast<MessageType>(header.message_type));
+        if (off / chunk != (off + size - 1) / chunk) {
+            total += size;
+        }
+        off += size;
+    }
+    return total;
+}
+
+void test_parse_in_place() {
+    std::cout << "Testing parsing in place... ";
+
+    // Receive-sized pieces that split messages: each piece is parsed where
+    // it lies; the split message's head is kept and only its tail copied
+    // from the next piece. 7-byte pieces also split headers.
+    TickGenerator gen(10);
+    gen.set_depth_levels(5);
+    auto stream = make_stream(gen, 5000, false);
+
+    for (size_t chunk : {size_t(1000), size_t(7)}) {
+        MessageParser parser;
+        size_t parsed = 0;
+        for (size_t off = 0; off < stream.size(); off += chunk) {
+            size_t len = std::min<size_t>(chunk, stream.size() - off);
+            std::vector<uint8_t> piece(stream.begin() + off, stream.begin() + off + len);
+            parsed += parser.parse_buffer(piece.data(), piece.size());
+            assert(parser.buffer_used() < MAX_MSG_SIZE);
+        }
+        assert(parsed == 5000);
+        assert(parser.buffer_used() == 0);
+        assert(parser.checksum_errors() == 0 && parser.sequence_gaps() == 0);
+        assert(parser.bytes_copied() == split_bytes(stream, chunk));
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void test_batched_packets() {
+    std::cout << "Testing batched packets... ";
+
+    TickGenerator gen(10);
+    gen.set_depth_levels(5);
+    std::vector<uint8_t> plain, batched;
+    BatchEncoder batch;
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+
+    auto flush = [&]() {
+        size_t packet = batch.finish();
+        batched.insert(batched.end(), batch.data(), batch.data() + packet);
+        batch.clear();
+    };
+
+    for (int i = 0; i < 2000; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        plain.insert(plain.end(), buffer, buffer + size);
+        if (!batch.append(buffer, size)) {
+            flush();
+            bool appended = batch.append(buffer, size);
+            assert(appended);
+        }
+    }
+    flush();
+    assert(batched.size() < plain.size());
+
+    // Heartbeats aren't batchable
+    gen.generate_heartbeat(buffer, size);
+    bool appended = batch.append(buffer, size);
+    assert(!appended);
+
+    auto record = [](std::vector<uint32_t>& out) {
+        return [&out](const MessageHeader& h, const QuotePayload&) {
+            out.push_back(h.sequence_number);
+        };
+    };
+    std::vector<uint32_t> plain_seqs, batched_seqs;
+    MessageParser p1, p2;
+    p1.set_quote_callback(record(plain_seqs));
+    p2.set_quote_callback(record(batched_seqs));
+
+    p1.append_data(plain.data(), plain.size());
+    size_t parsed = p1.parse_messages();
+    assert(parsed == 2000);
+
+    // Feed batched stream in odd-sized chunks to split packets
+    parsed = 0;
+    for (size_t off = 0; off < batched.size(); off += 333) {
+        size_t len = std::min<size_t>(333, batched.size() - off);
+        p2.append_data(batched.data() + off, len);
+        parsed += p2.parse_messages();
+    }
+    assert(parsed == 2000);
+    assert(p2.sequence_gaps() == 0);
+    assert(p2.checksum_errors() == 0);
+    assert(p2.depth_updates_parsed() == p1.depth_updates_parsed());
+    assert(plain_seqs == batched_seqs);
+
+    // Parsed in place, only packets split across pieces are copied
+    MessageParser p3;
+    parsed = 0;
+    for (size_t off = 0; off < batched.size(); off += 4096) {
+        size_t len = std::min<size_t>(4096, batched.size() - off);
+        parsed += p3.parse_buffer(batched.data() + off, len);
+    }
+    assert(parsed == 2000);
+    assert(p3.checksum_errors() == 0 && p3.sequence_gaps() == 0);
+    assert(p3.bytes_copied() <= (batched.size() / 4096) * MAX_BATCH_PACKET_SIZE);
+
+    std::cout << "PASSED\n";
+}
+
+void test_reorder_releases_in_order() {
+    std::cout << "Testing reorder buffer releases in order... ";
+
+    ReorderHarness h(8);
+    assert(h.parser.reorder_stats().window == 8);
+
+    // 3 and 4 swapped, 6 arrives after 7-8
+    size_t dispatched = h.feed({1, 2, 4, 3, 5, 7, 8, 6, 9});
+    assert(dispatched == 9);
+    assert((h.seqs == std::vector<uint32_t>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    assert(h.gaps.empty());
+    assert(h.parser.sequence_gaps() == 0);
+
+    ReorderStats stats = h.parser.reorder_stats();
+    assert(stats.held == 3);
+    assert(stats.max_depth == 2);
+    assert(stats.depth == 0);
+    assert(stats.late == 0 && stats.lost == 0);
+
+    // Late copies are dropped, not reported as gaps or dispatched
+    dispatched = h.feed({3, 9, 10});
+    assert(dispatched == 1);
+    assert(h.seqs.back() == 10 && h.seqs.size() == 10);
+    assert(h.parser.reorder_stats().late == 2);
+    assert(h.parser.sequence_gaps() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_reorder_window_overflow() {
+    std::cout << "Testing reorder window overflow declares gap... ";
+
+    ReorderHarness h(8);
+
+    // 2-3 never arrive: 4-9 wait, 10 does not fit
+    h.feed({1, 4, 5, 6, 7, 8, 9});
+    assert(h.seqs.size() == 1);
+    assert(h.parser.reorder_stats().depth == 6);
+
+    h.feed({10});
+    assert(h.gaps.size() == 1 && h.gaps[0].first == 2 && h.gaps[0].second == 4);
+    assert((h.seqs == std::vector<uint32_t>{1, 4, 5, 6, 7, 8, 9, 10}));
+    assert(h.parser.sequence_gaps() == 1);
+
+    ReorderStats stats = h.parser.reorder_stats();
+    assert(stats.overflow_gaps == 1 && stats.timeout_gaps == 0);
+    assert(stats.lost == 2 && stats.depth == 0);
+
+    // A jump past the window with nothing held is a gap straight away
+    h.feed({20});
+    assert(h.gaps.back().first == 11 && h.gaps.back().second == 20);
+    assert(h.seqs.back() == 20);
+
+    // Behind by more than the window is still late
+    h.feed({3});
+    assert(h.seqs.size() == 9);
+    assert(h.parser.reorder_stats().late == 1);
+
+    // Far behind: the stream restarted, resync rather than drop
+    h.feed({3000000});
+    h.feed({1, 2});
+    assert(h.seqs.back() == 2 && h.seqs.size() == 12);
+    assert(h.parser.reorder_stats().late == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void test_reorder_hold_timeout() {
+    std::cout << "Testing reorder hold timeout... ";
+
+    ReorderHarness h(64, 1000000);  // 1ms
+    h.feed({1, 3, 4});
+    assert(h.seqs.size() == 1);
+
+    // parse_messages() checks the hold only as data arrives
+    auto t0 = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(2)) {}
+    h.feed({6});
+    assert(h.gaps.size() == 1 && h.gaps[0].first == 2 && h.gaps[0].second == 3);
+    assert((h.seqs == std::vector<uint32_t>{1, 3, 4}));
+    assert(h.parser.reorder_stats().depth == 1);  // 6 waits for 5
+
+    ReorderStats stats = h.parser.reorder_stats();
+    assert(stats.timeout_gaps == 1 && stats.lost == 1);
+    assert(stats.max_hold_ns >= 1000000);
+    assert(stats.mean_hold_ns > 0);
+
+    // Flushing gives up on 5
+    h.parser.flush_reorder();
+    assert(h.seqs.back() == 6);
+    assert(h.parser.reorder_stats().depth == 0);
+    assert(h.parser.sequence_gaps() == 2);
+
+    std::cout << "PASSED\n";
+}
+
+void test_reorder_batched_and_disabled() {
+    std::cout << "Testing reorder with batches, and disabled... ";
+
+    // Batch records go through the same window
+    BatchEncoder batch;
+    std::vector<uint8_t> stream;
+    for (uint32_t seq : {5u, 6u}) {
+        std::vector<uint8_t> msg = trades({seq});
+        bool appended = batch.append(msg.data(), msg.size());
+        assert(appended);
+    }
+    size_t packet = batch.finish();
+
+    ReorderHarness h(16);
+    auto first = trades({1, 2, 3});
+    h.parser.append_data(first.data(), first.size());
+    h.parser.append_data(batch.data(), packet);
+    h.parser.parse_messages();
+    assert(h.parser.reorder_stats().depth == 2);
+    h.feed({4});
+    assert((h.seqs == std::vector<uint32_t>{1, 2, 3, 4, 5, 6}));
+
+    // Disabled (default): every out-of-order message is a gap, dispatched at once
+    ReorderHarness off(0);
+    assert(off.parser.reorder_stats().window == 0);
+    off.feed({1, 3, 2, 4});
+    assert((off.seqs == std::vector<uint32_t>{1, 3, 2, 4}));
+    assert(off.parser.sequence_gaps() == 3);
+
+    std::cout << "PASSED\n";
+}
+
+// Trades first..first+count-1 with `burst` bytes overwritten by noise at
+// offset `at`; returns the sequences the parser delivered
+static std::vector<uint32_t> parse_corrupted(MessageParser& parser, uint32_t first,
+                                             uint32_t count, size_t at, size_t burst,
+                                             size_t chunk) {
+    std::vector<uint8_t> stream;
+    for (uint32_t i = 0; i < count; ++i) append_trade(stream, first + i);
+    std::mt19937 rng(7);
+    for (size_t i = at; i < at + burst && i < stream.size(); ++i) {
+        stream[i] = static_cast<uint8_t>(rng());
+    }
+
+    std::vector<uint32_t> seqs;
+    parser.set_trade_callback([&seqs](const MessageHeader& h, const TradePayload& p) {
+        uint32_t seq = h.sequence_number;
+        assert(p.price == 100.0 + seq);
+        seqs.push_back(seq);
+    });
+    for (size_t off = 0; off < stream.size(); off += chunk) {
+        parser.append_data(stream.data() + off, std::min(chunk, stream.size() - off));
+        parser.parse_messages();
+    }
+    return seqs;
+}
+
+void test_resync_after_corruption() {
+    std::cout << "Testing resync after corrupt bursts... ";
+
+    // Burst sizes inside one message, across a few, and across many
+    for (size_t burst : {1, 7, 100, 5000}) {
+        MessageParser scan, crawl;
+        crawl.set_resync_scan(false);
+        size_t at = 100 * TRADE_MSG_SIZE + 3;
+        auto scanned = parse_corrupted(scan, 1, 1000, at, burst, 64 * 1024);
+        auto crawled = parse_corrupted(crawl, 1, 1000, at, burst, 64 * 1024);
+
+        // Every message the burst didn't touch, and nothing else
+        uint32_t first_hit = static_cast<uint32_t>(at / TRADE_MSG_SIZE) + 1;
+        uint32_t last_hit = static_cast<uint32_t>((at + burst - 1) / TRADE_MSG_SIZE) + 1;
+        assert(scanned.size() == 1000 - (last_hit - first_hit + 1));
+        assert(scanned == crawled);
+        for (uint32_t seq : scanned) assert(seq < first_hit || seq > last_hit);
+
+        ResyncStats stats = scan.resync_stats();
+        assert(stats.events == 1);
+        assert(stats.bytes_skipped == crawl.resync_stats().bytes_skipped);
+        assert(scan.sequence_gaps() == 1);
+
+        // The scan tries few checksums; the crawl tries one per byte
+        assert(scan.checksum_errors() + scan.malformed_messages() <= 1 + stats.candidates);
+        assert(crawl.checksum_errors() + crawl.malformed_messages() == stats.bytes_skipped);
+    }
+
+    // Same result when the stream arrives in small pieces
+    MessageParser whole, pieces;
+    auto a = parse_corrupted(whole, 1, 500, 2000, 300, 64 * 1024);
+    auto b = parse_corrupted(pieces, 1, 500, 2000, 300, 7);
+    assert(a == b);
+
+    std::cout << "PASSED\n";
+}
+
+void test_resync_rejects_implausible() {
+    std::cout << "Testing resync skips implausible headers... ";
+
+    // Valid-looking messages in the noise: far-off sequence, unknown symbol
+    std::vector<uint8_t> stream = trades({1, 2, 3});
+    stream.insert(stream.end(), {0xFF, 0x13, 0x00, 0xAB});
+    append_trade(stream, 0x70000000);
+    std::vector<uint8_t> bad_symbol = trades({5});
+    bad_symbol[14] = 0xE8;  // symbol_id 1000
+    bad_symbol[15] = 0x03;
+    uint32_t sum = calculate_checksum(bad_symbol.data(), TRADE_MSG_SIZE - CHECKSUM_SIZE);
+    std::memcpy(bad_symbol.data() + TRADE_MSG_SIZE - CHECKSUM_SIZE, &sum, sizeof(sum));
+    stream.insert(stream.end(), bad_symbol.begin(), bad_symbol.end());
+    append_trade(stream, 6);
+
+    MessageParser parser;
+    parser.set_symbol_limit(500);
+    std::vector<uint32_t> seqs;
+    parser.set_trade_callback([&seqs](const MessageHeader& h, const TradePayload&) {
+        uint32_t seq = h.sequence_number;
+        seqs.push_back(seq);
+    });
+    parser.append_data(stream.data(), stream.size());
+    parser.parse_messages();
+
+    assert((seqs == std::vector<uint32_t>{1, 2, 3, 6}));
+    ResyncStats stats = parser.resync_stats();
+    assert(stats.events == 1);
+    assert(stats.rejected >= 3);  // Type 0x13, sequence, symbol (and bytes inside them)
+    assert(stats.bytes_skipped == 4 + 2 * TRADE_MSG_SIZE);
+
+    // Without the scan the far-off message gets through
+    MessageParser crawl;
+    crawl.set_resync_scan(false);
+    std::vector<uint32_t> crawled;
+    crawl.set_trade_callback([&crawled](const MessageHeader& h, const TradePayload&) {
+        uint32_t seq = h.sequence_number;
+        crawled.push_back(seq);
+    });
+    crawl.append_data(stream.data(), stream.size());
+    crawl.parse_messages();
+    assert(crawled.size() == 6);
+
+    std::cout << "PASSED\n";
+}
+
+void test_resync_restarted_stream() {
+    std::cout << "Testing resync into a restarted stream... ";
+
+    // Corruption at the seam, then sequences nowhere near the old ones:
+    // strict for RESYNC_STRICT_BYTES, then any sequence goes
+    MessageParser parser;
+    std::vector<uint8_t> stream = trades({1, 2, 3});
+    stream.push_back(0x01);
+    size_t restart = 4000;
+    for (uint32_t i = 0; i < restart; ++i) append_trade(stream, 50000000 + i);
+
+    std::vector<uint32_t> seqs;
+    parser.set_trade_callback([&seqs](const MessageHeader& h, const TradePayload&) {
+        uint32_t seq = h.sequence_number;
+        seqs.push_back(seq);
+    });
+    parser.append_data(stream.data(), stream.size());
+    parser.parse_messages();
+
+    size_t skipped = MessageParser::RESYNC_STRICT_BYTES / TRADE_MSG_SIZE + 1;
+    assert(seqs.size() == 3 + restart - skipped);
+    assert(seqs[3] == 50000000 + skipped);
+    assert(seqs.back() == 50000000 + restart - 1);
+    assert(parser.resync_stats().events == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void test_resync_split_type() {
+    std::cout << "Testing resync across a chunk ending mid-type... ";
+
+    // Message 5 is noise, and the chunk ends one byte into message 6.
+    // Each chunk sits in its own block followed by a byte that isn't
+    // part of the stream.
+    std::vector<uint8_t> stream = trades({1, 2, 3, 4, 5, 6, 7, 8});
+    std::memset(stream.data() + 4 * TRADE_MSG_SIZE, 0xFF, TRADE_MSG_SIZE);
+    size_t split = 5 * TRADE_MSG_SIZE + 1;
+
+    MessageParser parser;
+    std::vector<uint32_t> seqs;
+    parser.set_trade_callback([&seqs](const MessageHeader& h, const TradePayload&) {
+        uint32_t seq = h.sequence_number;
+        seqs.push_back(seq);
+    });
+    for (auto [off, len] : {std::pair<size_t, size_t>{0, split},
+                            std::pair<size_t, size_t>{split, stream.size() - split}}) {
+        std::vector<uint8_t> block(stream.begin() + off, stream.begin() + off + len);
+        block.push_back(0xFF);
+        parser.parse_buffer(block.data(), len);
+    }
+
+    assert((seqs == std::vector<uint32_t>{1, 2, 3, 4, 6, 7, 8}));
+    assert(parser.resync_stats().events == 1);
+    assert(parser.resync_stats().bytes_skipped == TRADE_MSG_SIZE);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Parser Tests ===\n";
+
+    test_parse_v1();
+    test_buffer_growth();
+    test_parse_v2_matches_v1();
+    test_fragmented_input();
+    test_parse_in_place();
+    test_batched_packets();
+    test_reorder_releases_in_order();
+    test_reorder_window_overflow();
+    test_reorder_hold_timeout();
+    test_reorder_batched_and_disabled();
+    test_resync_after_corruption();
+    test_resync_rejects_implausible();
+    test_resync_restarted_stream();
+    test_resync_split_type();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
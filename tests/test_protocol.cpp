@@ -63,6 +63,59 @@ void test_symbol_names() {
     std::cout << "PASSED\n";
 }
 
+void test_v2_layout() {
+    std::cout << "Testing v2 message layout... ";
+    
+    assert(sizeof(TradePayloadV2) == TRADE_V2_PAYLOAD_SIZE);
+    assert(sizeof(QuotePayloadV2) == QUOTE_V2_PAYLOAD_SIZE);
+    assert(sizeof(DepthUpdatePayloadV2) == DEPTH_V2_PAYLOAD_SIZE);
+    assert(sizeof(SubscriptionRequestV2) == 4);
+    assert(sizeof(BatchHeader) == BATCH_HEADER_SIZE);
+    assert(sizeof(BatchRecord) == BATCH_RECORD_SIZE);
+    
+    assert(get_message_size(MessageType::TRADE_V2) == TRADE_V2_MSG_SIZE);
+    assert(get_message_size(MessageType::QUOTE_V2) == QUOTE_V2_MSG_SIZE);
+    assert(QUOTE_V2_MSG_SIZE < QUOTE_MSG_SIZE);
+    
+    // Paisa round trip
+    assert(to_fixed_price(1234.56) == 123456);
+    assert(to_fixed_price(0.07) == 7);
+    assert(from_fixed_price(123456) == 1234.56);
+    
+    std::cout << "PASSED\n";
+}
+
+void test_v2_encode() {
+    std::cout << "Testing v1 -> v2 encoding... ";
+    
+    QuoteMessage v1{};
+    v1.header.message_type = static_cast<uint16_t>(MessageType::QUOTE);
+    v1.header.sequence_number = 42;
+    v1.header.symbol_id = 7;
+    v1.payload = {2500.15, 300, 2500.65, 700};
+    v1.checksum = calculate_checksum(&v1, HEADER_SIZE + QUOTE_PAYLOAD_SIZE);
+    
+    uint8_t out[MAX_MSG_SIZE];
+    size_t size = encode_v2(reinterpret_cast<const uint8_t*>(&v1), out);
+    assert(size == QUOTE_V2_MSG_SIZE);
+    
+    MessageHeader header;
+    QuotePayloadV2 payload;
+    std::memcpy(&header, out, sizeof(header));
+    std::memcpy(&payload, out + HEADER_SIZE, sizeof(payload));
+    assert(header.message_type == static_cast<uint16_t>(MessageType::QUOTE_V2));
+    assert(header.sequence_number == 42);
+    assert(payload.bid_price == 250015);
+    assert(payload.ask_price == 250065);
+    assert(payload.ask_quantity == 700);
+    
+    uint32_t checksum;
+    std::memcpy(&checksum, out + HEADER_SIZE + QUOTE_V2_PAYLOAD_SIZE, 4);
+    assert(checksum == calculate_checksum(out, HEADER_SIZE + QUOTE_V2_PAYLOAD_SIZE));
+    
+    std::cout << "PASSED\n";
+}
+
 int main() {
     std::cout << "=== Protocol Tests ===\n";
     
@@ -70,6 +123,8 @@ int main() {
     test_checksum();
     test_message_type_sizes();
     test_symbol_names();
+    test_v2_layout();
+    test_v2_encode();
     
     std::cout << "\nAll tests passed!\n";
     return 0;
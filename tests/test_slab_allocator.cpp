@@ -0,0 +1,205 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "../include/alloc_counter.h"
+#include "../include/slab_allocator.h"
+
+using namespace mdf;
+
+static size_t total_in_use(const SlabAllocator& slab) {
+    size_t total = 0;
+    for (size_t i = 0; i < SlabAllocator::NUM_CLASSES; ++i) {
+        total += slab.class_stats(i).in_use;
+    }
+    return total;
+}
+
+void test_size_classes() {
+    std::cout << "Testing size classes... ";
+
+    assert(SlabAllocator::class_index(1) == 0);
+    assert(SlabAllocator::class_index(64) == 0);
+    assert(SlabAllocator::class_index(65) == 1);
+    assert(SlabAllocator::class_index(4096) == 6);
+    assert(SlabAllocator::class_index(4097) == 7);
+    assert(SlabAllocator::class_index(64 * 1024) == SlabAllocator::NUM_CLASSES - 1);
+    assert(SlabAllocator::class_index(64 * 1024 + 1) == SlabAllocator::NUM_CLASSES);
+
+    SlabAllocator slab;
+    for (size_t i = 0; i < SlabAllocator::NUM_CLASSES; ++i) {
+        SlabAllocator::ClassStats stats = slab.class_stats(i);
+        assert(stats.block_size == SlabAllocator::class_size(i));
+        assert(stats.capacity * stats.block_size == SlabAllocator::DEFAULT_CLASS_BYTES ||
+               stats.capacity == 1);
+        assert(stats.in_use == 0 && stats.fallbacks == 0);
+    }
+
+    // Every size lands in its class, aligned to the class size
+    std::vector<std::pair<void*, size_t>> held;
+    for (size_t size : {1, 24, 64, 100, 128, 700, 4000, 5000, 40000, 65536}) {
+        void* ptr = slab.allocate(size, 8);
+        size_t index = SlabAllocator::class_index(size);
+        assert(slab.owns(ptr));
+        assert(slab.class_pool(size)->owns(ptr));
+        size_t align = std::min<size_t>(SlabAllocator::class_size(index), 4096);
+        assert(reinterpret_cast<uintptr_t>(ptr) % align == 0);
+        std::memset(ptr, 0xab, size);
+        held.emplace_back(ptr, size);
+    }
+    assert(slab.class_stats(0).in_use == 3);
+    assert(slab.class_stats(1).in_use == 2);
+    assert(slab.class_stats(SlabAllocator::NUM_CLASSES - 1).in_use == 2);
+    assert(total_in_use(slab) == held.size());
+
+    // An alignment above the size picks a larger class
+    void* aligned = slab.allocate(16, 256);
+    assert(reinterpret_cast<uintptr_t>(aligned) % 256 == 0);
+    assert(slab.class_stats(2).in_use == 1);
+    slab.deallocate(aligned, 16, 256);
+
+    for (auto& [ptr, size] : held) {
+        slab.deallocate(ptr, size, 8);
+    }
+    assert(total_in_use(slab) == 0);
+    assert(slab.oversize_allocations() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_upstream() {
+    std::cout << "Testing exhausted and oversize requests go upstream... ";
+
+    // 1KB a class: sixteen 64B blocks, a single 1KB block, one 64KB block
+    SlabAllocator slab(1024);
+    assert(slab.class_stats(0).capacity == 16);
+    assert(slab.class_stats(4).capacity == 1);
+    assert(slab.class_stats(SlabAllocator::NUM_CLASSES - 1).capacity == 1);
+
+    std::vector<void*> small;
+    for (int i = 0; i < 16; ++i) {
+        small.push_back(slab.allocate(48));
+    }
+    AllocationScope scope;
+    void* extra = slab.allocate(48);
+    assert(scope.allocations() == 1);
+    assert(!slab.owns(extra));
+    assert(slab.class_stats(0).fallbacks == 1);
+
+    void* big = slab.allocate(100 * 1024);
+    void* page_aligned = slab.allocate(64, 8192);
+    assert(reinterpret_cast<uintptr_t>(page_aligned) % 8192 == 0);
+    assert(slab.oversize_allocations() == 2);
+    assert(scope.allocations() == 3);
+
+    // Upstream blocks go back upstream, class blocks to their class
+    slab.deallocate(extra, 48);
+    slab.deallocate(big, 100 * 1024);
+    slab.deallocate(page_aligned, 64, 8192);
+    for (void* ptr : small) {
+        slab.deallocate(ptr, 48);
+    }
+    assert(slab.class_stats(0).in_use == 0);
+    assert(scope.allocations() == 3);
+
+    // A freed block serves the next request, with no fallback
+    void* again = slab.allocate(48);
+    assert(slab.owns(again));
+    assert(slab.class_stats(0).fallbacks == 1);
+    slab.deallocate(again, 48);
+
+    std::cout << "PASSED\n";
+}
+
+void test_pmr_containers() {
+    std::cout << "Testing std::pmr containers on the slab... ";
+
+    SlabAllocator slab;
+    {
+        AllocationScope scope;
+        std::pmr::vector<uint16_t> symbols(&slab);
+        for (uint16_t i = 0; i < 500; ++i) {
+            symbols.push_back(i);
+        }
+        std::pmr::unordered_set<uint16_t> subscribed(symbols.begin(), symbols.end(), 0, {}, {},
+                                                     &slab);
+        std::pmr::string address("2001:0db8:85a3:0000:0000:8a2e:0370:7334", &slab);
+        assert(subscribed.size() == 500 && subscribed.count(42) == 1);
+        assert(address.size() == 39);
+        assert(scope.allocations() == 0);
+        assert(slab.class_stats(0).in_use >= 500);   // Set nodes
+
+        // Moved-from containers hand over their slab blocks
+        std::pmr::unordered_set<uint16_t> moved(std::move(subscribed));
+        assert(moved.get_allocator().resource() == &slab);
+        assert(scope.allocations() == 0);
+    }
+    assert(total_in_use(slab) == 0);
+
+    // Other resources are never equal, so containers copy between them
+    SlabAllocator other;
+    assert(slab.is_equal(slab) && !slab.is_equal(other));
+
+    std::cout << "PASSED\n";
+}
+
+void test_concurrent() {
+    std::cout << "Testing concurrent allocation across classes... ";
+
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 20000;
+    SlabAllocator slab(256 * 1024);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&slab, t] {
+            std::mt19937 rng(t);
+            std::vector<std::pair<uint8_t*, size_t>> held;
+            for (int i = 0; i < ROUNDS; ++i) {
+                if (held.size() < 32 && (held.empty() || rng() % 2)) {
+                    size_t size = 1 + rng() % (rng() % 8 == 0 ? 16384 : 512);
+                    auto* ptr = static_cast<uint8_t*>(slab.allocate(size));
+                    std::memset(ptr, t + 1, size);
+                    held.emplace_back(ptr, size);
+                } else {
+                    size_t pick = rng() % held.size();
+                    auto [ptr, size] = held[pick];
+                    for (size_t b = 0; b < size; b += 61) {
+                        assert(ptr[b] == t + 1);
+                    }
+                    slab.deallocate(ptr, size);
+                    held[pick] = held.back();
+                    held.pop_back();
+                }
+            }
+            for (auto& [ptr, size] : held) {
+                slab.deallocate(ptr, size);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Exited threads returned their cached blocks
+    assert(total_in_use(slab) == 0);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Slab Allocator Tests ===\n";
+
+    test_size_classes();
+    test_upstream();
+    test_pmr_containers();
+    test_concurrent();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
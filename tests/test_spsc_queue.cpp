@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include "../include/spsc_queue.h"
+
+using namespace mdf;
+
+void test_bounds() {
+    std::cout << "Testing SPSC bounds... ";
+
+    SpscQueue<int> queue(5);
+    assert(queue.capacity() == 8);   // Rounded to a power of two
+
+    int out[16];
+    size_t popped = queue.pop_batch(out, 16);
+    assert(popped == 0);
+    for (int i = 0; i < 8; ++i) {
+        bool pushed = queue.try_push(i);
+        assert(pushed);
+    }
+    bool pushed = queue.try_push(8);
+    assert(!pushed);                 // Full
+    assert(queue.size() == 8);
+
+    popped = queue.pop_batch(out, 3);
+    assert(popped == 3);
+    assert(out[0] == 0 && out[2] == 2);
+    pushed = queue.try_push(8);
+    assert(pushed);                  // Room again, wraps around
+    popped = queue.pop_batch(out, 16);
+    assert(popped == 6);
+    assert(out[0] == 3 && out[5] == 8);
+    assert(queue.size() == 0);
+    assert(queue.max_depth() == 8);
+
+    std::cout << "PASSED\n";
+}
+
+void test_concurrent_order() {
+    std::cout << "Testing SPSC concurrent order... ";
+
+    // A small ring forces the producer to wrap and hit full often
+    constexpr uint64_t COUNT = 2000000;
+    SpscQueue<uint64_t> queue(64);
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < COUNT; ++i) {
+            while (!queue.try_push(i)) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t batch[32];
+    bool in_order = true;
+    while (expected < COUNT) {
+        size_t n = queue.pop_batch(batch, 32);
+        if (n == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (batch[i] != expected++) in_order = false;
+        }
+    }
+    producer.join();
+    assert(in_order);
+    assert(queue.size() == 0);
+    assert(queue.max_depth() <= 64);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== SPSC Queue Tests ===\n";
+
+    test_bounds();
+    test_concurrent_order();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/symbol_master.h"
+
+using namespace mdf;
+
+static std::string write_file(const char* name, const std::string& contents) {
+    std::string path = std::string("/tmp/") + name;
+    std::ofstream out(path);
+    out << contents;
+    return path;
+}
+
+void test_builtin_names() {
+    std::cout << "Testing built-in names... ";
+
+    SymbolMaster symbols(200);
+    assert(symbols.size() == 200);
+    assert(std::string(symbols.name(0)) == "RELIANCE");
+    assert(std::string(symbols.name(49)) == "BLUESTAR");
+    assert(std::string(symbols.name(100)) == "SYM100");
+    assert(std::string(symbols.name(200)) == "?");
+    assert(symbols.find(200) == nullptr);
+
+    const SymbolInfo* info = symbols.find(2);
+    assert(info && info->id == 2 && info->name_length == 4);
+    assert(info->tick_size == SymbolMaster::DEFAULT_TICK_SIZE);
+    assert(info->lot_size == SymbolMaster::DEFAULT_LOT_SIZE);
+
+    // Matches the display helper it replaces
+    for (uint16_t id = 0; id < 200; ++id) {
+        assert(std::strcmp(symbols.name(id), get_symbol_name(id)) == 0);
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void test_name_lookup() {
+    std::cout << "Testing perfect-hash name lookup... ";
+
+    // Every name maps back to its id at several table sizes
+    for (size_t count : {1, 7, 500, 5000, 65535}) {
+        SymbolMaster symbols(count);
+        for (size_t id = 0; id < count; ++id) {
+            const SymbolInfo* info = symbols.find(static_cast<uint16_t>(id));
+            assert(symbols.id_of(std::string_view(info->name, info->name_length)) ==
+                   static_cast<int>(id));
+        }
+    }
+
+    SymbolMaster symbols;
+    assert(symbols.id_of("TCS") == 1);
+    assert(symbols.id_of("M&M") == 39);
+    assert(symbols.id_of("TC") == -1);
+    assert(symbols.id_of("TCSX") == -1);
+    assert(symbols.id_of("") == -1);
+    assert(symbols.id_of("SYM999") == -1);
+
+    std::cout << "PASSED\n";
+}
+
+void test_load_file() {
+    std::cout << "Testing reference-data file... ";
+
+    std::string path = write_file("mdf_symbols.csv",
+        "# id,name,tick,lot\n"
+        "\n"
+        "0, NIFTY50 ,0.01,50\n"
+        "3,BANKNIFTY,0.05,15\r\n"
+        "7,XYZ\n");
+
+    SymbolMaster symbols(10);
+    bool loaded = symbols.load(path);
+    assert(loaded);
+    assert(std::string(symbols.name(0)) == "NIFTY50");
+    assert(symbols.find(0)->tick_size == 0.01);
+    assert(symbols.find(0)->lot_size == 50);
+    assert(symbols.find(3)->lot_size == 15);
+    assert(std::string(symbols.name(7)) == "XYZ");
+    assert(symbols.find(7)->tick_size == SymbolMaster::DEFAULT_TICK_SIZE);
+    assert(std::string(symbols.name(1)) == "TCS");   // Unlisted ids keep defaults
+
+    assert(symbols.id_of("NIFTY50") == 0);
+    assert(symbols.id_of("BANKNIFTY") == 3);
+    assert(symbols.id_of("RELIANCE") == -1);         // Replaced
+    assert(symbols.id_of("HDFC") == -1);
+
+    std::cout << "PASSED\n";
+}
+
+void test_load_errors() {
+    std::cout << "Testing reference-data errors... ";
+
+    const char* bad[] = {
+        "10,OUTSIDE\n",                 // Id beyond the table
+        "x,BAD\n",                      // Not a number
+        "1,A\n1,B\n",                   // Id listed twice
+        "1,TCS2\n2,TCS2\n",             // Name listed twice
+        "2,TCS\n",                      // Clashes with a default name
+        "1,\n",                         // Empty name
+        "1,A,0\n",                      // Zero tick size
+        "1,A,0.05,0\n",                 // Zero lot size
+        "1,A,0.05,1,extra\n",           // Too many fields
+        "1\n",                          // Too few fields
+    };
+
+    for (const char* contents : bad) {
+        SymbolMaster symbols(10);
+        std::string path = write_file("mdf_symbols_bad.csv", contents);
+        bool loaded = symbols.load(path);
+        assert(!loaded);
+        assert(!symbols.last_error().empty());
+
+        // Unchanged on failure
+        assert(std::string(symbols.name(1)) == "TCS");
+        assert(symbols.id_of("TCS") == 1);
+    }
+
+    SymbolMaster symbols(10);
+    bool loaded = symbols.load("/nonexistent/symbols.csv");
+    assert(!loaded);
+
+    std::cout << "PASSED\n";
+}
+
+void test_concurrent_lookup() {
+    std::cout << "Testing concurrent lookups... ";
+
+    // Names are stable pointers into the table, so readers never race
+    SymbolMaster symbols(1000);
+    std::vector<std::thread> threads;
+    std::vector<bool> ok(4, true);
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < 200; ++round) {
+                for (uint16_t id = 0; id < 1000; ++id) {
+                    const char* name = symbols.name(id);
+                    if (symbols.id_of(name) != id) ok[t] = false;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (bool b : ok) assert(b);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Symbol Master Tests ===\n";
+
+    test_builtin_names();
+    test_name_lookup();
+    test_load_file();
+    test_load_errors();
+    test_concurrent_lookup();
+
+    std::remove("/tmp/mdf_symbols.csv");
+    std::remove("/tmp/mdf_symbols_bad.csv");
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "../include/tick_ring.h"
+
+using namespace mdf;
+
+static void put(TickRing& ring, uint64_t value, TickRing::Kind kind = TickRing::Kind::Tick) {
+    uint8_t* buffer = ring.claim();
+    std::memcpy(buffer, &value, sizeof(value));
+    std::memset(buffer + sizeof(value), static_cast<int>(value), MAX_MSG_SIZE - sizeof(value));
+    ring.publish(MAX_MSG_SIZE, static_cast<uint16_t>(value % 100), kind);
+}
+
+// Check a message put() wrote and return its value
+static uint64_t check(const uint8_t* data, size_t size, uint16_t symbol_id) {
+    uint64_t value;
+    assert(size == MAX_MSG_SIZE);
+    std::memcpy(&value, data, sizeof(value));
+    assert(symbol_id == value % 100);
+    for (size_t i = sizeof(value); i < size; ++i) {
+        if (data[i] != static_cast<uint8_t>(value)) return UINT64_MAX;   // Torn
+    }
+    return value;
+}
+
+void test_readers() {
+    std::cout << "Testing every reader sees every message... ";
+
+    TickRing ring(100);
+    assert(ring.capacity() == 128);   // Rounded to a power of two
+
+    uint64_t a = ring.head();
+    put(ring, 1);
+    put(ring, 2, TickRing::Kind::Heartbeat);
+    uint64_t b = ring.head();   // Joins late: sees only what follows
+    put(ring, 3);
+
+    std::vector<uint64_t> seen_a, seen_b;
+    size_t heartbeats = 0;
+    auto reader = [&](std::vector<uint64_t>& seen) {
+        return [&](const uint8_t* data, size_t size, uint16_t symbol_id, TickRing::Kind kind) {
+            seen.push_back(check(data, size, symbol_id));
+            heartbeats += kind == TickRing::Kind::Heartbeat;
+        };
+    };
+    uint64_t lost_a = ring.read(a, reader(seen_a));
+    uint64_t lost_b = ring.read(b, reader(seen_b));
+    assert(lost_a == 0 && lost_b == 0);
+    assert((seen_a == std::vector<uint64_t>{1, 2, 3}));
+    assert((seen_b == std::vector<uint64_t>{3}));
+    assert(heartbeats == 1);
+    assert(a == 3 && b == 3);
+
+    // Nothing new, nothing read
+    lost_a = ring.read(a, reader(seen_a));
+    assert(lost_a == 0 && seen_a.size() == 3);
+
+    std::cout << "PASSED\n";
+}
+
+void test_overrun() {
+    std::cout << "Testing a lagging reader skips what was overwritten... ";
+
+    TickRing ring(16);
+    uint64_t cursor = ring.head();
+    for (uint64_t i = 0; i < 50; ++i) {
+        put(ring, i);
+    }
+
+    std::vector<uint64_t> seen;
+    uint64_t lost = ring.read(cursor, [&](const uint8_t* data, size_t size, uint16_t symbol_id,
+                                          TickRing::Kind) {
+        seen.push_back(check(data, size, symbol_id));
+    });
+    assert(lost == 50 - 16);
+    assert(seen.size() == 16);
+    assert(seen.front() == 34 && seen.back() == 49);
+    assert(cursor == ring.head());
+
+    std::cout << "PASSED\n";
+}
+
+void test_concurrent() {
+    std::cout << "Testing concurrent readers against a fast producer... ";
+
+    // Small ring: readers get lapped now and then, and must then count
+    // losses rather than pass on a torn or reordered message
+    constexpr uint64_t COUNT = 1000000;
+    constexpr int READERS = 3;
+    TickRing ring(256);
+    std::vector<uint64_t> received(READERS), lost(READERS);
+    std::vector<uint8_t> ok(READERS, 1);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&, r]() {
+            uint64_t cursor = 0;
+            uint64_t last = 0;
+            bool first = true;
+            while (received[r] + lost[r] < COUNT) {
+                lost[r] += ring.read(cursor, [&](const uint8_t* data, size_t size,
+                                                 uint16_t symbol_id, TickRing::Kind) {
+                    uint64_t value = check(data, size, symbol_id);
+                    if (value == UINT64_MAX || (!first && value <= last)) ok[r] = 0;
+                    last = value;
+                    first = false;
+                    received[r]++;
+                });
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (uint64_t i = 0; i < COUNT; ++i) {
+        put(ring, i);
+        if (i % 64 == 0) std::this_thread::yield();   // Interleave on one core too
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    for (int r = 0; r < READERS; ++r) {
+        assert(ok[r]);
+        assert(received[r] + lost[r] == COUNT);
+        assert(received[r] > 0);
+    }
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== Tick Ring Tests ===\n";
+
+    test_readers();
+    test_overrun();
+    test_concurrent();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
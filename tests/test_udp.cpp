@@ -0,0 +1,204 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "../include/parser.h"
+#include "../include/socket.h"
+#include "../include/tick_generator.h"
+#include "../include/udp_publisher.h"
+
+using namespace mdf;
+
+// Publish count ticks, one datagram per flush_every messages
+static void publish_ticks(TickGenerator& gen, UdpPublisher& pub, size_t count,
+                          size_t flush_every) {
+    uint8_t buffer[MAX_MSG_SIZE];
+    size_t size;
+    uint16_t symbol_id;
+    for (size_t i = 0; i < count; ++i) {
+        gen.generate_tick(buffer, size, symbol_id);
+        pub.publish(buffer, size);
+        if ((i + 1) % flush_every == 0) {
+            pub.flush();
+        }
+    }
+    pub.flush();
+}
+
+// Receive datagrams until the expected number arrive (or 2s pass)
+// lose_every > 0 discards every Nth datagram (from the middle of each
+// run of N, so the last one survives) to simulate loss
+static size_t receive_ticks(MarketDataSocket& sock, MessageParser& parser,
+                            size_t expected_datagrams, size_t lose_every = 0) {
+    size_t parsed = 0;
+    size_t datagrams = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (datagrams < expected_datagrams && std::chrono::steady_clock::now() < deadline) {
+        int count = sock.receive_datagrams();
+        assert(count >= 0);
+        if (count == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (lose_every && ++datagrams % lose_every == lose_every / 2) {
+                continue;
+            }
+            if (!lose_every) {
+                datagrams++;
+            }
+            parser.append_data(sock.datagram(i), sock.datagram_size(i));
+            parsed += parser.parse_messages();
+        }
+    }
+    return parsed;
+}
+
+void test_unicast_loopback() {
+    std::cout << "Testing UDP unicast over loopback... ";
+
+    MarketDataSocket sock;
+    bool ok = sock.open_udp("127.0.0.1", 0);
+    assert(ok);
+    assert(sock.udp_port() != 0);
+
+    UdpPublisher pub;
+    ok = pub.add_destination("127.0.0.1", sock.udp_port());
+    assert(ok);
+    assert(!pub.is_multicast());
+
+    TickGenerator gen(10);
+    publish_ticks(gen, pub, 2000, 20);
+    assert(pub.send_errors() == 0);
+
+    MessageParser parser;
+    size_t parsed = receive_ticks(sock, parser, 100);
+    assert(parsed == 2000);
+    assert(parser.sequence_gaps() == 0);
+    assert(parser.checksum_errors() == 0);
+    assert(sock.datagrams_received() == pub.datagrams_sent());
+
+    std::cout << "PASSED\n";
+}
+
+void test_unicast_fanout() {
+    std::cout << "Testing UDP unicast endpoint list... ";
+
+    MarketDataSocket a, b;
+    bool ok = a.open_udp("127.0.0.1", 0);
+    assert(ok);
+    ok = b.open_udp("127.0.0.1", 0);
+    assert(ok);
+
+    UdpPublisher pub;
+    ok = pub.add_destination("127.0.0.1", a.udp_port());
+    assert(ok);
+    ok = pub.add_destination("127.0.0.1", b.udp_port());
+    assert(ok);
+    assert(pub.destination_count() == 2);
+
+    // A group can't be mixed with unicast endpoints
+    ok = pub.add_destination("239.255.0.1", 40000);
+    assert(!ok);
+
+    TickGenerator gen(10);
+    publish_ticks(gen, pub, 500, 10);
+
+    MessageParser pa, pb;
+    size_t parsed_a = receive_ticks(a, pa, 50);
+    size_t parsed_b = receive_ticks(b, pb, 50);
+    assert(parsed_a == 500 && parsed_b == 500);
+
+    std::cout << "PASSED\n";
+}
+
+void test_multicast_loopback() {
+    std::cout << "Testing UDP multicast over loopback... ";
+
+    // Two receivers share the group port
+    MarketDataSocket a, b;
+    if (!a.open_udp("239.255.77.1", 0)) {
+        std::cout << "SKIPPED (" << a.last_error() << ")\n";
+        return;
+    }
+    bool ok = b.open_udp("239.255.77.1", a.udp_port());
+    assert(ok);
+
+    UdpPublisher pub;
+    ok = pub.add_destination("239.255.77.1", a.udp_port());
+    assert(ok);
+    assert(pub.is_multicast());
+
+    TickGenerator gen(10);
+    publish_ticks(gen, pub, 1000, 25);
+
+    // One send per datagram regardless of receiver count
+    assert(pub.datagrams_sent() == 40);
+
+    MessageParser pa, pb;
+    size_t parsed_a = receive_ticks(a, pa, 40);
+    size_t parsed_b = receive_ticks(b, pb, 40);
+    assert(parsed_a == 1000 && parsed_b == 1000);
+    assert(pa.sequence_gaps() == 0 && pb.sequence_gaps() == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_gap_recovery() {
+    std::cout << "Testing gap recovery from retained messages... ";
+
+    MarketDataSocket sock;
+    bool ok = sock.open_udp("127.0.0.1", 0);
+    assert(ok);
+    UdpPublisher pub;
+    ok = pub.add_destination("127.0.0.1", sock.udp_port());
+    assert(ok);
+
+    TickGenerator gen(10);
+    publish_ticks(gen, pub, 2000, 20);  // 100 datagrams
+
+    // Lose every 10th datagram; gaps name the missing ranges
+    std::vector<std::pair<uint32_t, uint32_t>> gaps;
+    MessageParser parser;
+    parser.set_gap_callback([&](uint32_t expected, uint32_t received) {
+        gaps.emplace_back(expected, received);
+    });
+    size_t live = receive_ticks(sock, parser, 100, 10);
+    assert(live == 1800);
+    assert(gaps.size() == 10);
+
+    // Server side answers retransmit requests from its ring
+    size_t recovered = 0;
+    uint8_t buffer[MAX_MSG_SIZE];
+    for (const auto& [expected, received] : gaps) {
+        for (uint32_t seq = expected; seq != received; ++seq) {
+            size_t size = pub.lookup(seq, buffer);
+            assert(size > 0);
+            MessageHeader header;
+            std::memcpy(&header, buffer, sizeof(header));
+            assert(header.sequence_number == seq);
+            recovered++;
+        }
+    }
+    assert(live + recovered == 2000);
+
+    // Messages older than the ring are gone
+    publish_ticks(gen, pub, UdpPublisher::RETRANSMIT_DEPTH, 50);
+    assert(pub.lookup(gaps.front().first, buffer) == 0);
+
+    std::cout << "PASSED\n";
+}
+
+int main() {
+    std::cout << "=== UDP Distribution Tests ===\n";
+
+    test_unicast_loopback();
+    test_unicast_fanout();
+    test_multicast_loopback();
+    test_gap_recovery();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}